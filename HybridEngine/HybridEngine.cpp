@@ -13,6 +13,30 @@
 #include "MeshComponent.h"
 #include "BlendState.h"
 #include "DepthStencilState.h"
+#include "NullBackend.h"
+#include "RenderQueue.h"
+#include "ConstantBufferRing.h"
+#include "JobSystem.h"
+#include "BaseApp.h"
+#include "Benchmarks.h"
+#include "SceneGraph.h"
+#include "ECS/World.h"
+#include "ECS/Components.h"
+#include "FrustumCuller.h"
+#include "OcclusionCuller.h"
+#include "MathConversions.h"
+#include "PlanarShadows.h"
+#include "ObjLoader.h"
+#include "MeshFile.h"
+#include "MeshOptimizer.h"
+#include "VertexFormat.h"
+#include "MeshSimplifier.h"
+#include "ShaderCache.h"
+#include "ShaderPermutations.h"
+#include "AsyncLoader.h"
+#include "ParameterBlock.h"
+#include "HotReloader.h"
+#include <cstdio>
 
 // Customs
 Window g_window;
@@ -25,32 +49,58 @@ Texture g_depthStencil;
 DepthStencilView g_depthStencilView;
 Viewport g_viewport;
 ShaderProgram g_shaderProgram;
-ShaderProgram g_shaderShadow;
+ShaderPermutations g_instancedShaders;   // Mundo y color por instancia (slot 1)
+ShaderVariantKey g_instancedKey = 0;
+ShaderVariantKey g_instancedShadowKey = 0;   // Sombras planas: solo el color de la instancia
+VertexFormat g_vertexFormat;       // Formato de los vertices de la escena
+ShaderCache g_shaderCache;         // Bytecode compilado entre ejecuciones
+AsyncLoader g_loader;              // Carga en paralelo de InitDevice
+bool g_quitDuringLoad = false;
+HotReloader g_hotReloader;         // Recarga .fx y texturas editados en caliente
 BlendState g_shadowBlendState;
 DepthStencilState g_shadowDepthStencilState;
+RenderQueue g_renderQueue;
+ConstantBufferRing g_constantRing;
 
-// Camera Buffers
-Buffer m_neverChanges;
-Buffer m_changeOnResize;
+// Modo headless: backend nulo sin ventana ni GPU
+NullBackend g_nullBackend;
+bool g_headless = false;
+unsigned int g_headlessFrames = 1000;
+
+JobSystem g_jobSystem;
+
+// Camera Buffers: layout reflejado de HybridEngine.fx, se suben solo si cambian
+ParameterBlock m_neverChanges;
+ParameterBlock m_changeOnResize;
 
 // Cube Buffers
 Buffer m_vertexBuffer;
 Buffer m_indexBuffer;
-Buffer m_changeEveryFrame;
-
-// Cube Shadow Buffers
-Buffer m_constShadow;
 
 // Plane Buffers
 Buffer m_planeVertexBuffer;
 Buffer m_planeIndexBuffer;
-Buffer m_constPlane;
 
 // Variable global para el constant buffer de la luz puntual
 ID3D11ShaderResourceView*           g_pTextureRV = NULL;
 ID3D11SamplerState*                 g_pSamplerLinear = NULL;
-XMMATRIX                            g_World;         // Para el cubo
-XMMATRIX                            g_PlaneWorld;    // Para el plano
+SceneGraph                          g_sceneGraph;
+SceneNodeId                         g_planeNode = INVALID_SCENE_NODE;
+SceneNodeId                         g_cubeNode = INVALID_SCENE_NODE;  // Hijo del plano
+EntityWorld                         g_world;
+Entity                              g_cubeEntity = NULL_ENTITY;
+FrustumCuller                       g_frustumCuller;
+std::vector<unsigned int>           g_cullObjects;   // Indice del culler -> objeto
+std::vector<unsigned int>           g_visibleList;
+std::vector<Bounds>                 g_cullBounds;    // Bounds en mundo por indice del culler
+OcclusionCuller                     g_occlusionCuller;
+PlanarShadows                       g_planarShadows;
+std::vector<XMFLOAT4X4>             g_shadowCasterWorlds;
+std::vector<XMFLOAT4>               g_shadowCasterColors;
+std::vector<Bounds>                 g_shadowCasterBounds;
+std::vector<unsigned int>           g_shadowCasterObjects;
+std::vector<CBChangesEveryFrame>    g_shadowCandidates;  // [luz][plano][caster]
+std::vector<MeshLOD>                g_cubeLODs;          // Niveles de detalle del cubo en su m_index
 XMMATRIX                            g_View;
 XMMATRIX                            g_Projection;
 XMFLOAT4                            g_vMeshColor(0.7f, 0.7f, 0.7f, 1.0f);
@@ -65,9 +115,14 @@ MeshComponent cubeMesh;
 MeshComponent planeMesh;
 CBNeverChanges cbNeverChanges;
 CBChangeOnResize cbChangesOnResize;
-CBChangesEveryFrame cbPlane;
-CBChangesEveryFrame cb;
-CBChangesEveryFrame cbShadow;
+
+// Orden de las constantes por objeto dentro del FramePacket
+enum
+SceneObject {
+  OBJECT_PLANE = 0,
+  OBJECT_CUBE,
+  OBJECT_COUNT
+};
 
 //--------------------------------------------------------------------------------------
 // Declaraciones adelantadas
@@ -75,8 +130,83 @@ CBChangesEveryFrame cbShadow;
 HRESULT InitDevice();
 void CleanupDevice();
 LRESULT CALLBACK    WndProc(HWND, UINT, WPARAM, LPARAM);
-void UpdateScene();
-void RenderScene();
+void UpdateScene(FramePacket& packet);
+void RenderScene(const FramePacket& packet);
+
+// La escena de ejemplo sobre el frame loop de BaseApp
+class
+HybridApp : public BaseApp {
+public:
+  explicit HybridApp(Window& window) : BaseApp(window) {}
+
+  HRESULT
+  init() override { return InitDevice(); }
+
+  void
+  update(FramePacket& packet) override { UpdateScene(packet); }
+
+  void
+  render(const FramePacket& packet) override { RenderScene(packet); }
+
+  void
+  destroy() override { CleanupDevice(); }
+};
+
+HybridApp g_app(g_window);
+
+// Resumen de -headless: a la salida de depuracion y a stdout, para que un
+// script lo lea sin depurador
+void PrintSummary(const std::string& text)
+{
+  OutputDebugStringA(text.c_str());
+  fputs(text.c_str(), stdout);
+  fflush(stdout);
+}
+
+// Ruta que sigue a flag en la linea de comandos, o "" si no hay (o si sigue
+// otro flag). index elige entre varias rutas seguidas. Acepta rutas entre
+// comillas y las convierte a la pagina de codigos ANSI, la que usan las
+// funciones de archivo con char
+std::string ParsePathArgument(LPCWSTR cmdLine, LPCWSTR flag, unsigned int index = 0)
+{
+  const wchar_t* c = cmdLine ? wcsstr(cmdLine, flag) : nullptr;
+  if (!c) {
+    return std::string();
+  }
+  c += wcslen(flag);
+  std::wstring path;
+  for (unsigned int i = 0; i <= index; ++i) {
+    while (*c == L' ') {
+      ++c;
+    }
+    if (*c == L'\0' || *c == L'-') {
+      return std::string();
+    }
+    path.clear();
+    if (*c == L'"') {
+      for (++c; *c && *c != L'"'; ++c) {
+        path += *c;
+      }
+      if (*c == L'"') {
+        ++c;
+      }
+    }
+    else {
+      for (; *c && *c != L' '; ++c) {
+        path += *c;
+      }
+    }
+  }
+
+  int length = static_cast<int>(path.size());
+  int size = WideCharToMultiByte(CP_ACP, 0, path.c_str(), length, nullptr, 0, nullptr, nullptr);
+  if (size <= 0) {
+    return std::string();
+  }
+  std::string result(size, '\0');
+  WideCharToMultiByte(CP_ACP, 0, path.c_str(), length, &result[0], size, nullptr, nullptr);
+  return result;
+}
 
 //--------------------------------------------------------------------------------------
 // Punto de entrada del programa. Inicializa todo y entra en el bucle de mensajes.
@@ -84,133 +214,241 @@ void RenderScene();
 int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmdLine, int nCmdShow)
 {
   UNREFERENCED_PARAMETER(hPrevInstance);
-  UNREFERENCED_PARAMETER(lpCmdLine);
 
-  if (FAILED(g_window.init(hInstance, nCmdShow, WndProc)))
-    return 0;
+  // "-ringbench" verifica el ring de subida de constantes y mide sus asignaciones
+  if (lpCmdLine && wcsstr(lpCmdLine, L"-ringbench")) {
+    return RunUploadRingBenchmark() ? 0 : 1;
+  }
 
-  if (FAILED(InitDevice()))
-  {
-    CleanupDevice();
-    return 0;
+  // "-jobbench" mide el costo de planificacion y el escalado del JobSystem
+  if (lpCmdLine && wcsstr(lpCmdLine, L"-jobbench")) {
+    return RunJobBenchmark() ? 0 : 1;
   }
 
-  // Bucle principal de mensajes
-  MSG msg = { 0 };
-  while (WM_QUIT != msg.message)
-  {
-    if (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
-    {
-      TranslateMessage(&msg);
-      DispatchMessage(&msg);
-    }
-    else
-    {
-      // Actualiza la lgica de la escena
-      UpdateScene();
-      // Renderiza la escena
-      RenderScene();
-    }
+  // "-transformbench" compara la composicion SoA/SIMD contra XMMATRIX por objeto
+  if (lpCmdLine && wcsstr(lpCmdLine, L"-transformbench")) {
+    return RunTransformBenchmark() ? 0 : 1;
   }
 
-  CleanupDevice();
+  // "-ecsbench" compara la iteracion por chunks del ECS contra update() virtual
+  if (lpCmdLine && wcsstr(lpCmdLine, L"-ecsbench")) {
+    return RunEcsBenchmark() ? 0 : 1;
+  }
 
-  return (int)msg.wParam;
-}
+  // "-cullbench" mide el frustum culling SIMD y lo compara con la version escalar
+  if (lpCmdLine && wcsstr(lpCmdLine, L"-cullbench")) {
+    return RunCullingBenchmark() ? 0 : 1;
+  }
 
+  // "-occlusionbench" mide el rasterizado de oclusores y las pruebas de cajas
+  if (lpCmdLine && wcsstr(lpCmdLine, L"-occlusionbench")) {
+    return RunOcclusionBenchmark() ? 0 : 1;
+  }
 
+  // "-objbench [archivo.obj]" mide el loader OBJ (sin archivo usa una malla sintetica)
+  if (lpCmdLine && wcsstr(lpCmdLine, L"-objbench")) {
+    return RunObjBenchmark(ParsePathArgument(lpCmdLine, L"-objbench")) ? 0 : 1;
+  }
 
-//--------------------------------------------------------------------------------------
-// Creacin del dispositivo Direct3D y swap chain
-//--------------------------------------------------------------------------------------
-HRESULT InitDevice()
-{
-  HRESULT hr = S_OK;
+  // "-meshoptbench [archivo.obj]" reporta ACMR, ATVR y overdraw antes y despues de optimizar
+  if (lpCmdLine && wcsstr(lpCmdLine, L"-meshoptbench")) {
+    return RunMeshOptimizerBenchmark(ParsePathArgument(lpCmdLine, L"-meshoptbench")) ? 0 : 1;
+  }
 
-  hr = g_swapChain.init(g_device, g_deviceContext, g_backBuffer, g_window);
+  // "-vertexformatbench" mide la codificacion de vertices cuantizados y su error
+  if (lpCmdLine && wcsstr(lpCmdLine, L"-vertexformatbench")) {
+    return RunVertexFormatBenchmark() ? 0 : 1;
+  }
 
-  if (FAILED(hr)) {
-		ERROR("Main", "InitDevice", 
-      ("Failed to initialize SwpaChian. HRESULT: " + std::to_string(hr)).c_str());
-		return hr;
+  // "-lodbench [archivo.obj]" genera la cadena de LODs y reporta triangulos y error por nivel
+  if (lpCmdLine && wcsstr(lpCmdLine, L"-lodbench")) {
+    return RunLodBenchmark(ParsePathArgument(lpCmdLine, L"-lodbench")) ? 0 : 1;
   }
 
-	hr = g_renderTargetView.init(g_device, g_backBuffer, DXGI_FORMAT_R8G8B8A8_UNORM);
+  // "-meshletbench [archivo.obj]" mide la construccion de meshlets y su culling
+  if (lpCmdLine && wcsstr(lpCmdLine, L"-meshletbench")) {
+    return RunMeshletBenchmark(ParsePathArgument(lpCmdLine, L"-meshletbench")) ? 0 : 1;
+  }
 
-	if (FAILED(hr)) {
-    ERROR("Main", "InitDevice", 
-			("Failed to initialize RenderTargetView. HRESULT: " + std::to_string(hr)).c_str());
-		return hr;
-	}
+  // "-shadercachebench" mide el indice del cache de shaders y el arranque en frio contra en caliente
+  if (lpCmdLine && wcsstr(lpCmdLine, L"-shadercachebench")) {
+    return RunShaderCacheBenchmark() ? 0 : 1;
+  }
 
-  // Crear textura de depth stencil.
-  hr = g_depthStencil.init(g_device,
-                           g_window.m_width,
-                           g_window.m_height,
-                           DXGI_FORMAT_D24_UNORM_S8_UINT,
-                           D3D11_BIND_DEPTH_STENCIL,
-                           4,
-                           0);
+  // "-permutationbench" compila las variantes de un shader en serie y en el JobSystem
+  if (lpCmdLine && wcsstr(lpCmdLine, L"-permutationbench")) {
+    return RunShaderPermutationBenchmark() ? 0 : 1;
+  }
 
-  if (FAILED(hr)) {
-    ERROR("Main", "InitDevice",
-      ("Failed to initialize DepthStencil. HRESULT: " + std::to_string(hr)).c_str());
-    return hr;
+  // "-loadbench" mide el arranque con AsyncLoader en serie y en paralelo
+  if (lpCmdLine && wcsstr(lpCmdLine, L"-loadbench")) {
+    return RunAsyncLoadBenchmark() ? 0 : 1;
   }
 
-  // Crear el depth stencil view
-	hr = g_depthStencilView.init(g_device, 
-                               g_depthStencil, 
-                               DXGI_FORMAT_D24_UNORM_S8_UINT);
+  // "-parameterbench" compara subir la camara cada frame contra solo al cambiar
+  if (lpCmdLine && wcsstr(lpCmdLine, L"-parameterbench")) {
+    return RunParameterBlockBenchmark() ? 0 : 1;
+  }
 
-  if (FAILED(hr)) {
-    ERROR("Main", "InitDevice",
-      ("Failed to initialize DepthStencilView. HRESULT: " + std::to_string(hr)).c_str());
-    return hr;
+  // "-hotreloadbench" mide cuanto tarda en verse un archivo editado
+  if (lpCmdLine && wcsstr(lpCmdLine, L"-hotreloadbench")) {
+    return RunHotReloadBenchmark() ? 0 : 1;
   }
 
-	// Crear el g_viewport
-	hr = g_viewport.init(g_window);
-  
-  if (FAILED(hr)) {
-    ERROR("Main", "InitDevice",
-      ("Failed to initialize Viewport. HRESULT: " + std::to_string(hr)).c_str());
-    return hr;
-	}
+  // "-meshfilebench" compara abrir una malla cocinada contra parsear el OBJ
+  if (lpCmdLine && wcsstr(lpCmdLine, L"-meshfilebench")) {
+    return RunMeshFileBenchmark() ? 0 : 1;
+  }
 
-  // Definir el layout de entrada
-  std::vector<D3D11_INPUT_ELEMENT_DESC> Layout;
+  // "-cookmesh entrada.obj salida.hmesh" convierte un OBJ al formato binario
+  if (lpCmdLine && wcsstr(lpCmdLine, L"-cookmesh")) {
+    std::string paths[2] = { ParsePathArgument(lpCmdLine, L"-cookmesh", 0),
+                             ParsePathArgument(lpCmdLine, L"-cookmesh", 1) };
+    if (paths[0].empty() || paths[1].empty()) {
+      ERROR("Main", "wWinMain", "Usage: -cookmesh input.obj output.hmesh");
+      return 1;
+    }
+    JobSystem jobs;
+    jobs.init();
+    ObjLoader loader;
+    MeshComponent mesh;
+    HRESULT hr = loader.load(paths[0], mesh, &jobs);
+    jobs.destroy();
+    if (SUCCEEDED(hr)) {
+      // Los assets cocinados salen ya ordenados para cache, overdraw y fetch,
+      // y en submeshes con indices de 16 bits
+      OptimizeMesh(mesh);
+      std::vector<MeshFileSubmesh> submeshes;
+      SplitMeshFor16BitIndices(mesh, submeshes);
+      hr = MeshFile::write(paths[1], mesh, submeshes.data(), static_cast<unsigned int>(submeshes.size()));
+    }
+    return SUCCEEDED(hr) ? 0 : 1;
+  }
+
+  g_jobSystem.init();
+
+  // "-pipeline N" fija cuantos frames pueden estar en vuelo (1 = serie)
+  const wchar_t* pipelineArg = lpCmdLine ? wcsstr(lpCmdLine, L"-pipeline") : nullptr;
+  if (pipelineArg) {
+    g_app.setPipelineDepth(wcstoul(pipelineArg + wcslen(L"-pipeline"), nullptr, 10));
+  }
+
+  // "-headless [frames]" ejecuta la escena sobre el backend nulo y reporta costos
+  const wchar_t* headlessArg = lpCmdLine ? wcsstr(lpCmdLine, L"-headless") : nullptr;
+  if (headlessArg) {
+    g_headless = true;
+    unsigned long frames = wcstoul(headlessArg + wcslen(L"-headless"), nullptr, 10);
+    if (frames > 0) {
+      g_headlessFrames = static_cast<unsigned int>(frames);
+    }
+    g_window.m_width = 1280;
+    g_window.m_height = 720;
+    g_nullBackend.init();
+
+    if (FAILED(g_app.runFrames(g_headlessFrames))) {
+      ERROR("Main", "wWinMain", "Headless run failed.");
+      // Dice cuantos frames llegaron a dibujarse
+      PrintSummary(g_app.pipelineSummary());
+      g_app.destroy();
+      return 1;
+    }
+
+    std::ostringstream os;
+    os << g_nullBackend.summary();
+    const BindStats& bindStats = g_deviceContext.getBindStats();
+    os << "DeviceContext binds issued=" << bindStats.issued
+       << " skipped=" << bindStats.skipped << "\n";
+    const UploadRingStats& ringStats = g_constantRing.getRing().getLastFrameStats();
+    os << "ConstantBufferRing last frame allocations=" << ringStats.allocations
+       << " bytes=" << ringStats.bytesRequested
+       << " consumed=" << ringStats.bytesConsumed
+       << " failed=" << ringStats.failedAllocations << "\n";
+    const ParameterBlockStats& cameraStats = m_neverChanges.getStats();
+    const ParameterBlockStats& projectionStats = m_changeOnResize.getStats();
+    os << "ParameterBlock camera uploads=" << cameraStats.uploads
+       << " skipped=" << cameraStats.skipped
+       << " projection uploads=" << projectionStats.uploads
+       << " skipped=" << projectionStats.skipped << "\n";
+    const CullStats& cullStats = g_frustumCuller.getStats();
+    os << "FrustumCuller last frame tested=" << cullStats.tested
+       << " visible=" << cullStats.visible << "\n";
+    const OcclusionStats& occlusionStats = g_occlusionCuller.getStats();
+    os << "OcclusionCuller last frame occluders=" << occlusionStats.occluders
+       << " triangles=" << occlusionStats.triangles
+       << " tested=" << occlusionStats.tested
+       << " culled=" << occlusionStats.culled
+       << " raster=" << occlusionStats.rasterMs << "ms"
+       << " test=" << occlusionStats.testMs << "ms\n";
+    const RenderQueueStats& queueStats = g_renderQueue.getStats();
+    os << "RenderQueue last frame packets=" << queueStats.packets
+       << " draws=" << queueStats.drawCalls
+       << " instancedDraws=" << queueStats.instancedDraws
+       << " instances=" << queueStats.instances << "\n";
+    os << g_app.pipelineSummary();
+    PrintSummary(os.str());
+    g_app.destroy();
+    return 0;
+  }
+
+  return g_app.run(hInstance, hPrevInstance, lpCmdLine, nCmdShow, WndProc);
+}
+
+
+
+//--------------------------------------------------------------------------------------
+// Tareas de carga de InitDevice. work() corre en los workers y solo toca la
+// CPU (compilar, llenar mallas, decodificar); finish() crea los objetos de
+// GPU en el hilo principal
+//--------------------------------------------------------------------------------------
+HRESULT CompileShaderTask(ShaderType type)
+{
+  // Solo llena el cache; ShaderProgram::init lo encuentra despues
+  ID3DBlob* blob = nullptr;
+  HRESULT hr = g_shaderProgram.CompileShader("HybridEngine.fx", type, &blob);
+  SAFE_RELEASE(blob);
+  return hr;
+}
+
+HRESULT CompileVertexShaderTask(void* data)
+{
+  UNREFERENCED_PARAMETER(data);
+  return CompileShaderTask(VERTEX_SHADER);
+}
 
-  D3D11_INPUT_ELEMENT_DESC position;
-  position.SemanticName = "POSITION";
-  position.SemanticIndex = 0;
-  position.Format = DXGI_FORMAT_R32G32B32_FLOAT;
-  position.InputSlot = 0;
-  position.AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT /*0*/;
-  position.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-  position.InstanceDataStepRate = 0;
-  Layout.push_back(position);
-
-  D3D11_INPUT_ELEMENT_DESC texcoord;
-  texcoord.SemanticName = "TEXCOORD";
-  texcoord.SemanticIndex = 0;
-  texcoord.Format = DXGI_FORMAT_R32G32_FLOAT;
-  texcoord.InputSlot = 0;
-  texcoord.AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT /*12*/;
-  texcoord.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-  texcoord.InstanceDataStepRate = 0;
-  Layout.push_back(texcoord);
-
-  // Create the Shader Program
-  hr = g_shaderProgram.init(g_device, "HybridEngine.fx", Layout);
+HRESULT CompilePixelShaderTask(void* data)
+{
+  UNREFERENCED_PARAMETER(data);
+  return CompileShaderTask(PIXEL_SHADER);
+}
 
+// data: el input layout de InitDevice
+HRESULT CreateShaderProgramTask(void* data)
+{
+  const std::vector<D3D11_INPUT_ELEMENT_DESC>& layout =
+    *static_cast<const std::vector<D3D11_INPUT_ELEMENT_DESC>*>(data);
+  HRESULT hr = g_shaderProgram.init(g_device, "HybridEngine.fx", layout);
   if (FAILED(hr)) {
     ERROR("Main", "InitDevice",
       ("Failed to initialize ShaderProgram. HRESULT: " + std::to_string(hr)).c_str());
-    return hr;
   }
+  return hr;
+}
+
+// data: la ShaderVariantKey en el puntero (no depende de locales de InitDevice)
+HRESULT CompileVariantTask(void* data)
+{
+  return g_instancedShaders.compile(static_cast<ShaderVariantKey>(reinterpret_cast<size_t>(data)));
+}
+
+HRESULT CreateVariantTask(void* data)
+{
+  ShaderVariantKey key = static_cast<ShaderVariantKey>(reinterpret_cast<size_t>(data));
+  return g_instancedShaders.createVariant(key) ? S_OK : E_FAIL;
+}
 
-  // Crear vertex buffer y index buffer para el cubo
+HRESULT BuildCubeMeshTask(void* data)
+{
+  UNREFERENCED_PARAMETER(data);
   SimpleVertex vertices[] =  {
       { XMFLOAT3(-1.0f, 1.0f, -1.0f), XMFLOAT2(0.0f, 0.0f) },
       { XMFLOAT3(1.0f, 1.0f, -1.0f), XMFLOAT2(1.0f, 0.0f) },
@@ -264,85 +502,43 @@ HRESULT InitDevice()
 
   // Store the vertex data
   for (int i = 0; i < 24; i++) {
-		cubeMesh.m_vertex.push_back(vertices[i]);
+    cubeMesh.m_vertex.push_back(vertices[i]);
   }
-	// Store the index data
-	for (int i = 0; i < 36; i++) {
+  // Store the index data
+  for (int i = 0; i < 36; i++) {
     cubeMesh.m_index.push_back(indices[i]);
-	}
+  }
 
-  hr = m_vertexBuffer.init(g_device, cubeMesh, D3D11_BIND_VERTEX_BUFFER);
+  // Cadena de LODs al 50%, 25% y 12.5% de los triangulos; los niveles se agregan
+  // a m_index y comparten el vertex buffer (se corta si la malla no reduce)
+  const float lodRatios[] = { 0.5f, 0.25f, 0.125f };
+  GenerateMeshLODs(cubeMesh, lodRatios, 3, g_cubeLODs);
+  return S_OK;
+}
+
+HRESULT CreateCubeBuffersTask(void* data)
+{
+  UNREFERENCED_PARAMETER(data);
+  HRESULT hr = m_vertexBuffer.init(g_device, cubeMesh, D3D11_BIND_VERTEX_BUFFER);
 
   if (FAILED(hr)) {
     ERROR("Main", "InitDevice",
       ("Failed to initialize VertexBuffer. HRESULT: " + std::to_string(hr)).c_str());
     return hr;
-	}
+  }
 
   hr = m_indexBuffer.init(g_device, cubeMesh, D3D11_BIND_INDEX_BUFFER);
 
   if (FAILED(hr)) {
     ERROR("Main", "InitDevice",
       ("Failed to initialize IndexBuffer. HRESULT: " + std::to_string(hr)).c_str());
-    return hr;
   }
+  return hr;
+}
 
-  // Establecer topologa primitiva
-  g_deviceContext.m_deviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-
-  // Crear los constant buffers
-	hr = m_neverChanges.init(g_device, sizeof(CBNeverChanges));
-  if (FAILED(hr)) {
-    ERROR("Main", "InitDevice",
-      ("Failed to initialize NeverChanges Buffer. HRESULT: " + std::to_string(hr)).c_str());
-		return hr;
-	}
-
-	hr = m_changeOnResize.init(g_device, sizeof(CBChangeOnResize));
-  if (FAILED(hr)) {
-    ERROR("Main", "InitDevice",
-			("Failed to initialize ChangeOnResize Buffer. HRESULT: " + std::to_string(hr)).c_str());
-		return hr;
-	}
-
-	hr = m_changeEveryFrame.init(g_device, sizeof(CBChangesEveryFrame));
-  if (FAILED(hr)) {
-    ERROR("Main", "InitDevice",
-      ("Failed to initialize ChangesEveryFrame Buffer. HRESULT: " + std::to_string(hr)).c_str());
-    return hr;
-	}
-
-
-  // Cargar la textura
-  hr = D3DX11CreateShaderResourceViewFromFile(g_device.m_device, "seafloor.dds", NULL, NULL, &g_pTextureRV, NULL);
-  if (FAILED(hr))
-    return hr;
-
-  // Crear el sampler state
-  D3D11_SAMPLER_DESC sampDesc;
-  ZeroMemory(&sampDesc, sizeof(sampDesc));
-  sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
-  sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_WRAP;
-  sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_WRAP;
-  sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_WRAP;
-  sampDesc.ComparisonFunc = D3D11_COMPARISON_NEVER;
-  sampDesc.MinLOD = 0;
-  sampDesc.MaxLOD = D3D11_FLOAT32_MAX;
-  hr = g_device.CreateSamplerState(&sampDesc, &g_pSamplerLinear);
-  if (FAILED(hr))
-    return hr;
-
-  // Inicializar las matrices de mundo, vista y proyeccin
-  XMVECTOR Eye = XMVectorSet(0.0f, 3.0f, -6.0f, 0.0f);
-  XMVECTOR At = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
-  XMVECTOR Up = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
-  g_View = XMMatrixLookAtLH(Eye, At, Up);
-
-  // Actualizar la matriz de proyeccin
-  cbNeverChanges.mView = XMMatrixTranspose(g_View);
-  g_Projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, g_window.m_width / (FLOAT)g_window.m_height, 0.01f, 100.0f);
-  cbChangesOnResize.mProjection = XMMatrixTranspose(g_Projection);
-
+HRESULT BuildPlaneMeshTask(void* data)
+{
+  UNREFERENCED_PARAMETER(data);
   //------- CREACIN DE GEOMETRA DEL PLANO (suelo) -------//
   SimpleVertex planeVertices[] =
   {
@@ -368,9 +564,13 @@ HRESULT InitDevice()
   for (int i = 0; i < 6; i++) {
     planeMesh.m_index.push_back(planeIndices[i]);
   }
+  return S_OK;
+}
 
-	// Crear el vertex buffer y index buffer para el plano
-  hr = m_planeVertexBuffer.init(g_device, planeMesh, D3D11_BIND_VERTEX_BUFFER);
+HRESULT CreatePlaneBuffersTask(void* data)
+{
+  UNREFERENCED_PARAMETER(data);
+  HRESULT hr = m_planeVertexBuffer.init(g_device, planeMesh, D3D11_BIND_VERTEX_BUFFER);
 
   if (FAILED(hr)) {
     ERROR("Main", "InitDevice",
@@ -383,31 +583,190 @@ HRESULT InitDevice()
   if (FAILED(hr)) {
     ERROR("Main", "InitDevice",
       ("Failed to initialize PlaneIndexBuffer. HRESULT: " + std::to_string(hr)).c_str());
-    return hr;
+  }
+  return hr;
+}
+
+// D3DX lee, decodifica y crea la textura en una sola llamada: en un worker
+// solo si el backend acepta Create* desde otros hilos
+HRESULT LoadTextureTask(void* data)
+{
+  UNREFERENCED_PARAMETER(data);
+  if (!g_device.m_backend->isFreeThreaded()) {
+    return S_OK;
+  }
+  return g_device.CreateShaderResourceViewFromFile("seafloor.dds", &g_pTextureRV);
+}
+
+HRESULT CreateTextureTask(void* data)
+{
+  UNREFERENCED_PARAMETER(data);
+  if (g_pTextureRV) {
+    return S_OK;
+  }
+  return g_device.CreateShaderResourceViewFromFile("seafloor.dds", &g_pTextureRV);
+}
+
+// Frame de carga: el color de fondo se aclara con el progreso. Un WM_QUIT
+// recibido aqui se vuelve a publicar cuando termina la carga
+void LoadingFrame(float progress, void* data)
+{
+  UNREFERENCED_PARAMETER(data);
+  float color[4] = { ClearColor[0] * progress, ClearColor[1] * progress, ClearColor[2] * progress, 1.0f };
+  g_renderTargetView.render(g_deviceContext, g_depthStencilView, 1, color);
+  g_swapChain.present();
+
+  MSG msg = { 0 };
+  while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) {
+    if (msg.message == WM_QUIT) {
+      g_quitDuringLoad = true;
+      continue;
+    }
+    TranslateMessage(&msg);
+    DispatchMessage(&msg);
+  }
+}
+
+//--------------------------------------------------------------------------------------
+// Creacin del dispositivo Direct3D y swap chain
+//--------------------------------------------------------------------------------------
+HRESULT InitDevice()
+{
+  HRESULT hr = S_OK;
+
+  if (g_headless) {
+    hr = g_swapChain.init(g_device,
+                          g_deviceContext,
+                          g_backBuffer,
+                          g_nullBackend,
+                          g_window.m_width,
+                          g_window.m_height);
+  }
+  else {
+    hr = g_swapChain.init(g_device, g_deviceContext, g_backBuffer, g_window);
   }
 
-  hr = m_constPlane.init(g_device, sizeof(CBChangesEveryFrame));
+  if (FAILED(hr)) {
+		ERROR("Main", "InitDevice", 
+      ("Failed to initialize SwpaChian. HRESULT: " + std::to_string(hr)).c_str());
+		return hr;
+  }
+
+	hr = g_renderTargetView.init(g_device, g_backBuffer, DXGI_FORMAT_R8G8B8A8_UNORM);
+
+	if (FAILED(hr)) {
+    ERROR("Main", "InitDevice", 
+			("Failed to initialize RenderTargetView. HRESULT: " + std::to_string(hr)).c_str());
+		return hr;
+	}
+
+  // Crear textura de depth stencil.
+  hr = g_depthStencil.init(g_device,
+                           g_window.m_width,
+                           g_window.m_height,
+                           DXGI_FORMAT_D24_UNORM_S8_UINT,
+                           D3D11_BIND_DEPTH_STENCIL,
+                           4,
+                           0);
+
   if (FAILED(hr)) {
     ERROR("Main", "InitDevice",
-      ("Failed to initialize Plane Buffer. HRESULT: " + std::to_string(hr)).c_str());
+      ("Failed to initialize DepthStencil. HRESULT: " + std::to_string(hr)).c_str());
     return hr;
   }
 
-  //------- COMPILAR SHADER DE SOMBRA -------//
-	hr = g_shaderShadow.CreateShader(g_device, PIXEL_SHADER ,"HybridEngine.fx");
+  // Crear el depth stencil view
+	hr = g_depthStencilView.init(g_device, 
+                               g_depthStencil, 
+                               DXGI_FORMAT_D24_UNORM_S8_UINT);
 
   if (FAILED(hr)) {
     ERROR("Main", "InitDevice",
-      ("Failed to initialize Shadow Shader. HRESULT: " + std::to_string(hr)).c_str());
+      ("Failed to initialize DepthStencilView. HRESULT: " + std::to_string(hr)).c_str());
+    return hr;
+  }
+
+	// Crear el g_viewport
+	hr = g_headless ? g_viewport.init(g_window.m_width, g_window.m_height)
+                  : g_viewport.init(g_window);
+  
+  if (FAILED(hr)) {
+    ERROR("Main", "InitDevice",
+      ("Failed to initialize Viewport. HRESULT: " + std::to_string(hr)).c_str());
     return hr;
 	}
 
-  hr = m_constShadow.init(g_device, sizeof(CBChangesEveryFrame));
+  // Definir el layout de entrada a partir del formato de vertice (el desc
+  // por defecto equivale a SimpleVertex)
+  std::vector<D3D11_INPUT_ELEMENT_DESC> Layout;
+  g_vertexFormat.init(VertexFormatDesc());
+  g_vertexFormat.buildLayout(Layout);
+
+  // Los shaders cargan el bytecode del cache si el fuente no cambio
+  g_shaderCache.load("ShaderCache.bin");
+  g_shaderProgram.setCache(&g_shaderCache);
+
+  // Variante instanciada: mismo layout mas el stream de instancias en el slot 1
+  std::vector<D3D11_INPUT_ELEMENT_DESC> instancedLayout = Layout;
+  InputLayout::appendInstanceElements(instancedLayout, 1);
+  unsigned int instanceColor = g_instancedShaders.addKeyword("INSTANCE_COLOR");
+  unsigned int shadowKeyword = g_instancedShaders.addKeyword("SHADOW");
+  hr = g_instancedShaders.init(g_device, "HybridEngineInstanced.fx", instancedLayout, &g_shaderCache);
   if (FAILED(hr)) {
     ERROR("Main", "InitDevice",
-      ("Failed to initialize Shadow Buffer. HRESULT: " + std::to_string(hr)).c_str());
+      ("Failed to initialize instanced ShaderProgram. HRESULT: " + std::to_string(hr)).c_str());
     return hr;
   }
+  g_instancedKey = g_instancedShaders.setKeyword(0, instanceColor, 1);
+  g_instancedShadowKey = g_instancedShaders.setKeyword(g_instancedKey, shadowKeyword, 1);
+
+  // Shaders, mallas y textura se cargan a la vez en el JobSystem. El
+  // ShaderProgram (y su input layout) espera al bytecode del VS y del PS
+  g_loader.init(g_jobSystem);
+  LoadTaskId vertexShader = g_loader.add("HybridEngine.fx VS", &CompileVertexShaderTask, nullptr);
+  LoadTaskId pixelShader = g_loader.add("HybridEngine.fx PS", &CompilePixelShaderTask, nullptr);
+  LoadTaskId programDependencies[] = { vertexShader, pixelShader };
+  g_loader.add("ShaderProgram", nullptr, &CreateShaderProgramTask, &Layout, programDependencies, 2);
+  for (ShaderVariantKey key = 0; key < g_instancedShaders.getKeyCount(); ++key) {
+    if (g_instancedShaders.isValid(key)) {
+      g_loader.add("HybridEngineInstanced.fx variant " + std::to_string(key),
+                   &CompileVariantTask,
+                   &CreateVariantTask,
+                   reinterpret_cast<void*>(static_cast<size_t>(key)));
+    }
+  }
+  g_loader.add("Cube mesh", &BuildCubeMeshTask, &CreateCubeBuffersTask);
+  g_loader.add("Plane mesh", &BuildPlaneMeshTask, &CreatePlaneBuffersTask);
+  g_loader.add("seafloor.dds", &LoadTextureTask, &CreateTextureTask);
+  g_loader.start();
+
+  // Mientras los workers cargan: los objetos baratos que solo tocan el dispositivo
+
+  // Establecer topologa primitiva
+  g_deviceContext.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+	// Constantes por objeto: slices de 256 bytes, 3 frames en vuelo
+	hr = g_constantRing.init(g_device, 1024, 3);
+  if (FAILED(hr)) {
+    ERROR("Main", "InitDevice",
+      ("Failed to initialize Constant Buffer Ring. HRESULT: " + std::to_string(hr)).c_str());
+    return hr;
+	}
+
+  // Crear el sampler state
+  D3D11_SAMPLER_DESC sampDesc;
+  ZeroMemory(&sampDesc, sizeof(sampDesc));
+  sampDesc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
+  sampDesc.AddressU = D3D11_TEXTURE_ADDRESS_WRAP;
+  sampDesc.AddressV = D3D11_TEXTURE_ADDRESS_WRAP;
+  sampDesc.AddressW = D3D11_TEXTURE_ADDRESS_WRAP;
+  sampDesc.ComparisonFunc = D3D11_COMPARISON_NEVER;
+  sampDesc.MinLOD = 0;
+  sampDesc.MaxLOD = D3D11_FLOAT32_MAX;
+  hr = g_device.CreateSamplerState(&sampDesc, &g_pSamplerLinear);
+  if (FAILED(hr))
+    return hr;
+
   //------- CREAR ESTADOS DE BLENDING Y DEPTH STENCIL PARA LAS SOMBRAS -------//
 	hr = g_shadowBlendState.init(g_device);
   if (FAILED(hr)) {
@@ -416,7 +775,7 @@ HRESULT InitDevice()
 		return hr;
 	}
 
-  hr = g_shadowDepthStencilState.init(g_device, true, false);
+  hr = g_shadowDepthStencilState.initPlanarShadow(g_device);
 
   if (FAILED(hr)) {
     ERROR("Main", "InitDevice",
@@ -424,6 +783,148 @@ HRESULT InitDevice()
     return hr;
   }
 
+  g_renderQueue.init(16);
+  g_renderQueue.setConstantRing(&g_constantRing);
+  hr = g_renderQueue.initInstancing(g_device, 4096);
+  if (FAILED(hr)) {
+    ERROR("Main", "InitDevice",
+      ("Failed to initialize instancing. HRESULT: " + std::to_string(hr)).c_str());
+    return hr;
+  }
+
+  // Inicializar las matrices de mundo, vista y proyeccin
+  XMVECTOR Eye = XMVectorSet(0.0f, 3.0f, -6.0f, 0.0f);
+  XMVECTOR At = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+  XMVECTOR Up = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+  g_View = XMMatrixLookAtLH(Eye, At, Up);
+
+  // Actualizar la matriz de proyeccin
+  cbNeverChanges.mView = XMMatrixTranspose(g_View);
+  g_Projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, g_window.m_width / (FLOAT)g_window.m_height, 0.01f, 100.0f);
+  cbChangesOnResize.mProjection = XMMatrixTranspose(g_Projection);
+
+  // Esperar la carga; sin ventana no hay frames de carga
+  hr = g_loader.wait(g_headless ? nullptr : &LoadingFrame);
+  if (g_quitDuringLoad) {
+    PostQuitMessage(0);
+  }
+  const AsyncLoadStats& loadStats = g_loader.getStats();
+  std::ostringstream loadLog;
+  loadLog << "AsyncLoader tasks=" << loadStats.tasks
+          << " failed=" << loadStats.failed
+          << " work=" << loadStats.workMs << "ms"
+          << " finish=" << loadStats.finishMs << "ms"
+          << " wall=" << loadStats.wallMs << "ms"
+          << " frames=" << loadStats.loadingFrames << "\n";
+  OutputDebugStringA(loadLog.str().c_str());
+  g_loader.destroy();
+
+  if (FAILED(hr)) {
+    ERROR("Main", "InitDevice",
+      ("Failed to load resources. HRESULT: " + std::to_string(hr)).c_str());
+    return hr;
+  }
+  if (!g_instancedShaders.findVariant(g_instancedKey) || !g_instancedShaders.findVariant(g_instancedShadowKey)) {
+    ERROR("Main", "InitDevice", "Instanced ShaderProgram variant is missing.");
+    return E_FAIL;
+  }
+
+  // Los structs de C++ de los cbuffers se validan contra el layout reflejado
+  // del shader; si no coinciden se deja en el log la declaracion correcta
+  const ShaderReflection& reflection = g_shaderProgram.getReflection();
+  const ConstantBufferLayout* neverChangesLayout = reflection.find("cbNeverChanges");
+  const ConstantBufferLayout* changeOnResizeLayout = reflection.find("cbChangeOnResize");
+  const ConstantBufferLayout* changesEveryFrameLayout = reflection.find("cbChangesEveryFrame");
+  const ConstantBufferMember neverChangesMembers[] = {
+    CB_MEMBER("View", CBNeverChanges, mView)
+  };
+  const ConstantBufferMember changeOnResizeMembers[] = {
+    CB_MEMBER("Projection", CBChangeOnResize, mProjection)
+  };
+  const ConstantBufferMember changesEveryFrameMembers[] = {
+    CB_MEMBER("World", CBChangesEveryFrame, mWorld),
+    CB_MEMBER("vMeshColor", CBChangesEveryFrame, vMeshColor)
+  };
+  bool layoutsOk =
+    neverChangesLayout && changeOnResizeLayout &&
+    ShaderReflection::validate(*neverChangesLayout, neverChangesMembers, 1, sizeof(CBNeverChanges)) &&
+    ShaderReflection::validate(*changeOnResizeLayout, changeOnResizeMembers, 1, sizeof(CBChangeOnResize)) &&
+    (!changesEveryFrameLayout ||
+     ShaderReflection::validate(*changesEveryFrameLayout, changesEveryFrameMembers, 2, sizeof(CBChangesEveryFrame)));
+  if (!layoutsOk) {
+    ERROR("Main", "InitDevice", "Constant buffer structs do not match HybridEngine.fx.");
+    for (size_t i = 0; i < reflection.getLayouts().size(); ++i) {
+      const ConstantBufferLayout& layout = reflection.getLayouts()[i];
+      OutputDebugStringA(ShaderReflection::generateStruct(layout, layout.name).c_str());
+    }
+    return E_FAIL;
+  }
+
+  // Crear los constant buffers
+  hr = m_neverChanges.init(g_device, *neverChangesLayout);
+  if (FAILED(hr)) {
+    ERROR("Main", "InitDevice",
+      ("Failed to initialize NeverChanges Buffer. HRESULT: " + std::to_string(hr)).c_str());
+    return hr;
+  }
+
+  hr = m_changeOnResize.init(g_device, *changeOnResizeLayout);
+  if (FAILED(hr)) {
+    ERROR("Main", "InitDevice",
+      ("Failed to initialize ChangeOnResize Buffer. HRESULT: " + std::to_string(hr)).c_str());
+    return hr;
+  }
+
+  // Jerarquia de la escena: el plano 5 unidades abajo y el cubo colgando de el,
+  // 2 unidades sobre el origen
+  g_sceneGraph.init(OBJECT_COUNT);
+  g_planeNode = g_sceneGraph.createNode(INVALID_SCENE_NODE, XMFLOAT3(0.0f, -5.0f, 0.0f));
+  g_cubeNode = g_sceneGraph.createNode(g_planeNode, XMFLOAT3(0.0f, 7.0f, 0.0f));
+
+  // Entidades dibujables; RenderScene recorre sus MeshRendererComponent
+  Entity planeEntity = g_world.create();
+  g_world.add(planeEntity, SceneNodeComponent{ g_planeNode });
+  g_world.add(planeEntity, MeshRendererComponent{ &planeMesh, &m_planeVertexBuffer, &m_planeIndexBuffer, OBJECT_PLANE, nullptr });
+  g_cubeEntity = g_world.create();
+  g_world.add(g_cubeEntity, SceneNodeComponent{ g_cubeNode });
+  g_world.add(g_cubeEntity, MeshRendererComponent{ &cubeMesh, &m_vertexBuffer, &m_indexBuffer, OBJECT_CUBE, &g_cubeLODs });
+  g_world.add(g_cubeEntity, ShadowCasterComponent{ XMFLOAT4(0.0f, 0.0f, 0.0f, 0.5f) });
+
+  // Sombras planas: una luz puntual sobre el suelo (y = -5)
+  g_planarShadows.addLight(g_LightPos);
+  g_planarShadows.addReceiver(XMFLOAT4(0.0f, 1.0f, 0.0f, 5.0f));
+
+  // Bounds locales de cada malla para el frustum culling
+  g_world.add(planeEntity, BoundsComponent{ ComputeMeshBounds(planeMesh) });
+  g_world.add(g_cubeEntity, BoundsComponent{ ComputeMeshBounds(cubeMesh) });
+  g_frustumCuller.init(OBJECT_COUNT);
+
+  // El plano tapa lo que queda debajo del suelo
+  g_world.add(planeEntity, OccluderComponent{ &planeMesh });
+  g_occlusionCuller.init();
+
+  // Guardar lo que se compilo en este arranque (no hace nada si todo fue acierto)
+  const ShaderCacheStats& shaderCacheStats = g_shaderCache.getStats();
+  std::ostringstream shaderCacheLog;
+  shaderCacheLog << "ShaderCache hits=" << shaderCacheStats.hits
+                 << " misses=" << shaderCacheStats.misses
+                 << " compile=" << shaderCacheStats.compileMs << "ms\n";
+  OutputDebugStringA(shaderCacheLog.str().c_str());
+  g_shaderCache.save();
+
+  // Recarga en caliente: los cambios de los .fx y de la textura se aplican
+  // entre frames sin reiniciar. Sin ventana nadie edita archivos
+  if (!g_headless && SUCCEEDED(g_hotReloader.init(g_device, g_jobSystem))) {
+    g_hotReloader.addShader(g_shaderProgram);
+    for (ShaderVariantKey key = 0; key < g_instancedShaders.getKeyCount(); ++key) {
+      ShaderProgram* variant = g_instancedShaders.findVariant(key);
+      if (variant) {
+        g_hotReloader.addShader(*variant);
+      }
+    }
+    g_hotReloader.addTexture("seafloor.dds", &g_pTextureRV);
+  }
+
   return S_OK;
 }
 
@@ -432,11 +933,17 @@ HRESULT InitDevice()
 //--------------------------------------------------------------------------------------
 void CleanupDevice()
 {
-  if (g_deviceContext.m_deviceContext) g_deviceContext.m_deviceContext->ClearState();
-
+  // Un InitDevice que fallo a mitad puede dejar works de carga en vuelo
+  g_loader.destroy();
+  g_hotReloader.destroy();
+  if (g_deviceContext.m_backend) g_deviceContext.ClearState();
+
+	g_renderQueue.destroy();
+	g_occlusionCuller.destroy();
+	g_world.destroy();
+	g_sceneGraph.destroy();
 	g_shadowBlendState.destroy();
   g_shadowDepthStencilState.destroy();
-  g_shaderShadow.destroy();
 
 	m_planeVertexBuffer.destroy();
 	m_planeIndexBuffer.destroy();
@@ -446,19 +953,19 @@ void CleanupDevice()
 
 	m_neverChanges.destroy();
 	m_changeOnResize.destroy();
-	m_changeEveryFrame.destroy();
-	m_constPlane.destroy();
-	m_constShadow.destroy();
+	g_constantRing.destroy();
 
   m_vertexBuffer.destroy();
   m_indexBuffer.destroy();
   g_shaderProgram.destroy();
+  g_instancedShaders.destroy();
   g_depthStencil.destroy();
   g_depthStencilView.destroy();
   g_renderTargetView.destroy();
   g_swapChain.destroy();
   if (g_deviceContext.m_deviceContext) g_deviceContext.m_deviceContext->Release();
   if (g_device.m_device) g_device.m_device->Release();
+  g_jobSystem.destroy();
 }
 
 //--------------------------------------------------------------------------------------
@@ -493,7 +1000,7 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam)
 //--------------------------------------------------------------------------------------
 // Funcin UpdateScene: actualiza transformaciones, tiempo y dems variables dinmicas.
 //--------------------------------------------------------------------------------------
-void UpdateScene()
+void UpdateScene(FramePacket& packet)
 {
   // Actualizar tiempo (mismo que antes)
   static float t = 0.0f;
@@ -511,79 +1018,134 @@ void UpdateScene()
   }
 
   // Actualizar la matriz de proyeccin y vista
-  cbNeverChanges.mView = XMMatrixTranspose(g_View);
-	m_neverChanges.update(g_deviceContext, nullptr, 0, nullptr, &cbNeverChanges, 0,0);
-  cbChangesOnResize.mProjection = XMMatrixTranspose(g_Projection);
-	m_changeOnResize.update(g_deviceContext, nullptr, 0, nullptr, &cbChangesOnResize, 0, 0);
-
-  
-  // --- Transformacin del cubo ---
-  // Parmetros del cubo:
-  float cubePosX = 0.0f, cubePosY = 2.0f, cubePosZ = 0.0f;  // Ubicado 2 unidades arriba
-  float cubeScale = 1.0f;                                    // Escala uniforme
-  float cubeAngleX = 0.0f, cubeAngleY = t, cubeAngleZ = 0.0f;  // Rotacin dinmica en Y
-
-  // Crear las matrices individuales
-  XMMATRIX cubeScaleMat = XMMatrixScaling(cubeScale, cubeScale, cubeScale);
-  XMMATRIX cubeRotMat = XMMatrixRotationX(cubeAngleX) *
-    XMMatrixRotationY(cubeAngleY) *
-    XMMatrixRotationZ(cubeAngleZ);
-  XMMATRIX cubeTransMat = XMMatrixTranslation(cubePosX, cubePosY, cubePosZ);
-
-  // Combinar: primero escala, luego rota y por ltimo traslada
-  g_World = cubeTransMat * cubeRotMat * cubeScaleMat;
+  packet.time = t;
+  packet.camera.mView = XMMatrixTranspose(g_View);
+  packet.projection.mProjection = XMMatrixTranspose(g_Projection);
+  packet.objects.resize(OBJECT_COUNT);
+  packet.lod.assign(OBJECT_COUNT, 0);
+  packet.geometry.assign(OBJECT_COUNT, FrameGeometry());
+
+
+  // --- Transformaciones: el cubo gira en Y, el plano queda fijo ---
+  g_sceneGraph.setLocalRotationRollPitchYaw(g_cubeNode, 0.0f, t, 0.0f);
+  g_sceneGraph.update();
+  g_frustumCuller.clear();
+  g_cullObjects.clear();
+  g_cullBounds.clear();
+  g_world.forEachChunk<SceneNodeComponent, MeshRendererComponent, BoundsComponent>(
+    [&packet](unsigned int count, Entity*, SceneNodeComponent* nodes, MeshRendererComponent* renderers, BoundsComponent* bounds) {
+      for (unsigned int i = 0; i < count; ++i) {
+        g_sceneGraph.getWorldTransposed(nodes[i].node, &packet.objects[renderers[i].object].mWorld);
+        g_cullBounds.push_back(TransformBounds(bounds[i].local, ToFloat4x4(g_sceneGraph.getWorldMatrix(nodes[i].node))));
+        g_frustumCuller.add(g_cullBounds.back());
+        g_cullObjects.push_back(renderers[i].object);
+        // LOD por tamano proyectado: el mas simple con error menor a un pixel
+        const MeshRendererComponent& renderer = renderers[i];
+        FrameGeometry& geometry = packet.geometry[renderer.object];
+        geometry.vertexBuffer = renderer.vertexBuffer;
+        geometry.indexBuffer = renderer.indexBuffer;
+        if (renderer.lods) {
+          packet.lod[renderer.object] = static_cast<unsigned char>(
+            SelectMeshLOD(*renderer.lods, g_cullBounds.back(), g_View, g_Projection, (float)g_window.m_height));
+          const MeshLOD& lod = (*renderer.lods)[packet.lod[renderer.object]];
+          geometry.startIndex = lod.indexStart;
+          geometry.indexCount = lod.indexCount;
+        }
+        else {
+          geometry.startIndex = 0;
+          geometry.indexCount = static_cast<unsigned int>(renderer.mesh->m_index.size());
+        }
+      }
+    });
 
   // Actualizar el color animado del cubo
   g_vMeshColor.x = (sinf(t * 1.0f) + 1.0f) * 0.5f;
   g_vMeshColor.y = (cosf(t * 3.0f) + 1.0f) * 0.5f;
   g_vMeshColor.z = (sinf(t * 5.0f) + 1.0f) * 0.5f;
 
-  // --- Transformacin del plano ---
-  // Parmetros para el plano:
-  float planePosX = 0.0f, planePosY = -5.0f, planePosZ = 0.0f;
-  // Aunque los vrtices ya definen un plano extenso (-20 a 20), aqu puedes ajustar el escalado adicional
-  float planeScaleFactor = 1.0f; // Puedes modificar este factor para agrandar o reducir el plano
-  float planeAngleX = 0.0f, planeAngleY = 0.0f, planeAngleZ = 0.0f; // Sin rotacin por defecto
-
-  XMMATRIX planeScaleMat = XMMatrixScaling(planeScaleFactor, planeScaleFactor, planeScaleFactor);
-  XMMATRIX planeRotMat = XMMatrixRotationX(planeAngleX) *
-    XMMatrixRotationY(planeAngleY) *
-    XMMatrixRotationZ(planeAngleZ);
-  XMMATRIX planeTransMat = XMMatrixTranslation(planePosX, planePosY, planePosZ);
-
-  // Combinar transformaciones para el plano
-  g_PlaneWorld = planeTransMat * planeRotMat * planeScaleMat;
-
-
-  // Update Plane
-  cbPlane.mWorld = XMMatrixTranspose(g_PlaneWorld);
-  cbPlane.vMeshColor = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
-  m_constPlane.update(g_deviceContext, nullptr, 0, nullptr, &cbPlane, 0, 0);
-
-  // Update cube
-  cb.mWorld = XMMatrixTranspose(g_World);
-  cb.vMeshColor = g_vMeshColor;
-  m_changeEveryFrame.update(g_deviceContext, nullptr, 0, nullptr, &cb, 0, 0);
-
-  // Update Shadow cube
-  float dot = g_LightPos.y;
-  XMMATRIX shadowMatrix = XMMATRIX(
-    dot, -g_LightPos.x, 0.0f, 0.0f,
-    0.0f, 0.0f, 0.0f, 0.0f,
-    0.0f, -g_LightPos.z, dot, 0.0f,
-    0.0f, -1.0f, 0.0f, dot
-  );
-  XMMATRIX shadowWorld = g_World * shadowMatrix;
-  cbShadow.mWorld = XMMatrixTranspose(shadowWorld);
-  cbShadow.vMeshColor = XMFLOAT4(0.0f, 0.0f, 0.0f, 0.5f);
-  m_constShadow.update(g_deviceContext, nullptr, 0, nullptr, &cbShadow, 0, 0);
+  packet.objects[OBJECT_PLANE].vMeshColor = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
+  packet.objects[OBJECT_CUBE].vMeshColor = g_vMeshColor;
+
+  // --- Sombras planas: todas las matrices luz x plano x caster en un lote ---
+  g_shadowCasterWorlds.clear();
+  g_shadowCasterColors.clear();
+  g_shadowCasterBounds.clear();
+  g_shadowCasterObjects.clear();
+  g_world.forEachChunk<SceneNodeComponent, MeshRendererComponent, BoundsComponent, ShadowCasterComponent>(
+    [](unsigned int count, Entity*, SceneNodeComponent* nodes, MeshRendererComponent* renderers,
+       BoundsComponent* bounds, ShadowCasterComponent* casters) {
+      for (unsigned int i = 0; i < count; ++i) {
+        XMMATRIX world = g_sceneGraph.getWorldMatrix(nodes[i].node);
+        XMFLOAT4X4 stored;
+        XMStoreFloat4x4(&stored, world);
+        g_shadowCasterWorlds.push_back(stored);
+        g_shadowCasterColors.push_back(casters[i].color);
+        g_shadowCasterBounds.push_back(TransformBounds(bounds[i].local, ToFloat4x4(world)));
+        g_shadowCasterObjects.push_back(renderers[i].object);
+      }
+    });
+  const unsigned int casterCount = static_cast<unsigned int>(g_shadowCasterWorlds.size());
+  g_planarShadows.build(g_shadowCasterWorlds.data(), g_shadowCasterColors.data(), casterCount, g_shadowCandidates);
+
+  // Las sombras entran al culler con indice de objeto OBJECT_COUNT + candidato
+  for (unsigned int l = 0; l < g_planarShadows.getLightCount(); ++l) {
+    for (unsigned int r = 0; r < g_planarShadows.getReceiverCount(); ++r) {
+      for (unsigned int c = 0; c < casterCount; ++c) {
+        Bounds shadowBounds;
+        if (!g_planarShadows.projectBounds(g_shadowCasterBounds[c], l, r, shadowBounds)) {
+          continue;
+        }
+        g_cullBounds.push_back(shadowBounds);
+        g_frustumCuller.add(shadowBounds);
+        g_cullObjects.push_back(OBJECT_COUNT + (l * g_planarShadows.getReceiverCount() + r) * casterCount + c);
+      }
+    }
+  }
+  g_frustumCuller.setFrustum(ToFloat4x4(g_View * g_Projection));
+  g_frustumCuller.cull(g_visibleList);
+
+  // --- Occlusion culling: rasterizar los oclusores y probar lo que sobrevivio ---
+  g_occlusionCuller.beginFrame(ToFloat4x4(g_View * g_Projection));
+  g_world.forEachChunk<SceneNodeComponent, OccluderComponent>(
+    [](unsigned int count, Entity*, SceneNodeComponent* nodes, OccluderComponent* occluders) {
+      for (unsigned int i = 0; i < count; ++i) {
+        const MeshComponent& mesh = *occluders[i].mesh;
+        if (mesh.m_vertex.empty()) {
+          continue;
+        }
+        g_occlusionCuller.addOccluder(&mesh.m_vertex[0].Pos.x, static_cast<unsigned int>(mesh.m_vertex.size()), sizeof(SimpleVertex),
+                                      mesh.m_index.data(), static_cast<unsigned int>(mesh.m_index.size()),
+                                      ToFloat4x4(g_sceneGraph.getWorldMatrix(nodes[i].node)));
+      }
+    });
+  g_occlusionCuller.finalize();
+
+  packet.visible.assign(OBJECT_COUNT, 0);
+  packet.shadows.clear();
+  packet.shadowObjects.clear();
+  for (size_t i = 0; i < g_visibleList.size(); ++i) {
+    unsigned int index = g_visibleList[i];
+    unsigned int object = g_cullObjects[index];
+    // Las sombras son coplanares con su receptor; no se prueban contra el
+    if (object >= OBJECT_COUNT) {
+      unsigned int candidate = object - OBJECT_COUNT;
+      packet.shadows.push_back(g_shadowCandidates[candidate]);
+      packet.shadowObjects.push_back(g_shadowCasterObjects[candidate % casterCount]);
+    }
+    else if (g_occlusionCuller.isVisible(g_cullBounds[index])) {
+      packet.visible[object] = 1;
+    }
+  }
 }
 
 //--------------------------------------------------------------------------------------
 // Funcin RenderScene: limpia buffers y dibuja la escena (plano, cubo y sombra).
 //--------------------------------------------------------------------------------------
-void RenderScene()
+void RenderScene(const FramePacket& packet)
 {
+  // Limite de frame: aplicar los shaders y texturas recargados
+  g_hotReloader.update();
+
   // Limpiar el back buffer y el depth buffer
   g_renderTargetView.render(g_deviceContext, g_depthStencilView, 1, ClearColor);
   
@@ -592,56 +1154,74 @@ void RenderScene()
 
   g_depthStencilView.render(g_deviceContext);
   
-  // Configurar los buffers y shaders para el pipeline
-  g_shaderProgram.render(g_deviceContext);
-
-  // Asignar buffers constantes
-	m_neverChanges.render(g_deviceContext,    0, 1);
-	m_changeOnResize.render(g_deviceContext,  1, 1);
-  //------------- Renderizar el plano (suelo) -------------//
-	// Asignar buffers Vertex e Index
-  m_planeVertexBuffer.render(g_deviceContext, 0, 1);
-  m_planeIndexBuffer.render(g_deviceContext, 0, 1, false, DXGI_FORMAT_R32_UINT);
-  
-  // Asignar buffers constantes
-  m_constPlane.render(g_deviceContext,      2, 1);
-  m_constPlane.render(g_deviceContext,      2, 1, true);
-	
-  g_deviceContext.m_deviceContext->PSSetShaderResources(0, 1, &g_pTextureRV);
-  g_deviceContext.m_deviceContext->PSSetSamplers(0, 1, &g_pSamplerLinear);
-  g_deviceContext.m_deviceContext->DrawIndexed(planeMesh.m_index.size(), 0, 0);
-
-  //------------- Renderizar el cubo (normal) -------------//
-	// Asignar buffers Vertex e Index
-	m_vertexBuffer.render(g_deviceContext, 0, 1);
-  m_indexBuffer.render(g_deviceContext, 0, 1, false, DXGI_FORMAT_R32_UINT);
-
-  // Asignar buffers constantes
-  m_changeEveryFrame.render(g_deviceContext,  2, 1);
-	m_changeEveryFrame.render(g_deviceContext,  2, 1, true);
-
-  g_deviceContext.m_deviceContext->PSSetShaderResources(0, 1, &g_pTextureRV);
-  g_deviceContext.m_deviceContext->PSSetSamplers(0, 1, &g_pSamplerLinear);
-  g_deviceContext.m_deviceContext->DrawIndexed(cubeMesh.m_index.size(), 0, 0);
-
-  //------------- Renderizar la sombra del cubo -------------//
-	g_shaderShadow.render(g_deviceContext, PIXEL_SHADER);
-
-	g_shadowBlendState.render(g_deviceContext, blendFactor, 0xffffffff);
-  g_shadowDepthStencilState.render(g_deviceContext, 0);
-
-	// Asignar buffers Vertex e Index
-  m_vertexBuffer.render(g_deviceContext, 0, 1);
-  m_indexBuffer.render(g_deviceContext, 0, 1, false, DXGI_FORMAT_R32_UINT);
-
-  // Asignar buffers constantes
-  m_constShadow.render(g_deviceContext, 2, 1, true);
+  // Asignar buffers constantes de la camara (compartidos por todos los paquetes).
+  // Los structs estan validados contra el shader; solo se suben si cambiaron
+	m_neverChanges.setRaw(0, &packet.camera, sizeof(CBNeverChanges));
+	m_changeOnResize.setRaw(0, &packet.projection, sizeof(CBChangeOnResize));
+	m_neverChanges.update(g_deviceContext);
+	m_changeOnResize.update(g_deviceContext);
+	m_neverChanges.render(g_deviceContext);
+	m_changeOnResize.render(g_deviceContext);
+
+  g_renderQueue.clear();
+  g_constantRing.beginFrame();
+
+  //------------- Mallas opacas (plano y cubo) -------------//
+  DrawPacket opaque;
+  opaque.sortKey = RenderQueue::makeSortKey(RENDER_PASS_OPAQUE, 0, 0, 0.0f);
+  opaque.shaderProgram = &g_shaderProgram;
+  opaque.texture = g_pTextureRV;
+  opaque.sampler = g_pSamplerLinear;
+  opaque.instancedProgram = g_instancedShaders.getVariant(g_instancedKey);
+  // Buffers y rango de indices del nivel de detalle elegido en UpdateScene
+  auto setGeometry = [](DrawPacket& draw, const FrameGeometry& geometry) {
+    draw.vertexBuffer = geometry.vertexBuffer;
+    draw.indexBuffer = geometry.indexBuffer;
+    draw.startIndex = geometry.startIndex;
+    draw.indexCount = geometry.indexCount;
+  };
+  for (unsigned int object = 0; object < OBJECT_COUNT; ++object) {
+    if (!packet.visible[object] || !packet.geometry[object].vertexBuffer) {
+      continue;
+    }
+    setGeometry(opaque, packet.geometry[object]);
+    g_renderQueue.submit(opaque, &packet.objects[object], sizeof(CBChangesEveryFrame));
+  }
 
-  g_deviceContext.m_deviceContext->DrawIndexed(cubeMesh.m_index.size(), 0, 0);
+  //------------- Sombras planas -------------//
+  // Llegan por luz, receptor y caster. La geometria va en los bits de
+  // material de la clave: al ordenar, las sombras de cada malla quedan
+  // contiguas y la RenderQueue las junta en un draw instanciado. El stencil
+  // evita el doble blend, asi que el orden entre mallas no cambia la imagen.
+  // Sin shaderProgram se dibujan siempre con la variante de sombra, aun si
+  // una queda sola
+  DrawPacket shadow = opaque;
+  shadow.shaderProgram = nullptr;
+  shadow.instancedProgram = g_instancedShaders.getVariant(g_instancedShadowKey);
+  shadow.blendState = &g_shadowBlendState;
+  shadow.depthStencilState = &g_shadowDepthStencilState;
+  for (size_t i = 0; i < packet.shadows.size(); ++i) {
+    unsigned int object = packet.shadowObjects[i];
+    const FrameGeometry& geometry = packet.geometry[object];
+    // Id de la geometria: el primer objeto que dibuja los mismos buffers y rango
+    unsigned int geometryId = object;
+    for (unsigned int other = 0; other < object; ++other) {
+      const FrameGeometry& candidate = packet.geometry[other];
+      if (candidate.vertexBuffer == geometry.vertexBuffer && candidate.indexBuffer == geometry.indexBuffer &&
+          candidate.startIndex == geometry.startIndex && candidate.indexCount == geometry.indexCount) {
+        geometryId = other;
+        break;
+      }
+    }
+    shadow.sortKey = RenderQueue::makeSortKey(RENDER_PASS_TRANSPARENT, 1, geometryId, 0.0f);
+    setGeometry(shadow, geometry);
+    g_renderQueue.submit(shadow, &packet.shadows[i], sizeof(CBChangesEveryFrame));
+  }
 
-	g_shadowBlendState.render(g_deviceContext, blendFactor, 0xffffffff, true);
-  g_shadowDepthStencilState.render(g_deviceContext, 0, true);
+  g_renderQueue.sort();
+  g_renderQueue.execute(g_deviceContext);
 
   // Presentar el back buffer al front buffer
   g_swapChain.present();
-}
\ No newline at end of file
+  g_constantRing.endFrame();
+}
@@ -0,0 +1,87 @@
+//--------------------------------------------------------------------------------------
+// File: HybridEngineInstanced.fx
+//
+// Variante instanciada de HybridEngine.fx: el mundo y el color de cada objeto
+// llegan por el stream de instancias (slot 1) en lugar de cbChangesEveryFrame.
+//
+// Keywords (ShaderPermutations los define siempre como 0..n-1):
+//   INSTANCE_COLOR  multiplica la textura por el color de la instancia
+//   SHADOW          sombra plana: solo el color de la instancia (con su alpha)
+//--------------------------------------------------------------------------------------
+
+#ifndef INSTANCE_COLOR
+#define INSTANCE_COLOR 1
+#endif
+
+#ifndef SHADOW
+#define SHADOW 0
+#endif
+
+//--------------------------------------------------------------------------------------
+// Constant Buffer Variables
+//--------------------------------------------------------------------------------------
+Texture2D txDiffuse : register( t0 );
+SamplerState samLinear : register( s0 );
+
+cbuffer cbNeverChanges : register( b0 )
+{
+    matrix View;
+};
+
+cbuffer cbChangeOnResize : register( b1 )
+{
+    matrix Projection;
+};
+
+//--------------------------------------------------------------------------------------
+struct VS_INPUT
+{
+    float4 Pos : POSITION;
+    float2 Tex : TEXCOORD0;
+    // Por instancia: filas de la matriz de mundo transpuesta (como en CBChangesEveryFrame)
+    float4 World0 : WORLD0;
+    float4 World1 : WORLD1;
+    float4 World2 : WORLD2;
+    float4 World3 : WORLD3;
+    float4 Color : COLOR0;
+};
+
+struct PS_INPUT
+{
+    float4 Pos : SV_POSITION;
+    float2 Tex : TEXCOORD0;
+    float4 Color : COLOR0;
+};
+
+
+//--------------------------------------------------------------------------------------
+// Vertex Shader
+//--------------------------------------------------------------------------------------
+PS_INPUT VS( VS_INPUT input )
+{
+    PS_INPUT output = (PS_INPUT)0;
+    float4 pos = float4( input.Pos.xyz, 1.0f );
+    output.Pos = float4( dot( input.World0, pos ), dot( input.World1, pos ),
+                         dot( input.World2, pos ), dot( input.World3, pos ) );
+    output.Pos = mul( output.Pos, View );
+    output.Pos = mul( output.Pos, Projection );
+    output.Tex = input.Tex;
+    output.Color = input.Color;
+
+    return output;
+}
+
+
+//--------------------------------------------------------------------------------------
+// Pixel Shader
+//--------------------------------------------------------------------------------------
+float4 PS( PS_INPUT input) : SV_Target
+{
+#if SHADOW
+    return input.Color;
+#elif INSTANCE_COLOR
+    return txDiffuse.Sample( samLinear, input.Tex ) * input.Color;
+#else
+    return txDiffuse.Sample( samLinear, input.Tex );
+#endif
+}
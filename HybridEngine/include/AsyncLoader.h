@@ -0,0 +1,128 @@
+#pragma once
+#include "Prerequisites.h"
+#include <atomic>
+#include <chrono>
+
+class JobSystem;
+struct Job;
+class AsyncLoader;
+
+typedef unsigned int LoadTaskId;
+typedef HRESULT (*LoadFunction)(void* data);
+typedef void (*LoadingFrameFunction)(float progress, void* data);
+
+const LoadTaskId INVALID_LOAD_TASK = 0xffffffff;
+
+enum
+LoadTaskState {
+	LOAD_TASK_PENDING = 0,   // Esperando dependencias
+	LOAD_TASK_RUNNING,       // work() en un worker
+	LOAD_TASK_WORKED,        // Falta finish() en el hilo principal
+	LOAD_TASK_DONE,
+	LOAD_TASK_FAILED
+};
+
+struct
+LoadTask {
+	std::string name;
+	LoadFunction work;     // En un worker: compilar, leer, decodificar (nullptr = nada)
+	LoadFunction finish;   // En el hilo principal: crear objetos de GPU (nullptr = nada)
+	void* data;
+	std::vector<LoadTaskId> dependencies;
+	std::atomic<int> state;
+	HRESULT result;
+	double workMs;
+	AsyncLoader* loader;
+};
+
+struct
+AsyncLoadStats {
+	unsigned int tasks = 0;
+	unsigned int failed = 0;
+	unsigned int loadingFrames = 0;
+	double workMs = 0.0;     // Suma de work() en todos los hilos
+	double finishMs = 0.0;   // Suma de finish() en el hilo principal
+	double wallMs = 0.0;     // De start() al final de wait()
+};
+
+/**
+ * @brief Grafo de tareas de carga sobre el JobSystem.
+ *
+ * Cada tarea tiene una parte de CPU (work) que corre en los workers y una
+ * parte que toca el dispositivo (finish) que corre en el hilo principal
+ * dentro de update(); el backend nulo no es free-threaded y el contexto
+ * nunca lo es. Una tarea arranca cuando todas sus dependencias terminaron
+ * las dos partes (p. ej. el input layout espera al bytecode del VS), y
+ * falla sin ejecutarse si alguna dependencia fallo. wait() llama a un
+ * callback de frame de carga cada frameIntervalMs y, entre frames, ejecuta
+ * jobs en el hilo principal si los workers no alcanzan o duerme si no hay
+ * nada que hacer.
+ */
+class
+AsyncLoader {
+public:
+	AsyncLoader()  = default;
+	~AsyncLoader() { destroy(); }
+
+	AsyncLoader(const AsyncLoader&) = delete;
+	AsyncLoader&
+	operator=(const AsyncLoader&) = delete;
+
+	void
+	init(JobSystem& jobs);
+
+	// Espera a los workers y libera las tareas
+	void
+	destroy();
+
+	LoadTaskId
+	add(const std::string& name,
+			LoadFunction work,
+			LoadFunction finish,
+			void* data = nullptr,
+			const LoadTaskId* dependencies = nullptr,
+			unsigned int dependencyCount = 0);
+
+	// Una sola dependencia
+	LoadTaskId
+	add(const std::string& name, LoadFunction work, LoadFunction finish, void* data, LoadTaskId dependency);
+
+	// Lanza las tareas listas; se puede agregar mas despues
+	void
+	start();
+
+	// Hilo principal: lanza lo que quedo listo y corre los finish(). true
+	// mientras quede trabajo
+	bool
+	update();
+
+	// update() hasta terminar con un frame de carga cada frameIntervalMs.
+	// Devuelve el primer error (con el nombre de la tarea en el log) o S_OK
+	HRESULT
+	wait(LoadingFrameFunction frame = nullptr, void* frameData = nullptr, double frameIntervalMs = 16.0);
+
+	float
+	getProgress() const;
+
+	LoadTaskState
+	getState(LoadTaskId id) const { return static_cast<LoadTaskState>(m_tasks[id]->state.load()); }
+
+	const AsyncLoadStats&
+	getStats() const { return m_stats; }
+
+private:
+	static void
+	runWork(Job& job);
+
+	HRESULT
+	firstError() const;
+
+private:
+	JobSystem* m_jobs = nullptr;
+	std::vector<LoadTask*> m_tasks;
+	std::atomic<int> m_running{ 0 };   // Works lanzados que no han vuelto
+	unsigned int m_completed = 0;
+	std::chrono::steady_clock::time_point m_start;
+	bool m_started = false;
+	AsyncLoadStats m_stats;
+};
@@ -1,32 +1,132 @@
 #pragma once
 #include "Prerequisites.h"
 #include "Window.h"
+#include <mutex>
+#include <condition_variable>
 
+class Buffer;
+
+// Geometria de un objeto con el nivel de detalle ya resuelto
+struct
+FrameGeometry {
+	Buffer* vertexBuffer = nullptr;
+	Buffer* indexBuffer = nullptr;
+	unsigned int startIndex = 0;
+	unsigned int indexCount = 0;
+};
+
+/**
+ * @brief Datos que la simulacion deja listos para que se dibuje un frame.
+ *
+ * Hay un paquete por etapa del pipeline: mientras el render consume el
+ * paquete N la simulacion escribe el N+1, por lo que el render nunca debe
+ * leer estado global de la simulacion, solo lo que viene aqui.
+ */
+struct
+FramePacket {
+	unsigned long long frame = 0;
+	float time = 0.0f;
+	CBNeverChanges camera;
+	CBChangeOnResize projection;
+	std::vector<CBChangesEveryFrame> objects;
+	std::vector<unsigned char> visible;   // Por objeto: 1 si paso el culling
+	std::vector<unsigned char> lod;       // Por objeto: nivel de detalle elegido
+	std::vector<FrameGeometry> geometry;  // Por objeto: buffers y rango de indices del LOD
+	std::vector<CBChangesEveryFrame> shadows;   // Sombras planas visibles
+	std::vector<unsigned int> shadowObjects;    // Objeto cuya malla proyecta cada sombra
+};
+
+// Tiempos acumulados por etapa (ms)
+struct
+PipelineStats {
+	unsigned long long frames = 0;
+	double simulateMs = 0.0;
+	double renderMs = 0.0;
+	double simulateWaitMs = 0.0;  // Simulacion esperando un paquete libre
+	double renderWaitMs = 0.0;    // Render esperando un paquete listo
+};
+
+/**
+ * @brief Aplicacion base con un frame loop de dos etapas.
+ *
+ * Con profundidad 1 update() y render() corren en serie en el hilo
+ * principal. Con profundidad >= 2 render() corre en un hilo propio y la
+ * simulacion puede adelantarse hasta depth - 1 frames. El hilo principal
+ * sigue atendiendo los mensajes de la ventana.
+ */
 class
 BaseApp {
 public:
-	BaseApp()  = default;
-	~BaseApp() = default;
+	explicit BaseApp(Window& window) : m_window(window) {}
+	virtual ~BaseApp() = default;
 
-	HRESULT
+	virtual HRESULT
 	init();
-	
-	void 
-	update();
-	
-	void 
-	render();
-	
-	void 
+
+	// Etapa de simulacion: llena el paquete del frame
+	virtual void
+	update(FramePacket& packet);
+
+	// Etapa de render: solo lee el paquete
+	virtual void
+	render(const FramePacket& packet);
+
+	virtual void
 	destroy();
 
-	int 
-	run(HINSTANCE hInstance, 
-			HINSTANCE hPrevInstance, 
-			LPWSTR lpCmdLine, 
-			int nCmdShow, 
+	int
+	run(HINSTANCE hInstance,
+			HINSTANCE hPrevInstance,
+			LPWSTR lpCmdLine,
+			int nCmdShow,
 			WNDPROC wndproc);
 
+	// Ejecuta frameCount frames sin ventana ni bucle de mensajes (no llama
+	// destroy). E_FAIL si el pipeline no dibujo todos los frames simulados
+	HRESULT
+	runFrames(unsigned int frameCount);
+
+	// Numero de paquetes en vuelo; se aplica al iniciar el pipeline
+	void
+	setPipelineDepth(unsigned int depth) { m_pipelineDepth = depth > 0 ? depth : 1; }
+
+	unsigned int
+	getPipelineDepth() const { return m_pipelineDepth; }
+
+	const PipelineStats&
+	getPipelineStats() const { return m_stats; }
+
+	// Tiempos promedio por frame en texto
+	std::string
+	pipelineSummary() const;
+
+private:
+	void
+	startPipeline();
+
+	// Simula el siguiente frame y lo entrega al render
+	void
+	frame();
+
+	// Espera a que el render consuma todo y detiene su hilo
+	void
+	stopPipeline();
+
+	void
+	renderLoop();
+
+protected:
+	Window& m_window;
+
 private:
-	Window m_window;
-};
\ No newline at end of file
+	unsigned int m_pipelineDepth = 2;
+	std::vector<FramePacket> m_packets;
+	std::thread m_renderThread;
+	std::mutex m_pipelineLock;
+	std::condition_variable m_packetReady;
+	std::condition_variable m_packetFree;
+	unsigned long long m_simulated = 0;
+	unsigned long long m_rendered = 0;
+	bool m_stopRender = false;
+	PipelineStats m_stats;
+};
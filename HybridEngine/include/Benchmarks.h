@@ -0,0 +1,92 @@
+#pragma once
+#include "Prerequisites.h"
+
+// Micro-benchmarks que se lanzan desde la linea de comandos (-jobbench,
+// -transformbench, ...). Los resultados van a la salida de depuracion y a
+// stdout; cada uno devuelve false si alguna verificacion da MISMATCH y el
+// flag sale con codigo 1.
+
+// Ring de subida de constantes: casos conocidos de vuelta, liberacion por
+// fence y asignaciones que no caben, mas el costo por asignacion
+bool
+RunUploadRingBenchmark();
+
+// Costo por job vacio y escalado de parallelFor de 1 a N hilos
+bool
+RunJobBenchmark();
+
+// Composicion de matrices de mundo: XMMATRIX por objeto contra SoA/SIMD
+bool
+RunTransformBenchmark();
+
+// ECS: iteracion por chunks contra update() virtual por objeto
+bool
+RunEcsBenchmark();
+
+// Frustum culling SIMD contra la referencia escalar (verifica que coincidan)
+bool
+RunCullingBenchmark();
+
+// Occlusion culling en CPU: costo de rasterizado y de pruebas, mas casos conocidos
+bool
+RunOcclusionBenchmark();
+
+// Loader OBJ: MB/s en serie y en paralelo. Con path vacio genera una malla
+// sintetica en memoria y verifica los conteos y que el resultado en
+// paralelo sea igual al de un hilo
+bool
+RunObjBenchmark(const std::string& path);
+
+// Malla cocinada: abrir y validar un MeshFile contra parsear el mismo OBJ
+bool
+RunMeshFileBenchmark();
+
+// Optimizacion de mallas: ACMR, ATVR y overdraw antes y despues. Sin path
+// usa esferas concentricas con los triangulos desordenados. Verifica que el
+// conjunto de triangulos no cambie
+bool
+RunMeshOptimizerBenchmark(const std::string& path);
+
+// Formato de vertice cuantizado: codificacion SIMD contra la referencia
+// escalar (verifica que coincidan), bytes por vertice y error maximo
+bool
+RunVertexFormatBenchmark();
+
+// LODs por cuadricas: triangulos, error y tiempo por nivel, y el nivel que
+// elige el selector a varias distancias. Sin path usa una esfera UV
+bool
+RunLodBenchmark(const std::string& path);
+
+// Meshlets: construccion, culling por frustum + cono (SIMD contra escalar)
+// y escritura del index buffer compactado. Sin path usa una esfera densa
+bool
+RunMeshletBenchmark(const std::string& path);
+
+// Cache de shaders: insercion, guardado, carga y busqueda con blobs
+// sinteticos (sin compilador), sensibilidad de la key a includes y flags, y
+// compilacion en frio contra en caliente de HybridEngine.fx si esta presente
+bool
+RunShaderCacheBenchmark();
+
+// Permutaciones de shader: empaquetado de keys, compilacion de todas las
+// variantes en serie contra el JobSystem, arranque con cache y busqueda O(1)
+// (dispositivo nulo; no requiere GPU pero si el compilador)
+bool
+RunShaderPermutationBenchmark();
+
+// Carga asincrona: grafo sintetico de compilaciones y texturas sin workers
+// contra el JobSystem, orden de dependencias y propagacion de fallos
+bool
+RunAsyncLoadBenchmark();
+
+// Parameter blocks: validacion de un struct de C++ contra un layout de
+// cbuffer y subidas por frame de una camara casi fija, siempre contra solo
+// al cambiar (backend nulo)
+bool
+RunParameterBlockBenchmark();
+
+// Recarga en caliente: latencia del FileWatcher (nativo y por sondeo),
+// recarga de una malla OBJ y de un shader, y rechazo de cambios rotos
+// (backend nulo)
+bool
+RunHotReloadBenchmark();
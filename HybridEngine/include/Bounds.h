@@ -0,0 +1,27 @@
+#pragma once
+#include "CullingMath.h"
+
+class MeshComponent;
+
+/**
+ * @brief Volumen envolvente: caja alineada a los ejes (centro y medias
+ * extensiones) mas una esfera con el mismo centro.
+ *
+ * Guardar ambas permite usar la mas ajustada de las dos en cada prueba.
+ */
+struct
+Bounds {
+	Float3 center;
+	Float3 extents;
+	float radius;
+};
+
+// Calcula la caja y la esfera de los vertices de la malla (espacio local)
+Bounds
+ComputeMeshBounds(const MeshComponent& mesh);
+
+// Lleva bounds locales a mundo con la matriz world (vector fila, v * M).
+// El resultado es conservador aun con escalas no uniformes; tambien acepta
+// matrices con w constante como la de sombra plana.
+Bounds
+TransformBounds(const Bounds& local, const Float4x4& world);
@@ -11,14 +11,36 @@ public:
 	Buffer()  = default;
 	~Buffer() = default;
 
-	 // Inicializa Vertex e Index Buffers 
+	 // Inicializa Vertex e Index Buffers. Los indices se guardan en 16 bits
+	 // si todos caben (ver SplitMeshFor16BitIndices para mallas grandes)
   HRESULT
   init(Device& device, const MeshComponent& mesh, unsigned int bindFlag);
 
+  // Inicializa un Vertex o Index Buffer inmutable directo desde memoria
+  // (p. ej. una seccion de un MeshFile proyectado); no copia en CPU. Para
+  // indices stride 2 o 4 elige R16_UINT o R32_UINT
+  HRESULT
+  init(Device& device,
+       const void* data,
+       unsigned int count,
+       unsigned int stride,
+       unsigned int bindFlag);
+
   // Inicializa Constant Buffers
   HRESULT
   init(Device& device, unsigned int ByteWidth);
 
+  // Inicializa un buffer DYNAMIC que la CPU escribe con map() (p. ej. instancias)
+  HRESULT
+  initDynamic(Device& device, unsigned int ByteWidth, unsigned int stride, unsigned int bindFlag);
+
+  // Mapea un buffer dinamico; devuelve nullptr si falla
+  void*
+  map(DeviceContext& deviceContext, D3D11_MAP mapType);
+
+  void
+  unmap(DeviceContext& deviceContext);
+
   // Actualiza los constant buffers a nivel logico
 	void
 	update(DeviceContext& deviceContext, 
@@ -29,7 +51,8 @@ public:
          unsigned int SrcRowPitch,
          unsigned int SrcDepthPitch);
 
-  // Actualiza en render el Vertex, Index y Constant Buffer
+  // Actualiza en render el Vertex, Index y Constant Buffer. Con format
+  // UNKNOWN un Index Buffer usa su propio formato
   void
   render(DeviceContext& deviceContext,
          unsigned int StartSlot,
@@ -41,6 +64,13 @@ public:
   void 
   destroy();
 
+  unsigned int
+  getStride() const { return m_stride; }
+
+  // Formato de indices (R16_UINT o R32_UINT); UNKNOWN si no es Index Buffer
+  DXGI_FORMAT
+  getFormat() const { return m_format; }
+
   HRESULT
   createBuffer(Device& device, 
                D3D11_BUFFER_DESC& desc, 
@@ -52,4 +82,5 @@ private:
 	unsigned int m_stride = 0;
 	unsigned int m_offset = 0;
 	unsigned int m_bindFlag = 0;
+	DXGI_FORMAT m_format = DXGI_FORMAT_UNKNOWN;
 };
\ No newline at end of file
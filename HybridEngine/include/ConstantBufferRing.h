@@ -0,0 +1,47 @@
+#pragma once
+#include "Prerequisites.h"
+#include "UploadRing.h"
+
+class Device;
+class DeviceContext;
+
+/**
+ * @brief Constant buffers por draw suballocados de un ring compartido.
+ *
+ * D3D11.0 no permite enlazar un constant buffer con offset (eso llega con
+ * VSSetConstantBuffers1 en 11.1) ni NO_OVERWRITE sobre constant buffers, asi
+ * que cada slice de 256 bytes del ring es un buffer DYNAMIC propio que se
+ * escribe con WRITE_DISCARD. El UploadRing garantiza que un slice no se
+ * reutiliza mientras un frame en vuelo lo puede estar leyendo.
+ */
+class
+ConstantBufferRing {
+public:
+	static const unsigned int SLICE_SIZE = 256;
+
+	ConstantBufferRing()  = default;
+	~ConstantBufferRing() = default;
+
+	HRESULT
+	init(Device& device, unsigned int sliceCount, unsigned int framesInFlight);
+
+	void
+	beginFrame();
+
+	// Copia data a un slice libre; devuelve el buffer a enlazar o nullptr si no cabe
+	ID3D11Buffer*
+	upload(DeviceContext& deviceContext, const void* data, unsigned int size);
+
+	void
+	endFrame();
+
+	void
+	destroy();
+
+	const UploadRing&
+	getRing() const { return m_ring; }
+
+private:
+	UploadRing m_ring;
+	std::vector<ID3D11Buffer*> m_slices;
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+/**
+ * @brief Tipos de float planos para Bounds, FrustumCuller y OcclusionCuller.
+ *
+ * Tienen el mismo layout que XMFLOAT3, XMFLOAT4 y XMFLOAT4X4 pero no
+ * dependen de windows.h ni de xnamath.h, asi que el culling compila sin el
+ * SDK de DirectX. MathConversions.h convierte desde y hacia XNA Math.
+ */
+struct
+Float3 {
+	float x, y, z;
+
+	Float3() = default;
+	Float3(float x_, float y_, float z_) : x(x_), y(y_), z(z_) {}
+};
+
+struct
+Float4 {
+	float x, y, z, w;
+
+	Float4() = default;
+	Float4(float x_, float y_, float z_, float w_) : x(x_), y(y_), z(z_), w(w_) {}
+};
+
+// Matriz en el orden de XNA Math (vector fila, v * M)
+struct
+Float4x4 {
+	float m[4][4];
+};
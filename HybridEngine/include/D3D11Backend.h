@@ -0,0 +1,209 @@
+#pragma once
+#include "RenderBackend.h"
+
+/**
+ * @brief Backend que reenvia cada llamada a Direct3D 11.
+ *
+ * No es duenio del dispositivo ni del contexto: SwapChain los crea y
+ * CleanupDevice los libera.
+ */
+class
+D3D11Backend : public RenderBackend {
+public:
+	D3D11Backend()  = default;
+	~D3D11Backend() = default;
+
+	void
+	init(ID3D11Device* device, ID3D11DeviceContext* deviceContext);
+
+	void
+	destroy();
+
+	const char*
+	getName() const override { return "D3D11"; }
+
+	bool
+	isFreeThreaded() const override { return true; }
+
+	HRESULT
+	CreateBuffer(const D3D11_BUFFER_DESC* pDesc,
+							 const D3D11_SUBRESOURCE_DATA* pInitialData,
+							 ID3D11Buffer** ppBuffer) override;
+
+	HRESULT
+	CreateTexture2D(const D3D11_TEXTURE2D_DESC* pDesc,
+									const D3D11_SUBRESOURCE_DATA* pInitialData,
+									ID3D11Texture2D** ppTexture2D) override;
+
+	HRESULT
+	CreateShaderResourceView(ID3D11Resource* pResource,
+													 const D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc,
+													 ID3D11ShaderResourceView** ppSRView) override;
+
+	HRESULT
+	CreateShaderResourceViewFromFile(const std::string& fileName,
+																	 ID3D11ShaderResourceView** ppSRView) override;
+
+	HRESULT
+	CreateRenderTargetView(ID3D11Resource* pResource,
+												 const D3D11_RENDER_TARGET_VIEW_DESC* pDesc,
+												 ID3D11RenderTargetView** ppRTView) override;
+
+	HRESULT
+	CreateDepthStencilView(ID3D11Resource* pResource,
+												 const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc,
+												 ID3D11DepthStencilView** ppDepthStencilView) override;
+
+	HRESULT
+	CreateVertexShader(const void* pShaderBytecode,
+										 unsigned int BytecodeLength,
+										 ID3D11ClassLinkage* pClassLinkage,
+										 ID3D11VertexShader** ppVertexShader) override;
+
+	HRESULT
+	CreatePixelShader(const void* pShaderBytecode,
+										unsigned int BytecodeLength,
+										ID3D11ClassLinkage* pClassLinkage,
+										ID3D11PixelShader** ppPixelShader) override;
+
+	HRESULT
+	CreateInputLayout(const D3D11_INPUT_ELEMENT_DESC* pInputElementDescs,
+										unsigned int NumElements,
+										const void* pShaderBytecodeWithInputSignature,
+										unsigned int BytecodeLength,
+										ID3D11InputLayout** ppInputLayout) override;
+
+	HRESULT
+	CreateSamplerState(const D3D11_SAMPLER_DESC* pSamplerDesc,
+										 ID3D11SamplerState** ppSamplerState) override;
+
+	HRESULT
+	CreateBlendState(const D3D11_BLEND_DESC* pBlendStateDesc,
+									 ID3D11BlendState** ppBlendState) override;
+
+	HRESULT
+	CreateDepthStencilState(const D3D11_DEPTH_STENCIL_DESC* pDepthStencilDesc,
+													ID3D11DepthStencilState** ppDepthStencilState) override;
+
+	HRESULT
+	CreateRasterizerState(const D3D11_RASTERIZER_DESC* pRasterizerDesc,
+												ID3D11RasterizerState** ppRasterizerState) override;
+
+	void
+	IASetInputLayout(ID3D11InputLayout* pInputLayout) override;
+
+	void
+	IASetVertexBuffers(unsigned int StartSlot,
+										 unsigned int NumBuffers,
+										 ID3D11Buffer* const* ppVertexBuffers,
+										 const unsigned int* pStrides,
+										 const unsigned int* pOffsets) override;
+
+	void
+	IASetIndexBuffer(ID3D11Buffer* pIndexBuffer,
+									 DXGI_FORMAT Format,
+									 unsigned int Offset) override;
+
+	void
+	IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology) override;
+
+	void
+	VSSetShader(ID3D11VertexShader* pVertexShader,
+							ID3D11ClassInstance* const* ppClassInstances,
+							unsigned int NumClassInstances) override;
+
+	void
+	PSSetShader(ID3D11PixelShader* pPixelShader,
+							ID3D11ClassInstance* const* ppClassInstances,
+							unsigned int NumClassInstances) override;
+
+	void
+	VSSetConstantBuffers(unsigned int StartSlot,
+											 unsigned int NumBuffers,
+											 ID3D11Buffer* const* ppConstantBuffers) override;
+
+	void
+	PSSetConstantBuffers(unsigned int StartSlot,
+											 unsigned int NumBuffers,
+											 ID3D11Buffer* const* ppConstantBuffers) override;
+
+	void
+	PSSetShaderResources(unsigned int StartSlot,
+											 unsigned int NumViews,
+											 ID3D11ShaderResourceView* const* ppShaderResourceViews) override;
+
+	void
+	PSSetSamplers(unsigned int StartSlot,
+								unsigned int NumSamplers,
+								ID3D11SamplerState* const* ppSamplers) override;
+
+	void
+	OMSetRenderTargets(unsigned int NumViews,
+										 ID3D11RenderTargetView* const* ppRenderTargetViews,
+										 ID3D11DepthStencilView* pDepthStencilView) override;
+
+	void
+	OMSetBlendState(ID3D11BlendState* pBlendState,
+									const float BlendFactor[4],
+									unsigned int SampleMask) override;
+
+	void
+	OMSetDepthStencilState(ID3D11DepthStencilState* pDepthStencilState,
+												 unsigned int StencilRef) override;
+
+	void
+	RSSetViewports(unsigned int NumViewports, const D3D11_VIEWPORT* pViewports) override;
+
+	void
+	RSSetState(ID3D11RasterizerState* pRasterizerState) override;
+
+	void
+	ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView,
+												const float ColorRGBA[4]) override;
+
+	void
+	ClearDepthStencilView(ID3D11DepthStencilView* pDepthStencilView,
+												unsigned int ClearFlags,
+												float Depth,
+												UINT8 Stencil) override;
+
+	void
+	UpdateSubresource(ID3D11Resource* pDstResource,
+										unsigned int DstSubresource,
+										const D3D11_BOX* pDstBox,
+										const void* pSrcData,
+										unsigned int SrcRowPitch,
+										unsigned int SrcDepthPitch) override;
+
+	HRESULT
+	Map(ID3D11Resource* pResource,
+			unsigned int Subresource,
+			D3D11_MAP MapType,
+			unsigned int MapFlags,
+			D3D11_MAPPED_SUBRESOURCE* pMappedResource) override;
+
+	void
+	Unmap(ID3D11Resource* pResource, unsigned int Subresource) override;
+
+	void
+	DrawIndexed(unsigned int IndexCount,
+							unsigned int StartIndexLocation,
+							int BaseVertexLocation) override;
+
+	void
+	DrawIndexedInstanced(unsigned int IndexCountPerInstance,
+											 unsigned int InstanceCount,
+											 unsigned int StartIndexLocation,
+											 int BaseVertexLocation,
+											 unsigned int StartInstanceLocation) override;
+
+	void
+	ClearState() override;
+
+	HRESULT
+	Present(IDXGISwapChain* pSwapChain, unsigned int SyncInterval, unsigned int Flags) override;
+
+private:
+	ID3D11Device* m_device = nullptr;
+	ID3D11DeviceContext* m_deviceContext = nullptr;
+};
@@ -13,6 +13,11 @@ public:
 	HRESULT 
 	init(Device& device, bool enableDepth = true, bool enableStencil = false);
 
+	// Prueba de profundidad sin escritura y stencil EQUAL 0 / INCR: cada pixel
+	// se mezcla una sola vez aunque se solapen varias sombras planas
+	HRESULT
+	initPlanarShadow(Device& device);
+
 	void 
 	update(); 
 
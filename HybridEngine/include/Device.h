@@ -1,14 +1,17 @@
 #pragma once
 #include "Prerequisites.h"
 
+class RenderBackend;
+
 class 
 Device {
 public:
 	Device() = default;
 	~Device()= default;
 
+	// Enlaza el dispositivo con el backend (D3D11 o nulo)
 	void
-	init();
+	init(RenderBackend* backend);
 	
 	void 
 	update();
@@ -29,6 +32,15 @@ public:
 									const D3D11_SUBRESOURCE_DATA* pInitialData,
 									ID3D11Texture2D** ppTexture2D);
 
+	HRESULT
+	CreateShaderResourceView(ID3D11Resource* pResource,
+													 const D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc,
+													 ID3D11ShaderResourceView** ppSRView);
+
+	HRESULT
+	CreateShaderResourceViewFromFile(const std::string& fileName,
+																	 ID3D11ShaderResourceView** ppSRView);
+
 	HRESULT 
 	CreateDepthStencilView(ID3D11Resource* pResource,
 												 const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc,
@@ -74,5 +86,7 @@ public:
 	CreateRasterizerState(const D3D11_RASTERIZER_DESC* pRasterizerDesc,
 												ID3D11RasterizerState** ppRasterizerState);
 public:
+	// Dispositivo nativo; nullptr con el backend nulo
 	ID3D11Device* m_device = nullptr;
+	RenderBackend* m_backend = nullptr;
 };
@@ -1,41 +1,215 @@
 #pragma once
 #include "Prerequisites.h"
 
-class 
+class RenderBackend;
+
+// Numero de slots que sigue la cache de estado por etapa
+const unsigned int CACHED_VERTEX_BUFFER_SLOTS  = 16;
+const unsigned int CACHED_CONSTANT_BUFFER_SLOTS = D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT;
+const unsigned int CACHED_SHADER_RESOURCE_SLOTS = 16;
+const unsigned int CACHED_SAMPLER_SLOTS         = D3D11_COMMONSHADER_SAMPLER_SLOT_COUNT;
+const unsigned int CACHED_RENDER_TARGET_SLOTS   = D3D11_SIMULTANEOUS_RENDER_TARGET_COUNT;
+
+// Copia en CPU del estado IA/VS/PS/RS/OM enlazado en el contexto
+struct
+PipelineStateCache {
+	ID3D11InputLayout* inputLayout;
+	D3D11_PRIMITIVE_TOPOLOGY topology;
+	ID3D11Buffer* vertexBuffers[CACHED_VERTEX_BUFFER_SLOTS];
+	unsigned int vertexStrides[CACHED_VERTEX_BUFFER_SLOTS];
+	unsigned int vertexOffsets[CACHED_VERTEX_BUFFER_SLOTS];
+	ID3D11Buffer* indexBuffer;
+	DXGI_FORMAT indexFormat;
+	unsigned int indexOffset;
+
+	ID3D11VertexShader* vertexShader;
+	ID3D11PixelShader* pixelShader;
+	ID3D11Buffer* vsConstantBuffers[CACHED_CONSTANT_BUFFER_SLOTS];
+	ID3D11Buffer* psConstantBuffers[CACHED_CONSTANT_BUFFER_SLOTS];
+	ID3D11ShaderResourceView* psShaderResources[CACHED_SHADER_RESOURCE_SLOTS];
+	ID3D11SamplerState* psSamplers[CACHED_SAMPLER_SLOTS];
+
+	ID3D11RasterizerState* rasterizerState;
+	unsigned int numViewports;
+	D3D11_VIEWPORT viewport;
+
+	ID3D11RenderTargetView* renderTargets[CACHED_RENDER_TARGET_SLOTS];
+	unsigned int numRenderTargets;
+	ID3D11DepthStencilView* depthStencilView;
+	ID3D11BlendState* blendState;
+	float blendFactor[4];
+	unsigned int sampleMask;
+	ID3D11DepthStencilState* depthStencilState;
+	unsigned int stencilRef;
+};
+
+// Contadores de binds enviados al backend vs. descartados por redundantes
+struct
+BindStats {
+	unsigned long long issued = 0;
+	unsigned long long skipped = 0;
+};
+
+class
 DeviceContext {
 public:
 	DeviceContext()  = default;
 	~DeviceContext() = default;
 
+	// Enlaza el contexto con el backend (D3D11 o nulo)
+	void
+	init(RenderBackend* backend);
+
 	void
-	init();
-	
-	void 
 	update();
-	
-	void 
+
+	void
 	render();
-	
-	void 
+
+	void
 	destroy();
 
-	void 
+	void
 	RSSetViewports(unsigned int NumViewports, const D3D11_VIEWPORT* pViewports);
 
-	void 
+	void
+	RSSetState(ID3D11RasterizerState* pRasterizerState);
+
+	void
 	ClearDepthStencilView(ID3D11DepthStencilView* pDepthStencilView,
 												unsigned int ClearFlags,
 												float Depth,
 												UINT8 Stencil);
 
-	void 
-	ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView, 
+	void
+	ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView,
 												const float ColorRGBA[4]);
 
-	void 
+	void
 	OMSetRenderTargets(unsigned int NumViews,
 										 ID3D11RenderTargetView* const* ppRenderTargetViews,
 										 ID3D11DepthStencilView* pDepthStencilView);
+
+	void
+	OMSetBlendState(ID3D11BlendState* pBlendState,
+									const float BlendFactor[4],
+									unsigned int SampleMask);
+
+	void
+	OMSetDepthStencilState(ID3D11DepthStencilState* pDepthStencilState,
+												 unsigned int StencilRef);
+
+	void
+	IASetInputLayout(ID3D11InputLayout* pInputLayout);
+
+	void
+	IASetVertexBuffers(unsigned int StartSlot,
+										 unsigned int NumBuffers,
+										 ID3D11Buffer* const* ppVertexBuffers,
+										 const unsigned int* pStrides,
+										 const unsigned int* pOffsets);
+
+	void
+	IASetIndexBuffer(ID3D11Buffer* pIndexBuffer,
+									 DXGI_FORMAT Format,
+									 unsigned int Offset);
+
+	void
+	IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology);
+
+	void
+	VSSetShader(ID3D11VertexShader* pVertexShader,
+							ID3D11ClassInstance* const* ppClassInstances,
+							unsigned int NumClassInstances);
+
+	void
+	PSSetShader(ID3D11PixelShader* pPixelShader,
+							ID3D11ClassInstance* const* ppClassInstances,
+							unsigned int NumClassInstances);
+
+	void
+	VSSetConstantBuffers(unsigned int StartSlot,
+											 unsigned int NumBuffers,
+											 ID3D11Buffer* const* ppConstantBuffers);
+
+	void
+	PSSetConstantBuffers(unsigned int StartSlot,
+											 unsigned int NumBuffers,
+											 ID3D11Buffer* const* ppConstantBuffers);
+
+	void
+	PSSetShaderResources(unsigned int StartSlot,
+											 unsigned int NumViews,
+											 ID3D11ShaderResourceView* const* ppShaderResourceViews);
+
+	void
+	PSSetSamplers(unsigned int StartSlot,
+								unsigned int NumSamplers,
+								ID3D11SamplerState* const* ppSamplers);
+
+	void
+	UpdateSubresource(ID3D11Resource* pDstResource,
+										unsigned int DstSubresource,
+										const D3D11_BOX* pDstBox,
+										const void* pSrcData,
+										unsigned int SrcRowPitch,
+										unsigned int SrcDepthPitch);
+
+	HRESULT
+	Map(ID3D11Resource* pResource,
+			unsigned int Subresource,
+			D3D11_MAP MapType,
+			unsigned int MapFlags,
+			D3D11_MAPPED_SUBRESOURCE* pMappedResource);
+
+	void
+	Unmap(ID3D11Resource* pResource, unsigned int Subresource);
+
+	void
+	DrawIndexed(unsigned int IndexCount,
+							unsigned int StartIndexLocation,
+							int BaseVertexLocation);
+
+	void
+	DrawIndexedInstanced(unsigned int IndexCountPerInstance,
+											 unsigned int InstanceCount,
+											 unsigned int StartIndexLocation,
+											 int BaseVertexLocation,
+											 unsigned int StartInstanceLocation);
+
+	void
+	ClearState();
+
+	// Activa/desactiva la eliminacion de binds redundantes (activa por defecto)
+	void
+	setStateCacheEnabled(bool enabled);
+
+	// Olvida el estado conocido; el siguiente bind de cada etapa se envia siempre
+	void
+	invalidateStateCache();
+
+	const BindStats&
+	getBindStats() const { return m_bindStats; }
+
+	void
+	resetBindStats() { m_bindStats = BindStats(); }
+
+private:
+	// Estado por defecto de un contexto recien creado / tras ClearState
+	void
+	resetStateCache();
+
+	// Registra el resultado de un bind; devuelve true si hay que enviarlo
+	bool
+	countBind(bool redundant);
+
 public:
+	// Contexto nativo; nullptr con el backend nulo
 	ID3D11DeviceContext* m_deviceContext = nullptr;
-};
\ No newline at end of file
+	RenderBackend* m_backend = nullptr;
+
+private:
+	PipelineStateCache m_state;
+	BindStats m_bindStats;
+	bool m_stateCacheEnabled = true;
+};
@@ -0,0 +1,92 @@
+#pragma once
+#include "ECS/Component.h"
+
+struct
+Entity {
+	unsigned int index;
+	unsigned int generation;
+
+	bool
+	operator==(const Entity& other) const { return index == other.index && generation == other.generation; }
+
+	bool
+	operator!=(const Entity& other) const { return !(*this == other); }
+};
+
+const Entity NULL_ENTITY = { 0xffffffff, 0 };
+
+// Bloque de 16 KB con las entidades y un arreglo por componente (SoA)
+struct
+ArchetypeChunk {
+	unsigned char* data;
+	unsigned int count;
+};
+
+/**
+ * @brief Almacenamiento de todas las entidades con la misma firma.
+ *
+ * Cada chunk guarda primero el arreglo de Entity y luego un arreglo por
+ * componente, todos con la misma capacidad. Las filas se mantienen densas:
+ * al quitar una se rellena el hueco con la ultima fila del ultimo chunk.
+ */
+class
+Archetype {
+public:
+	static const unsigned int CHUNK_SIZE = 16 * 1024;
+	static const unsigned int INVALID_OFFSET = 0xffffffff;
+
+	Archetype()  = default;
+	~Archetype() { destroy(); }
+
+	void
+	init(ComponentMask mask);
+
+	void
+	destroy();
+
+	// Reserva una fila para entity; los componentes quedan en cero
+	void
+	allocate(Entity entity, unsigned int& chunk, unsigned int& row);
+
+	// Quita la fila y devuelve la entidad que se movio a su lugar (o NULL_ENTITY)
+	Entity
+	removeRow(unsigned int chunk, unsigned int row);
+
+	void*
+	getComponent(unsigned int chunk, unsigned int row, unsigned int typeId) const;
+
+	void*
+	getArray(const ArchetypeChunk& chunk, unsigned int typeId) const {
+		return chunk.data + m_offsets[typeId];
+	}
+
+	Entity*
+	getEntities(const ArchetypeChunk& chunk) const {
+		return reinterpret_cast<Entity*>(chunk.data);
+	}
+
+	bool
+	hasComponent(unsigned int typeId) const { return (m_mask & (1ull << typeId)) != 0; }
+
+	ComponentMask
+	getMask() const { return m_mask; }
+
+	const std::vector<unsigned int>&
+	getTypes() const { return m_types; }
+
+	unsigned int
+	getCapacity() const { return m_capacity; }
+
+	const std::vector<ArchetypeChunk>&
+	getChunks() const { return m_chunks; }
+
+	unsigned int
+	getEntityCount() const;
+
+private:
+	ComponentMask m_mask = 0;
+	unsigned int m_capacity = 0;
+	unsigned int m_offsets[MAX_COMPONENT_TYPES];
+	std::vector<unsigned int> m_types;
+	std::vector<ArchetypeChunk> m_chunks;
+};
@@ -0,0 +1,80 @@
+#pragma once
+#include "ECS/World.h"
+
+/**
+ * @brief Cambios estructurales diferidos para un EntityWorld.
+ *
+ * Los sistemas que iteran en paralelo graban aqui las altas, bajas y cambios
+ * de componentes y el hilo principal los aplica con playback() cuando ya no
+ * hay iteraciones en curso. Cada hilo debe usar su propio buffer (o
+ * protegerlo). create() devuelve una entidad provisional que solo es valida
+ * dentro de este mismo buffer hasta el playback.
+ */
+class
+EntityCommandBuffer {
+public:
+	EntityCommandBuffer()  = default;
+	~EntityCommandBuffer() = default;
+
+	Entity
+	create();
+
+	void
+	destroyEntity(Entity entity);
+
+	template<typename T>
+	void
+	add(Entity entity, const T& value = T()) {
+		addComponent(entity, componentId<T>(), &value, sizeof(T));
+	}
+
+	template<typename T>
+	void
+	remove(Entity entity) {
+		removeComponent(entity, componentId<T>());
+	}
+
+	void
+	addComponent(Entity entity, unsigned int typeId, const void* data, unsigned int size);
+
+	void
+	removeComponent(Entity entity, unsigned int typeId);
+
+	// Aplica los comandos en el orden en que se grabaron y vacia el buffer
+	void
+	playback(EntityWorld& world);
+
+	void
+	clear();
+
+	bool
+	empty() const { return m_commands.empty(); }
+
+private:
+	enum CommandType {
+		COMMAND_CREATE,
+		COMMAND_DESTROY,
+		COMMAND_ADD,
+		COMMAND_REMOVE
+	};
+
+	struct
+	Command {
+		CommandType type;
+		Entity entity;
+		unsigned int typeId;
+		unsigned int dataOffset;
+		unsigned int dataSize;
+	};
+
+	// Las entidades provisionales llevan este bit en el indice
+	static const unsigned int PENDING_BIT = 0x80000000;
+
+	Entity
+	resolve(Entity entity, const std::vector<Entity>& created) const;
+
+private:
+	std::vector<Command> m_commands;
+	std::vector<unsigned char> m_data;
+	unsigned int m_pendingCount = 0;
+};
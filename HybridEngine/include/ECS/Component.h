@@ -0,0 +1,61 @@
+#pragma once
+#include "Prerequisites.h"
+#include <mutex>
+#include <typeinfo>
+
+// Firma de un archetype: un bit por tipo de componente
+typedef unsigned long long ComponentMask;
+const unsigned int MAX_COMPONENT_TYPES = 64;
+
+struct
+ComponentInfo {
+	unsigned int size;
+	unsigned int alignment;
+	const char* name;
+};
+
+/**
+ * @brief Registro global de tipos de componente.
+ *
+ * Los componentes son datos planos (trivialmente copiables): los chunks los
+ * mueven con memcpy y nunca llaman constructores, destructores ni metodos
+ * virtuales. Toda la logica vive en los sistemas que iteran las queries.
+ */
+class
+ComponentRegistry {
+public:
+	static unsigned int
+	registerType(unsigned int size, unsigned int alignment, const char* name);
+
+	static const ComponentInfo&
+	getInfo(unsigned int typeId);
+
+	static unsigned int
+	getTypeCount();
+};
+
+// Id del tipo T; se registra la primera vez que se pide
+template<typename T>
+unsigned int
+componentId() {
+	static const unsigned int id = ComponentRegistry::registerType(sizeof(T), alignof(T), typeid(T).name());
+	return id;
+}
+
+template<typename T>
+ComponentMask
+componentMask() {
+	return 1ull << componentId<T>();
+}
+
+// Mascara con todos los tipos de un pack
+template<typename... T>
+ComponentMask
+makeComponentMask() {
+	ComponentMask masks[] = { 0ull, componentMask<T>()... };
+	ComponentMask mask = 0;
+	for (unsigned int i = 0; i < sizeof(masks) / sizeof(masks[0]); ++i) {
+		mask |= masks[i];
+	}
+	return mask;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "Prerequisites.h"
+#include "SceneGraph.h"
+#include "Bounds.h"
+
+class Buffer;
+class MeshComponent;
+struct MeshLOD;
+
+// Componentes del motor. Son datos planos: la logica vive en los sistemas
+// que los recorren con EntityWorld::forEachChunk.
+
+struct
+TransformComponent {
+	XMFLOAT3 position;
+	XMFLOAT4 rotation;
+	XMFLOAT3 scale;
+};
+
+struct
+VelocityComponent {
+	XMFLOAT3 linear;
+	float angular;   // Radianes por segundo alrededor de Y
+};
+
+// Enlaza la entidad con su nodo en el SceneGraph
+struct
+SceneNodeComponent {
+	SceneNodeId node;
+};
+
+// Volumen envolvente de la malla en espacio local
+struct
+BoundsComponent {
+	Bounds local;
+};
+
+// Malla que se rasteriza en el OcclusionCuller; puede ser una version
+// simplificada de la que se dibuja
+struct
+OccluderComponent {
+	const MeshComponent* mesh;
+};
+
+// La malla proyecta sombras planas con este color (alpha = opacidad)
+struct
+ShadowCasterComponent {
+	XMFLOAT4 color;
+};
+
+// Geometria que se envia a la RenderQueue
+struct
+MeshRendererComponent {
+	const MeshComponent* mesh;
+	Buffer* vertexBuffer;
+	Buffer* indexBuffer;
+	unsigned int object;                 // Indice en FramePacket::objects
+	const std::vector<MeshLOD>* lods;    // Rangos de m_index por nivel; nullptr = un solo nivel
+};
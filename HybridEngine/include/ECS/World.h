@@ -0,0 +1,152 @@
+#pragma once
+#include "ECS/Archetype.h"
+#include "JobSystem.h"
+#include <unordered_map>
+#include <mutex>
+
+/**
+ * @brief Contenedor de entidades agrupadas por archetype.
+ *
+ * Una entidad es un indice mas una generacion; su registro dice en que
+ * archetype, chunk y fila viven sus componentes. Agregar o quitar un
+ * componente mueve la entidad a otro archetype (cambio estructural), asi que
+ * durante una iteracion paralela esos cambios se difieren con un
+ * EntityCommandBuffer.
+ */
+class
+EntityWorld {
+public:
+	EntityWorld();
+	~EntityWorld();
+
+	Entity
+	create();
+
+	void
+	destroyEntity(Entity entity);
+
+	bool
+	isAlive(Entity entity) const;
+
+	// Versiones sin tipo; data puede ser nullptr (componente en cero)
+	void*
+	addComponent(Entity entity, unsigned int typeId, const void* data);
+
+	void
+	removeComponent(Entity entity, unsigned int typeId);
+
+	void*
+	getComponent(Entity entity, unsigned int typeId) const;
+
+	template<typename T>
+	T*
+	add(Entity entity, const T& value = T()) {
+		return static_cast<T*>(addComponent(entity, componentId<T>(), &value));
+	}
+
+	template<typename T>
+	void
+	remove(Entity entity) {
+		removeComponent(entity, componentId<T>());
+	}
+
+	template<typename T>
+	T*
+	get(Entity entity) const {
+		return static_cast<T*>(getComponent(entity, componentId<T>()));
+	}
+
+	template<typename T>
+	bool
+	has(Entity entity) const {
+		return getComponent(entity, componentId<T>()) != nullptr;
+	}
+
+	/**
+	 * Llama f(count, entities, T*...) una vez por chunk de cada archetype que
+	 * contenga todos los tipos T. Los punteros apuntan al inicio de cada arreglo
+	 * del chunk, asi que el cuerpo es un bucle plano sobre [0, count).
+	 */
+	template<typename... T, typename F>
+	void
+	forEachChunk(F f) {
+		const std::vector<Archetype*>& matches = query(makeComponentMask<T...>());
+		for (size_t a = 0; a < matches.size(); ++a) {
+			Archetype* archetype = matches[a];
+			const std::vector<ArchetypeChunk>& chunks = archetype->getChunks();
+			for (size_t c = 0; c < chunks.size(); ++c) {
+				f(chunks[c].count,
+					archetype->getEntities(chunks[c]),
+					static_cast<T*>(archetype->getArray(chunks[c], componentId<T>()))...);
+			}
+		}
+	}
+
+	// Igual que forEachChunk pero repartiendo los chunks entre los workers.
+	// f no debe hacer cambios estructurales; para eso usar un EntityCommandBuffer.
+	template<typename... T, typename F>
+	void
+	forEachChunkParallel(JobSystem& jobs, F f) {
+		const std::vector<Archetype*>& matches = query(makeComponentMask<T...>());
+		std::vector<std::pair<Archetype*, const ArchetypeChunk*>> work;
+		for (size_t a = 0; a < matches.size(); ++a) {
+			const std::vector<ArchetypeChunk>& chunks = matches[a]->getChunks();
+			for (size_t c = 0; c < chunks.size(); ++c) {
+				work.push_back(std::make_pair(matches[a], &chunks[c]));
+			}
+		}
+		jobs.parallelFor(static_cast<unsigned int>(work.size()), 1,
+										 [&](unsigned int begin, unsigned int end) {
+			for (unsigned int i = begin; i < end; ++i) {
+				Archetype* archetype = work[i].first;
+				const ArchetypeChunk& chunk = *work[i].second;
+				f(chunk.count,
+					archetype->getEntities(chunk),
+					static_cast<T*>(archetype->getArray(chunk, componentId<T>()))...);
+			}
+		});
+	}
+
+	unsigned int
+	getEntityCount() const { return m_aliveCount; }
+
+	unsigned int
+	getArchetypeCount() const { return static_cast<unsigned int>(m_archetypes.size()); }
+
+	void
+	destroy();
+
+private:
+	struct
+	EntityRecord {
+		Archetype* archetype;
+		unsigned int chunk;
+		unsigned int row;
+		unsigned int generation;
+	};
+
+	Archetype*
+	getOrCreateArchetype(ComponentMask mask);
+
+	// Mueve la entidad a otro archetype copiando los componentes compartidos
+	void
+	moveEntity(Entity entity, Archetype* target);
+
+	// Archetypes que contienen mask; la lista se cachea por mascara. Se puede
+	// llamar desde varios hilos mientras no haya cambios estructurales.
+	const std::vector<Archetype*>&
+	query(ComponentMask mask);
+
+	void
+	fixMovedRecord(Entity moved, unsigned int chunk, unsigned int row);
+
+private:
+	std::vector<EntityRecord> m_records;
+	std::vector<unsigned int> m_freeIndices;
+	unsigned int m_aliveCount = 0;
+
+	std::unordered_map<ComponentMask, Archetype*> m_archetypes;
+	std::unordered_map<ComponentMask, std::vector<Archetype*>> m_queryCache;
+	std::mutex m_queryLock;
+	Archetype* m_emptyArchetype = nullptr;
+};
@@ -0,0 +1,85 @@
+#pragma once
+#include "Prerequisites.h"
+#include <chrono>
+
+typedef unsigned int FileWatchId;
+
+const FileWatchId INVALID_FILE_WATCH = 0xffffffff;
+
+// Huella de un archivo para el sondeo: fecha de escritura y tamano
+struct
+FileStamp {
+	unsigned long long modified = 0;
+	unsigned long long size = 0;
+	bool exists = false;
+};
+
+struct
+FileWatchEntry {
+	std::string path;
+	std::string directory;   // Con la barra final; vacio = directorio actual
+	std::string name;
+	FileStamp stamp;
+	bool pending = false;
+	std::chrono::steady_clock::time_point changedAt;
+};
+
+/**
+ * @brief Avisa que archivos cambiaron desde la ultima llamada a poll().
+ *
+ * En Linux usa inotify sobre los directorios de los archivos (los editores
+ * suelen reemplazar el archivo con un rename); en el resto, o si inotify
+ * falla, compara cada pollIntervalMs la fecha de escritura y el tamano. Un
+ * cambio se reporta una sola vez y solo despues de settleMs sin nuevos
+ * eventos, para no leer un archivo a medio escribir.
+ */
+class
+FileWatcher {
+public:
+	FileWatcher()  = default;
+	~FileWatcher() { destroy(); }
+
+	FileWatcher(const FileWatcher&) = delete;
+	FileWatcher&
+	operator=(const FileWatcher&) = delete;
+
+	// native = false fuerza el sondeo
+	HRESULT
+	init(bool native = true, double pollIntervalMs = 250.0, double settleMs = 100.0);
+
+	void
+	destroy();
+
+	// Se puede vigilar un archivo que todavia no existe
+	FileWatchId
+	watch(const std::string& path);
+
+	// Agrega a changed los archivos que terminaron de cambiar; devuelve cuantos
+	unsigned int
+	poll(std::vector<FileWatchId>& changed);
+
+	const std::string&
+	getPath(FileWatchId id) const { return m_entries[id].path; }
+
+	bool
+	isNative() const { return m_inotify >= 0; }
+
+	static bool
+	readStamp(const std::string& path, FileStamp& stamp);
+
+private:
+	void
+	readNativeEvents();
+
+	void
+	scanStamps();
+
+private:
+	std::vector<FileWatchEntry> m_entries;
+	int m_inotify = -1;
+	std::vector<int> m_watchDescriptors;        // Paralelo a m_directories
+	std::vector<std::string> m_directories;
+	double m_pollIntervalMs = 250.0;
+	double m_settleMs = 100.0;
+	std::chrono::steady_clock::time_point m_lastScan;
+};
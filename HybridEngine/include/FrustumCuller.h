@@ -0,0 +1,71 @@
+#pragma once
+#include "Bounds.h"
+#include <vector>
+
+struct
+CullStats {
+	unsigned int tested = 0;
+	unsigned int visible = 0;
+};
+
+/**
+ * @brief Culling contra el frustum de la camara sobre bounds en formato SoA.
+ *
+ * Los bounds en espacio mundo se guardan en arreglos separados (centro,
+ * extensiones y radio) para probar 4 objetos por iteracion con SSE (8 con
+ * AVX). Un objeto queda fuera si su caja o su esfera esta por completo del
+ * lado negativo de algun plano; el radio efectivo por plano es el menor de
+ * los dos. cullScalar() es la referencia que debe dar el mismo resultado.
+ */
+class
+FrustumCuller {
+public:
+	FrustumCuller()  = default;
+	~FrustumCuller() = default;
+
+	void
+	init(unsigned int expectedCount);
+
+	// Extrae los 6 planos (normalizados, hacia adentro) de view * projection
+	void
+	setFrustum(const Float4x4& viewProjection);
+
+	// Agrega bounds en espacio mundo y devuelve su indice
+	unsigned int
+	add(const Bounds& worldBounds);
+
+	void
+	set(unsigned int index, const Bounds& worldBounds);
+
+	// Llena visible con los indices que pasan el culling (en orden creciente)
+	unsigned int
+	cull(std::vector<unsigned int>& visible);
+
+	unsigned int
+	cullScalar(std::vector<unsigned int>& visible) const;
+
+	void
+	clear();
+
+	unsigned int
+	size() const { return m_count; }
+
+	const CullStats&
+	getStats() const { return m_stats; }
+
+	// Plano i como (nx, ny, nz, d): dentro si dot(n, p) + d >= 0
+	const Float4&
+	getPlane(unsigned int i) const { return m_planes[i]; }
+
+private:
+	bool
+	isVisibleScalar(unsigned int index) const;
+
+private:
+	Float4 m_planes[6];
+	unsigned int m_count = 0;
+	std::vector<float> m_centerX, m_centerY, m_centerZ;
+	std::vector<float> m_extentX, m_extentY, m_extentZ;
+	std::vector<float> m_radius;
+	CullStats m_stats;
+};
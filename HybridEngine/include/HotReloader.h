@@ -0,0 +1,125 @@
+#pragma once
+#include "Prerequisites.h"
+#include "FileWatcher.h"
+#include "AsyncLoader.h"
+#include "MeshComponent.h"
+
+class Device;
+class JobSystem;
+class ShaderProgram;
+class Buffer;
+class HotReloader;
+
+enum
+HotReloadType {
+	HOT_RELOAD_SHADER = 0,
+	HOT_RELOAD_TEXTURE,
+	HOT_RELOAD_MESH
+};
+
+// Un objeto vivo y el archivo del que sale
+struct
+HotReloadAsset {
+	HotReloadType type;
+	std::string path;
+	FileWatchId watch;
+	ShaderProgram* shader;
+	ID3D11ShaderResourceView** texture;
+	MeshComponent* mesh;
+	Buffer* vertexBuffer;
+	Buffer* indexBuffer;
+	// Reload en curso
+	LoadTaskId task;
+	bool changedAgain;                        // Cambio otra vez mientras recargaba
+	ID3D11ShaderResourceView* stagedTexture;
+	MeshComponent stagedMesh;
+	HotReloader* reloader;
+};
+
+struct
+HotReloadStats {
+	unsigned int changes = 0;
+	unsigned int reloads = 0;
+	unsigned int failed = 0;
+	double lastSwapMs = 0.0;   // Tiempo del ultimo intercambio en el hilo que dibuja
+};
+
+/**
+ * @brief Recarga shaders, texturas y mallas cuando cambia su archivo.
+ *
+ * update() se llama una vez por frame antes de dibujar, en el hilo que
+ * dibuja. Los cambios que reporta el FileWatcher se lanzan como tareas de un
+ * AsyncLoader: la parte cara (compilar al cache, parsear la malla, decodificar
+ * la textura si el backend es free-threaded) corre en los workers y el
+ * intercambio del objeto vivo corre en un update() posterior, entre dos
+ * frames. Sin workers las dos partes corren en update(). Los punteros que
+ * guardan la escena (ShaderProgram*, Buffer*, el SRV) no cambian: se
+ * reemplaza su contenido. Si la recarga falla el objeto viejo sigue en uso.
+ */
+class
+HotReloader {
+public:
+	HotReloader()  = default;
+	~HotReloader() { destroy(); }
+
+	HotReloader(const HotReloader&) = delete;
+	HotReloader&
+	operator=(const HotReloader&) = delete;
+
+	HRESULT
+	init(Device& device, JobSystem& jobs, bool nativeWatch = true, double pollIntervalMs = 250.0);
+
+	// Espera las recargas en vuelo
+	void
+	destroy();
+
+	// Vigila el archivo de program (getFileName())
+	void
+	addShader(ShaderProgram& program);
+
+	void
+	addTexture(const std::string& path, ID3D11ShaderResourceView** view);
+
+	// OBJ o malla cocinada (.hmesh)
+	void
+	addMesh(const std::string& path, MeshComponent& mesh, Buffer& vertexBuffer, Buffer& indexBuffer);
+
+	// Limite de frame: lanza las recargas nuevas y aplica las terminadas.
+	// true si algun objeto cambio
+	bool
+	update();
+
+	bool
+	isBusy() const { return m_busy; }
+
+	const HotReloadStats&
+	getStats() const { return m_stats; }
+
+private:
+	void
+	add(HotReloadAsset* asset);
+
+	void
+	launch(HotReloadAsset& asset);
+
+	static HRESULT
+	reloadWork(void* data);
+
+	static HRESULT
+	reloadFinish(void* data);
+
+	// work y finish seguidos, para cuando no hay workers
+	static HRESULT
+	reloadInline(void* data);
+
+private:
+	Device* m_device = nullptr;
+	JobSystem* m_jobs = nullptr;
+	FileWatcher m_watcher;
+	AsyncLoader m_loader;
+	std::vector<HotReloadAsset*> m_assets;
+	std::vector<FileWatchId> m_changed;
+	bool m_busy = false;
+	unsigned int m_swapped = 0;   // Intercambios en el update() actual
+	HotReloadStats m_stats;
+};
@@ -15,6 +15,12 @@ public:
        std::vector<D3D11_INPUT_ELEMENT_DESC>& Layout, 
        ID3DBlob* VertexShaderData);
 
+  // Agrega los elementos por instancia (WORLD0..3 y COLOR0) leidos de un
+  // stream con el contenido de CBChangesEveryFrame en inputSlot
+  static void
+  appendInstanceElements(std::vector<D3D11_INPUT_ELEMENT_DESC>& Layout,
+                         unsigned int inputSlot = 1);
+
   void 
   update();
   
@@ -0,0 +1,249 @@
+#pragma once
+#include "Prerequisites.h"
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+class JobSystem;
+struct Job;
+
+typedef void (*JobFunction)(Job& job);
+
+/**
+ * @brief Contador de trabajos pendientes; sirve para esperar y para encadenar.
+ *
+ * Los jobs lanzados con dependencia sobre un contador quedan en espera y se
+ * encolan cuando el contador llega a cero.
+ */
+struct
+JobCounter {
+	std::atomic<int> value{ 0 };
+	std::mutex lock;
+	std::vector<Job*> continuations;
+
+	bool
+	isDone() const { return value.load(std::memory_order_acquire) == 0; }
+};
+
+// Un job ocupa una linea de cache para evitar false sharing entre workers
+struct alignas(64)
+Job {
+	JobFunction function;
+	void* data;
+	unsigned int begin;
+	unsigned int end;
+	unsigned int grain;
+	JobCounter* counter;
+	JobSystem* system;
+	std::atomic<int> live{ 0 };   // 1 desde allocateJob() hasta que termina
+	bool heap = false;             // Fuera del pool (pool lleno); se borra al terminar
+};
+
+/**
+ * @brief Deque Chase-Lev de capacidad fija.
+ *
+ * Solo el worker dueno hace push/pop por abajo (LIFO, caliente en cache);
+ * el resto roba por arriba (FIFO, los trabajos mas grandes).
+ */
+class
+WorkStealingQueue {
+public:
+	static const unsigned int CAPACITY = 4096;
+
+	WorkStealingQueue() : m_top(0), m_bottom(0) {}
+
+	// Devuelve false si la cola esta llena
+	bool
+	push(Job* job);
+
+	Job*
+	pop();
+
+	Job*
+	steal();
+
+	unsigned int
+	size() const;
+
+private:
+	std::atomic<long long> m_top;
+	char m_pad[64 - sizeof(std::atomic<long long>)];
+	std::atomic<long long> m_bottom;
+	std::atomic<Job*> m_jobs[CAPACITY];
+};
+
+struct
+JobWorkerStats {
+	unsigned long long executed = 0;
+	unsigned long long stolen = 0;
+	unsigned long long failedSteals = 0;
+	unsigned long long inlined = 0;  // Ejecutados al momento por cola llena
+	unsigned long long heapJobs = 0; // Pool lleno: el job se creo en el heap
+};
+
+/**
+ * @brief Sistema de jobs con un deque por worker y robo de trabajo.
+ *
+ * El hilo que llama init() es el worker 0 de este sistema (el mismo hilo
+ * puede ser el 0 de varios sistemas a la vez). Con mainThreadParticipates,
+ * wait() ejecuta jobs mientras espera; si no, solo cede el procesador.
+ * Los jobs salen de un pool circular por hilo; si el slot reciclado sigue
+ * vivo (mas de JOB_POOL_SIZE jobs pendientes en un hilo) el job se crea en
+ * el heap. Los hilos ajenos al sistema pueden lanzar jobs (pasan por una
+ * cola compartida) pero no ejecutan.
+ */
+class
+JobSystem {
+public:
+	static const unsigned int JOB_POOL_SIZE = 4096;
+	static const unsigned int AUTO_WORKERS = 0xffffffff;
+
+	JobSystem()  = default;
+	~JobSystem() { destroy(); }
+
+	// AUTO_WORKERS usa hardware_concurrency() - 1; 0 deja solo el hilo principal
+	void
+	init(unsigned int workerThreads = AUTO_WORKERS, bool mainThreadParticipates = true);
+
+	void
+	destroy();
+
+	// Lanza function(job) con el rango [begin, end). Si dependency no es nulo
+	// el job espera a que ese contador llegue a cero.
+	void
+	run(JobFunction function,
+			void* data,
+			JobCounter* counter,
+			unsigned int begin = 0,
+			unsigned int end = 0,
+			JobCounter* dependency = nullptr);
+
+	// Bloquea hasta que counter llegue a cero
+	void
+	wait(JobCounter& counter);
+
+	// Divide [0, count) en rangos de al menos grain elementos y llama
+	// body(begin, end) en paralelo. Retorna cuando todos terminaron.
+	template<typename Function>
+	void
+	parallelFor(unsigned int count, unsigned int grain, const Function& body);
+
+	unsigned int
+	getThreadCount() const { return static_cast<unsigned int>(m_queues.size()); }
+
+	// Indice del hilo actual dentro de este sistema (0 = principal); los
+	// hilos ajenos devuelven un indice >= getThreadCount()
+	unsigned int
+	getThreadIndex() const;
+
+	JobWorkerStats
+	getStats() const;
+
+	const JobWorkerStats&
+	getWorkerStats(unsigned int index) const { return m_stats[index]; }
+
+	// Ejecuta un job pendiente en el hilo que llama; false si no habia. Para
+	// bucles que esperan otra cosa ademas de un contador
+	bool
+	tryExecute() { return executeOne(); }
+
+	void
+	resetStats();
+
+private:
+	void
+	workerLoop(unsigned int index);
+
+	Job*
+	allocateJob();
+
+	void
+	submit(Job* job);
+
+	bool
+	executeOne();
+
+	void
+	execute(Job* job);
+
+	void
+	finish(Job* job);
+
+	// Devuelve el job al pool (o lo borra si salio del heap)
+	static void
+	release(Job* job);
+
+	template<typename Function>
+	static void
+	parallelForJob(Job& job);
+
+private:
+	std::vector<std::thread> m_threads;
+	std::vector<WorkStealingQueue*> m_queues;
+	std::vector<Job*> m_jobPools;
+	std::vector<unsigned int> m_jobPoolHeads;
+	std::vector<JobWorkerStats> m_stats;
+	// Jobs lanzados desde hilos que no pertenecen al sistema
+	std::vector<Job*> m_injected;
+	std::atomic<int> m_injectedCount{ 0 };
+	std::mutex m_injectLock;
+	std::atomic<bool> m_running{ false };
+	std::atomic<int> m_sleeping{ 0 };
+	std::mutex m_sleepLock;
+	std::condition_variable m_wakeUp;
+	bool m_mainThreadParticipates = true;
+	std::thread::id m_mainThread;   // El que llamo init()
+};
+
+template<typename Function>
+void
+JobSystem::parallelFor(unsigned int count, unsigned int grain, const Function& body) {
+	if (count == 0) {
+		return;
+	}
+	if (grain == 0) {
+		grain = 1;
+	}
+	if (count <= grain || m_queues.size() <= 1) {
+		body(0u, count);
+		return;
+	}
+	JobCounter counter;
+	Job* job = allocateJob();
+	job->function = &JobSystem::parallelForJob<Function>;
+	job->data = const_cast<Function*>(&body);
+	job->begin = 0;
+	job->end = count;
+	job->grain = grain;
+	job->counter = &counter;
+	job->system = this;
+	counter.value.fetch_add(1, std::memory_order_relaxed);
+	submit(job);
+	wait(counter);
+}
+
+template<typename Function>
+void
+JobSystem::parallelForJob(Job& job) {
+	JobSystem* system = job.system;
+	unsigned int begin = job.begin;
+	unsigned int end = job.end;
+
+	// Division binaria: la mitad derecha queda para que otro worker la robe
+	while (end - begin > job.grain) {
+		unsigned int middle = begin + (end - begin) / 2;
+		Job* right = system->allocateJob();
+		right->function = job.function;
+		right->data = job.data;
+		right->begin = middle;
+		right->end = end;
+		right->grain = job.grain;
+		right->counter = job.counter;
+		right->system = system;
+		job.counter->value.fetch_add(1, std::memory_order_relaxed);
+		system->submit(right);
+		end = middle;
+	}
+	(*static_cast<const Function*>(job.data))(begin, end);
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "Prerequisites.h"
+
+/**
+ * @brief Archivo de solo lectura proyectado en memoria.
+ *
+ * El sistema operativo trae las paginas bajo demanda, asi que los loaders
+ * leen el archivo como un arreglo sin copiarlo a un buffer propio. La vista
+ * es valida hasta close() o el destructor.
+ */
+class
+MappedFile {
+public:
+	MappedFile()  = default;
+	~MappedFile() { close(); }
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile&
+	operator=(const MappedFile&) = delete;
+
+	HRESULT
+	open(const std::string& path);
+
+	void
+	close();
+
+	const char*
+	data() const { return static_cast<const char*>(m_view); }
+
+	size_t
+	size() const { return m_size; }
+
+	bool
+	isOpen() const { return m_view != nullptr; }
+
+private:
+	HANDLE m_file = INVALID_HANDLE_VALUE;
+	HANDLE m_mapping = nullptr;
+	const void* m_view = nullptr;
+	size_t m_size = 0;
+};
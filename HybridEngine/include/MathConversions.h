@@ -0,0 +1,25 @@
+#pragma once
+#include "Prerequisites.h"
+#include "CullingMath.h"
+#include <cstring>
+
+// Conversiones entre XNA Math y los tipos planos de CullingMath.h
+
+inline Float3
+ToFloat3(const XMFLOAT3& v) {
+	return Float3(v.x, v.y, v.z);
+}
+
+inline XMVECTOR
+LoadFloat3(const Float3& v) {
+	return XMVectorSet(v.x, v.y, v.z, 0.0f);
+}
+
+inline Float4x4
+ToFloat4x4(const XMMATRIX& matrix) {
+	XMFLOAT4X4 stored;
+	XMStoreFloat4x4(&stored, matrix);
+	Float4x4 result;
+	memcpy(result.m, stored.m, sizeof(result.m));
+	return result;
+}
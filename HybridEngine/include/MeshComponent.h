@@ -1,32 +1,17 @@
 #pragma once
 #include "Prerequisites.h"
-//#include "ECS\Component.h"
-
-class DeviceContext;
 
+/**
+ * @brief Datos de geometria de una malla (vertices e indices en CPU).
+ *
+ * Solo guarda datos; el dibujo lo hace el sistema que recorre las entidades
+ * con MeshRendererComponent (ver ECS/Components.h).
+ */
 class
-  MeshComponent /*: public Component*/ {
+  MeshComponent {
 public:
-  MeshComponent() : m_numVertex(0), m_numIndex(0)/*, Component(ComponentType::MESH)*/ {}
-
-  virtual
-  ~MeshComponent() = default;
+  MeshComponent() : m_numVertex(0), m_numIndex(0) {}
 
-  /**
-   * @brief Actualiza el actor.
-   * @param deltaTime El tiempo transcurrido desde la ltima actualizacin.
-   * @param deviceContext Contexto del dispositivo para operaciones grficas.
-   */
-  void
-  update(float deltaTime) /*override*/ {}
-
-  /**
-   * @brief Renderiza el actor.
-   * @param deviceContext Contexto del dispositivo para operaciones grficas.
-   */
-  void
-  render(DeviceContext& deviceContext) /*override*/ {}
-public:
   std::string m_name;
   std::vector<SimpleVertex> m_vertex;
   std::vector<unsigned int> m_index;
@@ -0,0 +1,107 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Bounds.h"
+#include "MappedFile.h"
+
+class Device;
+class Buffer;
+class MeshComponent;
+
+const unsigned int MESH_FILE_MAGIC = 0x48534D48;   // "HMSH"
+const unsigned int MESH_FILE_VERSION = 1;
+const unsigned int MESH_FILE_ALIGNMENT = 64;       // Inicio de cada seccion
+
+// Rango de indices que se dibuja con un material
+struct
+MeshFileSubmesh {
+	unsigned int indexStart;
+	unsigned int indexCount;
+	unsigned int baseVertex;
+	unsigned int material;
+	Bounds bounds;
+};
+
+// Cabecera al inicio del archivo; los offsets son desde el inicio del archivo
+struct
+MeshFileHeader {
+	unsigned int magic;
+	unsigned int version;
+	unsigned int headerSize;
+	unsigned int alignment;
+	unsigned int vertexCount;
+	unsigned int vertexStride;
+	unsigned int indexCount;
+	unsigned int indexStride;
+	unsigned int submeshCount;
+	unsigned int reserved;
+	unsigned long long vertexOffset;
+	unsigned long long indexOffset;
+	unsigned long long submeshOffset;
+	unsigned long long fileSize;
+	Bounds bounds;
+};
+
+/**
+ * @brief Malla cocinada en binario que se lee proyectada en memoria.
+ *
+ * Las secciones (vertices, indices, submeshes) estan alineadas a
+ * MESH_FILE_ALIGNMENT y guardan exactamente el formato de los buffers de GPU,
+ * asi que createBuffers() pasa los punteros de la vista como pSysMem sin
+ * copias intermedias. Los indices se guardan en 16 bits cuando caben. Cargar una malla cuesta abrir el archivo y validar la
+ * cabecera; el resto es I/O que el sistema hace bajo demanda.
+ */
+class
+MeshFile {
+public:
+	MeshFile()  = default;
+	~MeshFile() = default;
+
+	// Escribe mesh como archivo cocinado. Sin submeshes se escribe uno que
+	// cubre todos los indices.
+	static HRESULT
+	write(const std::string& path,
+				const MeshComponent& mesh,
+				const MeshFileSubmesh* submeshes = nullptr,
+				unsigned int submeshCount = 0);
+
+	HRESULT
+	open(const std::string& path);
+
+	void
+	close();
+
+	// Crea los buffers inmutables leyendo directo de la vista
+	HRESULT
+	createBuffers(Device& device, Buffer& vertexBuffer, Buffer& indexBuffer) const;
+
+	// Copia a un MeshComponent (para herramientas o procesos en CPU)
+	void
+	toMesh(MeshComponent& mesh) const;
+
+	const MeshFileHeader&
+	getHeader() const { return *m_header; }
+
+	const SimpleVertex*
+	getVertices() const;
+
+	// 16 o 32 bits segun getHeader().indexStride
+	const void*
+	getIndices() const;
+
+	unsigned int
+	getIndex(unsigned int i) const;
+
+	const MeshFileSubmesh*
+	getSubmeshes() const;
+
+	bool
+	isOpen() const { return m_header != nullptr; }
+
+	// Valida que data contenga un archivo completo y consistente
+	static bool
+	validate(const void* data, size_t size);
+
+private:
+	MappedFile m_file;
+	const MeshFileHeader* m_header = nullptr;
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include "Prerequisites.h"
+
+class MeshComponent;
+struct MeshFileSubmesh;
+
+// Metricas de una lista de triangulos
+struct
+MeshOptimizationMetrics {
+	float acmr = 0.0f;       // Fallos de cache por triangulo (ideal ~0.5, peor 3)
+	float atvr = 0.0f;       // Fallos de cache por vertice (ideal 1)
+	float overdraw = 0.0f;   // Pixeles sombreados / pixeles cubiertos (ideal 1)
+};
+
+// Tamano de la cache FIFO post-transform que se simula al medir
+const unsigned int MESH_CACHE_SIZE = 16;
+
+/**
+ * Reordena los triangulos para la cache de vertices post-transform
+ * (algoritmo lineal de Tom Forsyth). Solo cambia el orden de m_index.
+ */
+void
+OptimizeVertexCache(MeshComponent& mesh);
+
+/**
+ * Reordena grupos de triangulos para reducir overdraw sin perder mas de
+ * threshold veces el ACMR actual. Corta la lista (ya optimizada para cache)
+ * en clusters y los ordena de afuera hacia adentro segun su normal.
+ */
+void
+OptimizeOverdraw(MeshComponent& mesh, float threshold = 1.05f);
+
+// Reordena m_vertex por primer uso y remapea m_index; quita vertices sin usar
+void
+OptimizeVertexFetch(MeshComponent& mesh);
+
+// Las tres pasadas en orden: cache, overdraw, fetch
+void
+OptimizeMesh(MeshComponent& mesh, float overdrawThreshold = 1.05f);
+
+/**
+ * Corta la malla en submeshes de hasta 65536 vertices cada uno para que sus
+ * indices quepan en 16 bits. Los vertices de cada submesh quedan contiguos
+ * (se duplican los compartidos en un corte) y m_index pasa a ser relativo al
+ * baseVertex de su submesh, asi que hay que dibujar por submesh. Mallas que
+ * ya caben quedan intactas con un solo submesh.
+ */
+void
+SplitMeshFor16BitIndices(MeshComponent& mesh, std::vector<MeshFileSubmesh>& submeshes);
+
+// ACMR/ATVR con una FIFO de MESH_CACHE_SIZE y overdraw rasterizando en CPU
+// desde los 6 ejes (con culling de caras traseras, horario = frente)
+MeshOptimizationMetrics
+AnalyzeMesh(const MeshComponent& mesh);
@@ -0,0 +1,61 @@
+#pragma once
+#include "Prerequisites.h"
+
+class MeshComponent;
+struct Bounds;
+
+struct
+MeshSimplifyOptions {
+	float uvWeight = 1.0f;      // Peso de las UV frente a la posicion (normalizada a la caja unitaria)
+	bool lockBorders = true;    // Los bordes abiertos no se mueven
+	float maxError = 1e30f;     // Error maximo permitido, en unidades de la malla
+};
+
+// Rango de indices de un nivel de detalle dentro de MeshComponent::m_index
+struct
+MeshLOD {
+	unsigned int indexStart;
+	unsigned int indexCount;
+	float error;              // Desviacion estimada respecto al nivel 0 (unidades de la malla)
+};
+
+/**
+ * Simplifica indices (triangulos sobre mesh.m_vertex) hasta targetIndexCount
+ * colapsando aristas con cuadricas de error 5D (posicion + UV). Cada colapso
+ * mueve un vertice sobre uno existente, asi que m_vertex no cambia y todos
+ * los niveles comparten el vertex buffer. Las costuras de UV se colapsan en
+ * pareja a lo largo de la costura; los vertices que no son variedad quedan
+ * fijos. Devuelve el error del peor colapso, en unidades de la malla.
+ */
+float
+SimplifyMesh(const MeshComponent& mesh,
+						 std::vector<unsigned int>& indices,
+						 unsigned int targetIndexCount,
+						 const MeshSimplifyOptions& options = MeshSimplifyOptions());
+
+/**
+ * Genera una cadena de LODs: el nivel 0 es m_index original y el nivel i
+ * simplifica el anterior hasta ratios[i - 1] de los triangulos originales.
+ * Los niveles se agregan al final de mesh.m_index; la cadena se corta cuando
+ * un nivel ya no reduce triangulos o supera options.maxError.
+ */
+void
+GenerateMeshLODs(MeshComponent& mesh,
+								 const float* ratios,
+								 unsigned int ratioCount,
+								 std::vector<MeshLOD>& lods,
+								 const MeshSimplifyOptions& options = MeshSimplifyOptions());
+
+// Fraccion de la altura del viewport que cubre la esfera de bounds (en mundo)
+float
+ProjectedScreenSize(const Bounds& worldBounds, const XMMATRIX& view, const XMMATRIX& projection);
+
+// Nivel mas simple cuyo error proyectado no supera maxPixelError pixeles.
+// El error de los niveles se toma en unidades de mundo (mallas sin escala)
+unsigned int
+SelectMeshLOD(const std::vector<MeshLOD>& lods,
+							const Bounds& worldBounds,
+							const XMMATRIX& view,
+							const XMMATRIX& projection,
+							float viewportHeight,
+							float maxPixelError = 1.0f);
@@ -0,0 +1,63 @@
+#pragma once
+#include "Prerequisites.h"
+
+class MeshComponent;
+
+// Limites por meshlet (los de mesh shaders: 64 vertices y 124 triangulos
+// caben en un grupo de 128 hilos con los indices locales en 8 bits)
+const unsigned int MESHLET_MAX_VERTICES = 64;
+const unsigned int MESHLET_MAX_TRIANGLES = 124;
+
+struct
+Meshlet {
+	unsigned int vertexOffset;     // En MeshletData::vertices
+	unsigned int triangleOffset;   // En MeshletData::triangles (3 bytes por triangulo)
+	unsigned int vertexCount;
+	unsigned int triangleCount;
+};
+
+/**
+ * @brief Malla partida en clusters pequenos con su volumen y cono de normales.
+ *
+ * vertices guarda, por meshlet, los indices al vertex buffer original y
+ * triangles los indices locales (0..63) a esa lista. Los bounds estan en SoA
+ * y en espacio local para que MeshletCuller pruebe 4 meshlets por iteracion:
+ * esfera (center, radius) y cono (axis, cutoff). Un meshlet mira por completo
+ * hacia atras si dot(center - camara, axis) >= cutoff * |center - camara| + radius;
+ * cutoff = 1 marca un cono degenerado que nunca se descarta.
+ */
+struct
+MeshletData {
+	std::vector<Meshlet> meshlets;
+	std::vector<unsigned int> vertices;
+	std::vector<unsigned char> triangles;
+
+	std::vector<float> centerX, centerY, centerZ, radius;
+	std::vector<float> axisX, axisY, axisZ, cutoff;
+
+	unsigned int
+	size() const { return static_cast<unsigned int>(meshlets.size()); }
+
+	void
+	clear();
+};
+
+/**
+ * Agrupa los triangulos [indexStart, indexStart + indexCount) de mesh.m_index
+ * en meshlets. Crece cada cluster por adyacencia eligiendo el triangulo que
+ * agrega menos vertices nuevos; coneWeight (0..1) favorece ademas triangulos
+ * alineados con la normal del cluster para que los conos sean mas cerrados.
+ * Conviene pasar la malla ya optimizada para cache (OptimizeVertexCache).
+ */
+void
+BuildMeshlets(const MeshComponent& mesh,
+							unsigned int indexStart,
+							unsigned int indexCount,
+							MeshletData& out,
+							float coneWeight = 0.25f,
+							unsigned int maxVertices = MESHLET_MAX_VERTICES,
+							unsigned int maxTriangles = MESHLET_MAX_TRIANGLES);
+
+// Todos los triangulos de m_index
+void
+BuildMeshlets(const MeshComponent& mesh, MeshletData& out, float coneWeight = 0.25f);
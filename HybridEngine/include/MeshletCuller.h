@@ -0,0 +1,65 @@
+#pragma once
+#include "Prerequisites.h"
+
+struct MeshletData;
+
+struct
+MeshletCullStats {
+	unsigned int tested = 0;
+	unsigned int frustumCulled = 0;
+	unsigned int coneCulled = 0;
+	unsigned int visible = 0;
+	unsigned int triangles = 0;   // Triangulos escritos en el ultimo cull()
+};
+
+/**
+ * @brief Culling por meshlet en CPU: frustum contra la esfera y backface
+ * contra el cono de normales.
+ *
+ * setView() lleva el frustum y la camara al espacio local del objeto
+ * (planos de world * viewProjection, camara por la inversa de world), asi
+ * los bounds de MeshletData se prueban sin transformarlos. Las dos pruebas
+ * son invariantes ante transformaciones afines, escalas no uniformes
+ * incluidas. cull() escribe la lista de indices compactada (al vertex
+ * buffer original) con los triangulos de los meshlets visibles, lista para
+ * subir a un index buffer dinamico.
+ */
+class
+MeshletCuller {
+public:
+	MeshletCuller()  = default;
+	~MeshletCuller() = default;
+
+	void
+	setView(const XMMATRIX& world, const XMMATRIX& viewProjection, const XMFLOAT3& cameraPosition);
+
+	// Indices de los meshlets visibles (SSE, 4 por iteracion)
+	unsigned int
+	cullMeshlets(const MeshletData& data, std::vector<unsigned int>& visible);
+
+	// Referencia escalar; debe coincidir con cullMeshlets()
+	unsigned int
+	cullMeshletsScalar(const MeshletData& data, std::vector<unsigned int>& visible);
+
+	// cullMeshlets() y luego los triangulos visibles en indices
+	unsigned int
+	cull(const MeshletData& data, std::vector<unsigned int>& indices);
+
+	// Agrega a indices los triangulos de los meshlets en visible
+	static void
+	writeIndices(const MeshletData& data, const std::vector<unsigned int>& visible, std::vector<unsigned int>& indices);
+
+	const MeshletCullStats&
+	getStats() const { return m_stats; }
+
+private:
+	// 0 visible, 1 fuera del frustum, 2 de espaldas
+	int
+	testScalar(const MeshletData& data, unsigned int index) const;
+
+private:
+	XMFLOAT4 m_planes[6];           // Espacio local, normalizados, hacia adentro
+	XMFLOAT3 m_camera;              // Espacio local
+	std::vector<unsigned int> m_visible;
+	MeshletCullStats m_stats;
+};
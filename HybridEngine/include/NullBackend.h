@@ -0,0 +1,316 @@
+#pragma once
+#include "RenderBackend.h"
+#include <chrono>
+
+// Operaciones que registra el backend nulo
+enum
+RenderOp {
+	OP_CREATE_BUFFER = 0,
+	OP_CREATE_TEXTURE2D,
+	OP_CREATE_SHADER_RESOURCE_VIEW,
+	OP_CREATE_RENDER_TARGET_VIEW,
+	OP_CREATE_DEPTH_STENCIL_VIEW,
+	OP_CREATE_VERTEX_SHADER,
+	OP_CREATE_PIXEL_SHADER,
+	OP_CREATE_INPUT_LAYOUT,
+	OP_CREATE_SAMPLER_STATE,
+	OP_CREATE_BLEND_STATE,
+	OP_CREATE_DEPTH_STENCIL_STATE,
+	OP_CREATE_RASTERIZER_STATE,
+	OP_IA_SET_INPUT_LAYOUT,
+	OP_IA_SET_VERTEX_BUFFERS,
+	OP_IA_SET_INDEX_BUFFER,
+	OP_IA_SET_PRIMITIVE_TOPOLOGY,
+	OP_VS_SET_SHADER,
+	OP_PS_SET_SHADER,
+	OP_VS_SET_CONSTANT_BUFFERS,
+	OP_PS_SET_CONSTANT_BUFFERS,
+	OP_PS_SET_SHADER_RESOURCES,
+	OP_PS_SET_SAMPLERS,
+	OP_OM_SET_RENDER_TARGETS,
+	OP_OM_SET_BLEND_STATE,
+	OP_OM_SET_DEPTH_STENCIL_STATE,
+	OP_RS_SET_VIEWPORTS,
+	OP_RS_SET_STATE,
+	OP_CLEAR_RENDER_TARGET_VIEW,
+	OP_CLEAR_DEPTH_STENCIL_VIEW,
+	OP_UPDATE_SUBRESOURCE,
+	OP_MAP,
+	OP_UNMAP,
+	OP_DRAW_INDEXED,
+	OP_DRAW_INDEXED_INSTANCED,
+	OP_CLEAR_STATE,
+	OP_PRESENT,
+	OP_COUNT
+};
+
+// Entrada compacta del log de comandos (24 bytes en x64)
+struct
+RenderCommand {
+	unsigned short op;      // RenderOp
+	unsigned short slot;    // StartSlot / flags
+	unsigned int count;     // NumBuffers, IndexCount, ByteWidth...
+	const void* handle;     // Objeto creado o enlazado
+	long long cpuNs;        // Tiempo de CPU del motor desde el comando anterior
+};
+
+struct
+RenderOpStats {
+	unsigned long long calls = 0;
+	long long cpuNs = 0;
+};
+
+struct
+NullFrameStats {
+	unsigned int frame = 0;
+	unsigned int commands = 0;
+	unsigned int draws = 0;
+	unsigned int instances = 0;      // Instancias de los draws instanciados
+	unsigned long long indices = 0;
+	long long cpuNs = 0;
+};
+
+/**
+ * @brief Backend sin GPU que registra cada llamada en un log de comandos.
+ *
+ * Los recursos creados son objetos IUnknown minimos: el motor solo llama
+ * Release() sobre ellos, el resto pasa por el backend. Los buffers guardan
+ * una copia en CPU de su contenido para poder inspeccionarlo en pruebas.
+ * Present() cierra el frame y acumula sus estadisticas.
+ */
+class
+NullBackend : public RenderBackend {
+public:
+	NullBackend()  = default;
+	~NullBackend() = default;
+
+	void
+	init(bool recordCommands = true);
+
+	void
+	destroy();
+
+	const char*
+	getName() const override { return "Null"; }
+
+	// Limpia el log y las estadisticas
+	void
+	reset();
+
+	const std::vector<RenderCommand>&
+	getCommands() const { return m_commands; }
+
+	const RenderOpStats&
+	getOpStats(RenderOp op) const { return m_opStats[op]; }
+
+	const std::vector<NullFrameStats>&
+	getFrameStats() const { return m_frameStats; }
+
+	// Resumen legible por operacion y por frame
+	std::string
+	summary() const;
+
+	// Contenido en CPU de un buffer creado por este backend
+	static unsigned char*
+	getBufferData(ID3D11Resource* pResource, unsigned int* pByteWidth = nullptr);
+
+	static const char*
+	getOpName(RenderOp op);
+
+	HRESULT
+	CreateBuffer(const D3D11_BUFFER_DESC* pDesc,
+							 const D3D11_SUBRESOURCE_DATA* pInitialData,
+							 ID3D11Buffer** ppBuffer) override;
+
+	HRESULT
+	CreateTexture2D(const D3D11_TEXTURE2D_DESC* pDesc,
+									const D3D11_SUBRESOURCE_DATA* pInitialData,
+									ID3D11Texture2D** ppTexture2D) override;
+
+	HRESULT
+	CreateShaderResourceView(ID3D11Resource* pResource,
+													 const D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc,
+													 ID3D11ShaderResourceView** ppSRView) override;
+
+	HRESULT
+	CreateShaderResourceViewFromFile(const std::string& fileName,
+																	 ID3D11ShaderResourceView** ppSRView) override;
+
+	HRESULT
+	CreateRenderTargetView(ID3D11Resource* pResource,
+												 const D3D11_RENDER_TARGET_VIEW_DESC* pDesc,
+												 ID3D11RenderTargetView** ppRTView) override;
+
+	HRESULT
+	CreateDepthStencilView(ID3D11Resource* pResource,
+												 const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc,
+												 ID3D11DepthStencilView** ppDepthStencilView) override;
+
+	HRESULT
+	CreateVertexShader(const void* pShaderBytecode,
+										 unsigned int BytecodeLength,
+										 ID3D11ClassLinkage* pClassLinkage,
+										 ID3D11VertexShader** ppVertexShader) override;
+
+	HRESULT
+	CreatePixelShader(const void* pShaderBytecode,
+										unsigned int BytecodeLength,
+										ID3D11ClassLinkage* pClassLinkage,
+										ID3D11PixelShader** ppPixelShader) override;
+
+	HRESULT
+	CreateInputLayout(const D3D11_INPUT_ELEMENT_DESC* pInputElementDescs,
+										unsigned int NumElements,
+										const void* pShaderBytecodeWithInputSignature,
+										unsigned int BytecodeLength,
+										ID3D11InputLayout** ppInputLayout) override;
+
+	HRESULT
+	CreateSamplerState(const D3D11_SAMPLER_DESC* pSamplerDesc,
+										 ID3D11SamplerState** ppSamplerState) override;
+
+	HRESULT
+	CreateBlendState(const D3D11_BLEND_DESC* pBlendStateDesc,
+									 ID3D11BlendState** ppBlendState) override;
+
+	HRESULT
+	CreateDepthStencilState(const D3D11_DEPTH_STENCIL_DESC* pDepthStencilDesc,
+													ID3D11DepthStencilState** ppDepthStencilState) override;
+
+	HRESULT
+	CreateRasterizerState(const D3D11_RASTERIZER_DESC* pRasterizerDesc,
+												ID3D11RasterizerState** ppRasterizerState) override;
+
+	void
+	IASetInputLayout(ID3D11InputLayout* pInputLayout) override;
+
+	void
+	IASetVertexBuffers(unsigned int StartSlot,
+										 unsigned int NumBuffers,
+										 ID3D11Buffer* const* ppVertexBuffers,
+										 const unsigned int* pStrides,
+										 const unsigned int* pOffsets) override;
+
+	void
+	IASetIndexBuffer(ID3D11Buffer* pIndexBuffer,
+									 DXGI_FORMAT Format,
+									 unsigned int Offset) override;
+
+	void
+	IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology) override;
+
+	void
+	VSSetShader(ID3D11VertexShader* pVertexShader,
+							ID3D11ClassInstance* const* ppClassInstances,
+							unsigned int NumClassInstances) override;
+
+	void
+	PSSetShader(ID3D11PixelShader* pPixelShader,
+							ID3D11ClassInstance* const* ppClassInstances,
+							unsigned int NumClassInstances) override;
+
+	void
+	VSSetConstantBuffers(unsigned int StartSlot,
+											 unsigned int NumBuffers,
+											 ID3D11Buffer* const* ppConstantBuffers) override;
+
+	void
+	PSSetConstantBuffers(unsigned int StartSlot,
+											 unsigned int NumBuffers,
+											 ID3D11Buffer* const* ppConstantBuffers) override;
+
+	void
+	PSSetShaderResources(unsigned int StartSlot,
+											 unsigned int NumViews,
+											 ID3D11ShaderResourceView* const* ppShaderResourceViews) override;
+
+	void
+	PSSetSamplers(unsigned int StartSlot,
+								unsigned int NumSamplers,
+								ID3D11SamplerState* const* ppSamplers) override;
+
+	void
+	OMSetRenderTargets(unsigned int NumViews,
+										 ID3D11RenderTargetView* const* ppRenderTargetViews,
+										 ID3D11DepthStencilView* pDepthStencilView) override;
+
+	void
+	OMSetBlendState(ID3D11BlendState* pBlendState,
+									const float BlendFactor[4],
+									unsigned int SampleMask) override;
+
+	void
+	OMSetDepthStencilState(ID3D11DepthStencilState* pDepthStencilState,
+												 unsigned int StencilRef) override;
+
+	void
+	RSSetViewports(unsigned int NumViewports, const D3D11_VIEWPORT* pViewports) override;
+
+	void
+	RSSetState(ID3D11RasterizerState* pRasterizerState) override;
+
+	void
+	ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView,
+												const float ColorRGBA[4]) override;
+
+	void
+	ClearDepthStencilView(ID3D11DepthStencilView* pDepthStencilView,
+												unsigned int ClearFlags,
+												float Depth,
+												UINT8 Stencil) override;
+
+	void
+	UpdateSubresource(ID3D11Resource* pDstResource,
+										unsigned int DstSubresource,
+										const D3D11_BOX* pDstBox,
+										const void* pSrcData,
+										unsigned int SrcRowPitch,
+										unsigned int SrcDepthPitch) override;
+
+	HRESULT
+	Map(ID3D11Resource* pResource,
+			unsigned int Subresource,
+			D3D11_MAP MapType,
+			unsigned int MapFlags,
+			D3D11_MAPPED_SUBRESOURCE* pMappedResource) override;
+
+	void
+	Unmap(ID3D11Resource* pResource, unsigned int Subresource) override;
+
+	void
+	DrawIndexed(unsigned int IndexCount,
+							unsigned int StartIndexLocation,
+							int BaseVertexLocation) override;
+
+	void
+	DrawIndexedInstanced(unsigned int IndexCountPerInstance,
+											 unsigned int InstanceCount,
+											 unsigned int StartIndexLocation,
+											 int BaseVertexLocation,
+											 unsigned int StartInstanceLocation) override;
+
+	void
+	ClearState() override;
+
+	HRESULT
+	Present(IDXGISwapChain* pSwapChain, unsigned int SyncInterval, unsigned int Flags) override;
+
+private:
+	void
+	record(RenderOp op, const void* handle, unsigned int slot = 0, unsigned int count = 0);
+
+	// Crea un objeto nulo con byteWidth bytes de almacenamiento en CPU
+	template<typename T> HRESULT
+	createObject(RenderOp op, unsigned int byteWidth, const void* initialData, T** ppObject);
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	bool m_recordCommands = true;
+	std::vector<RenderCommand> m_commands;
+	RenderOpStats m_opStats[OP_COUNT];
+	std::vector<NullFrameStats> m_frameStats;
+	NullFrameStats m_currentFrame;
+	Clock::time_point m_lastTick;
+	Clock::time_point m_frameStart;
+};
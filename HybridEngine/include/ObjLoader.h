@@ -0,0 +1,83 @@
+#pragma once
+#include "Prerequisites.h"
+
+class MeshComponent;
+class JobSystem;
+
+struct
+ObjLoadStats {
+	size_t bytes = 0;
+	unsigned int chunks = 0;
+	unsigned int positions = 0;
+	unsigned int texcoords = 0;
+	unsigned int normals = 0;
+	unsigned int triangles = 0;
+	unsigned int vertices = 0;   // Vertices unicos despues de deduplicar
+	double mapMs = 0.0;
+	double parseMs = 0.0;        // Etapa paralela
+	double mergeMs = 0.0;        // Union de chunks y deduplicacion
+};
+
+/**
+ * @brief Loader de Wavefront OBJ que parsea en paralelo.
+ *
+ * El archivo se proyecta en memoria y se corta en chunks alineados a fin de
+ * linea; cada chunk se parsea en un job del JobSystem con un parser de
+ * numeros propio (sin streams ni locale). Luego los chunks se unen, los
+ * indices relativos se resuelven y las tuplas v/vt se deduplican con una
+ * tabla hash para llenar MeshComponent::m_vertex/m_index.
+ *
+ * SimpleVertex no guarda normales, asi que vn se cuenta pero no forma parte
+ * de la clave. Los poligonos se triangulan en abanico y se convierte de mano
+ * derecha (OBJ) a mano izquierda (D3D): z y el orden de los indices se
+ * invierten y v pasa a 1 - v. Solo se leen v, vt, vn y f.
+ */
+class
+ObjLoader {
+public:
+	static const size_t CHUNK_SIZE = 1 << 20;
+
+	ObjLoader()  = default;
+	~ObjLoader() = default;
+
+	// jobs nulo parsea en el hilo que llama
+	HRESULT
+	load(const std::string& path, MeshComponent& mesh, JobSystem* jobs = nullptr);
+
+	HRESULT
+	parse(const char* data, size_t size, MeshComponent& mesh, JobSystem* jobs = nullptr);
+
+	const ObjLoadStats&
+	getStats() const { return m_stats; }
+
+private:
+	// Indices base 0 de una esquina de cara; -1 si falta
+	struct
+	Corner {
+		int v;
+		int vt;
+		int vn;
+	};
+
+	struct
+	Chunk {
+		const char* begin;
+		const char* end;
+		std::vector<XMFLOAT3> positions;
+		std::vector<XMFLOAT2> texcoords;
+		unsigned int normals;
+		std::vector<Corner> corners;        // 3 por triangulo
+		std::vector<unsigned char> relative; // Por esquina: bits v/vt/vn con indice negativo
+		bool failed;
+	};
+
+	static void
+	parseChunk(Chunk& chunk);
+
+	HRESULT
+	merge(MeshComponent& mesh, JobSystem* jobs);
+
+private:
+	std::vector<Chunk> m_chunks;
+	ObjLoadStats m_stats;
+};
@@ -0,0 +1,94 @@
+#pragma once
+#include "Bounds.h"
+#include <vector>
+
+struct
+OcclusionStats {
+	unsigned int occluders = 0;
+	unsigned int triangles = 0;    // Triangulos de oclusores rasterizados
+	unsigned int tested = 0;
+	unsigned int culled = 0;
+	double rasterMs = 0.0;         // Rasterizado + construccion de la jerarquia
+	double testMs = 0.0;
+};
+
+/**
+ * @brief Culling por oclusion en CPU con un depth buffer de baja resolucion.
+ *
+ * Por frame: beginFrame() limpia el buffer, addOccluder() rasteriza las
+ * mallas oclusoras (SSE, 4 pixeles por iteracion, guardando la profundidad
+ * mas cercana), finalize() construye la jerarquia de tiles de 8x8 con la
+ * profundidad mas lejana de cada uno, y isVisible() compara la profundidad
+ * mas cercana de la caja de un objeto con los tiles que cubre. Todo es CPU,
+ * sin dependencias de D3D.
+ */
+class
+OcclusionCuller {
+public:
+	static const unsigned int TILE_SIZE = 8;
+
+	OcclusionCuller()  = default;
+	~OcclusionCuller() = default;
+
+	// width y height se redondean a multiplos de TILE_SIZE
+	void
+	init(unsigned int width = 256, unsigned int height = 128);
+
+	void
+	beginFrame(const Float4x4& viewProjection);
+
+	// Malla indexada; positions apunta al x del primer vertice y stride es el
+	// tamano del vertice en bytes, asi sirve directo sobre SimpleVertex
+	void
+	addOccluder(const float* positions, unsigned int vertexCount, unsigned int stride,
+							const unsigned int* indices, unsigned int indexCount, const Float4x4& world);
+
+	// Rasteriza triangulos sueltos (3 posiciones por triangulo)
+	void
+	addOccluderTriangles(const Float3* positions, unsigned int triangleCount, const Float4x4& world);
+
+	void
+	finalize();
+
+	// false si la caja (espacio mundo) queda por completo detras de los oclusores
+	bool
+	isVisible(const Bounds& worldBounds);
+
+	unsigned int
+	getWidth() const { return m_width; }
+
+	unsigned int
+	getHeight() const { return m_height; }
+
+	const std::vector<float>&
+	getDepth() const { return m_depth; }
+
+	const OcclusionStats&
+	getStats() const { return m_stats; }
+
+	void
+	destroy();
+
+private:
+	// Recorta contra el plano cercano y rasteriza; clip es (x, y, z, w)
+	void
+	clipAndRasterize(const Float4& a, const Float4& b, const Float4& c);
+
+	// Triangulo ya proyectado a pixeles (x, y) con z en [0, 1]
+	void
+	rasterizeTriangle(const Float3& v0, const Float3& v1, const Float3& v2);
+
+	Float3
+	toScreen(const Float4& clip) const;
+
+private:
+	unsigned int m_width = 0;
+	unsigned int m_height = 0;
+	unsigned int m_tilesX = 0;
+	unsigned int m_tilesY = 0;
+	Float4x4 m_viewProjection;
+	std::vector<float> m_depth;       // Profundidad mas cercana por pixel
+	std::vector<float> m_tileMax;     // Profundidad mas lejana por tile
+	std::vector<Float4> m_clip;       // Vertices del oclusor en clip space
+	OcclusionStats m_stats;
+};
@@ -0,0 +1,79 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Buffer.h"
+#include "ShaderReflection.h"
+
+class Device;
+class DeviceContext;
+
+struct
+ParameterBlockStats {
+	unsigned long long uploads = 0;
+	unsigned long long skipped = 0;      // update() sin cambios
+	unsigned long long bytes = 0;        // Subidos a la GPU
+	unsigned long long dirtyBytes = 0;   // Rango que realmente cambio
+};
+
+/**
+ * @brief Constant buffer con copia en CPU y rango sucio.
+ *
+ * El tamano y los offsets salen del layout reflejado del shader. set()
+ * compara con la copia y solo extiende el rango sucio si el valor cambio;
+ * update() sube el buffer solo si hay algo sucio, asi la camara y la
+ * proyeccion dejan de subirse en cada frame. D3D11.0 no acepta una caja en
+ * UpdateSubresource para constant buffers, por lo que la subida es del
+ * buffer completo; el rango queda en las estadisticas.
+ */
+class
+ParameterBlock {
+public:
+	ParameterBlock()  = default;
+	~ParameterBlock() = default;
+
+	HRESULT
+	init(Device& device, const ConstantBufferLayout& layout);
+
+	void
+	destroy();
+
+	// Indice del parametro o INVALID_SHADER_PARAMETER
+	unsigned int
+	findParameter(const std::string& name) const { return m_layout.findParameter(name); }
+
+	// Copia size bytes (como mucho el tamano del parametro); true si cambio
+	bool
+	set(unsigned int parameter, const void* data, unsigned int size);
+
+	// Por offset, para escribir un struct de C++ validado completo
+	bool
+	setRaw(unsigned int offset, const void* data, unsigned int size);
+
+	// Marca todo el buffer (p. ej. despues de recrearlo)
+	void
+	invalidate();
+
+	// Sube la copia si hay cambios; true si subio
+	bool
+	update(DeviceContext& deviceContext);
+
+	// Enlaza el buffer en el registro del layout
+	void
+	render(DeviceContext& deviceContext, bool setPixelShader = false);
+
+	bool
+	isDirty() const { return m_dirtyBegin < m_dirtyEnd; }
+
+	const ConstantBufferLayout&
+	getLayout() const { return m_layout; }
+
+	const ParameterBlockStats&
+	getStats() const { return m_stats; }
+
+private:
+	ConstantBufferLayout m_layout;
+	Buffer m_buffer;
+	std::vector<unsigned char> m_data;
+	unsigned int m_dirtyBegin = 0;
+	unsigned int m_dirtyEnd = 0;
+	ParameterBlockStats m_stats;
+};
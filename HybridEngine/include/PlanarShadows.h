@@ -0,0 +1,78 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Bounds.h"
+
+/**
+ * @brief Sombras planas para muchos casters, planos receptores y luces.
+ *
+ * Para cada par (luz, plano) se arma una matriz de proyeccion y build()
+ * multiplica con SSE la matriz de mundo de cada caster por todas ellas,
+ * escribiendo el resultado transpuesto en CBChangesEveryFrame: listo para el
+ * stream de instancias de la RenderQueue, asi todas las sombras de una malla
+ * salen en un solo draw instanciado. Los planos son infinitos; el stencil del
+ * DepthStencilState de sombras evita mezclar dos veces el mismo pixel.
+ */
+class
+PlanarShadows {
+public:
+	PlanarShadows()  = default;
+	~PlanarShadows() = default;
+
+	// light.w = 1 para luz puntual (posicion), 0 para direccional (direccion hacia la luz)
+	unsigned int
+	addLight(const XMFLOAT4& light);
+
+	void
+	setLight(unsigned int index, const XMFLOAT4& light);
+
+	// Plano (nx, ny, nz, d) con dot(n, p) + d = 0; se normaliza al agregarlo
+	unsigned int
+	addReceiver(const XMFLOAT4& plane);
+
+	// Desplaza la sombra sobre el plano para evitar z-fighting
+	void
+	setBias(float bias) { m_bias = bias; }
+
+	// Matriz (vector fila) que aplasta puntos sobre plane vistos desde light
+	static XMFLOAT4X4
+	shadowMatrix(const XMFLOAT4& light, const XMFLOAT4& plane);
+
+	/**
+	 * Calcula las sombras de casterCount casters contra todas las luces y
+	 * planos. El orden de salida es [luz][plano][caster], indice
+	 * (luz * receptores + plano) * casterCount + caster. Devuelve cuantas
+	 * instancias escribio en out (se redimensiona).
+	 */
+	unsigned int
+	build(const XMFLOAT4X4* casterWorlds,
+				const XMFLOAT4* colors,
+				unsigned int casterCount,
+				std::vector<CBChangesEveryFrame>& out);
+
+	// Bounds en mundo de la sombra de un caster; false si el caster no
+	// proyecta sobre el plano (queda detras del plano o por encima de la luz)
+	bool
+	projectBounds(const Bounds& casterBounds,
+								unsigned int light,
+								unsigned int receiver,
+								Bounds& shadowBounds) const;
+
+	unsigned int
+	getLightCount() const { return static_cast<unsigned int>(m_lights.size()); }
+
+	unsigned int
+	getReceiverCount() const { return static_cast<unsigned int>(m_receivers.size()); }
+
+	void
+	clear();
+
+private:
+	XMFLOAT4
+	biasedPlane(unsigned int receiver) const;
+
+private:
+	std::vector<XMFLOAT4> m_lights;
+	std::vector<XMFLOAT4> m_receivers;
+	std::vector<XMFLOAT4X4> m_matrices;   // Una por par (luz, plano)
+	float m_bias = 0.01f;
+};
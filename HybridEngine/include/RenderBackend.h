@@ -0,0 +1,210 @@
+#pragma once
+#include "Prerequisites.h"
+
+/**
+ * @brief Interfaz abstracta del backend de render.
+ *
+ * Device y DeviceContext ya no hablan directamente con ID3D11Device /
+ * ID3D11DeviceContext: todas las llamadas de creacion, bind y draw pasan por
+ * esta interfaz. D3D11Backend las reenvia a Direct3D 11 y NullBackend las
+ * registra en un log de comandos sin necesitar GPU.
+ */
+class
+RenderBackend {
+public:
+	RenderBackend()          = default;
+	virtual ~RenderBackend() = default;
+
+	// Nombre del backend (para logs)
+	virtual const char*
+	getName() const = 0;
+
+	// true si los Create* se pueden llamar desde varios hilos a la vez
+	// (ID3D11Device lo es; el log de NullBackend no)
+	virtual bool
+	isFreeThreaded() const { return false; }
+
+	// Creacion de recursos
+	virtual HRESULT
+	CreateBuffer(const D3D11_BUFFER_DESC* pDesc,
+							 const D3D11_SUBRESOURCE_DATA* pInitialData,
+							 ID3D11Buffer** ppBuffer) = 0;
+
+	virtual HRESULT
+	CreateTexture2D(const D3D11_TEXTURE2D_DESC* pDesc,
+									const D3D11_SUBRESOURCE_DATA* pInitialData,
+									ID3D11Texture2D** ppTexture2D) = 0;
+
+	virtual HRESULT
+	CreateShaderResourceView(ID3D11Resource* pResource,
+													 const D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc,
+													 ID3D11ShaderResourceView** ppSRView) = 0;
+
+	virtual HRESULT
+	CreateShaderResourceViewFromFile(const std::string& fileName,
+																	 ID3D11ShaderResourceView** ppSRView) = 0;
+
+	virtual HRESULT
+	CreateRenderTargetView(ID3D11Resource* pResource,
+												 const D3D11_RENDER_TARGET_VIEW_DESC* pDesc,
+												 ID3D11RenderTargetView** ppRTView) = 0;
+
+	virtual HRESULT
+	CreateDepthStencilView(ID3D11Resource* pResource,
+												 const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc,
+												 ID3D11DepthStencilView** ppDepthStencilView) = 0;
+
+	virtual HRESULT
+	CreateVertexShader(const void* pShaderBytecode,
+										 unsigned int BytecodeLength,
+										 ID3D11ClassLinkage* pClassLinkage,
+										 ID3D11VertexShader** ppVertexShader) = 0;
+
+	virtual HRESULT
+	CreatePixelShader(const void* pShaderBytecode,
+										unsigned int BytecodeLength,
+										ID3D11ClassLinkage* pClassLinkage,
+										ID3D11PixelShader** ppPixelShader) = 0;
+
+	virtual HRESULT
+	CreateInputLayout(const D3D11_INPUT_ELEMENT_DESC* pInputElementDescs,
+										unsigned int NumElements,
+										const void* pShaderBytecodeWithInputSignature,
+										unsigned int BytecodeLength,
+										ID3D11InputLayout** ppInputLayout) = 0;
+
+	virtual HRESULT
+	CreateSamplerState(const D3D11_SAMPLER_DESC* pSamplerDesc,
+										 ID3D11SamplerState** ppSamplerState) = 0;
+
+	virtual HRESULT
+	CreateBlendState(const D3D11_BLEND_DESC* pBlendStateDesc,
+									 ID3D11BlendState** ppBlendState) = 0;
+
+	virtual HRESULT
+	CreateDepthStencilState(const D3D11_DEPTH_STENCIL_DESC* pDepthStencilDesc,
+													ID3D11DepthStencilState** ppDepthStencilState) = 0;
+
+	virtual HRESULT
+	CreateRasterizerState(const D3D11_RASTERIZER_DESC* pRasterizerDesc,
+												ID3D11RasterizerState** ppRasterizerState) = 0;
+
+	// Input Assembler
+	virtual void
+	IASetInputLayout(ID3D11InputLayout* pInputLayout) = 0;
+
+	virtual void
+	IASetVertexBuffers(unsigned int StartSlot,
+										 unsigned int NumBuffers,
+										 ID3D11Buffer* const* ppVertexBuffers,
+										 const unsigned int* pStrides,
+										 const unsigned int* pOffsets) = 0;
+
+	virtual void
+	IASetIndexBuffer(ID3D11Buffer* pIndexBuffer,
+									 DXGI_FORMAT Format,
+									 unsigned int Offset) = 0;
+
+	virtual void
+	IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology) = 0;
+
+	// Shaders
+	virtual void
+	VSSetShader(ID3D11VertexShader* pVertexShader,
+							ID3D11ClassInstance* const* ppClassInstances,
+							unsigned int NumClassInstances) = 0;
+
+	virtual void
+	PSSetShader(ID3D11PixelShader* pPixelShader,
+							ID3D11ClassInstance* const* ppClassInstances,
+							unsigned int NumClassInstances) = 0;
+
+	virtual void
+	VSSetConstantBuffers(unsigned int StartSlot,
+											 unsigned int NumBuffers,
+											 ID3D11Buffer* const* ppConstantBuffers) = 0;
+
+	virtual void
+	PSSetConstantBuffers(unsigned int StartSlot,
+											 unsigned int NumBuffers,
+											 ID3D11Buffer* const* ppConstantBuffers) = 0;
+
+	virtual void
+	PSSetShaderResources(unsigned int StartSlot,
+											 unsigned int NumViews,
+											 ID3D11ShaderResourceView* const* ppShaderResourceViews) = 0;
+
+	virtual void
+	PSSetSamplers(unsigned int StartSlot,
+								unsigned int NumSamplers,
+								ID3D11SamplerState* const* ppSamplers) = 0;
+
+	// Output Merger / Rasterizer
+	virtual void
+	OMSetRenderTargets(unsigned int NumViews,
+										 ID3D11RenderTargetView* const* ppRenderTargetViews,
+										 ID3D11DepthStencilView* pDepthStencilView) = 0;
+
+	virtual void
+	OMSetBlendState(ID3D11BlendState* pBlendState,
+									const float BlendFactor[4],
+									unsigned int SampleMask) = 0;
+
+	virtual void
+	OMSetDepthStencilState(ID3D11DepthStencilState* pDepthStencilState,
+												 unsigned int StencilRef) = 0;
+
+	virtual void
+	RSSetViewports(unsigned int NumViewports, const D3D11_VIEWPORT* pViewports) = 0;
+
+	virtual void
+	RSSetState(ID3D11RasterizerState* pRasterizerState) = 0;
+
+	// Limpieza, actualizacion y dibujo
+	virtual void
+	ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView,
+												const float ColorRGBA[4]) = 0;
+
+	virtual void
+	ClearDepthStencilView(ID3D11DepthStencilView* pDepthStencilView,
+												unsigned int ClearFlags,
+												float Depth,
+												UINT8 Stencil) = 0;
+
+	virtual void
+	UpdateSubresource(ID3D11Resource* pDstResource,
+										unsigned int DstSubresource,
+										const D3D11_BOX* pDstBox,
+										const void* pSrcData,
+										unsigned int SrcRowPitch,
+										unsigned int SrcDepthPitch) = 0;
+
+	virtual HRESULT
+	Map(ID3D11Resource* pResource,
+			unsigned int Subresource,
+			D3D11_MAP MapType,
+			unsigned int MapFlags,
+			D3D11_MAPPED_SUBRESOURCE* pMappedResource) = 0;
+
+	virtual void
+	Unmap(ID3D11Resource* pResource, unsigned int Subresource) = 0;
+
+	virtual void
+	DrawIndexed(unsigned int IndexCount,
+							unsigned int StartIndexLocation,
+							int BaseVertexLocation) = 0;
+
+	virtual void
+	DrawIndexedInstanced(unsigned int IndexCountPerInstance,
+											 unsigned int InstanceCount,
+											 unsigned int StartIndexLocation,
+											 int BaseVertexLocation,
+											 unsigned int StartInstanceLocation) = 0;
+
+	virtual void
+	ClearState() = 0;
+
+	// Presenta el frame (fin de frame para el backend nulo)
+	virtual HRESULT
+	Present(IDXGISwapChain* pSwapChain, unsigned int SyncInterval, unsigned int Flags) = 0;
+};
@@ -0,0 +1,211 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Buffer.h"
+#include <unordered_map>
+
+class Device;
+class DeviceContext;
+class ShaderProgram;
+class BlendState;
+class DepthStencilState;
+class ConstantBufferRing;
+
+// Pasadas de render; ocupan los bits altos de la sort key
+enum
+RenderPass {
+	RENDER_PASS_OPAQUE      = 0,
+	RENDER_PASS_TRANSPARENT = 1,
+	RENDER_PASS_OVERLAY     = 2
+};
+
+/**
+ * @brief Todo lo necesario para emitir un DrawIndexed.
+ *
+ * Los punteros no son propiedad del paquete; deben seguir vivos hasta que la
+ * cola se ejecute. Los campos opcionales en nullptr no se enlazan (blend y
+ * depth stencil en nullptr restauran el estado por defecto).
+ */
+struct
+DrawPacket {
+	unsigned long long sortKey = 0;
+
+	// Geometria
+	Buffer* vertexBuffer = nullptr;
+	Buffer* indexBuffer = nullptr;   // El formato (16 o 32 bits) lo lleva el Buffer
+	unsigned int indexCount = 0;
+	unsigned int startIndex = 0;
+	int baseVertex = 0;
+
+	// Shaders: programa completo (VS + PS + InputLayout) y PS opcional que lo
+	// sustituye. Sin shaderProgram el paquete solo se dibuja instanciado, aun
+	// si queda solo en su lote
+	ShaderProgram* shaderProgram = nullptr;
+	ShaderProgram* pixelShaderOverride = nullptr;
+
+	// Constantes por objeto: se suben a constantBuffer antes del draw, o a un
+	// slice del ring de la cola si constantBuffer es nullptr
+	Buffer* constantBuffer = nullptr;
+	unsigned int constantSlot = 2;
+	unsigned int constantDataOffset = 0;
+	unsigned int constantDataSize = 0;
+
+	// Variante instanciada del programa (lee CBChangesEveryFrame del stream de
+	// instancias). Si no es nullptr, los paquetes compatibles se agrupan en un
+	// solo DrawIndexedInstanced y este programa sustituye al VS; el PS es
+	// pixelShaderOverride si lo hay y si no el de este programa.
+	ShaderProgram* instancedProgram = nullptr;
+
+	// Material
+	ID3D11ShaderResourceView* texture = nullptr;
+	ID3D11SamplerState* sampler = nullptr;
+	BlendState* blendState = nullptr;
+	DepthStencilState* depthStencilState = nullptr;
+};
+
+struct
+RenderQueueStats {
+	unsigned int packets = 0;
+	unsigned int shaderChanges = 0;
+	unsigned int materialChanges = 0;
+	unsigned int geometryChanges = 0;
+	unsigned int stateChanges = 0;
+	unsigned int drawCalls = 0;
+	unsigned int instancedDraws = 0;
+	unsigned int instances = 0;       // Paquetes dibujados con instancing
+};
+
+/**
+ * @brief Cola de draw packets ordenada por una sort key de 64 bits.
+ *
+ * Layout de la key (bit alto -> bajo):
+ *   [63..60] pasada | [59..48] shader | [47..24] material | [23..0] profundidad
+ * Las pasadas transparentes invierten la profundidad (back to front).
+ * sort() usa radix sort LSD de 8 bits y omite los digitos constantes;
+ * execute() solo cambia el estado que difiere del paquete anterior.
+ *
+ * Con initInstancing(), los paquetes con instancedProgram que comparten
+ * geometria, shaders, material y estados se dibujan juntos: en la pasada
+ * opaca sin importar su orden y en las demas solo si quedan contiguos.
+ */
+class
+RenderQueue {
+public:
+	// Minimo de paquetes compatibles para emitir un draw instanciado
+	static const unsigned int MIN_INSTANCES = 2;
+	static const unsigned int INVALID_INDEX = 0xffffffff;
+
+	RenderQueue()  = default;
+	~RenderQueue() = default;
+
+	void
+	init(unsigned int expectedPackets);
+
+	// Crea el stream de instancias (maxInstances * sizeof(CBChangesEveryFrame))
+	HRESULT
+	initInstancing(Device& device, unsigned int maxInstances);
+
+	static unsigned long long
+	makeSortKey(RenderPass pass, unsigned int shaderId, unsigned int materialId, float depth01);
+
+	// Agrega un paquete. Si constantData no es nulo se copia a la memoria de la cola.
+	void
+	submit(const DrawPacket& packet, const void* constantData = nullptr, unsigned int constantSize = 0);
+
+	// Ring para las constantes de paquetes sin constantBuffer propio
+	void
+	setConstantRing(ConstantBufferRing* ring) { m_constantRing = ring; }
+
+	void
+	sort();
+
+	void
+	execute(DeviceContext& deviceContext);
+
+	// Vacia la cola para el siguiente frame (conserva la memoria reservada)
+	void
+	clear();
+
+	void
+	destroy();
+
+	unsigned int
+	size() const { return static_cast<unsigned int>(m_packets.size()); }
+
+	const DrawPacket&
+	getSortedPacket(unsigned int index) const { return m_packets[m_sorted[index].index]; }
+
+	const RenderQueueStats&
+	getStats() const { return m_stats; }
+
+private:
+	struct
+	SortEntry {
+		unsigned long long key;
+		unsigned int index;
+	};
+
+	// Paquetes que se dibujan juntos; la lista se enlaza con m_nextInBatch
+	struct
+	Batch {
+		unsigned int first;
+		unsigned int last;
+		unsigned int count;
+	};
+
+	// Estado enlazado en el contexto durante execute()
+	struct
+	BoundState {
+		const ShaderProgram* program = nullptr;
+		const ShaderProgram* pixelShader = nullptr;
+		Buffer* vertexBuffer = nullptr;
+		Buffer* indexBuffer = nullptr;
+		Buffer* constantBuffer = nullptr;
+		unsigned int constantSlot = 0xffffffff;
+		ID3D11ShaderResourceView* texture = nullptr;
+		ID3D11SamplerState* sampler = nullptr;
+		BlendState* blendState = nullptr;
+		DepthStencilState* depthStencilState = nullptr;
+		bool first = true;
+	};
+
+	bool
+	canInstance(const DrawPacket& packet) const;
+
+	static bool
+	sameBatch(const DrawPacket& a, const DrawPacket& b);
+
+	static size_t
+	batchHash(const DrawPacket& packet);
+
+	void
+	buildBatches();
+
+	void
+	bindState(DeviceContext& deviceContext,
+						const DrawPacket& packet,
+						const ShaderProgram* program,
+						const ShaderProgram* pixelShader,
+						BoundState& bound);
+
+	void
+	drawSingle(DeviceContext& deviceContext, const DrawPacket& packet, BoundState& bound);
+
+	void
+	drawInstanced(DeviceContext& deviceContext, const Batch& batch, BoundState& bound);
+
+	std::vector<DrawPacket> m_packets;
+	std::vector<SortEntry> m_sorted;
+	std::vector<SortEntry> m_scratch;
+	std::vector<unsigned char> m_constantData;
+	RenderQueueStats m_stats;
+	ConstantBufferRing* m_constantRing = nullptr;
+	bool m_isSorted = false;
+
+	// Instancing
+	std::vector<Batch> m_batches;
+	std::vector<unsigned int> m_nextInBatch;
+	std::unordered_multimap<size_t, unsigned int> m_openBatches;
+	Buffer m_instanceBuffer;
+	unsigned int m_instanceCapacity = 0;
+	unsigned int m_instanceCursor = 0;
+};
@@ -0,0 +1,111 @@
+#pragma once
+#include "Prerequisites.h"
+#include "TransformSystem.h"
+
+typedef unsigned int SceneNodeId;
+const SceneNodeId INVALID_SCENE_NODE = 0xffffffff;
+
+struct
+SceneGraphStats {
+	unsigned int nodes = 0;
+	unsigned int updated = 0;   // Nodos recalculados en el ultimo update()
+	unsigned int resorts = 0;   // Reordenamientos por cambios de jerarquia
+};
+
+/**
+ * @brief Jerarquia de transformaciones en arreglos planos ordenados por profundidad.
+ *
+ * Un padre siempre queda antes que sus hijos, asi que update() recorre el
+ * arreglo una sola vez: un nodo se recalcula si su local cambio o si el
+ * mundo de su padre cambio en esta misma pasada. Los nodos estaticos solo
+ * cuestan revisar dos bytes. Las locales viven en un TransformSystem (SoA)
+ * y las de los nodos sucios se componen con su camino SIMD, por tramos
+ * contiguos, antes de la pasada jerarquica. Los ids son estables; el indice
+ * interno cambia cuando se agregan, quitan o re-emparentan nodos (se
+ * reordena en el siguiente update()).
+ */
+class
+SceneGraph {
+public:
+	SceneGraph()  = default;
+	~SceneGraph() = default;
+
+	void
+	init(unsigned int expectedNodes);
+
+	SceneNodeId
+	createNode(SceneNodeId parent = INVALID_SCENE_NODE,
+						 const XMFLOAT3& position = XMFLOAT3(0.0f, 0.0f, 0.0f),
+						 const XMFLOAT4& rotation = XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f),
+						 const XMFLOAT3& scale = XMFLOAT3(1.0f, 1.0f, 1.0f));
+
+	// Elimina el nodo y todos sus descendientes
+	void
+	destroyNode(SceneNodeId id);
+
+	void
+	setParent(SceneNodeId id, SceneNodeId parent);
+
+	void
+	setLocalPosition(SceneNodeId id, const XMFLOAT3& position);
+
+	void
+	setLocalRotation(SceneNodeId id, const XMFLOAT4& rotation);
+
+	void
+	setLocalRotationRollPitchYaw(SceneNodeId id, float pitch, float yaw, float roll);
+
+	void
+	setLocalScale(SceneNodeId id, const XMFLOAT3& scale);
+
+	// Recalcula los mundos de los nodos sucios y sus descendientes
+	void
+	update();
+
+	XMMATRIX
+	getWorldMatrix(SceneNodeId id) const;
+
+	// Escribe la matriz de mundo transpuesta de id en dst (p. ej. CBChangesEveryFrame::mWorld)
+	void
+	getWorldTransposed(SceneNodeId id, XMMATRIX* dst) const;
+
+	// true si el mundo del nodo cambio en el ultimo update()
+	bool
+	worldChanged(SceneNodeId id) const { return m_worldChanged[m_idToIndex[id]] != 0; }
+
+	bool
+	isValid(SceneNodeId id) const;
+
+	void
+	destroy();
+
+	const SceneGraphStats&
+	getStats() const { return m_stats; }
+
+private:
+	// Ordena por profundidad y compacta los nodos eliminados
+	void
+	resort();
+
+	unsigned int
+	computeDepth(unsigned int index) const;
+
+private:
+	// Por indice (orden por profundidad)
+	std::vector<int> m_parent;              // Indice del padre o -1
+	std::vector<unsigned int> m_depth;
+	TransformSystem m_local;                    // Posicion, rotacion y escala locales
+	std::vector<XMFLOAT4X4> m_localTransposed;  // Ultima local compuesta (transpuesta)
+	std::vector<XMFLOAT4X4> m_world;
+	std::vector<unsigned char> m_localDirty;
+	std::vector<unsigned char> m_worldChanged;
+	std::vector<unsigned char> m_alive;
+	std::vector<SceneNodeId> m_indexToId;
+
+	// Por id
+	std::vector<unsigned int> m_idToIndex;
+	std::vector<SceneNodeId> m_freeIds;
+
+	bool m_needsResort = false;
+	SceneGraphStats m_stats;
+};
@@ -0,0 +1,128 @@
+#pragma once
+#include "Prerequisites.h"
+#include <mutex>
+
+const unsigned int SHADER_CACHE_MAGIC = 0x48435348;   // "HSCH"
+const unsigned int SHADER_CACHE_VERSION = 1;          // Cambiarlo invalida todas las entradas
+
+// Cabecera del archivo; los offsets son desde el inicio del archivo
+struct
+ShaderCacheHeader {
+	unsigned int magic;
+	unsigned int version;
+	unsigned int headerSize;
+	unsigned int entryCount;
+	unsigned long long indexOffset;
+	unsigned long long dataOffset;
+	unsigned long long fileSize;
+};
+
+// Entrada del indice, ordenado por key; offset es relativo a dataOffset
+struct
+ShaderCacheEntry {
+	unsigned long long key;
+	unsigned long long offset;
+	unsigned int size;
+	unsigned int checksum;   // Hash del bytecode, detecta archivos corruptos
+};
+
+struct
+ShaderCacheStats {
+	unsigned int hits = 0;
+	unsigned int misses = 0;
+	double compileMs = 0.0;   // Tiempo en el compilador (solo fallos)
+};
+
+/**
+ * @brief Cache persistente de bytecode de shaders en un solo archivo indexado.
+ *
+ * La key es un hash de 64 bits del texto del shader y de todos sus #include
+ * (recursivo), del entry point, el perfil y los flags de compilacion. Un
+ * acierto crea el blob con el bytecode guardado sin pasar por el compilador;
+ * un fallo compila, inserta y marca el cache para save(). El indice queda
+ * ordenado por key y find() es una busqueda binaria, asi que la logica de
+ * indice y busqueda se puede probar sin compilador (insert/find/save/load).
+ * save() solo escribe las entradas leidas o insertadas en esta sesion, asi
+ * las versiones viejas de un shader editado no se acumulan en el archivo.
+ * compileFromFile() e insert() se pueden llamar desde varios hilos; find()
+ * devuelve un puntero interno y no debe mezclarse con inserciones en curso.
+ */
+class
+ShaderCache {
+public:
+	ShaderCache()  = default;
+	~ShaderCache() = default;
+
+	// Carga el archivo; si no existe o no es valido el cache queda vacio
+	// (S_FALSE) y save() lo reescribe
+	HRESULT
+	load(const std::string& path);
+
+	// Escribe a un temporal y lo renombra; no hace nada si no hubo cambios
+	// ni entradas sin usar que descartar
+	HRESULT
+	save();
+
+	HRESULT
+	save(const std::string& path);
+
+	void
+	clear();
+
+	bool
+	find(unsigned long long key, const void** data, size_t* size) const;
+
+	// Reemplaza la entrada si la key ya existe
+	void
+	insert(unsigned long long key, const void* data, size_t size);
+
+	// Busca por key y, si falla, compila con D3DX11CompileFromFile e inserta.
+	// defines (terminado en { nullptr, nullptr }) forma parte de la key
+	HRESULT
+	compileFromFile(const std::string& fileName,
+									LPCSTR entryPoint,
+									LPCSTR shaderModel,
+									unsigned int flags,
+									ID3DBlob** blobOut,
+									const D3D_SHADER_MACRO* defines = nullptr);
+
+	// FNV-1a de 64 bits
+	static unsigned long long
+	hash(const void* data, size_t size, unsigned long long seed = 14695981039346656037ull);
+
+	// Hash del archivo y de su cierre de #include; false si no se pudo leer
+	static bool
+	hashSource(const std::string& fileName, unsigned long long& sourceHash);
+
+	static unsigned long long
+	makeKey(unsigned long long sourceHash,
+					LPCSTR entryPoint,
+					LPCSTR shaderModel,
+					unsigned int flags,
+					const D3D_SHADER_MACRO* defines = nullptr);
+
+	static bool
+	validate(const void* data, size_t size);
+
+	unsigned int
+	getEntryCount() const { return static_cast<unsigned int>(m_entries.size()); }
+
+	// Key de la entrada index (en orden de key)
+	unsigned long long
+	getEntryKey(unsigned int index) const { return m_entries[index].key; }
+
+	bool
+	isDirty() const { return m_dirty; }
+
+	const ShaderCacheStats&
+	getStats() const { return m_stats; }
+
+private:
+	std::string m_path;
+	std::vector<ShaderCacheEntry> m_entries;   // Ordenado por key
+	mutable std::vector<unsigned char> m_used;   // Paralelo a m_entries: leida o insertada en esta sesion
+	std::vector<char> m_data;
+	bool m_dirty = false;
+	ShaderCacheStats m_stats;
+	std::mutex m_lock;   // Entradas, datos y estadisticas
+};
@@ -0,0 +1,127 @@
+#pragma once
+#include "Prerequisites.h"
+#include "ShaderCache.h"
+
+class Device;
+class JobSystem;
+class ShaderProgram;
+
+typedef unsigned int ShaderVariantKey;
+
+const unsigned int SHADER_PERMUTATION_MAX_BITS = 12;        // Tabla de 4096 variantes
+const unsigned int SHADER_KEYWORD_MAX_VALUES = 16;
+const unsigned int INVALID_SHADER_KEYWORD = 0xffffffff;
+
+// Keyword de permutacion: booleano (2 valores) o enum (hasta 16). Ocupa
+// bits bits de la key a partir de shift.
+struct
+ShaderKeyword {
+	std::string name;
+	unsigned int valueCount;
+	unsigned int shift;
+	unsigned int bits;
+};
+
+struct
+ShaderPermutationStats {
+	unsigned int built = 0;
+	unsigned int failed = 0;
+	unsigned int lazyBuilds = 0;   // Variantes compiladas en getVariant() (hitch en el frame)
+	double prebuildMs = 0.0;
+};
+
+/**
+ * @brief Variantes de un .fx seleccionadas por keywords en una key de bits.
+ *
+ * Cada keyword se compila como una macro siempre definida (NAME=0..n-1),
+ * asi el shader usa #if NAME en lugar de un .fx por combinacion. La key
+ * empaqueta el valor de cada keyword y es el indice directo de la tabla de
+ * variantes, por lo que getVariant() es O(1). Las variantes se compilan bajo
+ * demanda o de antemano con prebuild(), que reparte la compilacion en el
+ * JobSystem (solo bytecode, a traves del cache) y crea los objetos de GPU en
+ * el hilo que llama.
+ */
+class
+ShaderPermutations {
+public:
+	ShaderPermutations()  = default;
+	~ShaderPermutations() { destroy(); }
+
+	ShaderPermutations(const ShaderPermutations&) = delete;
+	ShaderPermutations&
+	operator=(const ShaderPermutations&) = delete;
+
+	// Antes de init(). Devuelve el indice del keyword o INVALID_SHADER_KEYWORD
+	// si ya no caben los bits
+	unsigned int
+	addKeyword(const std::string& name, unsigned int valueCount = 2);
+
+	// Sin cache usa uno propio en memoria (necesario para prebuild en paralelo)
+	HRESULT
+	init(Device& device,
+			 const std::string& fileName,
+			 const std::vector<D3D11_INPUT_ELEMENT_DESC>& layout,
+			 ShaderCache* cache = nullptr);
+
+	void
+	destroy();
+
+	ShaderVariantKey
+	setKeyword(ShaderVariantKey key, unsigned int keyword, unsigned int value) const;
+
+	unsigned int
+	getKeyword(ShaderVariantKey key, unsigned int keyword) const;
+
+	// Todos los keywords dentro de su rango
+	bool
+	isValid(ShaderVariantKey key) const;
+
+	// Variante lista para dibujar; si falta la compila en el momento. nullptr
+	// si la key no es valida o la compilacion fallo.
+	ShaderProgram*
+	getVariant(ShaderVariantKey key);
+
+	// Solo busca; nullptr si no esta construida
+	ShaderProgram*
+	findVariant(ShaderVariantKey key) const;
+
+	// Construye keys (o todas las validas si esta vacio)
+	HRESULT
+	prebuild(JobSystem& jobs, const std::vector<ShaderVariantKey>& keys = std::vector<ShaderVariantKey>());
+
+	// Solo el bytecode de la variante, a traves del cache; se puede llamar
+	// desde cualquier hilo
+	HRESULT
+	compile(ShaderVariantKey key);
+
+	// Crea los objetos de GPU de la variante en el hilo que llama; despues
+	// de compile() cada compilacion es un acierto del cache
+	ShaderProgram*
+	createVariant(ShaderVariantKey key);
+
+	// Macros de la key, terminadas en { nullptr, nullptr }
+	void
+	buildDefines(ShaderVariantKey key, std::vector<D3D_SHADER_MACRO>& defines) const;
+
+	unsigned int
+	getKeywordCount() const { return static_cast<unsigned int>(m_keywords.size()); }
+
+	// Tamano de la tabla: 1 << bits usados
+	unsigned int
+	getKeyCount() const { return 1u << m_bits; }
+
+	const ShaderPermutationStats&
+	getStats() const { return m_stats; }
+
+private:
+	Device* m_device = nullptr;
+	std::string m_fileName;
+	std::vector<D3D11_INPUT_ELEMENT_DESC> m_layout;
+	ShaderCache* m_cache = nullptr;
+	ShaderCache m_localCache;
+	std::vector<ShaderKeyword> m_keywords;
+	unsigned int m_bits = 0;
+	std::vector<ShaderProgram*> m_variants;   // Indexado por key
+	std::vector<unsigned char> m_failed;      // No reintentar cada frame
+	ShaderPermutationStats m_stats;
+};
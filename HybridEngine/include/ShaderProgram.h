@@ -1,9 +1,11 @@
 #pragma once
 #include "Prerequisites.h"
 #include "InputLayout.h"
+#include "ShaderReflection.h"
 
 class Device;
 class DeviceContext;
+class ShaderCache;
 
 class 
 ShaderProgram {
@@ -37,12 +39,42 @@ public:
   HRESULT
   CreateShader(Device & device, ShaderType type, const std::string& fileName);
 
+  // Solo el bytecode de type (entry point y perfil de CreateShader) con las
+  // macros y el cache actuales; no toca el dispositivo, se puede llamar
+  // desde otros hilos para calentar el cache
+  HRESULT
+  CompileShader(const std::string& fileName, ShaderType type, ID3DBlob** ppBlobOut);
+
   HRESULT 
-  CompileShaderFromFile(char* szFileName, 
+  CompileShaderFromFile(const char* szFileName, 
                         LPCSTR szEntryPoint, 
                         LPCSTR szShaderModel, 
                         ID3DBlob** ppBlobOut);
 
+  // Con cache, CompileShaderFromFile carga el bytecode guardado si el
+  // fuente, sus includes y los flags no cambiaron
+  void
+  setCache(ShaderCache* cache) { m_cache = cache; }
+
+  // Macros para las proximas compilaciones (terminadas en { nullptr, nullptr });
+  // los strings deben vivir mientras se use el programa
+  void
+  setDefines(const D3D_SHADER_MACRO* defines);
+
+  // Constant buffers del VS y del PS creados con CreateShader
+  const ShaderReflection&
+  getReflection() const { return m_reflection; }
+
+  // Recompila desde el mismo archivo (macros, cache e input layout iguales)
+  // y cambia los objetos vivos solo si todo salio bien y los cbuffers no
+  // cambiaron de layout; si falla el programa viejo sigue intacto. Llamar
+  // entre frames, en el hilo que dibuja
+  HRESULT
+  reload(Device& device);
+
+  const std::string&
+  getFileName() const { return m_shaderFileName; }
+
 public:
   ID3D11VertexShader* m_VertexShader = nullptr;
   ID3D11PixelShader* m_PixelShader = nullptr;
@@ -51,4 +83,8 @@ private:
   std::string m_shaderFileName;
   ID3DBlob* m_vertexShaderData = nullptr;
   ID3DBlob* m_pixelShaderData = nullptr;
+  ShaderCache* m_cache = nullptr;
+  std::vector<D3D_SHADER_MACRO> m_defines;   // Vacio o terminado en nulo
+  ShaderReflection m_reflection;
+  std::vector<D3D11_INPUT_ELEMENT_DESC> m_layout;   // Para reload()
 };
\ No newline at end of file
@@ -0,0 +1,101 @@
+#pragma once
+#include "Prerequisites.h"
+#include <cstddef>
+
+const unsigned int INVALID_SHADER_PARAMETER = 0xffffffff;
+
+// Variable de un cbuffer segun el bytecode
+struct
+ShaderParameter {
+	std::string name;
+	unsigned int offset;
+	unsigned int size;
+	D3D_SHADER_VARIABLE_CLASS variableClass;
+	D3D_SHADER_VARIABLE_TYPE type;
+	unsigned int rows;
+	unsigned int columns;
+	unsigned int elements;   // 0 si no es arreglo
+};
+
+// Layout de un cbuffer: registro b#, tamano (multiplo de 16) y variables
+// ordenadas por offset
+struct
+ConstantBufferLayout {
+	std::string name;
+	unsigned int slot = 0;
+	unsigned int size = 0;
+	std::vector<ShaderParameter> parameters;
+
+	// Indice del parametro o INVALID_SHADER_PARAMETER
+	unsigned int
+	findParameter(const std::string& parameterName) const;
+};
+
+// Miembro del struct de C++ que espeja un cbuffer, con el nombre de HLSL
+struct
+ConstantBufferMember {
+	const char* name;
+	unsigned int offset;
+	unsigned int size;
+};
+
+#define CB_MEMBER(hlslName, type, member) \
+	{ hlslName, static_cast<unsigned int>(offsetof(type, member)), static_cast<unsigned int>(sizeof(((type*)nullptr)->member)) }
+
+/**
+ * @brief Layouts de los constant buffers leidos del bytecode con D3DReflect.
+ *
+ * Los structs de C++ (CBNeverChanges, ...) espejan a mano los cbuffers del
+ * .fx; validate() compara offsets y tamanos contra el layout reflejado para
+ * que un cambio en el shader falle al iniciar y no en pantalla, y
+ * generateStruct() escribe la declaracion de C++ equivalente. Un mismo
+ * cbuffer visto en el VS y en el PS debe tener el mismo layout.
+ */
+class
+ShaderReflection {
+public:
+	ShaderReflection()  = default;
+	~ShaderReflection() = default;
+
+	// Agrega los cbuffers del bytecode
+	HRESULT
+	reflect(const void* bytecode, size_t size);
+
+	// Agrega un layout; si ya existe uno con el nombre debe ser igual
+	HRESULT
+	addLayout(const ConstantBufferLayout& layout);
+
+	void
+	clear() { m_layouts.clear(); }
+
+	// nullptr si el shader no declara el cbuffer
+	const ConstantBufferLayout*
+	find(const std::string& name) const;
+
+	const std::vector<ConstantBufferLayout>&
+	getLayouts() const { return m_layouts; }
+
+	// Cada cbuffer de previous que sigue en este tiene el mismo layout (los
+	// buffers de C++ armados con el layout viejo siguen siendo validos)
+	bool
+	isCompatible(const ShaderReflection& previous) const;
+
+	static bool
+	sameLayout(const ConstantBufferLayout& a, const ConstantBufferLayout& b);
+
+	// Cada miembro coincide en nombre, offset y tamano, cada parametro tiene su
+	// miembro y cppSize redondeado a 16 es el tamano del cbuffer. Deja el
+	// primer error en el log
+	static bool
+	validate(const ConstantBufferLayout& layout,
+					 const ConstantBufferMember* members,
+					 unsigned int memberCount,
+					 unsigned int cppSize);
+
+	// Declaracion de C++ equivalente, con padding explicito
+	static std::string
+	generateStruct(const ConstantBufferLayout& layout, const std::string& typeName);
+
+private:
+	std::vector<ConstantBufferLayout> m_layouts;
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include "Prerequisites.h"
+#include "D3D11Backend.h"
 
 class Device;
 class DeviceContext;
@@ -18,6 +19,15 @@ public:
        Texture & backBuffer, 
        Window window);
 
+  // Inicializa sin ventana ni GPU sobre el backend indicado (p.ej. NullBackend)
+  HRESULT
+  init(Device & device,
+       DeviceContext & deviceContext,
+       Texture & backBuffer,
+       RenderBackend & backend,
+       unsigned int width,
+       unsigned int height);
+
   void 
   update();
   
@@ -34,6 +44,10 @@ public:
 	IDXGISwapChain* m_swapChain = nullptr;
 	D3D_DRIVER_TYPE m_driverType = D3D_DRIVER_TYPE_NULL;
 private:
+  // Backend activo; D3D11 salvo en modo headless
+  D3D11Backend m_d3d11Backend;
+  RenderBackend* m_backend = nullptr;
+
 	D3D_FEATURE_LEVEL m_featureLevel = D3D_FEATURE_LEVEL_11_0;
   // MSAA Configuration
   /*
@@ -0,0 +1,89 @@
+#pragma once
+#include "Prerequisites.h"
+
+/**
+ * @brief Transformaciones de muchos objetos en formato SoA.
+ *
+ * Cada componente (posicion, rotacion como cuaternion, escala) vive en su
+ * propio arreglo, asi que compose procesa 4 objetos por iteracion con SSE
+ * (8 con AVX) y escribe la matriz de mundo ya transpuesta, lista para el
+ * shader, directo en la memoria de subida de constantes.
+ *
+ * El orden es el de XNA Math (vector fila): world = S * R * T.
+ */
+class
+TransformSystem {
+public:
+	TransformSystem()  = default;
+	~TransformSystem() = default;
+
+	void
+	init(unsigned int expectedCount);
+
+	// Agrega un objeto y devuelve su indice
+	unsigned int
+	create(const XMFLOAT3& position,
+				 const XMFLOAT4& rotation = XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f),
+				 const XMFLOAT3& scale = XMFLOAT3(1.0f, 1.0f, 1.0f));
+
+	void
+	setPosition(unsigned int index, const XMFLOAT3& position);
+
+	// rotation es un cuaternion normalizado (x, y, z, w)
+	void
+	setRotation(unsigned int index, const XMFLOAT4& rotation);
+
+	// Atajo para rotaciones en angulos de Euler (radianes, mismo orden que XNA)
+	void
+	setRotationRollPitchYaw(unsigned int index, float pitch, float yaw, float roll);
+
+	void
+	setScale(unsigned int index, const XMFLOAT3& scale);
+
+	/**
+	 * Escribe la matriz de mundo transpuesta (16 floats, fila mayor) de los
+	 * objetos [begin, end) en dst + index * stride. Con stride =
+	 * sizeof(CBChangesEveryFrame) escribe directo sobre mWorld de un arreglo
+	 * de constantes. Rangos disjuntos se pueden componer en paralelo.
+	 */
+	void
+	composeWorldTransposed(unsigned int begin,
+												 unsigned int end,
+												 void* dst,
+												 unsigned int stride) const;
+
+	XMFLOAT3
+	getPosition(unsigned int index) const { return XMFLOAT3(m_posX[index], m_posY[index], m_posZ[index]); }
+
+	XMFLOAT4
+	getRotation(unsigned int index) const { return XMFLOAT4(m_rotX[index], m_rotY[index], m_rotZ[index], m_rotW[index]); }
+
+	XMFLOAT3
+	getScale(unsigned int index) const { return XMFLOAT3(m_scaleX[index], m_scaleY[index], m_scaleZ[index]); }
+
+	// Version escalar para un solo objeto (sin transponer)
+	XMMATRIX
+	getWorldMatrix(unsigned int index) const;
+
+	void
+	clear();
+
+	void
+	destroy();
+
+	unsigned int
+	size() const { return m_count; }
+
+private:
+	void
+	composeScalar(unsigned int index, float* out) const;
+
+	void
+	reserve(unsigned int capacity);
+
+private:
+	unsigned int m_count = 0;
+	std::vector<float> m_posX, m_posY, m_posZ;
+	std::vector<float> m_rotX, m_rotY, m_rotZ, m_rotW;
+	std::vector<float> m_scaleX, m_scaleY, m_scaleZ;
+};
@@ -0,0 +1,76 @@
+#pragma once
+#include <vector>
+
+// Estadisticas de un frame del ring
+struct
+UploadRingStats {
+	unsigned int frame = 0;
+	unsigned int allocations = 0;
+	unsigned int failedAllocations = 0;
+	unsigned int wraps = 0;
+	unsigned long long bytesRequested = 0;  // Bytes pedidos por el usuario
+	unsigned long long bytesConsumed = 0;   // Incluye alineacion y el hueco al dar la vuelta
+};
+
+/**
+ * @brief Suballocador lineal circular con fences por frame.
+ *
+ * Solo maneja offsets: no conoce D3D, por lo que se puede probar aislado.
+ * Cada frame reserva bloques alineados a partir de la cabeza; al cerrar el
+ * frame se guarda cuanto consumio. Un frame se considera terminado por la
+ * GPU cuando hay mas de framesInFlight frames cerrados despues de el, y solo
+ * entonces su memoria vuelve a estar disponible.
+ */
+class
+UploadRing {
+public:
+	static const unsigned int INVALID_OFFSET = 0xffffffff;
+
+	UploadRing()  = default;
+	~UploadRing() = default;
+
+	// alignment debe ser potencia de dos
+	bool
+	init(unsigned int capacity, unsigned int alignment, unsigned int framesInFlight);
+
+	// Libera los frames que ya no puede estar usando la GPU
+	void
+	beginFrame();
+
+	// Devuelve el offset del bloque o INVALID_OFFSET si el ring esta lleno
+	unsigned int
+	allocate(unsigned int size);
+
+	void
+	endFrame();
+
+	void
+	destroy();
+
+	unsigned int
+	getCapacity() const { return m_capacity; }
+
+	unsigned int
+	getUsed() const { return m_used; }
+
+	unsigned int
+	getFramesInFlight() const { return static_cast<unsigned int>(m_inFlight.size()); }
+
+	// Estadisticas del frame en curso y del ultimo frame cerrado
+	const UploadRingStats&
+	getCurrentStats() const { return m_current; }
+
+	const UploadRingStats&
+	getLastFrameStats() const { return m_lastFrame; }
+
+private:
+	unsigned int m_capacity = 0;
+	unsigned int m_alignment = 1;
+	unsigned int m_maxFramesInFlight = 0;
+	unsigned int m_head = 0;
+	unsigned int m_used = 0;
+	// Bytes consumidos por cada frame cerrado aun en vuelo (el mas viejo primero)
+	std::vector<unsigned int> m_inFlight;
+	UploadRingStats m_current;
+	UploadRingStats m_lastFrame;
+};
@@ -0,0 +1,131 @@
+#pragma once
+#include "Prerequisites.h"
+
+class MeshComponent;
+
+enum
+VertexPositionFormat {
+	VERTEX_POSITION_FLOAT3 = 0,   // R32G32B32_FLOAT, 12 bytes
+	VERTEX_POSITION_UNORM16       // R16G16B16A16_UNORM relativo a la caja de la malla, 8 bytes
+};
+
+enum
+VertexTexcoordFormat {
+	VERTEX_TEXCOORD_FLOAT2 = 0,   // R32G32_FLOAT, 8 bytes
+	VERTEX_TEXCOORD_HALF2         // R16G16_FLOAT, 4 bytes
+};
+
+enum
+VertexNormalFormat {
+	VERTEX_NORMAL_NONE = 0,
+	VERTEX_NORMAL_FLOAT3,         // R32G32B32_FLOAT, 12 bytes
+	VERTEX_NORMAL_OCT16           // Octaedrica en R16G16_SNORM, 4 bytes
+};
+
+enum
+VertexTangentFormat {
+	VERTEX_TANGENT_NONE = 0,
+	VERTEX_TANGENT_FLOAT4,        // R32G32B32A32_FLOAT (w = signo de la bitangente), 16 bytes
+	VERTEX_TANGENT_OCT16          // Octaedrica + signo en R16G16B16A16_SNORM, 8 bytes
+};
+
+struct
+VertexFormatDesc {
+	VertexPositionFormat position = VERTEX_POSITION_FLOAT3;
+	VertexTexcoordFormat texcoord = VERTEX_TEXCOORD_FLOAT2;
+	VertexNormalFormat normal = VERTEX_NORMAL_NONE;
+	VertexTangentFormat tangent = VERTEX_TANGENT_NONE;
+};
+
+/**
+ * @brief Formato de vertice configurable con atributos cuantizados.
+ *
+ * A partir del desc calcula offsets y stride, genera el layout de entrada y
+ * codifica/decodifica los vertices de un MeshComponent (mas normales y
+ * tangentes opcionales) con las rutinas SSE de abajo. Con posiciones UNORM16
+ * el shader recibe la posicion en [0, 1]: getDequantizeMatrix() devuelve la
+ * matriz que hay que anteponer a la de mundo (dequantize * world), asi los
+ * shaders existentes no cambian. El desc por defecto equivale a SimpleVertex.
+ */
+class
+VertexFormat {
+public:
+	VertexFormat()  = default;
+	~VertexFormat() = default;
+
+	void
+	init(const VertexFormatDesc& desc);
+
+	// Agrega los elementos de este formato a Layout en inputSlot
+	void
+	buildLayout(std::vector<D3D11_INPUT_ELEMENT_DESC>& Layout, unsigned int inputSlot = 0) const;
+
+	// Codifica los vertices de mesh; normals/tangents pueden ser nullptr si el
+	// formato no los usa. Con UNORM16 fija la caja de cuantizacion.
+	HRESULT
+	encode(const MeshComponent& mesh,
+				 const XMFLOAT3* normals,
+				 const XMFLOAT4* tangents,
+				 std::vector<unsigned char>& out);
+
+	// Inverso de encode(); normals/tangents pueden ser nullptr
+	void
+	decode(const void* data,
+				 unsigned int count,
+				 MeshComponent& mesh,
+				 XMFLOAT3* normals,
+				 XMFLOAT4* tangents) const;
+
+	// Escala y traslacion de [0, 1] a la caja original (identidad si FLOAT3)
+	XMMATRIX
+	getDequantizeMatrix() const;
+
+	unsigned int
+	getStride() const { return m_stride; }
+
+	const VertexFormatDesc&
+	getDesc() const { return m_desc; }
+
+private:
+	VertexFormatDesc m_desc;
+	unsigned int m_stride = 0;
+	unsigned int m_positionOffset = 0;
+	unsigned int m_texcoordOffset = 0;
+	unsigned int m_normalOffset = 0;
+	unsigned int m_tangentOffset = 0;
+	XMFLOAT3 m_quantizeMin = XMFLOAT3(0.0f, 0.0f, 0.0f);
+	XMFLOAT3 m_quantizeExtent = XMFLOAT3(1.0f, 1.0f, 1.0f);
+};
+
+// Rutinas SSE sobre arreglos con stride en bytes; procesan varios elementos
+// por registro y en el bloque final repiten el ultimo elemento
+
+// (p - minimum) / extent -> 4 x uint16 (w = 1)
+void
+EncodePositionsUnorm16(const void* src, unsigned int srcStride, unsigned int count,
+											 const XMFLOAT3& minimum, const XMFLOAT3& extent,
+											 void* dst, unsigned int dstStride);
+
+void
+DecodePositionsUnorm16(const void* src, unsigned int srcStride, unsigned int count,
+											 const XMFLOAT3& minimum, const XMFLOAT3& extent,
+											 void* dst, unsigned int dstStride);
+
+// 2 floats -> 2 halfs (redondeo al par mas cercano, inf/nan conservados)
+void
+EncodeHalf2(const void* src, unsigned int srcStride, unsigned int count,
+						void* dst, unsigned int dstStride);
+
+void
+DecodeHalf2(const void* src, unsigned int srcStride, unsigned int count,
+						void* dst, unsigned int dstStride);
+
+// Vector unitario -> octaedro en 2 x int16 snorm
+void
+EncodeOctahedral16(const void* src, unsigned int srcStride, unsigned int count,
+									 void* dst, unsigned int dstStride);
+
+// 2 x int16 snorm -> vector unitario (XMFLOAT3)
+void
+DecodeOctahedral16(const void* src, unsigned int srcStride, unsigned int count,
+									 void* dst, unsigned int dstStride);
@@ -0,0 +1,199 @@
+#include "AsyncLoader.h"
+#include "JobSystem.h"
+
+namespace {
+	typedef std::chrono::steady_clock Clock;
+
+	double
+	elapsedMs(Clock::time_point start) {
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+}
+
+void
+AsyncLoader::init(JobSystem& jobs) {
+	destroy();
+	m_jobs = &jobs;
+}
+
+void
+AsyncLoader::destroy() {
+	// Un work en vuelo todavia apunta a su tarea
+	while (m_running.load(std::memory_order_acquire) > 0) {
+		if (!m_jobs || !m_jobs->tryExecute()) {
+			std::this_thread::yield();
+		}
+	}
+	for (size_t i = 0; i < m_tasks.size(); ++i) {
+		delete m_tasks[i];
+	}
+	m_tasks.clear();
+	m_completed = 0;
+	m_started = false;
+	m_stats = AsyncLoadStats();
+}
+
+LoadTaskId
+AsyncLoader::add(const std::string& name,
+								 LoadFunction work,
+								 LoadFunction finish,
+								 void* data,
+								 const LoadTaskId* dependencies,
+								 unsigned int dependencyCount) {
+	LoadTask* task = new LoadTask();
+	task->name = name;
+	task->work = work;
+	task->finish = finish;
+	task->data = data;
+	task->state.store(LOAD_TASK_PENDING);
+	task->result = S_OK;
+	task->workMs = 0.0;
+	task->loader = this;
+	for (unsigned int i = 0; i < dependencyCount; ++i) {
+		// Solo hacia atras: el grafo no puede tener ciclos
+		if (dependencies[i] >= m_tasks.size()) {
+			ERROR("AsyncLoader", "add", ("Invalid dependency for task " + name).c_str());
+			continue;
+		}
+		task->dependencies.push_back(dependencies[i]);
+	}
+	m_tasks.push_back(task);
+	m_stats.tasks++;
+	return static_cast<LoadTaskId>(m_tasks.size() - 1);
+}
+
+LoadTaskId
+AsyncLoader::add(const std::string& name, LoadFunction work, LoadFunction finish, void* data, LoadTaskId dependency) {
+	return add(name, work, finish, data, &dependency, dependency == INVALID_LOAD_TASK ? 0 : 1);
+}
+
+void
+AsyncLoader::runWork(Job& job) {
+	LoadTask* task = static_cast<LoadTask*>(job.data);
+	Clock::time_point start = Clock::now();
+	task->result = task->work(task->data);
+	task->workMs = elapsedMs(start);
+	task->state.store(SUCCEEDED(task->result) ? LOAD_TASK_WORKED : LOAD_TASK_FAILED, std::memory_order_release);
+	task->loader->m_running.fetch_sub(1, std::memory_order_release);
+}
+
+void
+AsyncLoader::start() {
+	if (!m_started) {
+		m_started = true;
+		m_start = Clock::now();
+	}
+	update();
+}
+
+bool
+AsyncLoader::update() {
+	if (!m_jobs) {
+		ERROR("AsyncLoader", "update", "Not initialized.");
+		return false;
+	}
+	// Se repite mientras algo cambie: una cadena de finish() se resuelve en
+	// una sola llamada
+	bool progressed = true;
+	while (progressed) {
+		progressed = false;
+		for (size_t i = 0; i < m_tasks.size(); ++i) {
+			LoadTask& task = *m_tasks[i];
+			int state = task.state.load(std::memory_order_acquire);
+			if (state == LOAD_TASK_PENDING) {
+				bool ready = true;
+				bool dependencyFailed = false;
+				for (size_t d = 0; d < task.dependencies.size(); ++d) {
+					int dependency = m_tasks[task.dependencies[d]]->state.load(std::memory_order_acquire);
+					ready = ready && dependency == LOAD_TASK_DONE;
+					dependencyFailed = dependencyFailed || dependency == LOAD_TASK_FAILED;
+				}
+				if (dependencyFailed) {
+					task.result = E_ABORT;
+					task.state.store(LOAD_TASK_FAILED);
+					progressed = true;
+				}
+				else if (ready && task.work) {
+					task.state.store(LOAD_TASK_RUNNING);
+					m_running.fetch_add(1, std::memory_order_relaxed);
+					m_jobs->run(&AsyncLoader::runWork, &task, nullptr);
+				}
+				else if (ready) {
+					task.state.store(LOAD_TASK_WORKED);
+					state = LOAD_TASK_WORKED;
+				}
+			}
+			if (state == LOAD_TASK_WORKED) {
+				m_stats.workMs += task.workMs;
+				if (task.finish) {
+					Clock::time_point start = Clock::now();
+					task.result = task.finish(task.data);
+					m_stats.finishMs += elapsedMs(start);
+				}
+				task.state.store(SUCCEEDED(task.result) ? LOAD_TASK_DONE : LOAD_TASK_FAILED);
+				progressed = true;
+			}
+		}
+	}
+
+	unsigned int completed = 0;
+	unsigned int failed = 0;
+	for (size_t i = 0; i < m_tasks.size(); ++i) {
+		int state = m_tasks[i]->state.load(std::memory_order_acquire);
+		completed += state == LOAD_TASK_DONE || state == LOAD_TASK_FAILED ? 1 : 0;
+		failed += state == LOAD_TASK_FAILED ? 1 : 0;
+	}
+	m_completed = completed;
+	m_stats.failed = failed;
+	return m_completed < m_tasks.size();
+}
+
+HRESULT
+AsyncLoader::wait(LoadingFrameFunction frame, void* frameData, double frameIntervalMs) {
+	if (!m_started) {
+		start();
+	}
+	// El primer frame de carga sale de inmediato; despues uno por intervalo
+	Clock::time_point lastFrame = Clock::now();
+	bool firstFrame = true;
+	while (update()) {
+		if (frame && (firstFrame || elapsedMs(lastFrame) >= frameIntervalMs)) {
+			frame(getProgress(), frameData);
+			m_stats.loadingFrames++;
+			lastFrame = Clock::now();
+			firstFrame = false;
+		}
+		// Si los workers no alcanzan (o no hay), el hilo principal ayuda de a
+		// un job para volver pronto a update(); sin nada que ejecutar duerme
+		// en lugar de girar
+		if (!m_jobs->tryExecute()) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+	m_stats.wallMs = elapsedMs(m_start);
+
+	HRESULT hr = firstError();
+	for (size_t i = 0; i < m_tasks.size(); ++i) {
+		// Las que fallaron por una dependencia no repiten el error
+		if (FAILED(m_tasks[i]->result) && m_tasks[i]->result != E_ABORT) {
+			ERROR("AsyncLoader", "wait",
+				("Task " + m_tasks[i]->name + " failed. HRESULT: " + std::to_string(m_tasks[i]->result)).c_str());
+		}
+	}
+	return hr;
+}
+
+HRESULT
+AsyncLoader::firstError() const {
+	for (size_t i = 0; i < m_tasks.size(); ++i) {
+		if (FAILED(m_tasks[i]->result)) {
+			return m_tasks[i]->result;
+		}
+	}
+	return S_OK;
+}
+
+float
+AsyncLoader::getProgress() const {
+	return m_tasks.empty() ? 1.0f : static_cast<float>(m_completed) / m_tasks.size();
+}
@@ -1,4 +1,14 @@
 #include "BaseApp.h"
+#include <chrono>
+
+namespace {
+	typedef std::chrono::steady_clock Clock;
+
+	double
+	elapsedMs(Clock::time_point start, Clock::time_point end) {
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	}
+}
 
 HRESULT BaseApp::init()
 {
@@ -6,17 +16,17 @@ HRESULT BaseApp::init()
 }
 
 
-void 
-BaseApp::update() {
+void
+BaseApp::update(FramePacket& packet) {
 
 }
 
-void 
-BaseApp::render() {
+void
+BaseApp::render(const FramePacket& packet) {
 
 }
 
-void 
+void
 BaseApp::destroy() {
 
 }
@@ -27,6 +37,159 @@ BaseApp::run(HINSTANCE hInstance,
 						 LPWSTR lpCmdLine,
 						 int nCmdShow,
 						 WNDPROC wndproc) {
+	UNREFERENCED_PARAMETER(hPrevInstance);
+	UNREFERENCED_PARAMETER(lpCmdLine);
+
+	if (FAILED(m_window.init(hInstance, nCmdShow, wndproc))) {
+		return 0;
+	}
+	if (FAILED(init())) {
+		destroy();
+		return 0;
+	}
+
+	startPipeline();
+
+	// Bucle principal de mensajes
+	MSG msg = { 0 };
+	while (WM_QUIT != msg.message) {
+		if (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) {
+			TranslateMessage(&msg);
+			DispatchMessage(&msg);
+		}
+		else {
+			frame();
+		}
+	}
+
+	stopPipeline();
+	OutputDebugStringA(pipelineSummary().c_str());
+	destroy();
+
+	return (int)msg.wParam;
+}
+
+HRESULT
+BaseApp::runFrames(unsigned int frameCount) {
+	HRESULT hr = init();
+	if (FAILED(hr)) {
+		return hr;
+	}
+	startPipeline();
+	for (unsigned int i = 0; i < frameCount; ++i) {
+		frame();
+	}
+	stopPipeline();
+	// Cada frame simulado se tiene que haber dibujado una vez
+	if (m_rendered != m_simulated || m_stats.frames != frameCount) {
+		ERROR("BaseApp", "runFrames", "The pipeline did not render every simulated frame.");
+		return E_FAIL;
+	}
+	return S_OK;
+}
+
+std::string
+BaseApp::pipelineSummary() const {
+	std::ostringstream os;
+	double frames = m_stats.frames > 0 ? static_cast<double>(m_stats.frames) : 1.0;
+	os << "Pipeline depth=" << m_pipelineDepth
+		 << " frames=" << m_stats.frames
+		 << " simulate=" << m_stats.simulateMs / frames << "ms"
+		 << " render=" << m_stats.renderMs / frames << "ms"
+		 << " simulateWait=" << m_stats.simulateWaitMs / frames << "ms"
+		 << " renderWait=" << m_stats.renderWaitMs / frames << "ms\n";
+	return os.str();
+}
 
-	return 0;
-}
\ No newline at end of file
+void
+BaseApp::startPipeline() {
+	m_packets.assign(m_pipelineDepth, FramePacket());
+	m_simulated = 0;
+	m_rendered = 0;
+	m_stopRender = false;
+	m_stats = PipelineStats();
+	if (m_pipelineDepth > 1) {
+		m_renderThread = std::thread(&BaseApp::renderLoop, this);
+	}
+}
+
+void
+BaseApp::frame() {
+	if (m_pipelineDepth <= 1) {
+		// Sin pipeline: simular y dibujar en serie
+		FramePacket& packet = m_packets[0];
+		packet.frame = m_simulated;
+		Clock::time_point start = Clock::now();
+		update(packet);
+		Clock::time_point simulated = Clock::now();
+		render(packet);
+		Clock::time_point rendered = Clock::now();
+		m_stats.simulateMs += elapsedMs(start, simulated);
+		m_stats.renderMs += elapsedMs(simulated, rendered);
+		m_stats.frames++;
+		m_simulated++;
+		m_rendered++;
+		return;
+	}
+
+	// Esperar a que el render libere el paquete que toca escribir
+	Clock::time_point waitStart = Clock::now();
+	{
+		std::unique_lock<std::mutex> guard(m_pipelineLock);
+		m_packetFree.wait(guard, [this] { return m_simulated - m_rendered < m_pipelineDepth; });
+	}
+	Clock::time_point start = Clock::now();
+
+	FramePacket& packet = m_packets[m_simulated % m_pipelineDepth];
+	packet.frame = m_simulated;
+	update(packet);
+
+	m_stats.simulateWaitMs += elapsedMs(waitStart, start);
+	m_stats.simulateMs += elapsedMs(start, Clock::now());
+	{
+		std::lock_guard<std::mutex> guard(m_pipelineLock);
+		m_simulated++;
+	}
+	m_packetReady.notify_one();
+}
+
+void
+BaseApp::stopPipeline() {
+	if (!m_renderThread.joinable()) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> guard(m_pipelineLock);
+		m_stopRender = true;
+	}
+	m_packetReady.notify_one();
+	m_renderThread.join();
+}
+
+void
+BaseApp::renderLoop() {
+	for (;;) {
+		Clock::time_point waitStart = Clock::now();
+		{
+			std::unique_lock<std::mutex> guard(m_pipelineLock);
+			m_packetReady.wait(guard, [this] { return m_rendered < m_simulated || m_stopRender; });
+			// Al detenerse se dibujan primero los paquetes pendientes
+			if (m_rendered == m_simulated) {
+				return;
+			}
+		}
+		Clock::time_point start = Clock::now();
+
+		render(m_packets[m_rendered % m_pipelineDepth]);
+
+		Clock::time_point end = Clock::now();
+		m_stats.renderWaitMs += elapsedMs(waitStart, start);
+		m_stats.renderMs += elapsedMs(start, end);
+		{
+			std::lock_guard<std::mutex> guard(m_pipelineLock);
+			m_rendered++;
+			m_stats.frames++;
+		}
+		m_packetFree.notify_one();
+	}
+}
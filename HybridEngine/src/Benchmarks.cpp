@@ -0,0 +1,2122 @@
+#include "Benchmarks.h"
+#include "UploadRing.h"
+#include "JobSystem.h"
+#include "TransformSystem.h"
+#include "SceneGraph.h"
+#include "ECS/World.h"
+#include "ECS/CommandBuffer.h"
+#include "ECS/Components.h"
+#include "FrustumCuller.h"
+#include "OcclusionCuller.h"
+#include "ObjLoader.h"
+#include "MeshComponent.h"
+#include "MeshFile.h"
+#include "MeshOptimizer.h"
+#include "VertexFormat.h"
+#include "MeshSimplifier.h"
+#include "Meshlet.h"
+#include "MeshletCuller.h"
+#include "ShaderCache.h"
+#include "ShaderPermutations.h"
+#include "AsyncLoader.h"
+#include "ParameterBlock.h"
+#include "FileWatcher.h"
+#include "HotReloader.h"
+#include "DeviceContext.h"
+#include "ShaderProgram.h"
+#include "NullBackend.h"
+#include "Device.h"
+#include "Bounds.h"
+#include "MathConversions.h"
+#include <cstdio>
+#include <cstring>
+#include <array>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace {
+	typedef std::chrono::steady_clock Clock;
+
+	double
+	elapsedMs(Clock::time_point start) {
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	// Los benchmarks que verifican resultados tambien escriben en stdout para
+	// que un script pueda leerlos junto con el codigo de salida
+	void
+	report(const std::string& text) {
+		OutputDebugStringA(text.c_str());
+		fputs(text.c_str(), stdout);
+		fflush(stdout);
+	}
+
+	void
+	emptyJob(Job& job) {
+	}
+
+	// Retiene a sus dependientes hasta que se suelte el flag
+	void
+	gateJob(Job& job) {
+		std::atomic<bool>& open = *static_cast<std::atomic<bool>*>(job.data);
+		while (!open.load(std::memory_order_acquire)) {
+			std::this_thread::yield();
+		}
+	}
+
+	void
+	countJob(Job& job) {
+		static_cast<std::atomic<unsigned int>*>(job.data)->fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// Modelo anterior: un objeto en el heap con update() virtual
+	class
+	VirtualComponent {
+	public:
+		virtual
+		~VirtualComponent() = default;
+
+		virtual void
+		update(float deltaTime) = 0;
+	};
+
+	class
+	VirtualMover : public VirtualComponent {
+	public:
+		void
+		update(float deltaTime) override {
+			m_transform.position.x += m_velocity.linear.x * deltaTime;
+			m_transform.position.y += m_velocity.linear.y * deltaTime;
+			m_transform.position.z += m_velocity.linear.z * deltaTime;
+		}
+
+		TransformComponent m_transform;
+		VelocityComponent m_velocity;
+	};
+
+	// Triangulos como vertices completos, rotados para empezar por el menor
+	// (se conserva el winding) y ordenados: no depende del orden de los
+	// triangulos ni del de los vertices
+	std::vector<std::array<float, 15> >
+	triangleSet(const MeshComponent& mesh) {
+		std::vector<std::array<float, 15> > triangles(mesh.m_index.size() / 3);
+		for (size_t t = 0; t < triangles.size(); ++t) {
+			const SimpleVertex* corners[3];
+			for (int k = 0; k < 3; ++k) {
+				corners[k] = &mesh.m_vertex[mesh.m_index[t * 3 + k]];
+			}
+			int first = 0;
+			for (int k = 1; k < 3; ++k) {
+				if (memcmp(corners[k], corners[first], sizeof(SimpleVertex)) < 0) {
+					first = k;
+				}
+			}
+			for (int k = 0; k < 3; ++k) {
+				memcpy(&triangles[t][k * 5], corners[(first + k) % 3], sizeof(SimpleVertex));
+			}
+		}
+		std::sort(triangles.begin(), triangles.end());
+		return triangles;
+	}
+
+	// Rejilla sintetica de grid x grid quads en texto OBJ con v/vt/vn; los
+	// vertices compartidos deben quedar deduplicados a (grid + 1)^2
+	std::string
+	makeSyntheticObj(unsigned int grid) {
+		std::string text;
+		text.reserve(64u * 1024u * 1024u);
+		char line[128];
+		for (unsigned int z = 0; z <= grid; ++z) {
+			for (unsigned int x = 0; x <= grid; ++x) {
+				int n = snprintf(line, sizeof(line), "v %.6f %.6f %.6f\nvt %.6f %.6f\n",
+												 x * 0.1f, sinf(x * 0.05f) * cosf(z * 0.05f), z * 0.1f,
+												 static_cast<float>(x) / grid, static_cast<float>(z) / grid);
+				text.append(line, n);
+			}
+		}
+		text += "vn 0.000000 1.000000 0.000000\n";
+		for (unsigned int z = 0; z < grid; ++z) {
+			for (unsigned int x = 0; x < grid; ++x) {
+				unsigned int a = z * (grid + 1) + x + 1;
+				unsigned int b = a + 1;
+				unsigned int c = a + grid + 2;
+				unsigned int d = a + grid + 1;
+				int n = snprintf(line, sizeof(line), "f %u/%u/1 %u/%u/1 %u/%u/1 %u/%u/1\n", a, a, b, b, c, c, d, d);
+				text.append(line, n);
+			}
+		}
+		return text;
+	}
+
+	// Referencias escalares para -vertexformatbench; deben producir los mismos bits
+	unsigned short
+	floatToHalfScalar(float value) {
+		unsigned int bits;
+		memcpy(&bits, &value, sizeof(bits));
+		unsigned int sign = bits & 0x80000000u;
+		bits ^= sign;
+		unsigned short result;
+		if (bits >= ((127 + 16) << 23)) {
+			result = bits > (255u << 23) ? 0x7e00 : 0x7c00;
+		}
+		else if (bits < ((127 - 14) << 23)) {
+			const unsigned int magicBits = ((127 - 15) + (23 - 10) + 1) << 23;
+			float magic;
+			memcpy(&magic, &magicBits, sizeof(magic));
+			float absolute;
+			memcpy(&absolute, &bits, sizeof(absolute));
+			float sum = absolute + magic;
+			unsigned int sumBits;
+			memcpy(&sumBits, &sum, sizeof(sumBits));
+			result = static_cast<unsigned short>(sumBits - magicBits);
+		}
+		else {
+			unsigned int mantissaOdd = (bits >> 13) & 1;
+			bits += (0xfff - ((127 - 15) << 23)) + mantissaOdd;
+			result = static_cast<unsigned short>(bits >> 13);
+		}
+		return static_cast<unsigned short>(result | (sign >> 16));
+	}
+
+	void
+	encodeOctahedralScalar(const XMFLOAT3& n, short* out) {
+		float sum = fabsf(n.x) + fabsf(n.y) + fabsf(n.z);
+		float inv = 1.0f / (sum > 1e-20f ? sum : 1e-20f);
+		float x = n.x * inv;
+		float y = n.y * inv;
+		if (n.z < 0.0f) {
+			float foldX = copysignf(1.0f - fabsf(y), x);
+			float foldY = copysignf(1.0f - fabsf(x), y);
+			x = foldX;
+			y = foldY;
+		}
+		out[0] = static_cast<short>(lrintf(x * 32767.0f));
+		out[1] = static_cast<short>(lrintf(y * 32767.0f));
+	}
+
+	// Mismo layout que VertexFormat con posiciones UNORM16, HALF2 y OCT16
+	void
+	encodeVerticesScalar(const std::vector<SimpleVertex>& vertices,
+											 const std::vector<XMFLOAT3>& normals,
+											 const std::vector<XMFLOAT4>& tangents,
+											 const XMFLOAT3& minimum,
+											 const XMFLOAT3& extent,
+											 std::vector<unsigned char>& out) {
+		const unsigned int stride = 24;
+		out.assign(vertices.size() * stride, 0);
+		const float scale[3] = { extent.x > 0.0f ? 65535.0f / extent.x : 0.0f,
+														 extent.y > 0.0f ? 65535.0f / extent.y : 0.0f,
+														 extent.z > 0.0f ? 65535.0f / extent.z : 0.0f };
+		for (size_t i = 0; i < vertices.size(); ++i) {
+			unsigned char* vertex = &out[i * stride];
+			const float position[3] = { vertices[i].Pos.x - minimum.x,
+																	vertices[i].Pos.y - minimum.y,
+																	vertices[i].Pos.z - minimum.z };
+			unsigned short quantized[4] = { 0, 0, 0, 65535 };
+			for (int k = 0; k < 3; ++k) {
+				float q = position[k] * scale[k] + 0.5f;
+				q = q < 0.0f ? 0.0f : (q > 65535.0f ? 65535.0f : q);
+				quantized[k] = static_cast<unsigned short>(q);
+			}
+			memcpy(vertex, quantized, sizeof(quantized));
+			unsigned short texcoord[2] = { floatToHalfScalar(vertices[i].Tex.x), floatToHalfScalar(vertices[i].Tex.y) };
+			memcpy(vertex + 8, texcoord, sizeof(texcoord));
+			short octahedral[4] = { 0, 0, 0, 0 };
+			encodeOctahedralScalar(normals[i], octahedral);
+			memcpy(vertex + 12, octahedral, 4);
+			encodeOctahedralScalar(XMFLOAT3(tangents[i].x, tangents[i].y, tangents[i].z), octahedral);
+			octahedral[2] = static_cast<short>(tangents[i].w < 0.0f ? -32767 : 32767);
+			memcpy(vertex + 16, octahedral, sizeof(octahedral));
+		}
+	}
+
+	// Tarea sintetica de carga: work() gira workMs en la CPU (compilar,
+	// decodificar) y cada parte anota su turno en un reloj compartido
+	struct
+	LoadBenchTask {
+		double workMs;
+		bool fail;
+		unsigned int workStamp;
+		unsigned int finishStamp;
+		std::atomic<unsigned int>* clock;
+	};
+
+	HRESULT
+	loadBenchWork(void* data) {
+		LoadBenchTask& task = *static_cast<LoadBenchTask*>(data);
+		task.workStamp = task.clock->fetch_add(1);
+		Clock::time_point start = Clock::now();
+		while (elapsedMs(start) < task.workMs) {
+		}
+		return task.fail ? E_FAIL : S_OK;
+	}
+
+	HRESULT
+	loadBenchFinish(void* data) {
+		LoadBenchTask& task = *static_cast<LoadBenchTask*>(data);
+		task.finishStamp = task.clock->fetch_add(1);
+		return S_OK;
+	}
+
+	void
+	loadBenchFrame(float progress, void* data) {
+		*static_cast<float*>(data) = progress;
+	}
+
+	// Espejo de C++ del cbuffer sintetico del benchmark de ParameterBlock
+	struct
+	CBCameraBench {
+		XMMATRIX View;
+		XMMATRIX Projection;
+		XMFLOAT3 EyePos;
+	};
+
+	ShaderParameter
+	makeParameter(const char* name, unsigned int offset, unsigned int size,
+								D3D_SHADER_VARIABLE_CLASS variableClass, unsigned int rows, unsigned int columns) {
+		ShaderParameter parameter;
+		parameter.name = name;
+		parameter.offset = offset;
+		parameter.size = size;
+		parameter.variableClass = variableClass;
+		parameter.type = D3D_SVT_FLOAT;
+		parameter.rows = rows;
+		parameter.columns = columns;
+		parameter.elements = 0;
+		return parameter;
+	}
+
+	void
+	writeTextFile(const char* path, const std::string& text) {
+		FILE* file = fopen(path, "wb");
+		if (file) {
+			fwrite(text.data(), 1, text.size(), file);
+			fclose(file);
+		}
+	}
+
+	// Shader de -hotreloadbench; layoutChange agrega un miembro al cbuffer
+	std::string
+	makeHotReloadShader(const char* color, bool layoutChange) {
+		std::string text = "cbuffer cbFrame : register( b0 )\n{\n";
+		if (layoutChange) {
+			text += "    float4 Offset;\n";
+		}
+		text += "    matrix WorldViewProjection;\n};\n"
+						"struct VS_INPUT { float4 Pos : POSITION; float2 Tex : TEXCOORD0; };\n"
+						"struct PS_INPUT { float4 Pos : SV_POSITION; float2 Tex : TEXCOORD0; };\n"
+						"PS_INPUT VS( VS_INPUT input )\n{\n"
+						"    PS_INPUT output;\n"
+						"    output.Pos = mul( float4( input.Pos.xyz, 1.0f ), WorldViewProjection );\n";
+		if (layoutChange) {
+			text += "    output.Pos += Offset;\n";
+		}
+		text += "    output.Tex = input.Tex;\n    return output;\n}\n"
+						"float4 PS( PS_INPUT input ) : SV_Target\n{\n    return float4( ";
+		text += color;
+		text += " );\n}\n";
+		return text;
+	}
+
+	// Llama a update() como lo haria el frame loop hasta que el reloader
+	// termine target recargas (buenas o fallidas); devuelve la latencia
+	double
+	pumpHotReload(HotReloader& reloader, unsigned int target, double& longestUpdateMs) {
+		Clock::time_point start = Clock::now();
+		while (reloader.getStats().reloads + reloader.getStats().failed < target && elapsedMs(start) < 5000.0) {
+			Clock::time_point frame = Clock::now();
+			reloader.update();
+			longestUpdateMs = std::max(longestUpdateMs, elapsedMs(frame));
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		}
+		return elapsedMs(start);
+	}
+}
+
+bool
+RunUploadRingBenchmark() {
+	// Casos conocidos con slices de 256 bytes (como los constant buffers) y
+	// un frame en vuelo: el frame 2 tiene que dar la vuelta y el 3 reusa lo
+	// que libero el frame 1
+	UploadRing ring;
+	ring.init(1024, 256, 1);
+	bool wrapOk = true;
+	bool retireOk = true;
+	bool failOk = true;
+
+	ring.beginFrame();
+	wrapOk = wrapOk && ring.allocate(500) == 0;
+	ring.endFrame();
+
+	ring.beginFrame();
+	wrapOk = wrapOk && ring.allocate(200) == 512;
+	ring.endFrame();
+
+	// El frame 0 ya termino: quedan [512, 768) en uso y la cabeza en 768
+	ring.beginFrame();
+	retireOk = retireOk && ring.getUsed() == 256;
+	wrapOk = wrapOk && ring.allocate(512) == 0;
+	wrapOk = wrapOk && ring.getCurrentStats().wraps == 1 && ring.getCurrentStats().bytesConsumed == 768;
+	// Lleno, y mas grande que el ring
+	failOk = failOk && ring.allocate(1) == UploadRing::INVALID_OFFSET;
+	failOk = failOk && ring.allocate(2048) == UploadRing::INVALID_OFFSET;
+	failOk = failOk && ring.allocate(0) == UploadRing::INVALID_OFFSET;
+	failOk = failOk && ring.getCurrentStats().failedAllocations == 3 && ring.getCurrentStats().allocations == 1;
+	ring.endFrame();
+
+	// Se libera el frame 1 y su hueco vuelve a estar disponible
+	ring.beginFrame();
+	retireOk = retireOk && ring.getUsed() == 768;
+	retireOk = retireOk && ring.allocate(256) == 512;
+	failOk = failOk && ring.allocate(256) == UploadRing::INVALID_OFFSET;
+	ring.endFrame();
+	ring.destroy();
+
+	// Costo por asignacion: 2 frames en vuelo y 1000 slices por frame
+	const unsigned int frames = 1000;
+	const unsigned int perFrame = 1000;
+	ring.init(4 * 1024 * 1024, 256, 2);
+	unsigned long long failed = 0;
+	Clock::time_point start = Clock::now();
+	for (unsigned int f = 0; f < frames; ++f) {
+		ring.beginFrame();
+		for (unsigned int i = 0; i < perFrame; ++i) {
+			failed += ring.allocate(64 + (i % 7) * 96) == UploadRing::INVALID_OFFSET ? 1 : 0;
+		}
+		ring.endFrame();
+	}
+	double allocNs = elapsedMs(start) * 1000000.0 / (frames * perFrame);
+	ring.destroy();
+
+	std::ostringstream os;
+	os << "UploadRing ns/allocate=" << allocNs << " failed=" << failed
+		 << " wrap" << (wrapOk ? " OK" : " MISMATCH")
+		 << " retire" << (retireOk ? " OK" : " MISMATCH")
+		 << " over budget" << (failOk ? " OK" : " MISMATCH") << "\n";
+	report(os.str());
+	return wrapOk && retireOk && failOk && failed == 0;
+}
+
+bool
+RunJobBenchmark() {
+	const unsigned int jobCount = 100000;
+	const unsigned int elementCount = 1 << 22;
+	std::vector<float> data(elementCount, 1.0f);
+
+	unsigned int maxThreads = std::thread::hardware_concurrency();
+	if (maxThreads == 0) {
+		maxThreads = 1;
+	}
+
+	std::ostringstream os;
+	double baseMs = 0.0;
+	for (unsigned int threads = 1; threads <= maxThreads; ++threads) {
+		JobSystem jobs;
+		jobs.init(threads - 1);
+
+		// Planificacion: jobs vacios lanzados desde el hilo principal
+		JobCounter counter;
+		Clock::time_point start = Clock::now();
+		for (unsigned int i = 0; i < jobCount; ++i) {
+			jobs.run(&emptyJob, nullptr, &counter);
+			if ((i & (JobSystem::JOB_POOL_SIZE / 2 - 1)) == 0) {
+				jobs.wait(counter);
+			}
+		}
+		jobs.wait(counter);
+		double scheduleNs = elapsedMs(start) * 1000000.0 / jobCount;
+
+		// Escalado: parallelFor sobre un arreglo grande
+		start = Clock::now();
+		for (unsigned int pass = 0; pass < 10; ++pass) {
+			jobs.parallelFor(elementCount, 4096, [&data](unsigned int begin, unsigned int end) {
+				for (unsigned int i = begin; i < end; ++i) {
+					data[i] = data[i] * 0.999f + 0.001f;
+				}
+			});
+		}
+		double forMs = elapsedMs(start) / 10.0;
+		if (threads == 1) {
+			baseMs = forMs;
+		}
+
+		// Las estadisticas se leen con los workers ya detenidos
+		unsigned int threadCount = jobs.getThreadCount();
+		jobs.destroy();
+		JobWorkerStats stats = jobs.getStats();
+		os << "JobSystem threads=" << threadCount
+			 << " ns/job=" << scheduleNs
+			 << " parallelFor=" << forMs << "ms"
+			 << " speedup=" << (forMs > 0.0 ? baseMs / forMs : 0.0)
+			 << " stolen=" << stats.stolen
+			 << " inlined=" << stats.inlined
+			 << " heap=" << stats.heapJobs << "\n";
+	}
+
+	// Un sistema de vida corta no le quita el indice 0 al hilo en otro, y mas
+	// de JOB_POOL_SIZE jobs vivos en un hilo (esperando a gate) no se pisan
+	JobSystem outer;
+	outer.init(0);
+	{
+		JobSystem inner;
+		inner.init(0);
+		inner.destroy();
+	}
+	bool indexOk = outer.getThreadIndex() == 0;
+	const unsigned int liveJobs = JobSystem::JOB_POOL_SIZE + 1000;
+	std::atomic<unsigned int> ran(0);
+	std::atomic<bool> open(false);
+	JobCounter gate;
+	JobCounter counter;
+	outer.run(&gateJob, &open, &gate);
+	for (unsigned int i = 0; i < liveJobs; ++i) {
+		outer.run(&countJob, &ran, &counter, 0, 0, &gate);
+	}
+	open.store(true, std::memory_order_release);
+	outer.wait(counter);
+	outer.destroy();
+	bool poolOk = ran.load() == liveJobs && outer.getStats().heapJobs == liveJobs - JobSystem::JOB_POOL_SIZE + 1;
+	os << "  nested systems" << (indexOk ? " OK" : " MISMATCH")
+		 << " live jobs=" << liveJobs << (poolOk ? " OK" : " MISMATCH") << "\n";
+	report(os.str());
+	return indexOk && poolOk;
+}
+
+bool
+RunTransformBenchmark() {
+	const unsigned int counts[] = { 1000, 10000, 100000 };
+	const unsigned int passes = 20;
+
+	JobSystem jobs;
+	jobs.init();
+
+	std::ostringstream os;
+	bool composeOk = true;
+	for (unsigned int c = 0; c < 3; ++c) {
+		unsigned int count = counts[c];
+
+		// Mismos datos en AoS (camino actual) y en SoA
+		std::vector<XMFLOAT3> positions(count);
+		std::vector<XMFLOAT4> rotations(count);
+		std::vector<XMFLOAT3> scales(count);
+		TransformSystem transforms;
+		transforms.init(count);
+		for (unsigned int i = 0; i < count; ++i) {
+			positions[i] = XMFLOAT3(static_cast<float>(i % 100), 0.0f, static_cast<float>(i / 100));
+			XMStoreFloat4(&rotations[i], XMQuaternionRotationRollPitchYaw(0.1f * i, 0.2f * i, 0.0f));
+			scales[i] = XMFLOAT3(1.0f, 1.0f, 1.0f);
+			transforms.create(positions[i], rotations[i], scales[i]);
+		}
+		std::vector<CBChangesEveryFrame> constants(count);
+
+		// XMMATRIX por objeto: S * R * T y transpuesta
+		Clock::time_point start = Clock::now();
+		for (unsigned int pass = 0; pass < passes; ++pass) {
+			for (unsigned int i = 0; i < count; ++i) {
+				XMMATRIX world = XMMatrixScaling(scales[i].x, scales[i].y, scales[i].z) *
+												 XMMatrixRotationQuaternion(XMLoadFloat4(&rotations[i])) *
+												 XMMatrixTranslation(positions[i].x, positions[i].y, positions[i].z);
+				constants[i].mWorld = XMMatrixTranspose(world);
+			}
+		}
+		double scalarMs = elapsedMs(start) / passes;
+		std::vector<CBChangesEveryFrame> expected(constants);
+
+		// SoA en un hilo
+		start = Clock::now();
+		for (unsigned int pass = 0; pass < passes; ++pass) {
+			transforms.composeWorldTransposed(0, count, &constants[0].mWorld, sizeof(CBChangesEveryFrame));
+		}
+		double soaMs = elapsedMs(start) / passes;
+
+		// SoA repartido con parallelFor (rangos multiplos de 8)
+		start = Clock::now();
+		for (unsigned int pass = 0; pass < passes; ++pass) {
+			jobs.parallelFor((count + 7) / 8, 128, [&](unsigned int begin, unsigned int end) {
+				transforms.composeWorldTransposed(begin * 8, end * 8, &constants[0].mWorld, sizeof(CBChangesEveryFrame));
+			});
+		}
+		double parallelMs = elapsedMs(start) / passes;
+
+		bool countOk = true;
+		for (unsigned int i = 0; countOk && i < count; ++i) {
+			XMFLOAT4X4 world;
+			XMFLOAT4X4 reference;
+			XMStoreFloat4x4(&world, constants[i].mWorld);
+			XMStoreFloat4x4(&reference, expected[i].mWorld);
+			for (int r = 0; r < 4; ++r) {
+				for (int k = 0; k < 4; ++k) {
+					countOk = countOk && fabsf(world.m[r][k] - reference.m[r][k]) <= 1e-3f * (1.0f + fabsf(reference.m[r][k]));
+				}
+			}
+		}
+		composeOk = composeOk && countOk;
+
+		os << "Transforms count=" << count
+			 << " xmmatrix=" << scalarMs << "ms"
+			 << " soa=" << soaMs << "ms (x" << (soaMs > 0.0 ? scalarMs / soaMs : 0.0) << ")"
+			 << " soaParallel=" << parallelMs << "ms (x" << (parallelMs > 0.0 ? scalarMs / parallelMs : 0.0) << ")"
+			 << (countOk ? " OK" : " MISMATCH") << "\n";
+	}
+	jobs.destroy();
+
+	// SceneGraph: las locales pasan por el mismo compose y los mundos deben
+	// coincidir con S * R * T * padre en XMMATRIX (cadenas de 8 nodos)
+	const unsigned int nodeCount = 100000;
+	SceneGraph graph;
+	graph.init(nodeCount);
+	std::vector<SceneNodeId> nodes(nodeCount);
+	std::vector<XMFLOAT4X4> reference(nodeCount);
+	for (unsigned int i = 0; i < nodeCount; ++i) {
+		XMFLOAT3 position(static_cast<float>(i % 100), 0.5f, static_cast<float>(i / 100));
+		XMFLOAT4 rotation;
+		XMStoreFloat4(&rotation, XMQuaternionRotationRollPitchYaw(0.1f * i, 0.2f * i, 0.0f));
+		XMFLOAT3 scale(1.0f + (i % 3) * 0.25f, 1.0f, 1.0f);
+		bool root = (i % 8) == 0;
+		nodes[i] = graph.createNode(root ? INVALID_SCENE_NODE : nodes[i - 1], position, rotation, scale);
+		XMMATRIX world = XMMatrixScaling(scale.x, scale.y, scale.z) *
+										 XMMatrixRotationQuaternion(XMLoadFloat4(&rotation)) *
+										 XMMatrixTranslation(position.x, position.y, position.z);
+		if (!root) {
+			world = world * XMLoadFloat4x4(&reference[i - 1]);
+		}
+		XMStoreFloat4x4(&reference[i], world);
+	}
+	Clock::time_point start = Clock::now();
+	graph.update();
+	double graphMs = elapsedMs(start);
+	bool graphOk = graph.getStats().updated == nodeCount;
+	for (unsigned int i = 0; graphOk && i < nodeCount; ++i) {
+		XMFLOAT4X4 world;
+		XMStoreFloat4x4(&world, graph.getWorldMatrix(nodes[i]));
+		for (int r = 0; r < 4; ++r) {
+			for (int c = 0; c < 4; ++c) {
+				float expected = reference[i].m[r][c];
+				graphOk = graphOk && fabsf(world.m[r][c] - expected) <= 1e-3f * (1.0f + fabsf(expected));
+			}
+		}
+	}
+	// Sin cambios no se recalcula nada
+	graph.update();
+	graphOk = graphOk && graph.getStats().updated == 0;
+	graph.destroy();
+	os << "SceneGraph nodes=" << nodeCount << " update=" << graphMs << "ms"
+		 << (graphOk ? " OK" : " MISMATCH") << "\n";
+	report(os.str());
+	return composeOk && graphOk;
+}
+
+bool
+RunEcsBenchmark() {
+	const unsigned int count = 100000;
+	const unsigned int passes = 50;
+	const float deltaTime = 1.0f / 60.0f;
+
+	JobSystem jobs;
+	jobs.init();
+
+	// Objetos con update() virtual, creados en orden aleatorio como en una escena real
+	std::vector<VirtualComponent*> objects(count);
+	for (unsigned int i = 0; i < count; ++i) {
+		VirtualMover* mover = new VirtualMover();
+		mover->m_transform.position = XMFLOAT3(0.0f, 0.0f, 0.0f);
+		mover->m_velocity.linear = XMFLOAT3(1.0f, 0.0f, static_cast<float>(i % 7));
+		objects[i] = mover;
+	}
+	for (unsigned int i = count - 1; i > 0; --i) {
+		std::swap(objects[i], objects[(i * 2654435761u) % (i + 1)]);
+	}
+
+	// Mismos datos en el ECS; la alta se hace con un command buffer
+	EntityWorld world;
+	EntityCommandBuffer commands;
+	Clock::time_point start = Clock::now();
+	for (unsigned int i = 0; i < count; ++i) {
+		Entity entity = commands.create();
+		TransformComponent transform = { XMFLOAT3(0.0f, 0.0f, 0.0f), XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f), XMFLOAT3(1.0f, 1.0f, 1.0f) };
+		VelocityComponent velocity = { XMFLOAT3(1.0f, 0.0f, static_cast<float>(i % 7)), 0.0f };
+		commands.add(entity, transform);
+		commands.add(entity, velocity);
+	}
+	commands.playback(world);
+	double createMs = elapsedMs(start);
+
+	start = Clock::now();
+	for (unsigned int pass = 0; pass < passes; ++pass) {
+		for (unsigned int i = 0; i < count; ++i) {
+			objects[i]->update(deltaTime);
+		}
+	}
+	double virtualMs = elapsedMs(start) / passes;
+
+	auto move = [deltaTime](unsigned int n, Entity*, TransformComponent* transforms, VelocityComponent* velocities) {
+		for (unsigned int i = 0; i < n; ++i) {
+			transforms[i].position.x += velocities[i].linear.x * deltaTime;
+			transforms[i].position.y += velocities[i].linear.y * deltaTime;
+			transforms[i].position.z += velocities[i].linear.z * deltaTime;
+		}
+	};
+
+	start = Clock::now();
+	for (unsigned int pass = 0; pass < passes; ++pass) {
+		world.forEachChunk<TransformComponent, VelocityComponent>(move);
+	}
+	double chunkMs = elapsedMs(start) / passes;
+
+	start = Clock::now();
+	for (unsigned int pass = 0; pass < passes; ++pass) {
+		world.forEachChunkParallel<TransformComponent, VelocityComponent>(jobs, move);
+	}
+	double parallelMs = elapsedMs(start) / passes;
+
+	// Las dos pasadas movieron cada entidad 2 * passes veces: se compara con
+	// la misma suma hecha en escalar
+	const float steps = 2.0f * passes;
+	unsigned int visited = 0;
+	bool moveOk = world.getEntityCount() == count;
+	world.forEachChunk<TransformComponent, VelocityComponent>(
+		[&](unsigned int n, Entity*, TransformComponent* transforms, VelocityComponent* velocities) {
+			for (unsigned int i = 0; i < n; ++i) {
+				float expected = velocities[i].linear.z * deltaTime * steps;
+				moveOk = moveOk && fabsf(transforms[i].position.z - expected) <= 1e-3f * (1.0f + fabsf(expected));
+				moveOk = moveOk && transforms[i].position.y == 0.0f;
+			}
+			visited += n;
+		});
+	moveOk = moveOk && visited == count;
+
+	std::ostringstream os;
+	os << "ECS entities=" << count
+		 << " archetypes=" << world.getArchetypeCount()
+		 << " create=" << createMs << "ms"
+		 << " virtual=" << virtualMs << "ms"
+		 << " chunks=" << chunkMs << "ms (x" << (chunkMs > 0.0 ? virtualMs / chunkMs : 0.0) << ")"
+		 << " chunksParallel=" << parallelMs << "ms (x" << (parallelMs > 0.0 ? virtualMs / parallelMs : 0.0) << ")"
+		 << (moveOk ? " OK" : " MISMATCH") << "\n";
+	report(os.str());
+
+	for (unsigned int i = 0; i < count; ++i) {
+		delete objects[i];
+	}
+	world.destroy();
+	jobs.destroy();
+	return moveOk;
+}
+
+bool
+RunCullingBenchmark() {
+	const unsigned int counts[] = { 1000, 10000, 100000 };
+	const unsigned int passes = 50;
+
+	// Camara en el origen mirando a +Z, como la de la escena
+	XMMATRIX view = XMMatrixLookAtLH(XMVectorSet(0.0f, 0.0f, 0.0f, 0.0f),
+																	 XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f),
+																	 XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.01f, 100.0f);
+
+	std::ostringstream os;
+	bool ok = true;
+	unsigned int seed = 12345;
+	for (unsigned int c = 0; c < 3; ++c) {
+		unsigned int count = counts[c];
+		FrustumCuller culler;
+		culler.init(count);
+		culler.setFrustum(ToFloat4x4(view * projection));
+
+		// Objetos repartidos en un cubo de 240 unidades alrededor de la camara
+		for (unsigned int i = 0; i < count; ++i) {
+			Bounds bounds;
+			float r[7];
+			for (int k = 0; k < 7; ++k) {
+				seed = seed * 1664525u + 1013904223u;
+				r[k] = (seed >> 8) * (1.0f / 16777216.0f);
+			}
+			bounds.center = Float3(r[0] * 240.0f - 120.0f, r[1] * 240.0f - 120.0f, r[2] * 240.0f - 120.0f);
+			bounds.extents = Float3(r[3] * 4.0f, r[4] * 4.0f, r[5] * 4.0f);
+			bounds.radius = sqrtf(bounds.extents.x * bounds.extents.x +
+														bounds.extents.y * bounds.extents.y +
+														bounds.extents.z * bounds.extents.z) * (0.6f + 0.4f * r[6]);
+			culler.add(bounds);
+		}
+
+		std::vector<unsigned int> visible;
+		std::vector<unsigned int> reference;
+		Clock::time_point start = Clock::now();
+		for (unsigned int pass = 0; pass < passes; ++pass) {
+			culler.cullScalar(reference);
+		}
+		double scalarMs = elapsedMs(start) / passes;
+
+		start = Clock::now();
+		for (unsigned int pass = 0; pass < passes; ++pass) {
+			culler.cull(visible);
+		}
+		double simdMs = elapsedMs(start) / passes;
+
+		os << "Culling count=" << count
+			 << " visible=" << visible.size()
+			 << " scalar=" << scalarMs << "ms"
+			 << " simd=" << simdMs << "ms (x" << (simdMs > 0.0 ? scalarMs / simdMs : 0.0) << ")"
+			 << (visible == reference ? " OK" : " MISMATCH") << "\n";
+		ok = ok && visible == reference;
+	}
+
+	// Casos conocidos: delante de la camara, detras y mas alla del plano lejano
+	FrustumCuller known;
+	known.setFrustum(ToFloat4x4(view * projection));
+	Bounds front = { Float3(0.0f, 0.0f, 10.0f), Float3(1.0f, 1.0f, 1.0f), 1.8f };
+	Bounds behind = { Float3(0.0f, 0.0f, -10.0f), Float3(1.0f, 1.0f, 1.0f), 1.8f };
+	Bounds far = { Float3(0.0f, 0.0f, 150.0f), Float3(1.0f, 1.0f, 1.0f), 1.8f };
+	known.add(front);
+	known.add(behind);
+	known.add(far);
+	std::vector<unsigned int> visible;
+	known.cull(visible);
+	bool knownOk = visible.size() == 1 && visible[0] == 0;
+	os << "Culling known cases " << (knownOk ? "OK" : "MISMATCH") << "\n";
+
+	report(os.str());
+	return ok && knownOk;
+}
+
+bool
+RunOcclusionBenchmark() {
+	const unsigned int boxCount = 10000;
+	const unsigned int passes = 50;
+
+	XMMATRIX viewProjection = XMMatrixLookAtLH(XMVectorSet(0.0f, 0.0f, 0.0f, 0.0f),
+																						 XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f),
+																						 XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)) *
+														XMMatrixPerspectiveFovLH(XM_PIDIV4, 2.0f, 0.01f, 100.0f);
+	Float4x4 identity = ToFloat4x4(XMMatrixIdentity());
+
+	// Interior denso: una fila de muros a z = 10 con huecos entre ellos
+	std::vector<Float3> walls;
+	for (int w = -4; w < 4; ++w) {
+		float x0 = w * 3.0f, x1 = x0 + 2.5f;
+		Float3 quad[6] = {
+			Float3(x0, -5.0f, 10.0f), Float3(x1, -5.0f, 10.0f), Float3(x1, 5.0f, 10.0f),
+			Float3(x0, -5.0f, 10.0f), Float3(x1, 5.0f, 10.0f), Float3(x0, 5.0f, 10.0f)
+		};
+		walls.insert(walls.end(), quad, quad + 6);
+	}
+
+	std::vector<Bounds> boxes(boxCount);
+	unsigned int seed = 777;
+	for (unsigned int i = 0; i < boxCount; ++i) {
+		float r[4];
+		for (int k = 0; k < 4; ++k) {
+			seed = seed * 1664525u + 1013904223u;
+			r[k] = (seed >> 8) * (1.0f / 16777216.0f);
+		}
+		float size = 0.1f + r[3] * 0.4f;
+		boxes[i].center = Float3(r[0] * 20.0f - 10.0f, r[1] * 8.0f - 4.0f, 5.0f + r[2] * 40.0f);
+		boxes[i].extents = Float3(size, size, size);
+		boxes[i].radius = size * 1.7320508f;
+	}
+
+	OcclusionCuller culler;
+	culler.init();
+	unsigned int culled = 0;
+	double rasterMs = 0.0, testMs = 0.0;
+	for (unsigned int pass = 0; pass < passes; ++pass) {
+		culler.beginFrame(ToFloat4x4(viewProjection));
+		culler.addOccluderTriangles(&walls[0], static_cast<unsigned int>(walls.size() / 3), identity);
+		culler.finalize();
+		for (unsigned int i = 0; i < boxCount; ++i) {
+			culler.isVisible(boxes[i]);
+		}
+		culled = culler.getStats().culled;
+		rasterMs += culler.getStats().rasterMs;
+		testMs += culler.getStats().testMs;
+	}
+
+	std::ostringstream os;
+	os << "Occlusion " << culler.getWidth() << "x" << culler.getHeight()
+		 << " occluderTriangles=" << walls.size() / 3
+		 << " boxes=" << boxCount
+		 << " culled=" << culled
+		 << " raster=" << rasterMs / passes << "ms"
+		 << " test=" << testMs / passes << "ms\n";
+
+	// Casos conocidos: delante del muro, detras, detras pero asomando por arriba
+	Bounds front = { Float3(1.0f, 0.0f, 5.0f), Float3(0.5f, 0.5f, 0.5f), 0.9f };
+	Bounds behind = { Float3(1.0f, 0.0f, 20.0f), Float3(0.5f, 0.5f, 0.5f), 0.9f };
+	Bounds above = { Float3(1.0f, 12.0f, 20.0f), Float3(0.5f, 0.5f, 0.5f), 0.9f };
+	bool ok = culler.isVisible(front) && !culler.isVisible(behind) && culler.isVisible(above);
+	os << "Occlusion known cases " << (ok ? "OK" : "MISMATCH") << "\n";
+
+	report(os.str());
+	return ok;
+}
+
+bool
+RunObjBenchmark(const std::string& path) {
+	std::ostringstream os;
+	unsigned int maxThreads = std::thread::hardware_concurrency();
+	if (maxThreads == 0) {
+		maxThreads = 1;
+	}
+
+	if (!path.empty()) {
+		// Archivo real: incluye el costo de proyectarlo en memoria
+		JobSystem jobs;
+		jobs.init();
+		ObjLoader loader;
+		MeshComponent mesh;
+		Clock::time_point start = Clock::now();
+		HRESULT hr = loader.load(path, mesh, &jobs);
+		double totalMs = elapsedMs(start);
+		jobs.destroy();
+		if (FAILED(hr)) {
+			os << "ObjLoader failed to load " << path << "\n";
+			report(os.str());
+			return false;
+		}
+		const ObjLoadStats& stats = loader.getStats();
+		os << "ObjLoader " << path
+			 << " MB=" << stats.bytes / (1024.0 * 1024.0)
+			 << " threads=" << maxThreads
+			 << " chunks=" << stats.chunks
+			 << " triangles=" << stats.triangles
+			 << " vertices=" << stats.vertices
+			 << " map=" << stats.mapMs << "ms"
+			 << " parse=" << stats.parseMs << "ms"
+			 << " merge=" << stats.mergeMs << "ms"
+			 << " MB/s=" << (totalMs > 0.0 ? stats.bytes / (1024.0 * 1024.0) / (totalMs / 1000.0) : 0.0) << "\n";
+		report(os.str());
+		return true;
+	}
+
+	const unsigned int grid = 512;
+	std::string text = makeSyntheticObj(grid);
+	const double megabytes = text.size() / (1024.0 * 1024.0);
+	const unsigned int expectedVertices = (grid + 1) * (grid + 1);
+	const unsigned int expectedIndices = grid * grid * 6;
+
+	double baseMs = 0.0;
+	bool allOk = true;
+	// Con varios hilos la malla tiene que salir igual que en serie
+	MeshComponent serial;
+	for (unsigned int threads = 1;; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads) {
+		JobSystem jobs;
+		jobs.init(threads - 1);
+		ObjLoader loader;
+		MeshComponent mesh;
+		Clock::time_point start = Clock::now();
+		HRESULT hr = loader.parse(text.data(), text.size(), mesh, &jobs);
+		double totalMs = elapsedMs(start);
+		jobs.destroy();
+		if (threads == 1) {
+			baseMs = totalMs;
+		}
+		bool ok = SUCCEEDED(hr) &&
+							mesh.m_vertex.size() == expectedVertices &&
+							mesh.m_index.size() == expectedIndices;
+		if (threads == 1) {
+			serial = mesh;
+		}
+		else {
+			ok = ok && mesh.m_index == serial.m_index &&
+					 memcmp(mesh.m_vertex.data(), serial.m_vertex.data(), mesh.m_vertex.size() * sizeof(SimpleVertex)) == 0;
+		}
+		allOk = allOk && ok;
+		const ObjLoadStats& stats = loader.getStats();
+		os << "ObjLoader synthetic MB=" << megabytes
+			 << " threads=" << threads
+			 << " parse=" << stats.parseMs << "ms"
+			 << " merge=" << stats.mergeMs << "ms"
+			 << " MB/s=" << (totalMs > 0.0 ? megabytes / (totalMs / 1000.0) : 0.0)
+			 << " speedup=" << (totalMs > 0.0 ? baseMs / totalMs : 0.0)
+			 << (ok ? " OK" : " MISMATCH") << "\n";
+		if (threads == maxThreads) {
+			break;
+		}
+	}
+	report(os.str());
+	return allOk;
+}
+
+bool
+RunMeshFileBenchmark() {
+	const unsigned int grid = 512;
+	const char* path = "MeshFileBenchmark.hmesh";
+	std::string text = makeSyntheticObj(grid);
+
+	JobSystem jobs;
+	jobs.init();
+	ObjLoader loader;
+	MeshComponent mesh;
+	Clock::time_point start = Clock::now();
+	HRESULT hr = loader.parse(text.data(), text.size(), mesh, &jobs);
+	double objMs = elapsedMs(start);
+	jobs.destroy();
+	if (FAILED(hr)) {
+		report("MeshFile benchmark: OBJ parse failed\n");
+		return false;
+	}
+
+	start = Clock::now();
+	hr = MeshFile::write(path, mesh);
+	double writeMs = elapsedMs(start);
+	if (FAILED(hr)) {
+		report("MeshFile benchmark: write failed\n");
+		return false;
+	}
+
+	// Abrir, validar y tocar todas las paginas (lo que haria el driver al
+	// leer pSysMem en CreateBuffer)
+	MeshFile file;
+	start = Clock::now();
+	hr = file.open(path);
+	double openMs = elapsedMs(start);
+	unsigned int checksum = 0;
+	bool ok = SUCCEEDED(hr);
+	if (ok) {
+		const MeshFileHeader& header = file.getHeader();
+		const unsigned int* words = reinterpret_cast<const unsigned int*>(file.getVertices());
+		size_t wordCount = header.vertexCount * header.vertexStride / sizeof(unsigned int);
+		for (size_t i = 0; i < wordCount; i += 1024 / sizeof(unsigned int)) {
+			checksum += words[i];
+		}
+		for (unsigned int i = 0; i < header.indexCount; i += 1024 / header.indexStride) {
+			checksum += file.getIndex(i);
+		}
+	}
+	double touchMs = elapsedMs(start);
+
+	if (ok) {
+		const MeshFileHeader& header = file.getHeader();
+		ok = header.vertexCount == mesh.m_vertex.size() &&
+				 header.indexCount == mesh.m_index.size() &&
+				 memcmp(file.getVertices(), mesh.m_vertex.data(), mesh.m_vertex.size() * sizeof(SimpleVertex)) == 0 &&
+				 header.indexStride == (mesh.m_vertex.size() <= 0x10000 ? 2u : 4u) &&
+				 header.submeshCount == 1 && file.getSubmeshes()[0].indexCount == header.indexCount;
+		for (unsigned int i = 0; ok && i < header.indexCount; ++i) {
+			ok = file.getIndex(i) == mesh.m_index[i];
+		}
+	}
+	file.close();
+
+	// Misma malla cortada en submeshes de 16 bits: cada triangulo debe
+	// apuntar a las mismas posiciones que antes
+	MeshComponent split = mesh;
+	std::vector<MeshFileSubmesh> submeshes;
+	SplitMeshFor16BitIndices(split, submeshes);
+	bool splitOk = SUCCEEDED(MeshFile::write(path, split, submeshes.data(), static_cast<unsigned int>(submeshes.size()))) &&
+								 SUCCEEDED(file.open(path)) &&
+								 file.getHeader().indexStride == sizeof(unsigned short) &&
+								 file.getHeader().submeshCount == submeshes.size();
+	for (unsigned int s = 0; splitOk && s < file.getHeader().submeshCount; ++s) {
+		const MeshFileSubmesh& submesh = file.getSubmeshes()[s];
+		for (unsigned int i = 0; splitOk && i < submesh.indexCount; ++i) {
+			const XMFLOAT3& a = file.getVertices()[submesh.baseVertex + file.getIndex(submesh.indexStart + i)].Pos;
+			const XMFLOAT3& b = mesh.m_vertex[mesh.m_index[submesh.indexStart + i]].Pos;
+			splitOk = a.x == b.x && a.y == b.y && a.z == b.z;
+		}
+	}
+	unsigned long long indexBytes32 = mesh.m_index.size() * sizeof(unsigned int);
+	unsigned long long indexBytes16 = splitOk ? file.getHeader().indexCount * file.getHeader().indexStride : 0;
+	unsigned long long duplicated = split.m_vertex.size() - mesh.m_vertex.size();
+	file.close();
+	remove(path);
+
+	std::ostringstream os;
+	os << "MeshFile vertices=" << mesh.m_vertex.size()
+		 << " indices=" << mesh.m_index.size()
+		 << " objParse=" << objMs << "ms"
+		 << " write=" << writeMs << "ms"
+		 << " open=" << openMs << "ms"
+		 << " openAndTouch=" << touchMs << "ms"
+		 << " checksum=" << checksum
+		 << (ok ? " OK" : " MISMATCH") << "\n";
+	os << "MeshFile 16-bit split submeshes=" << submeshes.size()
+		 << " duplicatedVertices=" << duplicated
+		 << " indexBytes=" << indexBytes32 << "->" << indexBytes16
+		 << (splitOk ? " OK" : " MISMATCH") << "\n";
+	report(os.str());
+	return ok && splitOk;
+}
+
+bool
+RunMeshOptimizerBenchmark(const std::string& path) {
+	MeshComponent mesh;
+	if (!path.empty()) {
+		JobSystem jobs;
+		jobs.init();
+		ObjLoader loader;
+		HRESULT hr = loader.load(path, mesh, &jobs);
+		jobs.destroy();
+		if (FAILED(hr)) {
+			report("MeshOptimizer failed to load " + path + "\n");
+			return false;
+		}
+	}
+	else {
+		// Tres esferas UV concentricas con los triangulos barajados: peor caso
+		// para la cache y con capas internas que generan overdraw
+		const unsigned int rings = 96;
+		const unsigned int segments = 192;
+		const float radii[3] = { 0.6f, 0.8f, 1.0f };
+		std::vector<unsigned int> triangles;
+		for (int shell = 0; shell < 3; ++shell) {
+			unsigned int base = static_cast<unsigned int>(mesh.m_vertex.size());
+			for (unsigned int r = 0; r <= rings; ++r) {
+				float theta = XM_PI * r / rings;
+				for (unsigned int s = 0; s <= segments; ++s) {
+					float phi = XM_2PI * s / segments;
+					SimpleVertex vertex;
+					vertex.Pos = XMFLOAT3(radii[shell] * sinf(theta) * cosf(phi),
+																radii[shell] * cosf(theta),
+																radii[shell] * sinf(theta) * sinf(phi));
+					vertex.Tex = XMFLOAT2(static_cast<float>(s) / segments, static_cast<float>(r) / rings);
+					mesh.m_vertex.push_back(vertex);
+				}
+			}
+			for (unsigned int r = 0; r < rings; ++r) {
+				for (unsigned int s = 0; s < segments; ++s) {
+					unsigned int a = base + r * (segments + 1) + s;
+					unsigned int b = a + segments + 1;
+					unsigned int quad[6] = { a, a + 1, b, a + 1, b + 1, b };
+					triangles.insert(triangles.end(), quad, quad + 6);
+				}
+			}
+		}
+		unsigned int seed = 12345;
+		unsigned int triangleCount = static_cast<unsigned int>(triangles.size() / 3);
+		for (unsigned int t = triangleCount - 1; t > 0; --t) {
+			seed = seed * 1664525u + 1013904223u;
+			unsigned int other = (seed >> 8) % (t + 1);
+			for (int k = 0; k < 3; ++k) {
+				std::swap(triangles[t * 3 + k], triangles[other * 3 + k]);
+			}
+		}
+		mesh.m_index = triangles;
+		mesh.m_numVertex = static_cast<int>(mesh.m_vertex.size());
+		mesh.m_numIndex = static_cast<int>(mesh.m_index.size());
+	}
+
+	MeshOptimizationMetrics before = AnalyzeMesh(mesh);
+	std::vector<std::array<float, 15> > original = triangleSet(mesh);
+	Clock::time_point start = Clock::now();
+	OptimizeVertexCache(mesh);
+	double cacheMs = elapsedMs(start);
+	MeshOptimizationMetrics afterCache = AnalyzeMesh(mesh);
+	start = Clock::now();
+	OptimizeOverdraw(mesh);
+	double overdrawMs = elapsedMs(start);
+	start = Clock::now();
+	OptimizeVertexFetch(mesh);
+	double fetchMs = elapsedMs(start);
+	MeshOptimizationMetrics after = AnalyzeMesh(mesh);
+	// Reordenar no puede agregar, quitar ni voltear triangulos
+	bool ok = triangleSet(mesh) == original;
+
+	std::ostringstream os;
+	os << "MeshOptimizer " << (path.empty() ? "synthetic spheres" : path)
+		 << " vertices=" << mesh.m_vertex.size()
+		 << " triangles=" << mesh.m_index.size() / 3 << "\n"
+		 << "  before     ACMR=" << before.acmr << " ATVR=" << before.atvr << " overdraw=" << before.overdraw << "\n"
+		 << "  cache      ACMR=" << afterCache.acmr << " ATVR=" << afterCache.atvr << " overdraw=" << afterCache.overdraw
+		 << " (" << cacheMs << "ms)\n"
+		 << "  +overdraw  ACMR=" << after.acmr << " ATVR=" << after.atvr << " overdraw=" << after.overdraw
+		 << " (" << overdrawMs << "ms, fetch " << fetchMs << "ms)\n"
+		 << "  triangles" << (ok ? " OK" : " MISMATCH") << "\n";
+	report(os.str());
+	return ok;
+}
+
+bool
+RunVertexFormatBenchmark() {
+	// Esfera UV con normales y tangentes analiticas
+	const unsigned int rings = 256;
+	const unsigned int segments = 512;
+	MeshComponent mesh;
+	std::vector<XMFLOAT3> normals;
+	std::vector<XMFLOAT4> tangents;
+	for (unsigned int r = 0; r <= rings; ++r) {
+		float theta = XM_PI * r / rings;
+		for (unsigned int s = 0; s <= segments; ++s) {
+			float phi = XM_2PI * s / segments;
+			XMFLOAT3 normal(sinf(theta) * cosf(phi), cosf(theta), sinf(theta) * sinf(phi));
+			SimpleVertex vertex;
+			vertex.Pos = XMFLOAT3(normal.x * 25.0f + 100.0f, normal.y * 25.0f, normal.z * 25.0f - 40.0f);
+			vertex.Tex = XMFLOAT2(static_cast<float>(s) / segments * 3.7f, static_cast<float>(r) / rings * 0.9f);
+			mesh.m_vertex.push_back(vertex);
+			normals.push_back(normal);
+			tangents.push_back(XMFLOAT4(-sinf(phi), 0.0f, cosf(phi), (s & 1) ? -1.0f : 1.0f));
+		}
+	}
+	mesh.m_numVertex = static_cast<int>(mesh.m_vertex.size());
+	const unsigned int count = static_cast<unsigned int>(mesh.m_vertex.size());
+
+	VertexFormat full;
+	VertexFormatDesc fullDesc;
+	fullDesc.normal = VERTEX_NORMAL_FLOAT3;
+	fullDesc.tangent = VERTEX_TANGENT_FLOAT4;
+	full.init(fullDesc);
+
+	VertexFormat quantized;
+	VertexFormatDesc quantizedDesc;
+	quantizedDesc.position = VERTEX_POSITION_UNORM16;
+	quantizedDesc.texcoord = VERTEX_TEXCOORD_HALF2;
+	quantizedDesc.normal = VERTEX_NORMAL_OCT16;
+	quantizedDesc.tangent = VERTEX_TANGENT_OCT16;
+	quantized.init(quantizedDesc);
+
+	const unsigned int passes = 20;
+	std::vector<unsigned char> encoded;
+	Clock::time_point start = Clock::now();
+	for (unsigned int pass = 0; pass < passes; ++pass) {
+		quantized.encode(mesh, normals.data(), tangents.data(), encoded);
+	}
+	double simdMs = elapsedMs(start) / passes;
+
+	Bounds bounds = ComputeMeshBounds(mesh);
+	XMFLOAT3 minimum(bounds.center.x - bounds.extents.x,
+									 bounds.center.y - bounds.extents.y,
+									 bounds.center.z - bounds.extents.z);
+	XMFLOAT3 extent(bounds.extents.x * 2.0f, bounds.extents.y * 2.0f, bounds.extents.z * 2.0f);
+	std::vector<unsigned char> reference;
+	start = Clock::now();
+	for (unsigned int pass = 0; pass < passes; ++pass) {
+		encodeVerticesScalar(mesh.m_vertex, normals, tangents, minimum, extent, reference);
+	}
+	double scalarMs = elapsedMs(start) / passes;
+	bool match = reference == encoded;
+
+	MeshComponent decoded;
+	std::vector<XMFLOAT3> decodedNormals(count);
+	std::vector<XMFLOAT4> decodedTangents(count);
+	start = Clock::now();
+	for (unsigned int pass = 0; pass < passes; ++pass) {
+		quantized.decode(encoded.data(), count, decoded, decodedNormals.data(), decodedTangents.data());
+	}
+	double decodeMs = elapsedMs(start) / passes;
+
+	// Error de posicion despues de aplicar la matriz de decuantizacion como el shader
+	XMMATRIX dequantize = quantized.getDequantizeMatrix();
+	float positionError = 0.0f;
+	float decodeError = 0.0f;
+	float texcoordError = 0.0f;
+	float normalDot = 1.0f;
+	float tangentDot = 1.0f;
+	unsigned int signErrors = 0;
+	for (unsigned int i = 0; i < count; ++i) {
+		unsigned short raw[4];
+		memcpy(raw, &encoded[i * quantized.getStride()], sizeof(raw));
+		XMVECTOR unit = XMVectorSet(raw[0] / 65535.0f, raw[1] / 65535.0f, raw[2] / 65535.0f, 1.0f);
+		XMFLOAT3 position;
+		XMStoreFloat3(&position, XMVector3TransformCoord(unit, dequantize));
+		const XMFLOAT3& original = mesh.m_vertex[i].Pos;
+		positionError = std::max(positionError, std::max(fabsf(position.x - original.x),
+																										 std::max(fabsf(position.y - original.y), fabsf(position.z - original.z))));
+		const XMFLOAT3& cpu = decoded.m_vertex[i].Pos;
+		decodeError = std::max(decodeError, std::max(fabsf(cpu.x - original.x),
+																								 std::max(fabsf(cpu.y - original.y), fabsf(cpu.z - original.z))));
+		texcoordError = std::max(texcoordError, std::max(fabsf(decoded.m_vertex[i].Tex.x - mesh.m_vertex[i].Tex.x),
+																										 fabsf(decoded.m_vertex[i].Tex.y - mesh.m_vertex[i].Tex.y)));
+		const XMFLOAT3& n = normals[i];
+		const XMFLOAT3& dn = decodedNormals[i];
+		normalDot = std::min(normalDot, n.x * dn.x + n.y * dn.y + n.z * dn.z);
+		const XMFLOAT4& t = tangents[i];
+		const XMFLOAT4& dt = decodedTangents[i];
+		tangentDot = std::min(tangentDot, t.x * dt.x + t.y * dt.y + t.z * dt.z);
+		if (t.w != dt.w) {
+			signErrors++;
+		}
+	}
+	const float toDegrees = 180.0f / XM_PI;
+
+	std::ostringstream os;
+	os << "VertexFormat vertices=" << count
+		 << " bytes/vertex " << full.getStride() << " -> " << quantized.getStride() << "\n"
+		 << "  encode simd=" << simdMs << "ms scalar=" << scalarMs << "ms"
+		 << " speedup=" << (simdMs > 0.0 ? scalarMs / simdMs : 0.0)
+		 << (match ? " OK" : " MISMATCH") << "\n"
+		 << "  decode=" << decodeMs << "ms\n"
+		 << "  max error position=" << positionError << " cpu=" << decodeError
+		 << " (extent " << std::max(extent.x, std::max(extent.y, extent.z)) << ")"
+		 << " texcoord=" << texcoordError
+		 << " normal=" << acosf(std::min(normalDot, 1.0f)) * toDegrees << "deg"
+		 << " tangent=" << acosf(std::min(tangentDot, 1.0f)) * toDegrees << "deg"
+		 << " signErrors=" << signErrors << "\n";
+	report(os.str());
+	return match;
+}
+
+bool
+RunLodBenchmark(const std::string& path) {
+	MeshComponent mesh;
+	if (!path.empty()) {
+		JobSystem jobs;
+		jobs.init();
+		ObjLoader loader;
+		HRESULT hr = loader.load(path, mesh, &jobs);
+		jobs.destroy();
+		if (FAILED(hr)) {
+			report("LOD failed to load " + path + "\n");
+			return false;
+		}
+	}
+	else {
+		// Esfera UV con relieve: costura en phi = 0 y polos con muchos wedges
+		const unsigned int rings = 128;
+		const unsigned int segments = 256;
+		for (unsigned int r = 0; r <= rings; ++r) {
+			float theta = XM_PI * r / rings;
+			for (unsigned int s = 0; s <= segments; ++s) {
+				float phi = XM_2PI * s / segments;
+				float radius = 1.0f + 0.05f * sinf(theta * 6.0f) * cosf(phi * 4.0f);
+				SimpleVertex vertex;
+				vertex.Pos = XMFLOAT3(radius * sinf(theta) * cosf(phi), radius * cosf(theta), radius * sinf(theta) * sinf(phi));
+				vertex.Tex = XMFLOAT2(static_cast<float>(s) / segments, static_cast<float>(r) / rings);
+				mesh.m_vertex.push_back(vertex);
+			}
+		}
+		for (unsigned int r = 0; r < rings; ++r) {
+			for (unsigned int s = 0; s < segments; ++s) {
+				unsigned int a = r * (segments + 1) + s;
+				unsigned int b = a + segments + 1;
+				unsigned int quad[6] = { a, a + 1, b, a + 1, b + 1, b };
+				mesh.m_index.insert(mesh.m_index.end(), quad, quad + 6);
+			}
+		}
+		mesh.m_numVertex = static_cast<int>(mesh.m_vertex.size());
+		mesh.m_numIndex = static_cast<int>(mesh.m_index.size());
+	}
+
+	const float ratios[] = { 0.5f, 0.25f, 0.125f, 0.0625f, 0.03125f };
+	std::vector<MeshLOD> lods;
+	Clock::time_point start = Clock::now();
+	GenerateMeshLODs(mesh, ratios, 5, lods);
+	double generateMs = elapsedMs(start);
+
+	// Verificar que los niveles no tengan triangulos degenerados ni indices fuera de rango
+	unsigned int invalid = 0;
+	for (size_t l = 0; l < lods.size(); ++l) {
+		for (unsigned int i = lods[l].indexStart; i < lods[l].indexStart + lods[l].indexCount; i += 3) {
+			unsigned int a = mesh.m_index[i], b = mesh.m_index[i + 1], c = mesh.m_index[i + 2];
+			if (a >= mesh.m_vertex.size() || b >= mesh.m_vertex.size() || c >= mesh.m_vertex.size() ||
+					a == b || b == c || c == a) {
+				invalid++;
+			}
+		}
+	}
+
+	// Cada nivel tiene a lo sumo los triangulos del anterior y al menos su error
+	bool chainOk = !lods.empty();
+	for (size_t l = 1; chainOk && l < lods.size(); ++l) {
+		chainOk = lods[l].indexCount > 0 &&
+							lods[l].indexCount <= lods[l - 1].indexCount &&
+							lods[l].error >= lods[l - 1].error;
+	}
+
+	std::ostringstream os;
+	os << "LOD " << (path.empty() ? "synthetic sphere" : path)
+		 << " vertices=" << mesh.m_vertex.size()
+		 << " levels=" << lods.size()
+		 << " (" << generateMs << "ms)"
+		 << (invalid == 0 && chainOk ? " OK" : " INVALID") << "\n";
+	for (size_t l = 0; l < lods.size(); ++l) {
+		os << "  LOD" << l << " triangles=" << lods[l].indexCount / 3
+			 << " ratio=" << static_cast<float>(lods[l].indexCount) / lods[0].indexCount
+			 << " error=" << lods[l].error << "\n";
+	}
+
+	// Seleccion con la misma proyeccion que la escena en un viewport de 720 pixeles
+	Bounds bounds = ComputeMeshBounds(mesh);
+	XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.01f, 1000.0f);
+	os << "  selection";
+	const float distances[] = { 2.0f, 5.0f, 10.0f, 25.0f, 50.0f, 100.0f, 250.0f };
+	// Alejarse nunca elige un nivel mas detallado
+	bool selectionOk = true;
+	unsigned int previous = 0;
+	for (unsigned int d = 0; d < 7; ++d) {
+		XMVECTOR eye = XMVectorSet(bounds.center.x, bounds.center.y, bounds.center.z - distances[d] * bounds.radius, 0.0f);
+		XMMATRIX view = XMMatrixLookAtLH(eye, LoadFloat3(bounds.center), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+		unsigned int level = SelectMeshLOD(lods, bounds, view, projection, 720.0f);
+		selectionOk = selectionOk && level >= previous && level < lods.size();
+		previous = level;
+		os << " " << distances[d] << "r=LOD" << level;
+	}
+	os << (selectionOk ? " OK" : " MISMATCH") << "\n";
+	report(os.str());
+	return invalid == 0 && chainOk && selectionOk;
+}
+
+bool
+RunMeshletBenchmark(const std::string& path) {
+	MeshComponent mesh;
+	if (!path.empty()) {
+		JobSystem jobs;
+		jobs.init();
+		ObjLoader loader;
+		HRESULT hr = loader.load(path, mesh, &jobs);
+		jobs.destroy();
+		if (FAILED(hr)) {
+			report("Meshlet failed to load " + path + "\n");
+			return false;
+		}
+		OptimizeVertexCache(mesh);
+	}
+	else {
+		// Esfera densa: la mitad de los triangulos mira hacia atras desde cualquier punto
+		const unsigned int rings = 384;
+		const unsigned int segments = 768;
+		for (unsigned int r = 0; r <= rings; ++r) {
+			float theta = XM_PI * r / rings;
+			for (unsigned int s = 0; s <= segments; ++s) {
+				float phi = XM_2PI * s / segments;
+				SimpleVertex vertex;
+				vertex.Pos = XMFLOAT3(sinf(theta) * cosf(phi), cosf(theta), sinf(theta) * sinf(phi));
+				vertex.Tex = XMFLOAT2(static_cast<float>(s) / segments, static_cast<float>(r) / rings);
+				mesh.m_vertex.push_back(vertex);
+			}
+		}
+		for (unsigned int r = 0; r < rings; ++r) {
+			for (unsigned int s = 0; s < segments; ++s) {
+				unsigned int a = r * (segments + 1) + s;
+				unsigned int b = a + segments + 1;
+				unsigned int quad[6] = { a, a + 1, b, a + 1, b + 1, b };
+				mesh.m_index.insert(mesh.m_index.end(), quad, quad + 6);
+			}
+		}
+		mesh.m_numVertex = static_cast<int>(mesh.m_vertex.size());
+		mesh.m_numIndex = static_cast<int>(mesh.m_index.size());
+	}
+
+	MeshletData meshlets;
+	Clock::time_point start = Clock::now();
+	BuildMeshlets(mesh, meshlets);
+	double buildMs = elapsedMs(start);
+
+	// Camara a 3 radios mirando al centro con la proyeccion de la escena
+	Bounds bounds = ComputeMeshBounds(mesh);
+	XMFLOAT3 camera(bounds.center.x, bounds.center.y, bounds.center.z - 3.0f * bounds.radius);
+	XMMATRIX view = XMMatrixLookAtLH(XMLoadFloat3(&camera), LoadFloat3(bounds.center), XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+	XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.01f, 1000.0f);
+	MeshletCuller culler;
+	culler.setView(XMMatrixIdentity(), view * projection, camera);
+
+	const unsigned int passes = 100;
+	std::vector<unsigned int> visible;
+	std::vector<unsigned int> reference;
+	start = Clock::now();
+	for (unsigned int pass = 0; pass < passes; ++pass) {
+		culler.cullMeshletsScalar(meshlets, reference);
+	}
+	double scalarMs = elapsedMs(start) / passes;
+	start = Clock::now();
+	for (unsigned int pass = 0; pass < passes; ++pass) {
+		culler.cullMeshlets(meshlets, visible);
+	}
+	double simdMs = elapsedMs(start) / passes;
+	MeshletCullStats stats = culler.getStats();
+
+	std::vector<unsigned int> indices;
+	start = Clock::now();
+	for (unsigned int pass = 0; pass < passes; ++pass) {
+		culler.cull(meshlets, indices);
+	}
+	double writeMs = elapsedMs(start) / passes;
+
+	// Triangulos de espaldas reales: el maximo que podria quitar el culling por cono
+	unsigned int backfacing = 0;
+	const unsigned int triangleCount = static_cast<unsigned int>(mesh.m_index.size() / 3);
+	for (unsigned int t = 0; t < triangleCount; ++t) {
+		const XMFLOAT3& a = mesh.m_vertex[mesh.m_index[t * 3]].Pos;
+		const XMFLOAT3& b = mesh.m_vertex[mesh.m_index[t * 3 + 1]].Pos;
+		const XMFLOAT3& c = mesh.m_vertex[mesh.m_index[t * 3 + 2]].Pos;
+		XMFLOAT3 u(b.x - a.x, b.y - a.y, b.z - a.z);
+		XMFLOAT3 v(c.x - a.x, c.y - a.y, c.z - a.z);
+		XMFLOAT3 n(u.y * v.z - u.z * v.y, u.z * v.x - u.x * v.z, u.x * v.y - u.y * v.x);
+		if (n.x * (a.x - camera.x) + n.y * (a.y - camera.y) + n.z * (a.z - camera.z) >= 0.0f) {
+			backfacing++;
+		}
+	}
+
+	std::ostringstream os;
+	os << "Meshlet " << (path.empty() ? "synthetic sphere" : path)
+		 << " triangles=" << triangleCount
+		 << " meshlets=" << meshlets.size()
+		 << " avgVertices=" << static_cast<float>(meshlets.vertices.size()) / std::max(1u, meshlets.size())
+		 << " avgTriangles=" << static_cast<float>(meshlets.triangles.size() / 3) / std::max(1u, meshlets.size())
+		 << " (" << buildMs << "ms)\n"
+		 << "  cull simd=" << simdMs << "ms scalar=" << scalarMs << "ms"
+		 << (visible == reference ? " OK" : " MISMATCH") << "\n"
+		 << "  visible=" << stats.visible << " frustum=" << stats.frustumCulled << " cone=" << stats.coneCulled << "\n"
+		 << "  indices " << culler.getStats().triangles << "/" << triangleCount << " triangles"
+		 << " (backfacing " << backfacing << ", write " << writeMs << "ms)\n";
+	report(os.str());
+	return visible == reference;
+}
+
+bool
+RunShaderCacheBenchmark() {
+	const char* path = "ShaderCacheBenchmark.bin";
+	const unsigned int entryCount = 4096;
+
+	// Blobs sinteticos de 0.5 a 8 KB con contenido derivado de la key
+	std::vector<unsigned long long> keys(entryCount);
+	std::vector<std::vector<char> > blobs(entryCount);
+	unsigned int seed = 12345;
+	for (unsigned int i = 0; i < entryCount; ++i) {
+		keys[i] = ShaderCache::hash(&i, sizeof(i));
+		seed = seed * 1664525u + 1013904223u;
+		blobs[i].resize(512 + (seed >> 8) % 7680);
+		for (size_t b = 0; b < blobs[i].size(); ++b) {
+			blobs[i][b] = static_cast<char>((keys[i] >> ((b % 8) * 8)) + b);
+		}
+	}
+
+	ShaderCache cache;
+	Clock::time_point start = Clock::now();
+	for (unsigned int i = 0; i < entryCount; ++i) {
+		cache.insert(keys[i], blobs[i].data(), blobs[i].size());
+	}
+	double insertMs = elapsedMs(start);
+	start = Clock::now();
+	bool ok = SUCCEEDED(cache.save(path));
+	double saveMs = elapsedMs(start);
+
+	ShaderCache loaded;
+	start = Clock::now();
+	ok = ok && loaded.load(path) == S_OK && loaded.getEntryCount() == entryCount && !loaded.isDirty();
+	double loadMs = elapsedMs(start);
+	for (unsigned int i = 0; ok && i < entryCount; ++i) {
+		const void* data = nullptr;
+		size_t size = 0;
+		ok = loaded.find(keys[i], &data, &size) && size == blobs[i].size() &&
+				 memcmp(data, blobs[i].data(), size) == 0;
+	}
+	const void* data = nullptr;
+	size_t size = 0;
+	ok = ok && !loaded.find(ShaderCache::hash(&entryCount, sizeof(entryCount)), &data, &size);
+
+	const unsigned int lookups = 1000000;
+	unsigned int found = 0;
+	start = Clock::now();
+	for (unsigned int i = 0; i < lookups; ++i) {
+		found += loaded.find(keys[(i * 2654435761u) % entryCount], &data, &size) ? 1 : 0;
+	}
+	double lookupNs = elapsedMs(start) * 1e6 / lookups;
+	ok = ok && found == lookups;
+
+	// Reemplazar una entrada no debe dejar bytes viejos en el archivo
+	const char replacement[] = "replaced";
+	loaded.insert(keys[0], replacement, sizeof(replacement));
+	ShaderCache reloaded;
+	bool replaceOk = SUCCEEDED(loaded.save()) && reloaded.load(path) == S_OK &&
+									 reloaded.getEntryCount() == entryCount &&
+									 reloaded.find(keys[0], &data, &size) && size == sizeof(replacement) &&
+									 memcmp(data, replacement, size) == 0;
+
+	// Guardar despues de una sesion que solo leyo keys[0] descarta el resto
+	ShaderCache pruned;
+	bool evictOk = SUCCEEDED(reloaded.save()) && pruned.load(path) == S_OK &&
+								 pruned.getEntryCount() == 1 && pruned.find(keys[0], &data, &size) &&
+								 !pruned.find(keys[1], &data, &size);
+
+	// Un byte cambiado en los datos invalida el archivo completo
+	bool corruptOk = false;
+	{
+		std::string bytes;
+		FILE* file = fopen(path, "rb");
+		if (file) {
+			char buffer[65536];
+			size_t read = 0;
+			while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+				bytes.append(buffer, read);
+			}
+			fclose(file);
+		}
+		if (!bytes.empty()) {
+			bytes[bytes.size() - 1] ^= 0x5a;
+			file = fopen(path, "wb");
+			if (file) {
+				fwrite(bytes.data(), 1, bytes.size(), file);
+				fclose(file);
+			}
+			ShaderCache corrupt;
+			corruptOk = corrupt.load(path) == S_FALSE && corrupt.getEntryCount() == 0 && corrupt.isDirty();
+		}
+	}
+	remove(path);
+
+	// La key cambia con el include, el entry point, el perfil y los flags
+	const char* sourcePath = "ShaderCacheBenchmark.fx";
+	const char* includePath = "ShaderCacheBenchmark.fxh";
+	auto writeText = [](const char* name, const char* text) {
+		FILE* file = fopen(name, "wb");
+		if (file) {
+			fputs(text, file);
+			fclose(file);
+		}
+	};
+	writeText(sourcePath, "#include \"ShaderCacheBenchmark.fxh\"\nfloat4 PS() : SV_Target { return Tint; }\n");
+	writeText(includePath, "static const float4 Tint = float4(1, 0, 0, 1);\n");
+	unsigned long long sourceA = 0, sourceB = 0, sourceC = 0;
+	bool keyOk = ShaderCache::hashSource(sourcePath, sourceA) && ShaderCache::hashSource(sourcePath, sourceB) && sourceA == sourceB;
+	writeText(includePath, "static const float4 Tint = float4(0, 1, 0, 1);\n");
+	keyOk = keyOk && ShaderCache::hashSource(sourcePath, sourceC) && sourceC != sourceA;
+	unsigned long long key = ShaderCache::makeKey(sourceA, "PS", "ps_4_0", 0);
+	keyOk = keyOk &&
+					key == ShaderCache::makeKey(sourceA, "PS", "ps_4_0", 0) &&
+					key != ShaderCache::makeKey(sourceA, "VS", "ps_4_0", 0) &&
+					key != ShaderCache::makeKey(sourceA, "PS", "ps_5_0", 0) &&
+					key != ShaderCache::makeKey(sourceA, "PS", "ps_4_0", D3DCOMPILE_DEBUG);
+	remove(includePath);
+	keyOk = keyOk && !ShaderCache::hashSource(sourcePath, sourceC);
+	remove(sourcePath);
+
+	std::ostringstream os;
+	os << "ShaderCache entries=" << entryCount
+		 << " insert=" << insertMs << "ms"
+		 << " save=" << saveMs << "ms"
+		 << " load=" << loadMs << "ms"
+		 << " lookup=" << lookupNs << "ns"
+		 << (ok ? " OK" : " MISMATCH") << "\n"
+		 << "  replace" << (replaceOk ? " OK" : " MISMATCH")
+		 << " evict" << (evictOk ? " OK" : " MISMATCH")
+		 << " corrupt" << (corruptOk ? " OK" : " MISMATCH")
+		 << " key" << (keyOk ? " OK" : " MISMATCH") << "\n";
+
+	// Arranque real: VS y PS de la escena con el cache vacio y luego cargado
+	bool compileOk = true;
+	unsigned long long shaderHash = 0;
+	if (ShaderCache::hashSource("HybridEngine.fx", shaderHash)) {
+		const char* shaderCachePath = "ShaderCacheBenchmarkScene.bin";
+		const char* entries[2][2] = { { "VS", "vs_4_0" }, { "PS", "ps_4_0" } };
+		double passMs[2] = { 0.0, 0.0 };
+		remove(shaderCachePath);
+		for (int pass = 0; pass < 2; ++pass) {
+			ShaderCache sceneCache;
+			sceneCache.load(shaderCachePath);
+			start = Clock::now();
+			for (int e = 0; e < 2; ++e) {
+				ID3DBlob* blob = nullptr;
+				compileOk = SUCCEEDED(sceneCache.compileFromFile("HybridEngine.fx", entries[e][0], entries[e][1],
+																												 D3DCOMPILE_ENABLE_STRICTNESS, &blob)) && compileOk;
+				SAFE_RELEASE(blob);
+			}
+			passMs[pass] = elapsedMs(start);
+			compileOk = compileOk && sceneCache.getStats().hits == (pass == 0 ? 0u : 2u);
+			sceneCache.save();
+		}
+		remove(shaderCachePath);
+		os << "  HybridEngine.fx cold=" << passMs[0] << "ms warm=" << passMs[1] << "ms"
+			 << (compileOk ? " OK" : " MISMATCH") << "\n";
+	}
+	report(os.str());
+	return ok && replaceOk && evictOk && corruptOk && keyOk && compileOk;
+}
+
+bool
+RunShaderPermutationBenchmark() {
+	const char* path = "ShaderPermutationBenchmark.fx";
+	FILE* file = fopen(path, "wb");
+	if (!file) {
+		report("ShaderPermutation benchmark: failed to write shader\n");
+		return false;
+	}
+	fputs("Texture2D txDiffuse : register( t0 );\n"
+				"SamplerState samLinear : register( s0 );\n"
+				"cbuffer cbFrame : register( b0 )\n"
+				"{\n"
+				"    matrix WorldViewProjection;\n"
+				"    float4 FogColor;\n"
+				"    float4 LightDirection[3];\n"
+				"    float4 LightColor[3];\n"
+				"};\n"
+				"struct VS_INPUT { float4 Pos : POSITION; float2 Tex : TEXCOORD0; };\n"
+				"struct PS_INPUT { float4 Pos : SV_POSITION; float2 Tex : TEXCOORD0; float Fog : TEXCOORD1; };\n"
+				"PS_INPUT VS( VS_INPUT input )\n"
+				"{\n"
+				"    PS_INPUT output;\n"
+				"    float4 pos = float4( input.Pos.xyz, 1.0f );\n"
+				"#if WIND\n"
+				"    pos.x += sin( pos.y * 4.0f ) * 0.1f;\n"
+				"#endif\n"
+				"    output.Pos = mul( pos, WorldViewProjection );\n"
+				"    output.Tex = input.Tex;\n"
+				"    output.Fog = saturate( output.Pos.z * 0.01f );\n"
+				"    return output;\n"
+				"}\n"
+				"float4 PS( PS_INPUT input ) : SV_Target\n"
+				"{\n"
+				"    float4 color = float4( 1.0f, 1.0f, 1.0f, 1.0f );\n"
+				"#if TEXTURED\n"
+				"    color = txDiffuse.Sample( samLinear, input.Tex );\n"
+				"#endif\n"
+				"    float3 light = 0.2f;\n"
+				"    for ( int i = 0; i < LIGHTS; ++i )\n"
+				"        light += LightColor[i].rgb * saturate( LightDirection[i].y );\n"
+				"    color.rgb *= light;\n"
+				"#if FOG\n"
+				"    color.rgb = lerp( color.rgb, FogColor.rgb, input.Fog );\n"
+				"#endif\n"
+				"    return color;\n"
+				"}\n", file);
+	fclose(file);
+
+	VertexFormat format;
+	format.init(VertexFormatDesc());
+	std::vector<D3D11_INPUT_ELEMENT_DESC> layout;
+	format.buildLayout(layout);
+	NullBackend backend;
+	backend.init(false);
+	Device device;
+	device.init(&backend);
+
+	// 2 * 2 * 3 * 2 = 24 variantes validas en una tabla de 32
+	auto declare = [](ShaderPermutations& permutations) {
+		permutations.addKeyword("TEXTURED");
+		permutations.addKeyword("FOG");
+		permutations.addKeyword("LIGHTS", 3);
+		permutations.addKeyword("WIND");
+	};
+
+	// Empaquetado: set/get de cada keyword en cada key
+	ShaderPermutations serial;
+	declare(serial);
+	unsigned int validKeys = 0;
+	bool keyOk = serial.getKeyCount() == 32;
+	for (ShaderVariantKey key = 0; key < serial.getKeyCount(); ++key) {
+		validKeys += serial.isValid(key) ? 1 : 0;
+		ShaderVariantKey rebuilt = 0;
+		for (unsigned int k = 0; k < serial.getKeywordCount(); ++k) {
+			rebuilt = serial.setKeyword(rebuilt, k, serial.getKeyword(key, k));
+		}
+		keyOk = keyOk && rebuilt == key;
+	}
+	keyOk = keyOk && validKeys == 24;
+
+	// Frio en serie, frio en paralelo y caliente con el cache del primero
+	ShaderCache cache;
+	JobSystem single;
+	single.init(0);
+	serial.init(device, path, layout, &cache);
+	bool ok = SUCCEEDED(serial.prebuild(single));
+	single.destroy();
+
+	JobSystem jobs;
+	jobs.init();
+	ShaderCache parallelCache;
+	ShaderPermutations parallel;
+	declare(parallel);
+	parallel.init(device, path, layout, &parallelCache);
+	ok = SUCCEEDED(parallel.prebuild(jobs)) && ok;
+
+	// El JobSystem tiene que producir las mismas keys y el mismo bytecode
+	bool outputOk = parallelCache.getEntryCount() == cache.getEntryCount() && cache.getEntryCount() > 0;
+	for (unsigned int i = 0; outputOk && i < cache.getEntryCount(); ++i) {
+		const void* serialData = nullptr;
+		const void* parallelData = nullptr;
+		size_t serialSize = 0;
+		size_t parallelSize = 0;
+		outputOk = cache.getEntryKey(i) == parallelCache.getEntryKey(i) &&
+							 cache.find(cache.getEntryKey(i), &serialData, &serialSize) &&
+							 parallelCache.find(cache.getEntryKey(i), &parallelData, &parallelSize) &&
+							 serialSize == parallelSize && memcmp(serialData, parallelData, serialSize) == 0;
+	}
+
+	ShaderPermutations warm;
+	declare(warm);
+	unsigned int hitsBefore = cache.getStats().hits;
+	warm.init(device, path, layout, &cache);
+	ok = SUCCEEDED(warm.prebuild(jobs)) && ok;
+	unsigned int warmHits = cache.getStats().hits - hitsBefore;
+	unsigned int threads = jobs.getThreadCount();
+	jobs.destroy();
+	ok = ok && serial.getStats().built == validKeys && parallel.getStats().built == validKeys &&
+			 warm.getStats().built == validKeys && warmHits == validKeys * 4;
+
+	// Busqueda en el frame: key -> programa
+	std::vector<ShaderVariantKey> frameKeys;
+	for (ShaderVariantKey key = 0; key < warm.getKeyCount(); ++key) {
+		if (warm.isValid(key)) {
+			frameKeys.push_back(key);
+		}
+	}
+	const unsigned int lookups = 10000000;
+	size_t checksum = 0;
+	Clock::time_point start = Clock::now();
+	for (unsigned int i = 0; i < lookups; ++i) {
+		checksum += reinterpret_cast<size_t>(warm.getVariant(frameKeys[(i * 7) % frameKeys.size()]));
+	}
+	double lookupNs = elapsedMs(start) * 1e6 / lookups;
+	ok = ok && warm.getStats().lazyBuilds == 0;
+
+	std::ostringstream os;
+	os << "ShaderPermutation keywords=4 variants=" << validKeys << "/32"
+		 << (keyOk ? " keys OK" : " keys MISMATCH") << "\n"
+		 << "  prebuild serial=" << serial.getStats().prebuildMs << "ms"
+		 << " parallel=" << parallel.getStats().prebuildMs << "ms (" << threads << " threads)"
+		 << " cached=" << warm.getStats().prebuildMs << "ms"
+		 << " lookup=" << lookupNs << "ns (checksum " << (checksum & 0xff) << ")"
+		 << (ok ? " OK" : " MISMATCH") << "\n"
+		 << "  serial/parallel output" << (outputOk ? " OK" : " MISMATCH") << "\n";
+	report(os.str());
+
+	serial.destroy();
+	parallel.destroy();
+	warm.destroy();
+	device.destroy();
+	backend.destroy();
+	remove(path);
+	return keyOk && ok && outputOk;
+}
+
+bool
+RunAsyncLoadBenchmark() {
+	// Grafo de arranque: 8 pares VS/PS (4ms cada uno), un programa por par que
+	// espera a los dos, 4 texturas (6ms) y 2 mallas (3ms)
+	const unsigned int programCount = 8;
+	const unsigned int taskCount = programCount * 3 + 6;
+	std::ostringstream os;
+	os << "AsyncLoader tasks=" << taskCount << "\n";
+
+	double wallMs[2] = { 0.0, 0.0 };
+	double workMs = 0.0;
+	unsigned int threads[2] = { 0, 0 };
+	bool orderOk = true;
+	for (unsigned int pass = 0; pass < 2; ++pass) {
+		// Pasada 0: sin workers, todo en el hilo principal (el arranque serie)
+		JobSystem jobs;
+		if (pass == 0) {
+			jobs.init(0);
+		}
+		else {
+			jobs.init();
+		}
+		threads[pass] = jobs.getThreadCount();
+		std::atomic<unsigned int> clock(0);
+		std::vector<LoadBenchTask> tasks(taskCount);
+		AsyncLoader loader;
+		loader.init(jobs);
+		for (unsigned int i = 0; i < programCount; ++i) {
+			LoadBenchTask* shaders = &tasks[i * 3];
+			shaders[0] = { 4.0, false, 0, 0, &clock };
+			shaders[1] = { 4.0, false, 0, 0, &clock };
+			shaders[2] = { 0.0, false, 0, 0, &clock };
+			LoadTaskId dependencies[2];
+			dependencies[0] = loader.add("VS", &loadBenchWork, &loadBenchFinish, &shaders[0]);
+			dependencies[1] = loader.add("PS", &loadBenchWork, &loadBenchFinish, &shaders[1]);
+			loader.add("Program", nullptr, &loadBenchFinish, &shaders[2], dependencies, 2);
+		}
+		for (unsigned int i = programCount * 3; i < taskCount; ++i) {
+			tasks[i] = { i < programCount * 3 + 4 ? 6.0 : 3.0, false, 0, 0, &clock };
+			loader.add("Asset", &loadBenchWork, &loadBenchFinish, &tasks[i]);
+		}
+
+		float progress = 0.0f;
+		loader.start();
+		HRESULT hr = loader.wait(&loadBenchFrame, &progress, 1.0);
+		wallMs[pass] = loader.getStats().wallMs;
+		workMs = loader.getStats().workMs;
+
+		// Cada programa termina despues de los dos finish de su VS/PS
+		orderOk = orderOk && SUCCEEDED(hr) && loader.getStats().failed == 0;
+		for (unsigned int i = 0; i < programCount; ++i) {
+			orderOk = orderOk &&
+								tasks[i * 3 + 2].finishStamp > tasks[i * 3].finishStamp &&
+								tasks[i * 3 + 2].finishStamp > tasks[i * 3 + 1].finishStamp &&
+								tasks[i * 3].finishStamp > tasks[i * 3].workStamp;
+		}
+		orderOk = orderOk && loader.getProgress() == 1.0f;
+		loader.destroy();
+		jobs.destroy();
+	}
+
+	// Un fallo cancela a sus dependientes y no a las tareas independientes
+	JobSystem jobs;
+	jobs.init();
+	std::atomic<unsigned int> clock(0);
+	LoadBenchTask broken = { 1.0, true, 0, 0, &clock };
+	LoadBenchTask dependent = { 1.0, false, 0, 0, &clock };
+	LoadBenchTask chained = { 1.0, false, 0, 0, &clock };
+	LoadBenchTask independent = { 1.0, false, 0, 0, &clock };
+	AsyncLoader loader;
+	loader.init(jobs);
+	LoadTaskId brokenId = loader.add("Broken", &loadBenchWork, &loadBenchFinish, &broken);
+	LoadTaskId dependentId = loader.add("Dependent", &loadBenchWork, &loadBenchFinish, &dependent, brokenId);
+	LoadTaskId chainedId = loader.add("Chained", &loadBenchWork, &loadBenchFinish, &chained, dependentId);
+	LoadTaskId independentId = loader.add("Independent", &loadBenchWork, &loadBenchFinish, &independent);
+	HRESULT hr = loader.wait();
+	bool failOk = hr == E_FAIL &&
+								loader.getState(brokenId) == LOAD_TASK_FAILED &&
+								loader.getState(dependentId) == LOAD_TASK_FAILED &&
+								loader.getState(chainedId) == LOAD_TASK_FAILED &&
+								loader.getState(independentId) == LOAD_TASK_DONE &&
+								loader.getStats().failed == 3;
+	loader.destroy();
+	jobs.destroy();
+
+	os << "  work=" << workMs << "ms serial=" << wallMs[0] << "ms (" << threads[0] << " thread)"
+		 << " parallel=" << wallMs[1] << "ms (" << threads[1] << " threads)"
+		 << " speedup=" << wallMs[0] / wallMs[1] << "x"
+		 << (orderOk ? " order OK" : " order MISMATCH")
+		 << (failOk ? " failure OK" : " failure MISMATCH") << "\n";
+	report(os.str());
+	return orderOk && failOk;
+}
+
+bool
+RunParameterBlockBenchmark() {
+	// Layout como lo dejaria D3DReflect para
+	// cbuffer cbCamera : register( b3 ) { matrix View; matrix Projection; float3 EyePos; }
+	ConstantBufferLayout layout;
+	layout.name = "cbCamera";
+	layout.slot = 3;
+	layout.size = 144;
+	layout.parameters.push_back(makeParameter("View", 0, 64, D3D_SVC_MATRIX_COLUMNS, 4, 4));
+	layout.parameters.push_back(makeParameter("Projection", 64, 64, D3D_SVC_MATRIX_COLUMNS, 4, 4));
+	layout.parameters.push_back(makeParameter("EyePos", 128, 12, D3D_SVC_VECTOR, 1, 3));
+
+	// Validacion del struct de C++ y declaracion generada
+	const ConstantBufferMember members[] = {
+		CB_MEMBER("View", CBCameraBench, View),
+		CB_MEMBER("Projection", CBCameraBench, Projection),
+		CB_MEMBER("EyePos", CBCameraBench, EyePos)
+	};
+	ConstantBufferMember shifted[] = {
+		CB_MEMBER("View", CBCameraBench, View),
+		CB_MEMBER("Projection", CBCameraBench, Projection),
+		CB_MEMBER("EyePos", CBCameraBench, EyePos)
+	};
+	shifted[2].offset += 4;
+	std::string generated = ShaderReflection::generateStruct(layout, "CBCamera");
+	bool layoutOk = ShaderReflection::validate(layout, members, 3, sizeof(CBCameraBench)) &&
+									!ShaderReflection::validate(layout, shifted, 3, sizeof(CBCameraBench)) &&
+									!ShaderReflection::validate(layout, members, 2, sizeof(CBCameraBench)) &&
+									generated.find("XMMATRIX Projection;") != std::string::npos &&
+									generated.find("XMFLOAT3 EyePos;") != std::string::npos &&
+									generated.find("pad0[4]") != std::string::npos;
+
+	// Una camara que se mueve 1 de cada 100 frames y una proyeccion fija:
+	// subir siempre contra subir solo lo que cambio
+	NullBackend backend;
+	backend.init();
+	Device device;
+	device.init(&backend);
+	DeviceContext context;
+	context.init(&backend);
+
+	const unsigned int frames = 10000;
+	const unsigned int moveEvery = 100;
+	CBCameraBench camera;
+	camera.View = XMMatrixIdentity();
+	camera.Projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.01f, 100.0f);
+	camera.EyePos = XMFLOAT3(0.0f, 3.0f, -6.0f);
+
+	Buffer always;
+	always.init(device, layout.size);
+	Clock::time_point start = Clock::now();
+	for (unsigned int frame = 0; frame < frames; ++frame) {
+		if (frame % moveEvery == 0) {
+			camera.EyePos.x = static_cast<float>(frame);
+			camera.View = XMMatrixTranslation(-camera.EyePos.x, -camera.EyePos.y, -camera.EyePos.z);
+		}
+		always.update(context, nullptr, 0, nullptr, &camera, 0, 0);
+		always.render(context, layout.slot, 1);
+	}
+	double alwaysMs = elapsedMs(start);
+	unsigned long long alwaysUploads = backend.getOpStats(OP_UPDATE_SUBRESOURCE).calls;
+
+	backend.reset();
+	ParameterBlock block;
+	block.init(device, layout);
+	const unsigned int view = block.findParameter("View");
+	const unsigned int projection = block.findParameter("Projection");
+	const unsigned int eye = block.findParameter("EyePos");
+	start = Clock::now();
+	for (unsigned int frame = 0; frame < frames; ++frame) {
+		if (frame % moveEvery == 0) {
+			camera.EyePos.x = static_cast<float>(frame);
+			camera.View = XMMatrixTranslation(-camera.EyePos.x, -camera.EyePos.y, -camera.EyePos.z);
+		}
+		block.set(view, &camera.View, sizeof(XMMATRIX));
+		block.set(projection, &camera.Projection, sizeof(XMMATRIX));
+		block.set(eye, &camera.EyePos, sizeof(XMFLOAT3));
+		block.update(context);
+		block.render(context);
+	}
+	double blockMs = elapsedMs(start);
+	const ParameterBlockStats& stats = block.getStats();
+	unsigned long long blockUploads = backend.getOpStats(OP_UPDATE_SUBRESOURCE).calls;
+
+	// El buffer enlazado tiene el ultimo valor escrito
+	bool contentOk = false;
+	const std::vector<RenderCommand>& commands = backend.getCommands();
+	for (size_t i = commands.size(); i-- > 0;) {
+		if (commands[i].op == OP_VS_SET_CONSTANT_BUFFERS) {
+			unsigned int byteWidth = 0;
+			ID3D11Buffer* bound = static_cast<ID3D11Buffer*>(const_cast<void*>(commands[i].handle));
+			const unsigned char* data = NullBackend::getBufferData(bound, &byteWidth);
+			contentOk = data && byteWidth == layout.size &&
+									memcmp(data, &camera.View, sizeof(XMMATRIX)) == 0 &&
+									memcmp(data + 64, &camera.Projection, sizeof(XMMATRIX)) == 0 &&
+									memcmp(data + 128, &camera.EyePos, sizeof(XMFLOAT3)) == 0;
+			break;
+		}
+	}
+	bool uploadsOk = blockUploads == frames / moveEvery && stats.uploads == blockUploads &&
+									 stats.skipped == frames - blockUploads && alwaysUploads == frames;
+	unsigned long long dirtyBytes = stats.dirtyBytes;
+	block.destroy();
+	always.destroy();
+	context.destroy();
+	device.destroy();
+	backend.destroy();
+
+	std::ostringstream os;
+	os << "ParameterBlock frames=" << frames << " camera moves every " << moveEvery
+		 << (layoutOk ? " layout OK" : " layout MISMATCH") << "\n"
+		 << "  always uploads=" << alwaysUploads << " bytes=" << alwaysUploads * layout.size
+		 << " time=" << alwaysMs << "ms\n"
+		 << "  block uploads=" << blockUploads << " bytes=" << blockUploads * layout.size
+		 << " dirty=" << dirtyBytes << " time=" << blockMs << "ms"
+		 << (uploadsOk && contentOk ? " OK" : " MISMATCH") << "\n";
+	report(os.str());
+	return layoutOk && uploadsOk && contentOk;
+}
+
+bool
+RunHotReloadBenchmark() {
+	std::ostringstream os;
+	bool watchOk = true;
+
+	// Watcher nativo y por sondeo: nada sin cambios, una rafaga de escrituras
+	// se reporta una sola vez y la latencia desde la ultima escritura
+	const char* watchPath = "HotReloadBenchmark.txt";
+	writeTextFile(watchPath, "0");
+	for (int mode = 0; mode < 2; ++mode) {
+		FileWatcher watcher;
+		watcher.init(mode == 0, 20.0, 50.0);
+		FileWatchId id = watcher.watch(watchPath);
+		std::vector<FileWatchId> changed;
+		Clock::time_point start = Clock::now();
+		while (elapsedMs(start) < 150.0) {
+			watcher.poll(changed);
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
+		bool quietOk = changed.empty();
+
+		for (int i = 0; i < 5; ++i) {
+			writeTextFile(watchPath, std::string(static_cast<size_t>(i) + 2, 'x'));
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+		start = Clock::now();
+		while (changed.empty() && elapsedMs(start) < 2000.0) {
+			watcher.poll(changed);
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		double latencyMs = elapsedMs(start);
+		Clock::time_point settle = Clock::now();
+		while (elapsedMs(settle) < 200.0) {
+			watcher.poll(changed);
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
+		bool coalesceOk = changed.size() == 1 && changed[0] == id;
+		watchOk = watchOk && quietOk && coalesceOk;
+		os << "HotReload watcher " << (watcher.isNative() ? "native" : "polling")
+			 << " latency=" << latencyMs << "ms changes=" << changed.size()
+			 << (quietOk && coalesceOk ? " OK" : " MISMATCH") << "\n";
+		watcher.destroy();
+	}
+	remove(watchPath);
+
+	NullBackend backend;
+	backend.init(false);
+	Device device;
+	device.init(&backend);
+	JobSystem jobs;
+	jobs.init();
+	HotReloader reloader;
+	reloader.init(device, jobs, true, 20.0);
+	double longestUpdateMs = 0.0;
+
+	// Malla: la rejilla pasa de 16 a 32 quads por lado y un OBJ roto deja
+	// la malla anterior
+	const char* meshPath = "HotReloadBenchmark.obj";
+	writeTextFile(meshPath, makeSyntheticObj(16));
+	MeshComponent mesh;
+	ObjLoader loader;
+	Buffer vertexBuffer;
+	Buffer indexBuffer;
+	bool meshOk = SUCCEEDED(loader.load(meshPath, mesh)) &&
+								SUCCEEDED(vertexBuffer.init(device, mesh, D3D11_BIND_VERTEX_BUFFER)) &&
+								SUCCEEDED(indexBuffer.init(device, mesh, D3D11_BIND_INDEX_BUFFER));
+	const int verticesBefore = mesh.m_numVertex;
+	reloader.addMesh(meshPath, mesh, vertexBuffer, indexBuffer);
+	writeTextFile(meshPath, makeSyntheticObj(32));
+	double meshLatencyMs = pumpHotReload(reloader, 1, longestUpdateMs);
+	double meshSwapMs = reloader.getStats().lastSwapMs;
+	meshOk = meshOk && reloader.getStats().reloads == 1 && mesh.m_numVertex == 33 * 33;
+	writeTextFile(meshPath, "broken\n");
+	pumpHotReload(reloader, 2, longestUpdateMs);
+	meshOk = meshOk && reloader.getStats().failed == 1 && mesh.m_numVertex == 33 * 33;
+
+	// Shader: cambiar el color recarga; cambiar el layout del cbuffer o un
+	// error de sintaxis dejan el programa vivo
+	const char* shaderPath = "HotReloadBenchmark.fx";
+	writeTextFile(shaderPath, makeHotReloadShader("1.0f, 0.0f, 0.0f, 1.0f", false));
+	VertexFormat format;
+	format.init(VertexFormatDesc());
+	std::vector<D3D11_INPUT_ELEMENT_DESC> layout;
+	format.buildLayout(layout);
+	ShaderCache cache;
+	ShaderProgram program;
+	program.setCache(&cache);
+	bool shaderOk = SUCCEEDED(program.init(device, shaderPath, layout));
+	ID3D11VertexShader* original = program.m_VertexShader;
+	reloader.addShader(program);
+
+	writeTextFile(shaderPath, makeHotReloadShader("0.0f, 1.0f, 0.0f, 1.0f", false));
+	double shaderLatencyMs = pumpHotReload(reloader, 3, longestUpdateMs);
+	double shaderSwapMs = reloader.getStats().lastSwapMs;
+	ID3D11VertexShader* reloaded = program.m_VertexShader;
+	shaderOk = shaderOk && reloader.getStats().reloads == 2 && reloaded && reloaded != original;
+
+	writeTextFile(shaderPath, makeHotReloadShader("0.0f, 0.0f, 1.0f, 1.0f", true));
+	pumpHotReload(reloader, 4, longestUpdateMs);
+	bool layoutOk = reloader.getStats().failed == 2 && program.m_VertexShader == reloaded;
+
+	writeTextFile(shaderPath, makeHotReloadShader("0.0f, 0.0f, 1.0f, 1.0f", false) + "#error broken\n");
+	pumpHotReload(reloader, 5, longestUpdateMs);
+	bool syntaxOk = reloader.getStats().failed == 3 && program.m_VertexShader == reloaded;
+
+	// Sin escrituras no debe haber recargas
+	Clock::time_point start = Clock::now();
+	while (elapsedMs(start) < 200.0) {
+		reloader.update();
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	}
+	bool quietOk = reloader.getStats().reloads + reloader.getStats().failed == 5 && !reloader.isBusy();
+	unsigned int changes = reloader.getStats().changes;
+
+	reloader.destroy();
+	program.destroy();
+	vertexBuffer.destroy();
+	indexBuffer.destroy();
+	jobs.destroy();
+	device.destroy();
+	backend.destroy();
+	remove(meshPath);
+	remove(shaderPath);
+
+	os << "  mesh vertices " << verticesBefore << " -> " << mesh.m_numVertex
+		 << " latency=" << meshLatencyMs << "ms swap=" << meshSwapMs << "ms"
+		 << (meshOk ? " OK" : " MISMATCH") << "\n"
+		 << "  shader latency=" << shaderLatencyMs << "ms swap=" << shaderSwapMs << "ms"
+		 << (shaderOk ? " OK" : " MISMATCH")
+		 << (layoutOk ? " layout change rejected" : " layout change MISMATCH")
+		 << (syntaxOk ? " syntax error kept" : " syntax error MISMATCH") << "\n"
+		 << "  changes=" << changes << " longest update=" << longestUpdateMs << "ms"
+		 << (quietOk ? " quiet OK" : " quiet MISMATCH") << "\n";
+	report(os.str());
+	return watchOk && meshOk && shaderOk && layoutOk && syntaxOk && quietOk;
+}
@@ -4,7 +4,7 @@
 
 HRESULT
 BlendState::init(Device& device) {
-	if (!device.m_device) {
+	if (!device.m_backend) {
 		ERROR("ShaderProgram", "init", "Device is null.");
 		return E_POINTER;
 	}
@@ -25,7 +25,7 @@ BlendState::init(Device& device) {
 
 	blendDesc.RenderTarget[0] = rtBlendDesc;
 
-	HRESULT hr = device.m_device->CreateBlendState(&blendDesc, &m_blendState);
+	HRESULT hr = device.CreateBlendState(&blendDesc, &m_blendState);
 	if (FAILED(hr)) {
 		ERROR("BlendState", "init",
 			("Failed to create blend state. HRESULT: " + std::to_string(hr)).c_str());
@@ -39,7 +39,7 @@ BlendState::render(DeviceContext& deviceContext,
 	float* blendFactor,
 	unsigned int sampleMask,
 	bool reset) {
-	if (!deviceContext.m_deviceContext) {
+	if (!deviceContext.m_backend) {
 		ERROR("RenderTargetView", "render", "DeviceContext is nullptr.");
 		return;
 	}
@@ -54,10 +54,10 @@ BlendState::render(DeviceContext& deviceContext,
 	}
 
 	if (!reset) {
-		deviceContext.m_deviceContext->OMSetBlendState(m_blendState, blendFactor, sampleMask);
+		deviceContext.OMSetBlendState(m_blendState, blendFactor, sampleMask);
 	}
 	else {
-		deviceContext.m_deviceContext->OMSetBlendState(nullptr, blendFactor, sampleMask);
+		deviceContext.OMSetBlendState(nullptr, blendFactor, sampleMask);
 	}
 }
 
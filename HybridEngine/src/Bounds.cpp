@@ -0,0 +1,107 @@
+#include "Bounds.h"
+#include "MeshComponent.h"
+#include <cmath>
+
+namespace {
+	// Cota superior del factor de escala de la parte 3x3 de m. Sin cizalla
+	// (S * R o R * S) las filas o las columnas son ortogonales y la cota es
+	// exacta; en otro caso se usa la norma de Frobenius.
+	float
+	maxScale(const Float4x4& m) {
+		float rowSq[3], colSq[3];
+		float rowDot = 0.0f, colDot = 0.0f, frobeniusSq = 0.0f;
+		for (int i = 0; i < 3; ++i) {
+			rowSq[i] = m.m[i][0] * m.m[i][0] + m.m[i][1] * m.m[i][1] + m.m[i][2] * m.m[i][2];
+			colSq[i] = m.m[0][i] * m.m[0][i] + m.m[1][i] * m.m[1][i] + m.m[2][i] * m.m[2][i];
+			frobeniusSq += rowSq[i];
+		}
+		for (int i = 0; i < 3; ++i) {
+			int j = (i + 1) % 3;
+			rowDot = fmaxf(rowDot, fabsf(m.m[i][0] * m.m[j][0] + m.m[i][1] * m.m[j][1] + m.m[i][2] * m.m[j][2]));
+			colDot = fmaxf(colDot, fabsf(m.m[0][i] * m.m[0][j] + m.m[1][i] * m.m[1][j] + m.m[2][i] * m.m[2][j]));
+		}
+
+		const float epsilon = 1e-4f * frobeniusSq;
+		if (rowDot <= epsilon) {
+			return sqrtf(fmaxf(rowSq[0], fmaxf(rowSq[1], rowSq[2])));
+		}
+		if (colDot <= epsilon) {
+			return sqrtf(fmaxf(colSq[0], fmaxf(colSq[1], colSq[2])));
+		}
+		return sqrtf(frobeniusSq);
+	}
+}
+
+Bounds
+ComputeMeshBounds(const MeshComponent& mesh) {
+	Bounds bounds = { Float3(0.0f, 0.0f, 0.0f), Float3(0.0f, 0.0f, 0.0f), 0.0f };
+	if (mesh.m_vertex.empty()) {
+		return bounds;
+	}
+
+	XMFLOAT3 minimum = mesh.m_vertex[0].Pos;
+	XMFLOAT3 maximum = mesh.m_vertex[0].Pos;
+	for (size_t i = 1; i < mesh.m_vertex.size(); ++i) {
+		const XMFLOAT3& p = mesh.m_vertex[i].Pos;
+		minimum.x = p.x < minimum.x ? p.x : minimum.x;
+		minimum.y = p.y < minimum.y ? p.y : minimum.y;
+		minimum.z = p.z < minimum.z ? p.z : minimum.z;
+		maximum.x = p.x > maximum.x ? p.x : maximum.x;
+		maximum.y = p.y > maximum.y ? p.y : maximum.y;
+		maximum.z = p.z > maximum.z ? p.z : maximum.z;
+	}
+	bounds.center = Float3((minimum.x + maximum.x) * 0.5f,
+													 (minimum.y + maximum.y) * 0.5f,
+													 (minimum.z + maximum.z) * 0.5f);
+	bounds.extents = Float3((maximum.x - minimum.x) * 0.5f,
+														(maximum.y - minimum.y) * 0.5f,
+														(maximum.z - minimum.z) * 0.5f);
+
+	// Esfera centrada en la caja: mas holgada que la minima pero comparte centro
+	float radiusSq = 0.0f;
+	for (size_t i = 0; i < mesh.m_vertex.size(); ++i) {
+		const XMFLOAT3& p = mesh.m_vertex[i].Pos;
+		float dx = p.x - bounds.center.x;
+		float dy = p.y - bounds.center.y;
+		float dz = p.z - bounds.center.z;
+		float distSq = dx * dx + dy * dy + dz * dz;
+		radiusSq = distSq > radiusSq ? distSq : radiusSq;
+	}
+	bounds.radius = sqrtf(radiusSq);
+	return bounds;
+}
+
+Bounds
+TransformBounds(const Bounds& local, const Float4x4& world) {
+	const Float4x4& m = world;
+
+	Bounds result;
+	const float c[3] = { local.center.x, local.center.y, local.center.z };
+	const float e[3] = { local.extents.x, local.extents.y, local.extents.z };
+	float center[3];
+	float extents[3];
+	// Arvo: cada extension del resultado suma |M| * extension local
+	for (int j = 0; j < 3; ++j) {
+		center[j] = m.m[3][j];
+		extents[j] = 0.0f;
+		for (int i = 0; i < 3; ++i) {
+			center[j] += c[i] * m.m[i][j];
+			extents[j] += fabsf(m.m[i][j]) * e[i];
+		}
+	}
+	result.center = Float3(center[0], center[1], center[2]);
+	result.extents = Float3(extents[0], extents[1], extents[2]);
+
+	result.radius = local.radius * maxScale(m);
+
+	// Matrices con w constante (p. ej. la de sombra plana): dividir por w
+	if (m.m[0][3] == 0.0f && m.m[1][3] == 0.0f && m.m[2][3] == 0.0f &&
+			m.m[3][3] != 0.0f && m.m[3][3] != 1.0f) {
+		float inv = 1.0f / m.m[3][3];
+		float absInv = fabsf(inv);
+		result.center = Float3(result.center.x * inv, result.center.y * inv, result.center.z * inv);
+		result.extents = Float3(result.extents.x * absInv, result.extents.y * absInv, result.extents.z * absInv);
+		result.radius *= absInv;
+	}
+	return result;
+}
@@ -5,7 +5,7 @@
 
 HRESULT
 Buffer::init(Device& device, const MeshComponent& mesh, unsigned int bindFlag) {
-	if (!device.m_device) {
+	if (!device.m_backend) {
 		ERROR("ShaderProgram", "init", "Device is null.");
 		return E_POINTER;
 	}
@@ -32,18 +32,68 @@ Buffer::init(Device& device, const MeshComponent& mesh, unsigned int bindFlag) {
 		data.pSysMem = mesh.m_vertex.data();
 	}
 	else if (bindFlag & D3D11_BIND_INDEX_BUFFER) {
+		unsigned int maxIndex = 0;
+		for (size_t i = 0; i < mesh.m_index.size(); ++i) {
+			maxIndex = mesh.m_index[i] > maxIndex ? mesh.m_index[i] : maxIndex;
+		}
+		desc.BindFlags = (D3D11_BIND_FLAG)bindFlag;
+		if (maxIndex <= 0xffff) {
+			// Caben en 16 bits: mitad de memoria y de ancho de banda
+			std::vector<unsigned short> compact(mesh.m_index.begin(), mesh.m_index.end());
+			m_stride = sizeof(unsigned short);
+			m_format = DXGI_FORMAT_R16_UINT;
+			desc.ByteWidth = m_stride * static_cast<unsigned int>(compact.size());
+			data.pSysMem = compact.data();
+			return createBuffer(device, desc, &data);
+		}
 		m_stride = sizeof(unsigned int);
+		m_format = DXGI_FORMAT_R32_UINT;
 		desc.ByteWidth = m_stride * static_cast<unsigned int>(mesh.m_index.size());
-		desc.BindFlags = (D3D11_BIND_FLAG)bindFlag;
 		data.pSysMem = mesh.m_index.data();
 	}
 
 	return createBuffer(device, desc, &data);
 }
 
+HRESULT
+Buffer::init(Device& device,
+						 const void* data,
+						 unsigned int count,
+						 unsigned int stride,
+						 unsigned int bindFlag) {
+	if (!device.m_backend) {
+		ERROR("Buffer", "init", "Device is null.");
+		return E_POINTER;
+	}
+	if (!data || count == 0 || stride == 0) {
+		ERROR("Buffer", "init", "Buffer data is empty");
+		return E_INVALIDARG;
+	}
+	if ((bindFlag & D3D11_BIND_INDEX_BUFFER) && stride != 2 && stride != 4) {
+		ERROR("Buffer", "init", "Index stride must be 2 or 4 bytes");
+		return E_INVALIDARG;
+	}
+
+	D3D11_BUFFER_DESC desc = {};
+	desc.Usage = D3D11_USAGE_IMMUTABLE;
+	desc.ByteWidth = count * stride;
+	desc.BindFlags = (D3D11_BIND_FLAG)bindFlag;
+	desc.CPUAccessFlags = 0;
+	m_stride = stride;
+	m_bindFlag = bindFlag;
+	if (bindFlag & D3D11_BIND_INDEX_BUFFER) {
+		m_format = stride == 2 ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+	}
+
+	// El driver copia pSysMem durante CreateBuffer; data solo debe vivir hasta aqui
+	D3D11_SUBRESOURCE_DATA initData = {};
+	initData.pSysMem = data;
+	return createBuffer(device, desc, &initData);
+}
+
 HRESULT 
 Buffer::init(Device& device, unsigned int ByteWidth) {
-	if (!device.m_device) {
+	if (!device.m_backend) {
 		ERROR("ShaderProgram", "init", "Device is null.");
 		return E_POINTER;
 	}
@@ -62,6 +112,48 @@ Buffer::init(Device& device, unsigned int ByteWidth) {
 	return createBuffer(device, desc, nullptr);
 }
 
+HRESULT
+Buffer::initDynamic(Device& device, unsigned int ByteWidth, unsigned int stride, unsigned int bindFlag) {
+	if (!device.m_backend) {
+		ERROR("Buffer", "initDynamic", "Device is null.");
+		return E_POINTER;
+	}
+	if (ByteWidth == 0 || stride == 0) {
+		ERROR("Buffer", "initDynamic", "ByteWidth and stride must be greater than zero");
+		return E_INVALIDARG;
+	}
+	m_stride = stride;
+
+	D3D11_BUFFER_DESC desc = {};
+	desc.Usage = D3D11_USAGE_DYNAMIC;
+	desc.ByteWidth = ByteWidth;
+	desc.BindFlags = (D3D11_BIND_FLAG)bindFlag;
+	desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	m_bindFlag = bindFlag;
+
+	return createBuffer(device, desc, nullptr);
+}
+
+void*
+Buffer::map(DeviceContext& deviceContext, D3D11_MAP mapType) {
+	if (!m_buffer) {
+		ERROR("Buffer", "map", "m_buffer is null.");
+		return nullptr;
+	}
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	HRESULT hr = deviceContext.Map(m_buffer, 0, mapType, 0, &mapped);
+	if (FAILED(hr)) {
+		ERROR("Buffer", "map", ("Map failed. HRESULT: " + std::to_string(hr)).c_str());
+		return nullptr;
+	}
+	return mapped.pData;
+}
+
+void
+Buffer::unmap(DeviceContext& deviceContext) {
+	deviceContext.Unmap(m_buffer, 0);
+}
+
 void 
 Buffer::update(DeviceContext& deviceContext, 
 							 ID3D11Resource* pDstResource,
@@ -78,12 +170,12 @@ Buffer::update(DeviceContext& deviceContext,
 		ERROR("ShaderProgram", "update", "pSrcData is null.");
 		return;
 	}
-	deviceContext.m_deviceContext->UpdateSubresource(m_buffer, 
-																									 DstSubresource, 
-																									 pDstBox, 
-																									 pSrcData, 
-																									 SrcRowPitch, 
-																									 SrcDepthPitch);
+	deviceContext.UpdateSubresource(m_buffer, 
+                                  DstSubresource,
+                                  pDstBox,
+                                  pSrcData,
+                                  SrcRowPitch,
+                                  SrcDepthPitch);
 
 
 }
@@ -94,7 +186,7 @@ Buffer::render(DeviceContext& deviceContext,
 							 unsigned int NumBuffers, 
 							 bool setPixelShader, 
 							 DXGI_FORMAT format) {
-	if (!deviceContext.m_deviceContext) {
+	if (!deviceContext.m_backend) {
 		ERROR("RenderTargetView", "render", "DeviceContext is nullptr.");
 		return;
 	}
@@ -105,16 +197,16 @@ Buffer::render(DeviceContext& deviceContext,
 
 	switch (m_bindFlag) {
 	case D3D11_BIND_VERTEX_BUFFER:
-		deviceContext.m_deviceContext->IASetVertexBuffers(StartSlot, NumBuffers, &m_buffer, &m_stride, &m_offset);
+		deviceContext.IASetVertexBuffers(StartSlot, NumBuffers, &m_buffer, &m_stride, &m_offset);
 		break;
 	case D3D11_BIND_CONSTANT_BUFFER:
-		deviceContext.m_deviceContext->VSSetConstantBuffers(StartSlot, NumBuffers, &m_buffer);
+		deviceContext.VSSetConstantBuffers(StartSlot, NumBuffers, &m_buffer);
 		if (setPixelShader) {
-			deviceContext.m_deviceContext->PSSetConstantBuffers(StartSlot, NumBuffers, &m_buffer);
+			deviceContext.PSSetConstantBuffers(StartSlot, NumBuffers, &m_buffer);
 		}
 		break;
 	case D3D11_BIND_INDEX_BUFFER:
-		deviceContext.m_deviceContext->IASetIndexBuffer(m_buffer, format, m_offset);
+		deviceContext.IASetIndexBuffer(m_buffer, format == DXGI_FORMAT_UNKNOWN ? m_format : format, m_offset);
 		break;
 	default:
 		ERROR("Buffer", "render", "Unsupported BindFlag");
@@ -126,6 +218,7 @@ Buffer::render(DeviceContext& deviceContext,
 void 
 Buffer::destroy() {
 	SAFE_RELEASE(m_buffer);
+	m_format = DXGI_FORMAT_UNKNOWN;
 }
 
 
@@ -133,7 +226,7 @@ HRESULT
 Buffer::createBuffer(Device& device, 
 										 D3D11_BUFFER_DESC& desc, 
 										 D3D11_SUBRESOURCE_DATA* initData) {
-	if (!device.m_device) {
+	if (!device.m_backend) {
 		ERROR("Buffer", "createBuffer", "Device is nullptr");
 		return E_POINTER;
 	}
@@ -0,0 +1,80 @@
+#include "ConstantBufferRing.h"
+#include "Device.h"
+#include "DeviceContext.h"
+
+HRESULT
+ConstantBufferRing::init(Device& device, unsigned int sliceCount, unsigned int framesInFlight) {
+	if (!device.m_backend) {
+		ERROR("ConstantBufferRing", "init", "Device is nullptr");
+		return E_POINTER;
+	}
+	if (sliceCount == 0) {
+		ERROR("ConstantBufferRing", "init", "sliceCount must be greater than zero");
+		return E_INVALIDARG;
+	}
+
+	D3D11_BUFFER_DESC desc;
+	memset(&desc, 0, sizeof(desc));
+	desc.ByteWidth = SLICE_SIZE;
+	desc.Usage = D3D11_USAGE_DYNAMIC;
+	desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+	m_slices.resize(sliceCount, nullptr);
+	for (unsigned int i = 0; i < sliceCount; ++i) {
+		HRESULT hr = device.CreateBuffer(&desc, nullptr, &m_slices[i]);
+		if (FAILED(hr)) {
+			ERROR("ConstantBufferRing", "init",
+				("Failed to create slice. HRESULT: " + std::to_string(hr)).c_str());
+			destroy();
+			return hr;
+		}
+	}
+
+	m_ring.init(sliceCount * SLICE_SIZE, SLICE_SIZE, framesInFlight);
+	return S_OK;
+}
+
+void
+ConstantBufferRing::beginFrame() {
+	m_ring.beginFrame();
+}
+
+ID3D11Buffer*
+ConstantBufferRing::upload(DeviceContext& deviceContext, const void* data, unsigned int size) {
+	if (size > SLICE_SIZE) {
+		ERROR("ConstantBufferRing", "upload", "Constant data does not fit in a slice");
+		return nullptr;
+	}
+	unsigned int offset = m_ring.allocate(size);
+	if (offset == UploadRing::INVALID_OFFSET) {
+		ERROR("ConstantBufferRing", "upload", "Ring is full");
+		return nullptr;
+	}
+
+	ID3D11Buffer* slice = m_slices[offset / SLICE_SIZE];
+	D3D11_MAPPED_SUBRESOURCE mapped;
+	HRESULT hr = deviceContext.Map(slice, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+	if (FAILED(hr)) {
+		ERROR("ConstantBufferRing", "upload",
+			("Map failed. HRESULT: " + std::to_string(hr)).c_str());
+		return nullptr;
+	}
+	memcpy(mapped.pData, data, size);
+	deviceContext.Unmap(slice, 0);
+	return slice;
+}
+
+void
+ConstantBufferRing::endFrame() {
+	m_ring.endFrame();
+}
+
+void
+ConstantBufferRing::destroy() {
+	for (size_t i = 0; i < m_slices.size(); ++i) {
+		SAFE_RELEASE(m_slices[i]);
+	}
+	m_slices.clear();
+	m_ring.destroy();
+}
@@ -0,0 +1,288 @@
+#include "D3D11Backend.h"
+
+void
+D3D11Backend::init(ID3D11Device* device, ID3D11DeviceContext* deviceContext) {
+	m_device = device;
+	m_deviceContext = deviceContext;
+}
+
+void
+D3D11Backend::destroy() {
+	// Device y context se liberan en CleanupDevice
+	m_device = nullptr;
+	m_deviceContext = nullptr;
+}
+
+HRESULT
+D3D11Backend::CreateBuffer(const D3D11_BUFFER_DESC* pDesc,
+													 const D3D11_SUBRESOURCE_DATA* pInitialData,
+													 ID3D11Buffer** ppBuffer) {
+	return m_device->CreateBuffer(pDesc, pInitialData, ppBuffer);
+}
+
+HRESULT
+D3D11Backend::CreateTexture2D(const D3D11_TEXTURE2D_DESC* pDesc,
+															const D3D11_SUBRESOURCE_DATA* pInitialData,
+															ID3D11Texture2D** ppTexture2D) {
+	return m_device->CreateTexture2D(pDesc, pInitialData, ppTexture2D);
+}
+
+HRESULT
+D3D11Backend::CreateShaderResourceView(ID3D11Resource* pResource,
+																			 const D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc,
+																			 ID3D11ShaderResourceView** ppSRView) {
+	return m_device->CreateShaderResourceView(pResource, pDesc, ppSRView);
+}
+
+HRESULT
+D3D11Backend::CreateShaderResourceViewFromFile(const std::string& fileName,
+																							 ID3D11ShaderResourceView** ppSRView) {
+	return D3DX11CreateShaderResourceViewFromFile(m_device,
+																								fileName.c_str(),
+																								nullptr,
+																								nullptr,
+																								ppSRView,
+																								nullptr);
+}
+
+HRESULT
+D3D11Backend::CreateRenderTargetView(ID3D11Resource* pResource,
+																		 const D3D11_RENDER_TARGET_VIEW_DESC* pDesc,
+																		 ID3D11RenderTargetView** ppRTView) {
+	return m_device->CreateRenderTargetView(pResource, pDesc, ppRTView);
+}
+
+HRESULT
+D3D11Backend::CreateDepthStencilView(ID3D11Resource* pResource,
+																		 const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc,
+																		 ID3D11DepthStencilView** ppDepthStencilView) {
+	return m_device->CreateDepthStencilView(pResource, pDesc, ppDepthStencilView);
+}
+
+HRESULT
+D3D11Backend::CreateVertexShader(const void* pShaderBytecode,
+																 unsigned int BytecodeLength,
+																 ID3D11ClassLinkage* pClassLinkage,
+																 ID3D11VertexShader** ppVertexShader) {
+	return m_device->CreateVertexShader(pShaderBytecode, BytecodeLength, pClassLinkage, ppVertexShader);
+}
+
+HRESULT
+D3D11Backend::CreatePixelShader(const void* pShaderBytecode,
+																unsigned int BytecodeLength,
+																ID3D11ClassLinkage* pClassLinkage,
+																ID3D11PixelShader** ppPixelShader) {
+	return m_device->CreatePixelShader(pShaderBytecode, BytecodeLength, pClassLinkage, ppPixelShader);
+}
+
+HRESULT
+D3D11Backend::CreateInputLayout(const D3D11_INPUT_ELEMENT_DESC* pInputElementDescs,
+																unsigned int NumElements,
+																const void* pShaderBytecodeWithInputSignature,
+																unsigned int BytecodeLength,
+																ID3D11InputLayout** ppInputLayout) {
+	return m_device->CreateInputLayout(pInputElementDescs,
+																		 NumElements,
+																		 pShaderBytecodeWithInputSignature,
+																		 BytecodeLength,
+																		 ppInputLayout);
+}
+
+HRESULT
+D3D11Backend::CreateSamplerState(const D3D11_SAMPLER_DESC* pSamplerDesc,
+																 ID3D11SamplerState** ppSamplerState) {
+	return m_device->CreateSamplerState(pSamplerDesc, ppSamplerState);
+}
+
+HRESULT
+D3D11Backend::CreateBlendState(const D3D11_BLEND_DESC* pBlendStateDesc,
+															 ID3D11BlendState** ppBlendState) {
+	return m_device->CreateBlendState(pBlendStateDesc, ppBlendState);
+}
+
+HRESULT
+D3D11Backend::CreateDepthStencilState(const D3D11_DEPTH_STENCIL_DESC* pDepthStencilDesc,
+																			ID3D11DepthStencilState** ppDepthStencilState) {
+	return m_device->CreateDepthStencilState(pDepthStencilDesc, ppDepthStencilState);
+}
+
+HRESULT
+D3D11Backend::CreateRasterizerState(const D3D11_RASTERIZER_DESC* pRasterizerDesc,
+																		ID3D11RasterizerState** ppRasterizerState) {
+	return m_device->CreateRasterizerState(pRasterizerDesc, ppRasterizerState);
+}
+
+void
+D3D11Backend::IASetInputLayout(ID3D11InputLayout* pInputLayout) {
+	m_deviceContext->IASetInputLayout(pInputLayout);
+}
+
+void
+D3D11Backend::IASetVertexBuffers(unsigned int StartSlot,
+																 unsigned int NumBuffers,
+																 ID3D11Buffer* const* ppVertexBuffers,
+																 const unsigned int* pStrides,
+																 const unsigned int* pOffsets) {
+	m_deviceContext->IASetVertexBuffers(StartSlot, NumBuffers, ppVertexBuffers, pStrides, pOffsets);
+}
+
+void
+D3D11Backend::IASetIndexBuffer(ID3D11Buffer* pIndexBuffer,
+															 DXGI_FORMAT Format,
+															 unsigned int Offset) {
+	m_deviceContext->IASetIndexBuffer(pIndexBuffer, Format, Offset);
+}
+
+void
+D3D11Backend::IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology) {
+	m_deviceContext->IASetPrimitiveTopology(Topology);
+}
+
+void
+D3D11Backend::VSSetShader(ID3D11VertexShader* pVertexShader,
+													ID3D11ClassInstance* const* ppClassInstances,
+													unsigned int NumClassInstances) {
+	m_deviceContext->VSSetShader(pVertexShader, ppClassInstances, NumClassInstances);
+}
+
+void
+D3D11Backend::PSSetShader(ID3D11PixelShader* pPixelShader,
+													ID3D11ClassInstance* const* ppClassInstances,
+													unsigned int NumClassInstances) {
+	m_deviceContext->PSSetShader(pPixelShader, ppClassInstances, NumClassInstances);
+}
+
+void
+D3D11Backend::VSSetConstantBuffers(unsigned int StartSlot,
+																	 unsigned int NumBuffers,
+																	 ID3D11Buffer* const* ppConstantBuffers) {
+	m_deviceContext->VSSetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers);
+}
+
+void
+D3D11Backend::PSSetConstantBuffers(unsigned int StartSlot,
+																	 unsigned int NumBuffers,
+																	 ID3D11Buffer* const* ppConstantBuffers) {
+	m_deviceContext->PSSetConstantBuffers(StartSlot, NumBuffers, ppConstantBuffers);
+}
+
+void
+D3D11Backend::PSSetShaderResources(unsigned int StartSlot,
+																	 unsigned int NumViews,
+																	 ID3D11ShaderResourceView* const* ppShaderResourceViews) {
+	m_deviceContext->PSSetShaderResources(StartSlot, NumViews, ppShaderResourceViews);
+}
+
+void
+D3D11Backend::PSSetSamplers(unsigned int StartSlot,
+														unsigned int NumSamplers,
+														ID3D11SamplerState* const* ppSamplers) {
+	m_deviceContext->PSSetSamplers(StartSlot, NumSamplers, ppSamplers);
+}
+
+void
+D3D11Backend::OMSetRenderTargets(unsigned int NumViews,
+																 ID3D11RenderTargetView* const* ppRenderTargetViews,
+																 ID3D11DepthStencilView* pDepthStencilView) {
+	m_deviceContext->OMSetRenderTargets(NumViews, ppRenderTargetViews, pDepthStencilView);
+}
+
+void
+D3D11Backend::OMSetBlendState(ID3D11BlendState* pBlendState,
+															const float BlendFactor[4],
+															unsigned int SampleMask) {
+	m_deviceContext->OMSetBlendState(pBlendState, BlendFactor, SampleMask);
+}
+
+void
+D3D11Backend::OMSetDepthStencilState(ID3D11DepthStencilState* pDepthStencilState,
+																		 unsigned int StencilRef) {
+	m_deviceContext->OMSetDepthStencilState(pDepthStencilState, StencilRef);
+}
+
+void
+D3D11Backend::RSSetViewports(unsigned int NumViewports, const D3D11_VIEWPORT* pViewports) {
+	m_deviceContext->RSSetViewports(NumViewports, pViewports);
+}
+
+void
+D3D11Backend::RSSetState(ID3D11RasterizerState* pRasterizerState) {
+	m_deviceContext->RSSetState(pRasterizerState);
+}
+
+void
+D3D11Backend::ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView,
+																		const float ColorRGBA[4]) {
+	m_deviceContext->ClearRenderTargetView(pRenderTargetView, ColorRGBA);
+}
+
+void
+D3D11Backend::ClearDepthStencilView(ID3D11DepthStencilView* pDepthStencilView,
+																		unsigned int ClearFlags,
+																		float Depth,
+																		UINT8 Stencil) {
+	m_deviceContext->ClearDepthStencilView(pDepthStencilView, ClearFlags, Depth, Stencil);
+}
+
+void
+D3D11Backend::UpdateSubresource(ID3D11Resource* pDstResource,
+																unsigned int DstSubresource,
+																const D3D11_BOX* pDstBox,
+																const void* pSrcData,
+																unsigned int SrcRowPitch,
+																unsigned int SrcDepthPitch) {
+	m_deviceContext->UpdateSubresource(pDstResource,
+																		 DstSubresource,
+																		 pDstBox,
+																		 pSrcData,
+																		 SrcRowPitch,
+																		 SrcDepthPitch);
+}
+
+HRESULT
+D3D11Backend::Map(ID3D11Resource* pResource,
+									unsigned int Subresource,
+									D3D11_MAP MapType,
+									unsigned int MapFlags,
+									D3D11_MAPPED_SUBRESOURCE* pMappedResource) {
+	return m_deviceContext->Map(pResource, Subresource, MapType, MapFlags, pMappedResource);
+}
+
+void
+D3D11Backend::Unmap(ID3D11Resource* pResource, unsigned int Subresource) {
+	m_deviceContext->Unmap(pResource, Subresource);
+}
+
+void
+D3D11Backend::DrawIndexed(unsigned int IndexCount,
+													unsigned int StartIndexLocation,
+													int BaseVertexLocation) {
+	m_deviceContext->DrawIndexed(IndexCount, StartIndexLocation, BaseVertexLocation);
+}
+
+void
+D3D11Backend::DrawIndexedInstanced(unsigned int IndexCountPerInstance,
+																	 unsigned int InstanceCount,
+																	 unsigned int StartIndexLocation,
+																	 int BaseVertexLocation,
+																	 unsigned int StartInstanceLocation) {
+	m_deviceContext->DrawIndexedInstanced(IndexCountPerInstance,
+																				InstanceCount,
+																				StartIndexLocation,
+																				BaseVertexLocation,
+																				StartInstanceLocation);
+}
+
+void
+D3D11Backend::ClearState() {
+	m_deviceContext->ClearState();
+}
+
+HRESULT
+D3D11Backend::Present(IDXGISwapChain* pSwapChain, unsigned int SyncInterval, unsigned int Flags) {
+	if (!pSwapChain) {
+		ERROR("D3D11Backend", "Present", "Swap chain is nullptr.");
+		return E_POINTER;
+	}
+	return pSwapChain->Present(SyncInterval, Flags);
+}
@@ -4,7 +4,7 @@
 
 HRESULT 
 DepthStencilState::init(Device& device, bool enableDepth, bool enableStencil) {
-	if (!device.m_device) {
+	if (!device.m_backend) {
 		ERROR("ShaderProgram", "init", "Device is null.");
 		return E_POINTER;
 	}
@@ -37,6 +37,36 @@ DepthStencilState::init(Device& device, bool enableDepth, bool enableStencil) {
   return S_OK;
 }
 
+HRESULT
+DepthStencilState::initPlanarShadow(Device& device) {
+  if (!device.m_backend) {
+    ERROR("DepthStencilState", "initPlanarShadow", "Device is null.");
+    return E_POINTER;
+  }
+
+  D3D11_DEPTH_STENCIL_DESC desc = {};
+  desc.DepthEnable = TRUE;
+  desc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ZERO;
+  desc.DepthFunc = D3D11_COMPARISON_LESS_EQUAL;
+
+  // El stencil se limpia a 0 cada frame; el primer fragmento lo sube a 1 y
+  // los siguientes en ese pixel fallan la prueba
+  desc.StencilEnable = TRUE;
+  desc.StencilReadMask = D3D11_DEFAULT_STENCIL_READ_MASK;
+  desc.StencilWriteMask = D3D11_DEFAULT_STENCIL_WRITE_MASK;
+  desc.FrontFace.StencilFailOp = D3D11_STENCIL_OP_KEEP;
+  desc.FrontFace.StencilDepthFailOp = D3D11_STENCIL_OP_KEEP;
+  desc.FrontFace.StencilPassOp = D3D11_STENCIL_OP_INCR;
+  desc.FrontFace.StencilFunc = D3D11_COMPARISON_EQUAL;
+  desc.BackFace = desc.FrontFace;
+
+  HRESULT hr = device.CreateDepthStencilState(&desc, &m_depthStencilState);
+  if (FAILED(hr)) {
+    ERROR("DepthStencilState", "initPlanarShadow", "Failed to create DepthStencilState");
+  }
+  return hr;
+}
+
 void 
 DepthStencilState::update() {
 
@@ -46,7 +76,7 @@ void
 DepthStencilState::render(DeviceContext& deviceContext, 
 													unsigned int stencilRef,
                           bool reset) {
-  if (!deviceContext.m_deviceContext) {
+  if (!deviceContext.m_backend) {
     ERROR("RenderTargetView", "render", "DeviceContext is nullptr.");
     return;
   }
@@ -56,10 +86,10 @@ DepthStencilState::render(DeviceContext& deviceContext,
   }
 
   if (!reset) {
-    deviceContext.m_deviceContext->OMSetDepthStencilState(m_depthStencilState, stencilRef);
+    deviceContext.OMSetDepthStencilState(m_depthStencilState, stencilRef);
   }
   else {
-    deviceContext.m_deviceContext->OMSetDepthStencilState(nullptr, stencilRef);
+    deviceContext.OMSetDepthStencilState(nullptr, stencilRef);
   }
 }
 
@@ -5,7 +5,7 @@
 
 HRESULT 
 DepthStencilView::init(Device& device, Texture& depthStencil, DXGI_FORMAT format) {
-	if (!device.m_device) {
+	if (!device.m_backend) {
 		ERROR("DepthStencilView", "init", "Device is null.");
 	}
 	if (!depthStencil.m_texture) {
@@ -21,9 +21,9 @@ DepthStencilView::init(Device& device, Texture& depthStencil, DXGI_FORMAT format
 	descDSV.Texture2D.MipSlice = 0;
 
 	// Create depth stencil view
-	HRESULT hr = device.m_device->CreateDepthStencilView(depthStencil.m_texture, 
-																											 &descDSV, 
-																											 &m_depthStencilView);
+	HRESULT hr = device.CreateDepthStencilView(depthStencil.m_texture, 
+                                             &descDSV,
+                                             &m_depthStencilView);
 
 	if (FAILED(hr)) {
 		ERROR("DepthStencilView", "init", 
@@ -36,16 +36,16 @@ DepthStencilView::init(Device& device, Texture& depthStencil, DXGI_FORMAT format
 
 void 
 DepthStencilView::render(DeviceContext& deviceContext) {
-	if (!deviceContext.m_deviceContext) {
+	if (!deviceContext.m_backend) {
 		ERROR("DepthStencilView", "render", "Device context is null.");
 		return;
 	}
 
 	// Clear depth stencil view
-	deviceContext.m_deviceContext->ClearDepthStencilView(m_depthStencilView, 
-																											 D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 
-																											 1.0f, 
-																											 0);
+	deviceContext.ClearDepthStencilView(m_depthStencilView, 
+                                      D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL,
+                                      1.0f,
+                                      0);
 }
 
 void
@@ -1,8 +1,20 @@
 #include "Device.h"
+#include "RenderBackend.h"
+
+void
+Device::init(RenderBackend* backend) {
+	if (!backend) {
+		ERROR("Device", "init", "backend is nullptr");
+		return;
+	}
+	m_backend = backend;
+	MESSAGE("Device", "init", backend->getName());
+}
 
 void
 Device::destroy() {
 	SAFE_RELEASE(m_device);
+	m_backend = nullptr;
 }
 
 HRESULT
@@ -20,7 +32,7 @@ Device::CreateRenderTargetView(ID3D11Resource* pResource,
 	}
 
 	// Crear el Render Target View
-	HRESULT hr = m_device->CreateRenderTargetView(pResource, pDesc, ppRTView);
+	HRESULT hr = m_backend->CreateRenderTargetView(pResource, pDesc, ppRTView);
 
 	if (SUCCEEDED(hr)) {
 		MESSAGE("Device", "CreateRenderTargetView",
@@ -49,7 +61,7 @@ Device::CreateTexture2D(const D3D11_TEXTURE2D_DESC* pDesc,
 	}
 
 	// Crear la textura 2D
-	HRESULT hr = m_device->CreateTexture2D(pDesc, pInitialData, ppTexture2D);
+	HRESULT hr = m_backend->CreateTexture2D(pDesc, pInitialData, ppTexture2D);
 
 	if (SUCCEEDED(hr)) {
 		MESSAGE("Device", "CreateTexture2D",
@@ -63,6 +75,63 @@ Device::CreateTexture2D(const D3D11_TEXTURE2D_DESC* pDesc,
 	return hr;
 }
 
+HRESULT
+Device::CreateShaderResourceView(ID3D11Resource* pResource,
+																 const D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc,
+																 ID3D11ShaderResourceView** ppSRView) {
+	// Validar parametros de entrada
+	if (!pResource) {
+		ERROR("Device", "CreateShaderResourceView", "pResource is nullptr");
+		return E_INVALIDARG;
+	}
+	if (!ppSRView) {
+		ERROR("Device", "CreateShaderResourceView", "ppSRView is nullptr");
+		return E_POINTER;
+	}
+
+	// Crear el Shader Resource View
+	HRESULT hr = m_backend->CreateShaderResourceView(pResource, pDesc, ppSRView);
+
+	if (SUCCEEDED(hr)) {
+		MESSAGE("Device", "CreateShaderResourceView",
+			"Shader Resource View created successfully!");
+	}
+	else {
+		ERROR("Device", "CreateShaderResourceView",
+			("Failed to create Shader Resource View. HRESULT: " + std::to_string(hr)).c_str());
+	}
+
+	return hr;
+}
+
+HRESULT
+Device::CreateShaderResourceViewFromFile(const std::string& fileName,
+																				 ID3D11ShaderResourceView** ppSRView) {
+	// Validar parametros de entrada
+	if (fileName.empty()) {
+		ERROR("Device", "CreateShaderResourceViewFromFile", "fileName is empty");
+		return E_INVALIDARG;
+	}
+	if (!ppSRView) {
+		ERROR("Device", "CreateShaderResourceViewFromFile", "ppSRView is nullptr");
+		return E_POINTER;
+	}
+
+	// Cargar la textura y crear el Shader Resource View
+	HRESULT hr = m_backend->CreateShaderResourceViewFromFile(fileName, ppSRView);
+
+	if (SUCCEEDED(hr)) {
+		MESSAGE("Device", "CreateShaderResourceViewFromFile",
+			"Shader Resource View created successfully!");
+	}
+	else {
+		ERROR("Device", "CreateShaderResourceViewFromFile",
+			("Failed to load texture " + fileName + ". HRESULT: " + std::to_string(hr)).c_str());
+	}
+
+	return hr;
+}
+
 HRESULT
 Device::CreateDepthStencilView(ID3D11Resource* pResource,
 	const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc,
@@ -78,7 +147,7 @@ Device::CreateDepthStencilView(ID3D11Resource* pResource,
 	}
 
 	// Crear el Depth Stencil View
-	HRESULT hr = m_device->CreateDepthStencilView(pResource, pDesc, ppDepthStencilView);
+	HRESULT hr = m_backend->CreateDepthStencilView(pResource, pDesc, ppDepthStencilView);
 
 	if (SUCCEEDED(hr)) {
 		MESSAGE("Device", "CreateDepthStencilView",
@@ -108,7 +177,7 @@ Device::CreateVertexShader(const void* pShaderBytecode,
 	}
 
 	// Crear el Vertex Shader
-	HRESULT hr = m_device->CreateVertexShader(pShaderBytecode,
+	HRESULT hr = m_backend->CreateVertexShader(pShaderBytecode,
 		BytecodeLength,
 		pClassLinkage,
 		ppVertexShader);
@@ -142,7 +211,7 @@ Device::CreateInputLayout(const D3D11_INPUT_ELEMENT_DESC* pInputElementDescs,
 	}
 
 	// Crear el Input Layout
-	HRESULT hr = m_device->CreateInputLayout(pInputElementDescs,
+	HRESULT hr = m_backend->CreateInputLayout(pInputElementDescs,
 		NumElements,
 		pShaderBytecodeWithInputSignature,
 		BytecodeLength,
@@ -176,7 +245,7 @@ Device::CreatePixelShader(const void* pShaderBytecode,
 	}
 
 	// Crear el Pixel Shader
-	HRESULT hr = m_device->CreatePixelShader(pShaderBytecode,
+	HRESULT hr = m_backend->CreatePixelShader(pShaderBytecode,
 		BytecodeLength,
 		pClassLinkage,
 		ppPixelShader);
@@ -207,7 +276,7 @@ Device::CreateSamplerState(const D3D11_SAMPLER_DESC* pSamplerDesc,
 	}
 
 	// Crear el Sampler State
-	HRESULT hr = m_device->CreateSamplerState(pSamplerDesc, ppSamplerState);
+	HRESULT hr = m_backend->CreateSamplerState(pSamplerDesc, ppSamplerState);
 
 	if (SUCCEEDED(hr)) {
 		MESSAGE("Device", "CreateSamplerState",
@@ -236,7 +305,7 @@ Device::CreateBuffer(const D3D11_BUFFER_DESC* pDesc,
 	}
 
 	// Crear el Buffer
-	HRESULT hr = m_device->CreateBuffer(pDesc, pInitialData, ppBuffer);
+	HRESULT hr = m_backend->CreateBuffer(pDesc, pInitialData, ppBuffer);
 
 	if (SUCCEEDED(hr)) {
 		MESSAGE("Device", "CreateBuffer",
@@ -264,7 +333,7 @@ Device::CreateBlendState(const D3D11_BLEND_DESC* pBlendStateDesc,
 	}
 
 	// Crear el Blend State
-	HRESULT hr = m_device->CreateBlendState(pBlendStateDesc, ppBlendState);
+	HRESULT hr = m_backend->CreateBlendState(pBlendStateDesc, ppBlendState);
 	
 	if (SUCCEEDED(hr)) {
 		MESSAGE("Device", "CreateBlendState",
@@ -291,7 +360,7 @@ Device::CreateDepthStencilState(const D3D11_DEPTH_STENCIL_DESC* pDepthStencilDes
 	}	
 
 	// Crear el Depth Stencil State
-	HRESULT hr = m_device->CreateDepthStencilState(pDepthStencilDesc, ppDepthStencilState);
+	HRESULT hr = m_backend->CreateDepthStencilState(pDepthStencilDesc, ppDepthStencilState);
 
 	if (SUCCEEDED(hr)) {
 		MESSAGE("Device", "CreateDepthStencilState",
@@ -319,7 +388,7 @@ Device::CreateRasterizerState(const D3D11_RASTERIZER_DESC* pRasterizerDesc,
 	}
 
 	// Crear el Rasterizer State
-	HRESULT hr = m_device->CreateRasterizerState(pRasterizerDesc, ppRasterizerState);
+	HRESULT hr = m_backend->CreateRasterizerState(pRasterizerDesc, ppRasterizerState);
 
 	if (SUCCEEDED(hr)) {
 		MESSAGE("Device", "CreateRasterizerState",
@@ -1,24 +1,493 @@
 #include "DeviceContext.h"
+#include "RenderBackend.h"
 
-void 
-DeviceContext::RSSetViewports(unsigned int NumViewports, 
+namespace {
+	// Busca el rango [first, last] de slots que difieren de la cache.
+	// Devuelve false si todos coinciden (bind redundante).
+	template<typename T> bool
+	findChangedRange(T* const* cached,
+									 T* const* incoming,
+									 unsigned int count,
+									 unsigned int& first,
+									 unsigned int& last) {
+		bool changed = false;
+		for (unsigned int i = 0; i < count; ++i) {
+			T* value = incoming ? incoming[i] : nullptr;
+			if (cached[i] != value) {
+				if (!changed) {
+					first = i;
+					changed = true;
+				}
+				last = i;
+			}
+		}
+		return changed;
+	}
+
+	template<typename T> void
+	storeRange(T** cached, T* const* incoming, unsigned int count) {
+		for (unsigned int i = 0; i < count; ++i) {
+			cached[i] = incoming ? incoming[i] : nullptr;
+		}
+	}
+}
+
+void
+DeviceContext::init(RenderBackend* backend) {
+	if (!backend) {
+		ERROR("DeviceContext", "init", "backend is nullptr");
+		return;
+	}
+	m_backend = backend;
+	resetStateCache();
+	resetBindStats();
+	MESSAGE("DeviceContext", "init", backend->getName());
+}
+
+void
+DeviceContext::setStateCacheEnabled(bool enabled) {
+	m_stateCacheEnabled = enabled;
+	invalidateStateCache();
+}
+
+void
+DeviceContext::invalidateStateCache() {
+	// Punteros invalidos y floats NaN: ningun bind real coincide con este estado
+	memset(&m_state, 0xff, sizeof(m_state));
+}
+
+void
+DeviceContext::resetStateCache() {
+	memset(&m_state, 0, sizeof(m_state));
+	m_state.topology = D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
+	m_state.indexFormat = DXGI_FORMAT_UNKNOWN;
+	for (unsigned int i = 0; i < 4; ++i) {
+		m_state.blendFactor[i] = 1.0f;
+	}
+	m_state.sampleMask = 0xffffffff;
+}
+
+bool
+DeviceContext::countBind(bool redundant) {
+	if (redundant && m_stateCacheEnabled) {
+		m_bindStats.skipped++;
+		return false;
+	}
+	m_bindStats.issued++;
+	return true;
+}
+
+void
+DeviceContext::destroy() {
+	SAFE_RELEASE(m_deviceContext);
+	m_backend = nullptr;
+}
+
+void
+DeviceContext::RSSetViewports(unsigned int NumViewports,
 															const D3D11_VIEWPORT* pViewports) {
-	if (NumViewports < 0 && pViewports != nullptr) {
+	if (NumViewports > 0 && pViewports == nullptr) {
 		ERROR("DeviceContext", "RSSetViewports", "pViewports is nullptr");
+		return;
+	}
+	bool redundant = NumViewports == 1 &&
+									 m_state.numViewports == 1 &&
+									 memcmp(&m_state.viewport, pViewports, sizeof(D3D11_VIEWPORT)) == 0;
+	if (!countBind(redundant)) {
+		return;
+	}
+	m_state.numViewports = NumViewports;
+	if (NumViewports > 0) {
+		m_state.viewport = pViewports[0];
 	}
 	// Set the Viewport
-	m_deviceContext->RSSetViewports(NumViewports, pViewports);
+	m_backend->RSSetViewports(NumViewports, pViewports);
+}
+
+void
+DeviceContext::RSSetState(ID3D11RasterizerState* pRasterizerState) {
+	if (!countBind(m_state.rasterizerState == pRasterizerState)) {
+		return;
+	}
+	m_state.rasterizerState = pRasterizerState;
+	m_backend->RSSetState(pRasterizerState);
 }
 
-void 
-DeviceContext::ClearDepthStencilView(ID3D11DepthStencilView* pDepthStencilView, 
-																		 unsigned int ClearFlags, 
-																		 float Depth, 
+void
+DeviceContext::ClearDepthStencilView(ID3D11DepthStencilView* pDepthStencilView,
+																		 unsigned int ClearFlags,
+																		 float Depth,
 																		 UINT8 Stencil) {
+	if (!pDepthStencilView) {
+		ERROR("DeviceContext", "ClearDepthStencilView", "pDepthStencilView is nullptr");
+		return;
+	}
+	m_backend->ClearDepthStencilView(pDepthStencilView, ClearFlags, Depth, Stencil);
 }
 
-void 
-DeviceContext::ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView, 
+void
+DeviceContext::ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView,
 																		 const float ColorRGBA[4]) {
+	if (!pRenderTargetView) {
+		ERROR("DeviceContext", "ClearRenderTargetView", "pRenderTargetView is nullptr");
+		return;
+	}
+	m_backend->ClearRenderTargetView(pRenderTargetView, ColorRGBA);
+}
+
+void
+DeviceContext::OMSetRenderTargets(unsigned int NumViews,
+																	ID3D11RenderTargetView* const* ppRenderTargetViews,
+																	ID3D11DepthStencilView* pDepthStencilView) {
+	bool redundant = NumViews <= CACHED_RENDER_TARGET_SLOTS &&
+									 m_state.numRenderTargets == NumViews &&
+									 m_state.depthStencilView == pDepthStencilView;
+	unsigned int first = 0;
+	unsigned int last = 0;
+	if (redundant) {
+		redundant = !findChangedRange(m_state.renderTargets, ppRenderTargetViews, NumViews, first, last);
+	}
+	if (!countBind(redundant)) {
+		return;
+	}
+	if (NumViews <= CACHED_RENDER_TARGET_SLOTS) {
+		// OMSetRenderTargets desenlaza los slots que no se pasan
+		memset(m_state.renderTargets, 0, sizeof(m_state.renderTargets));
+		storeRange(m_state.renderTargets, ppRenderTargetViews, NumViews);
+		m_state.numRenderTargets = NumViews;
+		m_state.depthStencilView = pDepthStencilView;
+	}
+	m_backend->OMSetRenderTargets(NumViews, ppRenderTargetViews, pDepthStencilView);
+}
+
+void
+DeviceContext::OMSetBlendState(ID3D11BlendState* pBlendState,
+															 const float BlendFactor[4],
+															 unsigned int SampleMask) {
+	// Un BlendFactor nulo equivale a {1, 1, 1, 1}
+	const float defaultFactor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	const float* factor = BlendFactor ? BlendFactor : defaultFactor;
+
+	bool redundant = m_state.blendState == pBlendState &&
+									 m_state.sampleMask == SampleMask &&
+									 m_state.blendFactor[0] == factor[0] &&
+									 m_state.blendFactor[1] == factor[1] &&
+									 m_state.blendFactor[2] == factor[2] &&
+									 m_state.blendFactor[3] == factor[3];
+	if (!countBind(redundant)) {
+		return;
+	}
+	m_state.blendState = pBlendState;
+	m_state.sampleMask = SampleMask;
+	memcpy(m_state.blendFactor, factor, sizeof(m_state.blendFactor));
+	m_backend->OMSetBlendState(pBlendState, BlendFactor, SampleMask);
+}
+
+void
+DeviceContext::OMSetDepthStencilState(ID3D11DepthStencilState* pDepthStencilState,
+																			unsigned int StencilRef) {
+	bool redundant = m_state.depthStencilState == pDepthStencilState &&
+									 m_state.stencilRef == StencilRef;
+	if (!countBind(redundant)) {
+		return;
+	}
+	m_state.depthStencilState = pDepthStencilState;
+	m_state.stencilRef = StencilRef;
+	m_backend->OMSetDepthStencilState(pDepthStencilState, StencilRef);
+}
+
+void
+DeviceContext::IASetInputLayout(ID3D11InputLayout* pInputLayout) {
+	if (!countBind(m_state.inputLayout == pInputLayout)) {
+		return;
+	}
+	m_state.inputLayout = pInputLayout;
+	m_backend->IASetInputLayout(pInputLayout);
+}
+
+void
+DeviceContext::IASetVertexBuffers(unsigned int StartSlot,
+																	unsigned int NumBuffers,
+																	ID3D11Buffer* const* ppVertexBuffers,
+																	const unsigned int* pStrides,
+																	const unsigned int* pOffsets) {
+	if (NumBuffers == 0) {
+		return;
+	}
+	if (StartSlot + NumBuffers > CACHED_VERTEX_BUFFER_SLOTS || !pStrides || !pOffsets) {
+		// Fuera de la cache: enviar y olvidar lo que habia en esos slots
+		countBind(false);
+		for (unsigned int i = StartSlot; i < CACHED_VERTEX_BUFFER_SLOTS && i < StartSlot + NumBuffers; ++i) {
+			m_state.vertexBuffers[i] = nullptr;
+			m_state.vertexStrides[i] = 0xffffffff;
+		}
+		m_backend->IASetVertexBuffers(StartSlot, NumBuffers, ppVertexBuffers, pStrides, pOffsets);
+		return;
+	}
+
+	unsigned int first = 0;
+	unsigned int last = 0;
+	bool changed = false;
+	for (unsigned int i = 0; i < NumBuffers; ++i) {
+		unsigned int slot = StartSlot + i;
+		ID3D11Buffer* buffer = ppVertexBuffers ? ppVertexBuffers[i] : nullptr;
+		if (m_state.vertexBuffers[slot] != buffer ||
+				m_state.vertexStrides[slot] != pStrides[i] ||
+				m_state.vertexOffsets[slot] != pOffsets[i]) {
+			if (!changed) {
+				first = i;
+				changed = true;
+			}
+			last = i;
+		}
+	}
+	if (!countBind(!changed)) {
+		return;
+	}
+	if (!m_stateCacheEnabled) {
+		first = 0;
+		last = NumBuffers - 1;
+	}
+
+	for (unsigned int i = first; i <= last; ++i) {
+		unsigned int slot = StartSlot + i;
+		m_state.vertexBuffers[slot] = ppVertexBuffers ? ppVertexBuffers[i] : nullptr;
+		m_state.vertexStrides[slot] = pStrides[i];
+		m_state.vertexOffsets[slot] = pOffsets[i];
+	}
+	// Solo se envia el sub-rango que cambia
+	m_backend->IASetVertexBuffers(StartSlot + first,
+																last - first + 1,
+																ppVertexBuffers ? ppVertexBuffers + first : nullptr,
+																pStrides + first,
+																pOffsets + first);
+}
+
+void
+DeviceContext::IASetIndexBuffer(ID3D11Buffer* pIndexBuffer,
+																DXGI_FORMAT Format,
+																unsigned int Offset) {
+	bool redundant = m_state.indexBuffer == pIndexBuffer &&
+									 m_state.indexFormat == Format &&
+									 m_state.indexOffset == Offset;
+	if (!countBind(redundant)) {
+		return;
+	}
+	m_state.indexBuffer = pIndexBuffer;
+	m_state.indexFormat = Format;
+	m_state.indexOffset = Offset;
+	m_backend->IASetIndexBuffer(pIndexBuffer, Format, Offset);
+}
+
+void
+DeviceContext::IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology) {
+	if (!countBind(m_state.topology == Topology)) {
+		return;
+	}
+	m_state.topology = Topology;
+	m_backend->IASetPrimitiveTopology(Topology);
+}
+
+void
+DeviceContext::VSSetShader(ID3D11VertexShader* pVertexShader,
+													 ID3D11ClassInstance* const* ppClassInstances,
+													 unsigned int NumClassInstances) {
+	// Con class instances no se puede comparar el estado; se envia siempre
+	bool redundant = NumClassInstances == 0 && m_state.vertexShader == pVertexShader;
+	if (!countBind(redundant)) {
+		return;
+	}
+	m_state.vertexShader = pVertexShader;
+	m_backend->VSSetShader(pVertexShader, ppClassInstances, NumClassInstances);
+}
+
+void
+DeviceContext::PSSetShader(ID3D11PixelShader* pPixelShader,
+													 ID3D11ClassInstance* const* ppClassInstances,
+													 unsigned int NumClassInstances) {
+	bool redundant = NumClassInstances == 0 && m_state.pixelShader == pPixelShader;
+	if (!countBind(redundant)) {
+		return;
+	}
+	m_state.pixelShader = pPixelShader;
+	m_backend->PSSetShader(pPixelShader, ppClassInstances, NumClassInstances);
+}
+
+void
+DeviceContext::VSSetConstantBuffers(unsigned int StartSlot,
+																		unsigned int NumBuffers,
+																		ID3D11Buffer* const* ppConstantBuffers) {
+	unsigned int first = 0;
+	unsigned int last = NumBuffers - 1;
+	if (StartSlot + NumBuffers <= CACHED_CONSTANT_BUFFER_SLOTS) {
+		bool changed = findChangedRange(m_state.vsConstantBuffers + StartSlot,
+																		ppConstantBuffers,
+																		NumBuffers,
+																		first,
+																		last);
+		if (!countBind(!changed)) {
+			return;
+		}
+		if (!m_stateCacheEnabled) {
+			first = 0;
+			last = NumBuffers - 1;
+		}
+		storeRange(m_state.vsConstantBuffers + StartSlot + first,
+							 ppConstantBuffers ? ppConstantBuffers + first : nullptr,
+							 last - first + 1);
+	}
+	else {
+		countBind(false);
+	}
+	m_backend->VSSetConstantBuffers(StartSlot + first,
+																	last - first + 1,
+																	ppConstantBuffers ? ppConstantBuffers + first : nullptr);
+}
+
+void
+DeviceContext::PSSetConstantBuffers(unsigned int StartSlot,
+																		unsigned int NumBuffers,
+																		ID3D11Buffer* const* ppConstantBuffers) {
+	unsigned int first = 0;
+	unsigned int last = NumBuffers - 1;
+	if (StartSlot + NumBuffers <= CACHED_CONSTANT_BUFFER_SLOTS) {
+		bool changed = findChangedRange(m_state.psConstantBuffers + StartSlot,
+																		ppConstantBuffers,
+																		NumBuffers,
+																		first,
+																		last);
+		if (!countBind(!changed)) {
+			return;
+		}
+		if (!m_stateCacheEnabled) {
+			first = 0;
+			last = NumBuffers - 1;
+		}
+		storeRange(m_state.psConstantBuffers + StartSlot + first,
+							 ppConstantBuffers ? ppConstantBuffers + first : nullptr,
+							 last - first + 1);
+	}
+	else {
+		countBind(false);
+	}
+	m_backend->PSSetConstantBuffers(StartSlot + first,
+																	last - first + 1,
+																	ppConstantBuffers ? ppConstantBuffers + first : nullptr);
+}
+
+void
+DeviceContext::PSSetShaderResources(unsigned int StartSlot,
+																		unsigned int NumViews,
+																		ID3D11ShaderResourceView* const* ppShaderResourceViews) {
+	unsigned int first = 0;
+	unsigned int last = NumViews - 1;
+	if (StartSlot + NumViews <= CACHED_SHADER_RESOURCE_SLOTS) {
+		bool changed = findChangedRange(m_state.psShaderResources + StartSlot,
+																		ppShaderResourceViews,
+																		NumViews,
+																		first,
+																		last);
+		if (!countBind(!changed)) {
+			return;
+		}
+		if (!m_stateCacheEnabled) {
+			first = 0;
+			last = NumViews - 1;
+		}
+		storeRange(m_state.psShaderResources + StartSlot + first,
+							 ppShaderResourceViews ? ppShaderResourceViews + first : nullptr,
+							 last - first + 1);
+	}
+	else {
+		countBind(false);
+	}
+	m_backend->PSSetShaderResources(StartSlot + first,
+																	last - first + 1,
+																	ppShaderResourceViews ? ppShaderResourceViews + first : nullptr);
+}
+
+void
+DeviceContext::PSSetSamplers(unsigned int StartSlot,
+														 unsigned int NumSamplers,
+														 ID3D11SamplerState* const* ppSamplers) {
+	unsigned int first = 0;
+	unsigned int last = NumSamplers - 1;
+	if (StartSlot + NumSamplers <= CACHED_SAMPLER_SLOTS) {
+		bool changed = findChangedRange(m_state.psSamplers + StartSlot,
+																		ppSamplers,
+																		NumSamplers,
+																		first,
+																		last);
+		if (!countBind(!changed)) {
+			return;
+		}
+		if (!m_stateCacheEnabled) {
+			first = 0;
+			last = NumSamplers - 1;
+		}
+		storeRange(m_state.psSamplers + StartSlot + first,
+							 ppSamplers ? ppSamplers + first : nullptr,
+							 last - first + 1);
+	}
+	else {
+		countBind(false);
+	}
+	m_backend->PSSetSamplers(StartSlot + first,
+													 last - first + 1,
+													 ppSamplers ? ppSamplers + first : nullptr);
+}
+
+void
+DeviceContext::UpdateSubresource(ID3D11Resource* pDstResource,
+																 unsigned int DstSubresource,
+																 const D3D11_BOX* pDstBox,
+																 const void* pSrcData,
+																 unsigned int SrcRowPitch,
+																 unsigned int SrcDepthPitch) {
+	m_backend->UpdateSubresource(pDstResource,
+															 DstSubresource,
+															 pDstBox,
+															 pSrcData,
+															 SrcRowPitch,
+															 SrcDepthPitch);
+}
+
+HRESULT
+DeviceContext::Map(ID3D11Resource* pResource,
+									 unsigned int Subresource,
+									 D3D11_MAP MapType,
+									 unsigned int MapFlags,
+									 D3D11_MAPPED_SUBRESOURCE* pMappedResource) {
+	return m_backend->Map(pResource, Subresource, MapType, MapFlags, pMappedResource);
+}
+
+void
+DeviceContext::Unmap(ID3D11Resource* pResource, unsigned int Subresource) {
+	m_backend->Unmap(pResource, Subresource);
+}
+
+void
+DeviceContext::DrawIndexed(unsigned int IndexCount,
+													 unsigned int StartIndexLocation,
+													 int BaseVertexLocation) {
+	m_backend->DrawIndexed(IndexCount, StartIndexLocation, BaseVertexLocation);
+}
+
+void
+DeviceContext::DrawIndexedInstanced(unsigned int IndexCountPerInstance,
+																		unsigned int InstanceCount,
+																		unsigned int StartIndexLocation,
+																		int BaseVertexLocation,
+																		unsigned int StartInstanceLocation) {
+	m_backend->DrawIndexedInstanced(IndexCountPerInstance,
+																	InstanceCount,
+																	StartIndexLocation,
+																	BaseVertexLocation,
+																	StartInstanceLocation);
+}
 
+void
+DeviceContext::ClearState() {
+	m_backend->ClearState();
+	resetStateCache();
 }
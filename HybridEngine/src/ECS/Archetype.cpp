@@ -0,0 +1,110 @@
+#include "ECS/Archetype.h"
+#include <new>
+
+namespace {
+	const unsigned int CHUNK_ALIGNMENT = 64;
+
+	unsigned int
+	alignUp(unsigned int value, unsigned int alignment) {
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+void
+Archetype::init(ComponentMask mask) {
+	m_mask = mask;
+	m_types.clear();
+	for (unsigned int i = 0; i < MAX_COMPONENT_TYPES; ++i) {
+		m_offsets[i] = INVALID_OFFSET;
+		if (mask & (1ull << i)) {
+			m_types.push_back(i);
+		}
+	}
+
+	// Capacidad: lo que cabe en el chunk dejando margen para alinear cada arreglo
+	unsigned int bytesPerEntity = sizeof(Entity);
+	unsigned int padding = 0;
+	for (size_t t = 0; t < m_types.size(); ++t) {
+		const ComponentInfo& info = ComponentRegistry::getInfo(m_types[t]);
+		bytesPerEntity += info.size;
+		padding += info.alignment;
+	}
+	m_capacity = (CHUNK_SIZE - padding) / bytesPerEntity;
+
+	unsigned int offset = m_capacity * sizeof(Entity);
+	for (size_t t = 0; t < m_types.size(); ++t) {
+		const ComponentInfo& info = ComponentRegistry::getInfo(m_types[t]);
+		offset = alignUp(offset, info.alignment);
+		m_offsets[m_types[t]] = offset;
+		offset += m_capacity * info.size;
+	}
+}
+
+void
+Archetype::destroy() {
+	for (size_t i = 0; i < m_chunks.size(); ++i) {
+		::operator delete(m_chunks[i].data, std::align_val_t(CHUNK_ALIGNMENT));
+	}
+	m_chunks.clear();
+}
+
+void
+Archetype::allocate(Entity entity, unsigned int& chunk, unsigned int& row) {
+	if (m_chunks.empty() || m_chunks.back().count == m_capacity) {
+		ArchetypeChunk newChunk;
+		newChunk.data = static_cast<unsigned char*>(::operator new(CHUNK_SIZE, std::align_val_t(CHUNK_ALIGNMENT)));
+		newChunk.count = 0;
+		m_chunks.push_back(newChunk);
+	}
+	chunk = static_cast<unsigned int>(m_chunks.size() - 1);
+	ArchetypeChunk& target = m_chunks.back();
+	row = target.count++;
+
+	getEntities(target)[row] = entity;
+	for (size_t t = 0; t < m_types.size(); ++t) {
+		const ComponentInfo& info = ComponentRegistry::getInfo(m_types[t]);
+		memset(target.data + m_offsets[m_types[t]] + row * info.size, 0, info.size);
+	}
+}
+
+Entity
+Archetype::removeRow(unsigned int chunk, unsigned int row) {
+	ArchetypeChunk& last = m_chunks.back();
+	unsigned int lastRow = last.count - 1;
+	Entity moved = NULL_ENTITY;
+
+	ArchetypeChunk& target = m_chunks[chunk];
+	if (&target != &last || row != lastRow) {
+		// Rellenar el hueco con la ultima fila para que los chunks sigan densos
+		moved = getEntities(last)[lastRow];
+		getEntities(target)[row] = moved;
+		for (size_t t = 0; t < m_types.size(); ++t) {
+			unsigned int size = ComponentRegistry::getInfo(m_types[t]).size;
+			unsigned int offset = m_offsets[m_types[t]];
+			memcpy(target.data + offset + row * size, last.data + offset + lastRow * size, size);
+		}
+	}
+
+	last.count--;
+	if (last.count == 0) {
+		::operator delete(last.data, std::align_val_t(CHUNK_ALIGNMENT));
+		m_chunks.pop_back();
+	}
+	return moved;
+}
+
+void*
+Archetype::getComponent(unsigned int chunk, unsigned int row, unsigned int typeId) const {
+	if (m_offsets[typeId] == INVALID_OFFSET) {
+		return nullptr;
+	}
+	return m_chunks[chunk].data + m_offsets[typeId] + row * ComponentRegistry::getInfo(typeId).size;
+}
+
+unsigned int
+Archetype::getEntityCount() const {
+	if (m_chunks.empty()) {
+		return 0;
+	}
+	return static_cast<unsigned int>(m_chunks.size() - 1) * m_capacity + m_chunks.back().count;
+}
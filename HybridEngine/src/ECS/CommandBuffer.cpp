@@ -0,0 +1,77 @@
+#include "ECS/CommandBuffer.h"
+
+Entity
+EntityCommandBuffer::create() {
+	Entity pending = { PENDING_BIT | m_pendingCount++, 0 };
+	Command command = { COMMAND_CREATE, pending, 0, 0, 0 };
+	m_commands.push_back(command);
+	return pending;
+}
+
+void
+EntityCommandBuffer::destroyEntity(Entity entity) {
+	Command command = { COMMAND_DESTROY, entity, 0, 0, 0 };
+	m_commands.push_back(command);
+}
+
+void
+EntityCommandBuffer::addComponent(Entity entity, unsigned int typeId, const void* data, unsigned int size) {
+	// Los datos se copian alineados a 16 para poder leerlos como T en el playback
+	unsigned int offset = static_cast<unsigned int>((m_data.size() + 15) & ~size_t(15));
+	m_data.resize(offset + size);
+	memcpy(&m_data[offset], data, size);
+
+	Command command = { COMMAND_ADD, entity, typeId, offset, size };
+	m_commands.push_back(command);
+}
+
+void
+EntityCommandBuffer::removeComponent(Entity entity, unsigned int typeId) {
+	Command command = { COMMAND_REMOVE, entity, typeId, 0, 0 };
+	m_commands.push_back(command);
+}
+
+void
+EntityCommandBuffer::playback(EntityWorld& world) {
+	std::vector<Entity> created;
+	created.reserve(m_pendingCount);
+
+	for (size_t i = 0; i < m_commands.size(); ++i) {
+		const Command& command = m_commands[i];
+		switch (command.type) {
+		case COMMAND_CREATE:
+			created.push_back(world.create());
+			break;
+		case COMMAND_DESTROY:
+			world.destroyEntity(resolve(command.entity, created));
+			break;
+		case COMMAND_ADD:
+			world.addComponent(resolve(command.entity, created), command.typeId, &m_data[command.dataOffset]);
+			break;
+		case COMMAND_REMOVE:
+			world.removeComponent(resolve(command.entity, created), command.typeId);
+			break;
+		}
+	}
+	clear();
+}
+
+void
+EntityCommandBuffer::clear() {
+	m_commands.clear();
+	m_data.clear();
+	m_pendingCount = 0;
+}
+
+Entity
+EntityCommandBuffer::resolve(Entity entity, const std::vector<Entity>& created) const {
+	if ((entity.index & PENDING_BIT) == 0 || entity == NULL_ENTITY) {
+		return entity;
+	}
+	unsigned int pending = entity.index & ~PENDING_BIT;
+	if (pending >= created.size()) {
+		ERROR("EntityCommandBuffer", "playback", "Pending entity used before its create command");
+		return NULL_ENTITY;
+	}
+	return created[pending];
+}
@@ -0,0 +1,31 @@
+#include "ECS/Component.h"
+
+namespace {
+	std::mutex g_registryLock;
+	ComponentInfo g_componentInfos[MAX_COMPONENT_TYPES];
+	unsigned int g_componentTypeCount = 0;
+}
+
+unsigned int
+ComponentRegistry::registerType(unsigned int size, unsigned int alignment, const char* name) {
+	std::lock_guard<std::mutex> guard(g_registryLock);
+	if (g_componentTypeCount >= MAX_COMPONENT_TYPES) {
+		ERROR("ComponentRegistry", "registerType", "Too many component types");
+		return MAX_COMPONENT_TYPES - 1;
+	}
+	ComponentInfo& info = g_componentInfos[g_componentTypeCount];
+	info.size = size;
+	info.alignment = alignment;
+	info.name = name;
+	return g_componentTypeCount++;
+}
+
+const ComponentInfo&
+ComponentRegistry::getInfo(unsigned int typeId) {
+	return g_componentInfos[typeId];
+}
+
+unsigned int
+ComponentRegistry::getTypeCount() {
+	return g_componentTypeCount;
+}
@@ -0,0 +1,177 @@
+#include "ECS/World.h"
+
+EntityWorld::EntityWorld() {
+	m_emptyArchetype = getOrCreateArchetype(0);
+}
+
+EntityWorld::~EntityWorld() {
+	destroy();
+}
+
+Entity
+EntityWorld::create() {
+	unsigned int index;
+	if (!m_freeIndices.empty()) {
+		index = m_freeIndices.back();
+		m_freeIndices.pop_back();
+	}
+	else {
+		index = static_cast<unsigned int>(m_records.size());
+		EntityRecord record = { nullptr, 0, 0, 0 };
+		m_records.push_back(record);
+	}
+
+	EntityRecord& record = m_records[index];
+	Entity entity = { index, record.generation };
+	record.archetype = m_emptyArchetype;
+	m_emptyArchetype->allocate(entity, record.chunk, record.row);
+	m_aliveCount++;
+	return entity;
+}
+
+void
+EntityWorld::destroyEntity(Entity entity) {
+	if (!isAlive(entity)) {
+		return;
+	}
+	EntityRecord& record = m_records[entity.index];
+	unsigned int chunk = record.chunk;
+	unsigned int row = record.row;
+	Entity moved = record.archetype->removeRow(chunk, row);
+	fixMovedRecord(moved, chunk, row);
+
+	// La nueva generacion invalida los handles viejos
+	record.archetype = nullptr;
+	record.generation++;
+	m_freeIndices.push_back(entity.index);
+	m_aliveCount--;
+}
+
+bool
+EntityWorld::isAlive(Entity entity) const {
+	return entity.index < m_records.size() &&
+				 m_records[entity.index].generation == entity.generation &&
+				 m_records[entity.index].archetype != nullptr;
+}
+
+void*
+EntityWorld::addComponent(Entity entity, unsigned int typeId, const void* data) {
+	if (!isAlive(entity)) {
+		ERROR("EntityWorld", "addComponent", "Entity is not alive");
+		return nullptr;
+	}
+	EntityRecord& record = m_records[entity.index];
+	if (!record.archetype->hasComponent(typeId)) {
+		moveEntity(entity, getOrCreateArchetype(record.archetype->getMask() | (1ull << typeId)));
+	}
+	void* component = record.archetype->getComponent(record.chunk, record.row, typeId);
+	if (data) {
+		memcpy(component, data, ComponentRegistry::getInfo(typeId).size);
+	}
+	return component;
+}
+
+void
+EntityWorld::removeComponent(Entity entity, unsigned int typeId) {
+	if (!isAlive(entity)) {
+		return;
+	}
+	EntityRecord& record = m_records[entity.index];
+	if (record.archetype->hasComponent(typeId)) {
+		moveEntity(entity, getOrCreateArchetype(record.archetype->getMask() & ~(1ull << typeId)));
+	}
+}
+
+void*
+EntityWorld::getComponent(Entity entity, unsigned int typeId) const {
+	if (!isAlive(entity)) {
+		return nullptr;
+	}
+	const EntityRecord& record = m_records[entity.index];
+	return record.archetype->getComponent(record.chunk, record.row, typeId);
+}
+
+void
+EntityWorld::destroy() {
+	for (auto it = m_archetypes.begin(); it != m_archetypes.end(); ++it) {
+		delete it->second;
+	}
+	m_archetypes.clear();
+	m_queryCache.clear();
+	m_records.clear();
+	m_freeIndices.clear();
+	m_aliveCount = 0;
+	m_emptyArchetype = nullptr;
+}
+
+Archetype*
+EntityWorld::getOrCreateArchetype(ComponentMask mask) {
+	auto found = m_archetypes.find(mask);
+	if (found != m_archetypes.end()) {
+		return found->second;
+	}
+
+	Archetype* archetype = new Archetype();
+	archetype->init(mask);
+	m_archetypes[mask] = archetype;
+
+	// Agregar el archetype nuevo a las queries ya cacheadas que lo incluyen
+	std::lock_guard<std::mutex> guard(m_queryLock);
+	for (auto it = m_queryCache.begin(); it != m_queryCache.end(); ++it) {
+		if ((mask & it->first) == it->first) {
+			it->second.push_back(archetype);
+		}
+	}
+	return archetype;
+}
+
+void
+EntityWorld::moveEntity(Entity entity, Archetype* target) {
+	EntityRecord& record = m_records[entity.index];
+	Archetype* source = record.archetype;
+	unsigned int chunk = record.chunk;
+	unsigned int row = record.row;
+
+	unsigned int newChunk, newRow;
+	target->allocate(entity, newChunk, newRow);
+
+	const std::vector<unsigned int>& types = source->getTypes();
+	for (size_t t = 0; t < types.size(); ++t) {
+		if (target->hasComponent(types[t])) {
+			memcpy(target->getComponent(newChunk, newRow, types[t]),
+						 source->getComponent(chunk, row, types[t]),
+						 ComponentRegistry::getInfo(types[t]).size);
+		}
+	}
+
+	Entity moved = source->removeRow(chunk, row);
+	fixMovedRecord(moved, chunk, row);
+
+	record.archetype = target;
+	record.chunk = newChunk;
+	record.row = newRow;
+}
+
+const std::vector<Archetype*>&
+EntityWorld::query(ComponentMask mask) {
+	std::lock_guard<std::mutex> guard(m_queryLock);
+	auto found = m_queryCache.find(mask);
+	if (found != m_queryCache.end()) {
+		return found->second;
+	}
+	std::vector<Archetype*>& matches = m_queryCache[mask];
+	for (auto it = m_archetypes.begin(); it != m_archetypes.end(); ++it) {
+		if ((it->first & mask) == mask) {
+			matches.push_back(it->second);
+		}
+	}
+	return matches;
+}
+
+void
+EntityWorld::fixMovedRecord(Entity moved, unsigned int chunk, unsigned int row) {
+	if (moved != NULL_ENTITY) {
+		m_records[moved.index].chunk = chunk;
+		m_records[moved.index].row = row;
+	}
+}
@@ -0,0 +1,195 @@
+#include "FileWatcher.h"
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+#if !defined(_WIN32)
+#include <sys/stat.h>
+#endif
+
+namespace {
+	typedef std::chrono::steady_clock Clock;
+
+	double
+	elapsedMs(Clock::time_point start) {
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	bool
+	sameStamp(const FileStamp& a, const FileStamp& b) {
+		return a.exists == b.exists && a.modified == b.modified && a.size == b.size;
+	}
+}
+
+bool
+FileWatcher::readStamp(const std::string& path, FileStamp& stamp) {
+	stamp = FileStamp();
+#if defined(_WIN32)
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (!GetFileAttributesExA(path.c_str(), GetFileExInfoStandard, &data)) {
+		return false;
+	}
+	stamp.modified = (static_cast<unsigned long long>(data.ftLastWriteTime.dwHighDateTime) << 32) |
+									 data.ftLastWriteTime.dwLowDateTime;
+	stamp.size = (static_cast<unsigned long long>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+#else
+	struct stat info;
+	if (stat(path.c_str(), &info) != 0) {
+		return false;
+	}
+	stamp.modified = static_cast<unsigned long long>(info.st_mtim.tv_sec) * 1000000000ull + info.st_mtim.tv_nsec;
+	stamp.size = static_cast<unsigned long long>(info.st_size);
+#endif
+	stamp.exists = true;
+	return true;
+}
+
+HRESULT
+FileWatcher::init(bool native, double pollIntervalMs, double settleMs) {
+	destroy();
+	m_pollIntervalMs = pollIntervalMs;
+	m_settleMs = settleMs;
+	m_lastScan = Clock::now();
+#if defined(__linux__)
+	if (native) {
+		m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (m_inotify < 0) {
+			ERROR("FileWatcher", "init", "inotify is not available, polling instead");
+		}
+	}
+#endif
+	return S_OK;
+}
+
+void
+FileWatcher::destroy() {
+#if defined(__linux__)
+	if (m_inotify >= 0) {
+		close(m_inotify);
+	}
+#endif
+	m_inotify = -1;
+	m_entries.clear();
+	m_watchDescriptors.clear();
+	m_directories.clear();
+}
+
+FileWatchId
+FileWatcher::watch(const std::string& path) {
+	if (path.empty()) {
+		ERROR("FileWatcher", "watch", "Path is empty.");
+		return INVALID_FILE_WATCH;
+	}
+	FileWatchEntry entry;
+	entry.path = path;
+	size_t slash = path.find_last_of("/\\");
+	entry.directory = slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+	entry.name = slash == std::string::npos ? path : path.substr(slash + 1);
+	readStamp(path, entry.stamp);
+
+#if defined(__linux__)
+	// Un watch por directorio; los eventos traen solo el nombre del archivo
+	bool known = false;
+	for (size_t i = 0; i < m_directories.size() && !known; ++i) {
+		known = m_directories[i] == entry.directory;
+	}
+	if (m_inotify >= 0 && !known) {
+		const std::string directory = entry.directory.empty() ? std::string(".") : entry.directory;
+		int descriptor = inotify_add_watch(m_inotify, directory.c_str(),
+																			 IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE);
+		if (descriptor < 0) {
+			// Sin el directorio no hay eventos: todo pasa a sondeo
+			ERROR("FileWatcher", "watch", ("inotify failed for " + directory + ", polling instead").c_str());
+			close(m_inotify);
+			m_inotify = -1;
+		}
+		else {
+			m_watchDescriptors.push_back(descriptor);
+			m_directories.push_back(entry.directory);
+		}
+	}
+#endif
+	m_entries.push_back(entry);
+	return static_cast<FileWatchId>(m_entries.size() - 1);
+}
+
+void
+FileWatcher::readNativeEvents() {
+#if defined(__linux__)
+	alignas(inotify_event) char buffer[4096];
+	for (;;) {
+		ssize_t length = read(m_inotify, buffer, sizeof(buffer));
+		if (length <= 0) {
+			// EAGAIN: no hay mas eventos
+			return;
+		}
+		for (ssize_t offset = 0; offset < length;) {
+			const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+			offset += sizeof(inotify_event) + event->len;
+			if (event->len == 0) {
+				continue;
+			}
+			const std::string* directory = nullptr;
+			for (size_t i = 0; i < m_watchDescriptors.size() && !directory; ++i) {
+				directory = m_watchDescriptors[i] == event->wd ? &m_directories[i] : nullptr;
+			}
+			for (size_t i = 0; directory && i < m_entries.size(); ++i) {
+				FileWatchEntry& entry = m_entries[i];
+				if (entry.directory == *directory && entry.name == event->name) {
+					entry.pending = true;
+					entry.changedAt = Clock::now();
+				}
+			}
+		}
+	}
+#endif
+}
+
+void
+FileWatcher::scanStamps() {
+	if (elapsedMs(m_lastScan) < m_pollIntervalMs) {
+		return;
+	}
+	m_lastScan = Clock::now();
+	for (size_t i = 0; i < m_entries.size(); ++i) {
+		FileWatchEntry& entry = m_entries[i];
+		FileStamp stamp;
+		readStamp(entry.path, stamp);
+		if (!sameStamp(stamp, entry.stamp)) {
+			entry.stamp = stamp;
+			entry.pending = true;
+			entry.changedAt = m_lastScan;
+		}
+	}
+}
+
+unsigned int
+FileWatcher::poll(std::vector<FileWatchId>& changed) {
+	if (isNative()) {
+		readNativeEvents();
+	}
+	else {
+		scanStamps();
+	}
+	unsigned int count = 0;
+	for (size_t i = 0; i < m_entries.size(); ++i) {
+		FileWatchEntry& entry = m_entries[i];
+		if (!entry.pending || elapsedMs(entry.changedAt) < m_settleMs) {
+			continue;
+		}
+		entry.pending = false;
+		FileStamp stamp;
+		readStamp(entry.path, stamp);
+		// Un archivo borrado (el editor todavia no escribe el nuevo) espera al
+		// siguiente evento
+		if (!stamp.exists) {
+			entry.stamp = stamp;
+			continue;
+		}
+		entry.stamp = stamp;
+		changed.push_back(static_cast<FileWatchId>(i));
+		count++;
+	}
+	return count;
+}
@@ -0,0 +1,195 @@
+#include "FrustumCuller.h"
+#include <cmath>
+#include <xmmintrin.h>
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace {
+	// Agrega a visible los indices base + i con el bit i puesto en mask
+	inline void
+	appendMask(unsigned int mask, unsigned int base, std::vector<unsigned int>& visible) {
+		while (mask) {
+			unsigned int bit = 0;
+			while ((mask & (1u << bit)) == 0) {
+				++bit;
+			}
+			visible.push_back(base + bit);
+			mask &= mask - 1;
+		}
+	}
+}
+
+void
+FrustumCuller::init(unsigned int expectedCount) {
+	clear();
+	m_centerX.reserve(expectedCount);
+	m_centerY.reserve(expectedCount);
+	m_centerZ.reserve(expectedCount);
+	m_extentX.reserve(expectedCount);
+	m_extentY.reserve(expectedCount);
+	m_extentZ.reserve(expectedCount);
+	m_radius.reserve(expectedCount);
+}
+
+void
+FrustumCuller::setFrustum(const Float4x4& viewProjection) {
+	const Float4x4& m = viewProjection;
+
+	// Con vector fila clip = v * M, asi que cada plano sale de las columnas
+	// de M (Gribb/Hartmann). En D3D el z de clip va de 0 a w.
+	for (int i = 0; i < 4; ++i) {
+		const float* row = m.m[i];
+		(&m_planes[0].x)[i] = row[3] + row[0];   // Izquierdo
+		(&m_planes[1].x)[i] = row[3] - row[0];   // Derecho
+		(&m_planes[2].x)[i] = row[3] + row[1];   // Inferior
+		(&m_planes[3].x)[i] = row[3] - row[1];   // Superior
+		(&m_planes[4].x)[i] = row[2];            // Cercano
+		(&m_planes[5].x)[i] = row[3] - row[2];   // Lejano
+	}
+	for (int p = 0; p < 6; ++p) {
+		Float4& plane = m_planes[p];
+		float length = sqrtf(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+		float inv = length > 0.0f ? 1.0f / length : 0.0f;
+		plane.x *= inv;
+		plane.y *= inv;
+		plane.z *= inv;
+		plane.w *= inv;
+	}
+}
+
+unsigned int
+FrustumCuller::add(const Bounds& worldBounds) {
+	m_centerX.push_back(worldBounds.center.x);
+	m_centerY.push_back(worldBounds.center.y);
+	m_centerZ.push_back(worldBounds.center.z);
+	m_extentX.push_back(worldBounds.extents.x);
+	m_extentY.push_back(worldBounds.extents.y);
+	m_extentZ.push_back(worldBounds.extents.z);
+	m_radius.push_back(worldBounds.radius);
+	return m_count++;
+}
+
+void
+FrustumCuller::set(unsigned int index, const Bounds& worldBounds) {
+	m_centerX[index] = worldBounds.center.x;
+	m_centerY[index] = worldBounds.center.y;
+	m_centerZ[index] = worldBounds.center.z;
+	m_extentX[index] = worldBounds.extents.x;
+	m_extentY[index] = worldBounds.extents.y;
+	m_extentZ[index] = worldBounds.extents.z;
+	m_radius[index] = worldBounds.radius;
+}
+
+bool
+FrustumCuller::isVisibleScalar(unsigned int i) const {
+	for (int p = 0; p < 6; ++p) {
+		const Float4& plane = m_planes[p];
+		float distance = m_centerX[i] * plane.x + m_centerY[i] * plane.y + m_centerZ[i] * plane.z + plane.w;
+		float boxRadius = m_extentX[i] * fabsf(plane.x) + m_extentY[i] * fabsf(plane.y) + m_extentZ[i] * fabsf(plane.z);
+		float radius = m_radius[i] < boxRadius ? m_radius[i] : boxRadius;
+		if (distance < -radius) {
+			return false;
+		}
+	}
+	return true;
+}
+
+unsigned int
+FrustumCuller::cullScalar(std::vector<unsigned int>& visible) const {
+	visible.clear();
+	for (unsigned int i = 0; i < m_count; ++i) {
+		if (isVisibleScalar(i)) {
+			visible.push_back(i);
+		}
+	}
+	return static_cast<unsigned int>(visible.size());
+}
+
+unsigned int
+FrustumCuller::cull(std::vector<unsigned int>& visible) {
+	visible.clear();
+	visible.reserve(m_count);
+	unsigned int i = 0;
+
+#if defined(__AVX__)
+	const __m256 signMask8 = _mm256_set1_ps(-0.0f);
+	for (; i + 8 <= m_count; i += 8) {
+		__m256 cx = _mm256_loadu_ps(&m_centerX[i]);
+		__m256 cy = _mm256_loadu_ps(&m_centerY[i]);
+		__m256 cz = _mm256_loadu_ps(&m_centerZ[i]);
+		__m256 ex = _mm256_loadu_ps(&m_extentX[i]);
+		__m256 ey = _mm256_loadu_ps(&m_extentY[i]);
+		__m256 ez = _mm256_loadu_ps(&m_extentZ[i]);
+		__m256 sphere = _mm256_loadu_ps(&m_radius[i]);
+		__m256 outside = _mm256_setzero_ps();
+		for (int p = 0; p < 6; ++p) {
+			const Float4& plane = m_planes[p];
+			__m256 nx = _mm256_set1_ps(plane.x);
+			__m256 ny = _mm256_set1_ps(plane.y);
+			__m256 nz = _mm256_set1_ps(plane.z);
+			// Mismo orden de operaciones que isVisibleScalar
+			__m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(cx, nx), _mm256_mul_ps(cy, ny)),
+																										_mm256_mul_ps(cz, nz)),
+																			_mm256_set1_ps(plane.w));
+			__m256 boxRadius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ex, _mm256_andnot_ps(signMask8, nx)),
+																										 _mm256_mul_ps(ey, _mm256_andnot_ps(signMask8, ny))),
+																			 _mm256_mul_ps(ez, _mm256_andnot_ps(signMask8, nz)));
+			__m256 radius = _mm256_min_ps(sphere, boxRadius);
+			outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, _mm256_xor_ps(radius, signMask8), _CMP_LT_OQ));
+		}
+		appendMask(~_mm256_movemask_ps(outside) & 0xff, i, visible);
+	}
+#endif
+
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	for (; i + 4 <= m_count; i += 4) {
+		__m128 cx = _mm_loadu_ps(&m_centerX[i]);
+		__m128 cy = _mm_loadu_ps(&m_centerY[i]);
+		__m128 cz = _mm_loadu_ps(&m_centerZ[i]);
+		__m128 ex = _mm_loadu_ps(&m_extentX[i]);
+		__m128 ey = _mm_loadu_ps(&m_extentY[i]);
+		__m128 ez = _mm_loadu_ps(&m_extentZ[i]);
+		__m128 sphere = _mm_loadu_ps(&m_radius[i]);
+		__m128 outside = _mm_setzero_ps();
+		for (int p = 0; p < 6; ++p) {
+			const Float4& plane = m_planes[p];
+			__m128 nx = _mm_set1_ps(plane.x);
+			__m128 ny = _mm_set1_ps(plane.y);
+			__m128 nz = _mm_set1_ps(plane.z);
+			__m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, nx), _mm_mul_ps(cy, ny)),
+																							_mm_mul_ps(cz, nz)),
+																	 _mm_set1_ps(plane.w));
+			__m128 boxRadius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ex, _mm_andnot_ps(signMask, nx)),
+																							 _mm_mul_ps(ey, _mm_andnot_ps(signMask, ny))),
+																		_mm_mul_ps(ez, _mm_andnot_ps(signMask, nz)));
+			__m128 radius = _mm_min_ps(sphere, boxRadius);
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, _mm_xor_ps(radius, signMask)));
+		}
+		appendMask(~_mm_movemask_ps(outside) & 0xf, i, visible);
+	}
+
+	// Resto que no llena un registro
+	for (; i < m_count; ++i) {
+		if (isVisibleScalar(i)) {
+			visible.push_back(i);
+		}
+	}
+
+	m_stats.tested = m_count;
+	m_stats.visible = static_cast<unsigned int>(visible.size());
+	return m_stats.visible;
+}
+
+void
+FrustumCuller::clear() {
+	m_count = 0;
+	m_centerX.clear();
+	m_centerY.clear();
+	m_centerZ.clear();
+	m_extentX.clear();
+	m_extentY.clear();
+	m_extentZ.clear();
+	m_radius.clear();
+	m_stats = CullStats();
+}
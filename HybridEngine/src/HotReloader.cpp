@@ -0,0 +1,310 @@
+#include "HotReloader.h"
+#include "Device.h"
+#include "ShaderProgram.h"
+#include "Buffer.h"
+#include "JobSystem.h"
+#include "ObjLoader.h"
+#include "MeshFile.h"
+#include "RenderBackend.h"
+
+namespace {
+	bool
+	endsWith(const std::string& text, const std::string& suffix) {
+		return text.size() >= suffix.size() &&
+			text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+	}
+}
+
+HRESULT
+HotReloader::init(Device& device, JobSystem& jobs, bool nativeWatch, double pollIntervalMs) {
+	if (!device.m_backend) {
+		ERROR("HotReloader", "init", "Device is null.");
+		return E_POINTER;
+	}
+	destroy();
+	HRESULT hr = m_watcher.init(nativeWatch, pollIntervalMs);
+	if (FAILED(hr)) {
+		ERROR("HotReloader", "init", "Failed to initialize the file watcher.");
+		return hr;
+	}
+	m_device = &device;
+	m_jobs = &jobs;
+	m_loader.init(jobs);
+	return S_OK;
+}
+
+void
+HotReloader::destroy() {
+	// Los works en vuelo escriben en los assets
+	m_loader.destroy();
+	for (size_t i = 0; i < m_assets.size(); ++i) {
+		SAFE_RELEASE(m_assets[i]->stagedTexture);
+		delete m_assets[i];
+	}
+	m_assets.clear();
+	m_changed.clear();
+	m_watcher.destroy();
+	m_busy = false;
+	m_swapped = 0;
+	m_stats = HotReloadStats();
+	m_device = nullptr;
+	m_jobs = nullptr;
+}
+
+void
+HotReloader::add(HotReloadAsset* asset) {
+	asset->watch = m_watcher.watch(asset->path);
+	asset->task = INVALID_LOAD_TASK;
+	asset->changedAgain = false;
+	asset->stagedTexture = nullptr;
+	asset->reloader = this;
+	m_assets.push_back(asset);
+}
+
+void
+HotReloader::addShader(ShaderProgram& program) {
+	if (!m_device || program.getFileName().empty()) {
+		ERROR("HotReloader", "addShader", "Not initialized or shader without file.");
+		return;
+	}
+	HotReloadAsset* asset = new HotReloadAsset();
+	asset->type = HOT_RELOAD_SHADER;
+	asset->path = program.getFileName();
+	asset->shader = &program;
+	asset->texture = nullptr;
+	asset->mesh = nullptr;
+	asset->vertexBuffer = nullptr;
+	asset->indexBuffer = nullptr;
+	add(asset);
+}
+
+void
+HotReloader::addTexture(const std::string& path, ID3D11ShaderResourceView** view) {
+	if (!m_device || path.empty() || !view) {
+		ERROR("HotReloader", "addTexture", "Not initialized or invalid texture.");
+		return;
+	}
+	HotReloadAsset* asset = new HotReloadAsset();
+	asset->type = HOT_RELOAD_TEXTURE;
+	asset->path = path;
+	asset->shader = nullptr;
+	asset->texture = view;
+	asset->mesh = nullptr;
+	asset->vertexBuffer = nullptr;
+	asset->indexBuffer = nullptr;
+	add(asset);
+}
+
+void
+HotReloader::addMesh(const std::string& path, MeshComponent& mesh, Buffer& vertexBuffer, Buffer& indexBuffer) {
+	if (!m_device || path.empty()) {
+		ERROR("HotReloader", "addMesh", "Not initialized or mesh without file.");
+		return;
+	}
+	HotReloadAsset* asset = new HotReloadAsset();
+	asset->type = HOT_RELOAD_MESH;
+	asset->path = path;
+	asset->shader = nullptr;
+	asset->texture = nullptr;
+	asset->mesh = &mesh;
+	asset->vertexBuffer = &vertexBuffer;
+	asset->indexBuffer = &indexBuffer;
+	add(asset);
+}
+
+void
+HotReloader::launch(HotReloadAsset& asset) {
+	asset.changedAgain = false;
+	// Sin workers el update() corre en un hilo que no ejecuta jobs: el work
+	// se hace ahi mismo, junto con el intercambio
+	if (m_jobs->getThreadCount() == 1) {
+		asset.task = m_loader.add(asset.path, nullptr, &reloadInline, &asset);
+	}
+	else {
+		asset.task = m_loader.add(asset.path, &reloadWork, &reloadFinish, &asset);
+	}
+	if (!m_busy) {
+		m_loader.start();
+		m_busy = true;
+	}
+}
+
+bool
+HotReloader::update() {
+	if (!m_device) {
+		return false;
+	}
+	m_swapped = 0;
+
+	m_changed.clear();
+	m_watcher.poll(m_changed);
+	for (size_t c = 0; c < m_changed.size(); ++c) {
+		for (size_t i = 0; i < m_assets.size(); ++i) {
+			HotReloadAsset& asset = *m_assets[i];
+			if (asset.watch != m_changed[c]) {
+				continue;
+			}
+			m_stats.changes++;
+			// Se relanza al terminar; el work en curso pudo leer la version vieja
+			if (asset.task != INVALID_LOAD_TASK) {
+				asset.changedAgain = true;
+			}
+			else {
+				launch(asset);
+			}
+		}
+	}
+	if (!m_busy) {
+		return false;
+	}
+
+	bool pending = m_loader.update();
+
+	std::vector<HotReloadAsset*> relaunch;
+	for (size_t i = 0; i < m_assets.size(); ++i) {
+		HotReloadAsset& asset = *m_assets[i];
+		if (asset.task == INVALID_LOAD_TASK) {
+			continue;
+		}
+		LoadTaskState state = m_loader.getState(asset.task);
+		if (state != LOAD_TASK_DONE && state != LOAD_TASK_FAILED) {
+			continue;
+		}
+		if (state == LOAD_TASK_FAILED) {
+			ERROR("HotReloader", "update", ("Failed to reload " + asset.path + "; keeping the old version").c_str());
+			SAFE_RELEASE(asset.stagedTexture);
+			asset.stagedMesh = MeshComponent();
+			m_stats.failed++;
+		}
+		asset.task = INVALID_LOAD_TASK;
+		if (asset.changedAgain) {
+			relaunch.push_back(&asset);
+		}
+	}
+
+	// Los ids de tarea vuelven a empezar con un loader vacio
+	if (!pending) {
+		m_loader.destroy();
+		m_busy = false;
+	}
+	for (size_t i = 0; i < relaunch.size(); ++i) {
+		launch(*relaunch[i]);
+	}
+	return m_swapped > 0;
+}
+
+HRESULT
+HotReloader::reloadWork(void* data) {
+	HotReloadAsset& asset = *static_cast<HotReloadAsset*>(data);
+	switch (asset.type) {
+	case HOT_RELOAD_SHADER: {
+		// Solo llena el cache; el intercambio compila de nuevo y acierta. Un
+		// error de sintaxis se detecta aqui sin tocar el programa vivo
+		const ShaderType types[2] = { VERTEX_SHADER, PIXEL_SHADER };
+		const bool present[2] = { asset.shader->m_VertexShader != nullptr, asset.shader->m_PixelShader != nullptr };
+		for (int i = 0; i < 2; ++i) {
+			if (!present[i]) {
+				continue;
+			}
+			ID3DBlob* blob = nullptr;
+			HRESULT hr = asset.shader->CompileShader(asset.path, types[i], &blob);
+			SAFE_RELEASE(blob);
+			if (FAILED(hr)) {
+				return hr;
+			}
+		}
+		return S_OK;
+	}
+	case HOT_RELOAD_TEXTURE: {
+		Device& device = *asset.reloader->m_device;
+		if (!device.m_backend->isFreeThreaded()) {
+			return S_OK;
+		}
+		return device.CreateShaderResourceViewFromFile(asset.path, &asset.stagedTexture);
+	}
+	case HOT_RELOAD_MESH: {
+		asset.stagedMesh = MeshComponent();
+		HRESULT hr = S_OK;
+		if (endsWith(asset.path, ".hmesh")) {
+			MeshFile file;
+			hr = file.open(asset.path);
+			if (SUCCEEDED(hr)) {
+				file.toMesh(asset.stagedMesh);
+			}
+		}
+		else {
+			ObjLoader loader;
+			hr = loader.load(asset.path, asset.stagedMesh);
+		}
+		if (SUCCEEDED(hr) && (asset.stagedMesh.m_numVertex == 0 || asset.stagedMesh.m_numIndex == 0)) {
+			ERROR("HotReloader", "reloadWork", ("Empty mesh " + asset.path).c_str());
+			hr = E_FAIL;
+		}
+		return hr;
+	}
+	}
+	return E_INVALIDARG;
+}
+
+HRESULT
+HotReloader::reloadInline(void* data) {
+	HRESULT hr = reloadWork(data);
+	if (FAILED(hr)) {
+		return hr;
+	}
+	return reloadFinish(data);
+}
+
+HRESULT
+HotReloader::reloadFinish(void* data) {
+	HotReloadAsset& asset = *static_cast<HotReloadAsset*>(data);
+	HotReloader& reloader = *asset.reloader;
+	Device& device = *reloader.m_device;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	HRESULT hr = S_OK;
+	switch (asset.type) {
+	case HOT_RELOAD_SHADER:
+		hr = asset.shader->reload(device);
+		break;
+	case HOT_RELOAD_TEXTURE:
+		if (!asset.stagedTexture) {
+			hr = device.CreateShaderResourceViewFromFile(asset.path, &asset.stagedTexture);
+		}
+		if (SUCCEEDED(hr)) {
+			ID3D11ShaderResourceView* old = *asset.texture;
+			*asset.texture = asset.stagedTexture;
+			asset.stagedTexture = nullptr;
+			SAFE_RELEASE(old);
+		}
+		break;
+	case HOT_RELOAD_MESH: {
+		Buffer vertexBuffer;
+		Buffer indexBuffer;
+		hr = vertexBuffer.init(device, asset.stagedMesh, D3D11_BIND_VERTEX_BUFFER);
+		if (SUCCEEDED(hr)) {
+			hr = indexBuffer.init(device, asset.stagedMesh, D3D11_BIND_INDEX_BUFFER);
+		}
+		if (FAILED(hr)) {
+			vertexBuffer.destroy();
+			indexBuffer.destroy();
+			break;
+		}
+		asset.vertexBuffer->destroy();
+		asset.indexBuffer->destroy();
+		*asset.vertexBuffer = vertexBuffer;
+		*asset.indexBuffer = indexBuffer;
+		*asset.mesh = asset.stagedMesh;
+		asset.stagedMesh = MeshComponent();
+		break;
+	}
+	}
+	if (FAILED(hr)) {
+		return hr;
+	}
+	reloader.m_stats.lastSwapMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	reloader.m_stats.reloads++;
+	reloader.m_swapped++;
+	MESSAGE("HotReloader", "update", asset.path.c_str());
+	return S_OK;
+}
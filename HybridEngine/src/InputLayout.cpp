@@ -30,6 +30,30 @@ InputLayout::init(Device& device,
 	return S_OK;
 }
 
+void
+InputLayout::appendInstanceElements(std::vector<D3D11_INPUT_ELEMENT_DESC>& Layout,
+																		unsigned int inputSlot) {
+	D3D11_INPUT_ELEMENT_DESC element;
+	memset(&element, 0, sizeof(element));
+	element.Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+	element.InputSlot = inputSlot;
+	element.InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
+	element.InstanceDataStepRate = 1;
+
+	// mWorld ya viene transpuesta: cada fila es una columna de la matriz de mundo
+	element.SemanticName = "WORLD";
+	for (unsigned int row = 0; row < 4; ++row) {
+		element.SemanticIndex = row;
+		element.AlignedByteOffset = offsetof(CBChangesEveryFrame, mWorld) + row * 16;
+		Layout.push_back(element);
+	}
+
+	element.SemanticName = "COLOR";
+	element.SemanticIndex = 0;
+	element.AlignedByteOffset = offsetof(CBChangesEveryFrame, vMeshColor);
+	Layout.push_back(element);
+}
+
 void
 InputLayout::update() {
 	// Mtodo vaco, se puede utilizar en caso de necesitar cambios dinmicos en el layout
@@ -42,7 +66,7 @@ InputLayout::render(DeviceContext& deviceContext) {
 		return;
 	}
 
-	deviceContext.m_deviceContext->IASetInputLayout(m_inputLayout);
+	deviceContext.IASetInputLayout(m_inputLayout);
 }
 
 void
@@ -0,0 +1,352 @@
+#include "JobSystem.h"
+
+namespace {
+	const unsigned int INVALID_THREAD = 0xffffffff;
+
+	// Worker actual y el sistema al que pertenece; un hilo solo puede ser
+	// worker de un sistema. El hilo principal se reconoce por su id
+	thread_local const JobSystem* t_threadSystem = nullptr;
+	thread_local unsigned int t_threadIndex = INVALID_THREAD;
+	thread_local unsigned int t_stealCursor = 0;
+}
+
+//--------------------------------------------------------------------------------------
+// WorkStealingQueue
+//--------------------------------------------------------------------------------------
+bool
+WorkStealingQueue::push(Job* job) {
+	long long bottom = m_bottom.load(std::memory_order_relaxed);
+	long long top = m_top.load(std::memory_order_acquire);
+	if (bottom - top >= static_cast<long long>(CAPACITY)) {
+		return false;
+	}
+	m_jobs[bottom & (CAPACITY - 1)].store(job, std::memory_order_relaxed);
+	m_bottom.store(bottom + 1, std::memory_order_release);
+	return true;
+}
+
+Job*
+WorkStealingQueue::pop() {
+	long long bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+	m_bottom.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	long long top = m_top.load(std::memory_order_relaxed);
+
+	if (top > bottom) {
+		// Vacia
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return nullptr;
+	}
+
+	Job* job = m_jobs[bottom & (CAPACITY - 1)].load(std::memory_order_relaxed);
+	if (top == bottom) {
+		// Ultimo elemento: compite con los ladrones
+		if (!m_top.compare_exchange_strong(top, top + 1,
+																			 std::memory_order_seq_cst,
+																			 std::memory_order_relaxed)) {
+			job = nullptr;
+		}
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+	return job;
+}
+
+Job*
+WorkStealingQueue::steal() {
+	long long top = m_top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	long long bottom = m_bottom.load(std::memory_order_acquire);
+	if (top >= bottom) {
+		return nullptr;
+	}
+	Job* job = m_jobs[top & (CAPACITY - 1)].load(std::memory_order_relaxed);
+	if (!m_top.compare_exchange_strong(top, top + 1,
+																		 std::memory_order_seq_cst,
+																		 std::memory_order_relaxed)) {
+		return nullptr;
+	}
+	return job;
+}
+
+unsigned int
+WorkStealingQueue::size() const {
+	long long bottom = m_bottom.load(std::memory_order_relaxed);
+	long long top = m_top.load(std::memory_order_relaxed);
+	return bottom > top ? static_cast<unsigned int>(bottom - top) : 0;
+}
+
+//--------------------------------------------------------------------------------------
+// JobSystem
+//--------------------------------------------------------------------------------------
+void
+JobSystem::init(unsigned int workerThreads, bool mainThreadParticipates) {
+	if (m_running.load()) {
+		ERROR("JobSystem", "init", "JobSystem already initialized");
+		return;
+	}
+	if (workerThreads == AUTO_WORKERS) {
+		unsigned int cores = std::thread::hardware_concurrency();
+		workerThreads = cores > 1 ? cores - 1 : 0;
+	}
+	m_mainThreadParticipates = mainThreadParticipates;
+
+	// Cola y pool por hilo; el pool extra es para hilos ajenos al sistema
+	unsigned int threadCount = workerThreads + 1;
+	m_queues.resize(threadCount);
+	for (unsigned int i = 0; i < threadCount; ++i) {
+		m_queues[i] = new WorkStealingQueue();
+	}
+	m_jobPools.resize(threadCount + 1);
+	for (unsigned int i = 0; i <= threadCount; ++i) {
+		m_jobPools[i] = new Job[JOB_POOL_SIZE];
+	}
+	m_jobPoolHeads.assign(threadCount + 1, 0);
+	m_stats.assign(threadCount + 1, JobWorkerStats());
+
+	m_mainThread = std::this_thread::get_id();
+	m_running.store(true);
+	for (unsigned int i = 1; i < threadCount; ++i) {
+		m_threads.push_back(std::thread(&JobSystem::workerLoop, this, i));
+	}
+}
+
+void
+JobSystem::destroy() {
+	if (!m_running.exchange(false)) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> guard(m_sleepLock);
+		m_wakeUp.notify_all();
+	}
+	for (size_t i = 0; i < m_threads.size(); ++i) {
+		m_threads[i].join();
+	}
+	m_threads.clear();
+
+	for (size_t i = 0; i < m_queues.size(); ++i) {
+		delete m_queues[i];
+	}
+	m_queues.clear();
+	for (size_t i = 0; i < m_jobPools.size(); ++i) {
+		delete[] m_jobPools[i];
+	}
+	m_jobPools.clear();
+	m_jobPoolHeads.clear();
+	m_injected.clear();
+	m_injectedCount.store(0);
+	m_mainThread = std::thread::id();
+}
+
+void
+JobSystem::run(JobFunction function,
+							 void* data,
+							 JobCounter* counter,
+							 unsigned int begin,
+							 unsigned int end,
+							 JobCounter* dependency) {
+	Job* job = allocateJob();
+	job->function = function;
+	job->data = data;
+	job->begin = begin;
+	job->end = end;
+	job->grain = 0;
+	job->counter = counter;
+	job->system = this;
+	if (counter) {
+		counter->value.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	if (dependency) {
+		std::lock_guard<std::mutex> guard(dependency->lock);
+		if (!dependency->isDone()) {
+			dependency->continuations.push_back(job);
+			return;
+		}
+	}
+	submit(job);
+}
+
+void
+JobSystem::wait(JobCounter& counter) {
+	// Los workers siempre ayudan; el principal solo si se configuro asi
+	bool participate = m_mainThreadParticipates || getThreadIndex() != 0;
+	while (!counter.isDone()) {
+		if (!participate || !executeOne()) {
+			std::this_thread::yield();
+		}
+	}
+	// Sincroniza con el finish() que dejo el contador en cero
+	std::lock_guard<std::mutex> guard(counter.lock);
+}
+
+unsigned int
+JobSystem::getThreadIndex() const {
+	if (t_threadSystem == this) {
+		return t_threadIndex;
+	}
+	return std::this_thread::get_id() == m_mainThread ? 0 : INVALID_THREAD;
+}
+
+JobWorkerStats
+JobSystem::getStats() const {
+	JobWorkerStats total;
+	for (size_t i = 0; i < m_stats.size(); ++i) {
+		total.executed += m_stats[i].executed;
+		total.stolen += m_stats[i].stolen;
+		total.failedSteals += m_stats[i].failedSteals;
+		total.inlined += m_stats[i].inlined;
+		total.heapJobs += m_stats[i].heapJobs;
+	}
+	return total;
+}
+
+void
+JobSystem::resetStats() {
+	m_stats.assign(m_stats.size(), JobWorkerStats());
+}
+
+void
+JobSystem::workerLoop(unsigned int index) {
+	t_threadSystem = this;
+	t_threadIndex = index;
+	unsigned int idle = 0;
+	while (m_running.load(std::memory_order_relaxed)) {
+		if (executeOne()) {
+			idle = 0;
+			continue;
+		}
+		// Espera activa corta y luego a dormir hasta que alguien encole
+		if (++idle < 64) {
+			std::this_thread::yield();
+			continue;
+		}
+		std::unique_lock<std::mutex> guard(m_sleepLock);
+		m_sleeping.fetch_add(1);
+		m_wakeUp.wait_for(guard, std::chrono::milliseconds(1));
+		m_sleeping.fetch_sub(1);
+	}
+}
+
+Job*
+JobSystem::allocateJob() {
+	unsigned int index = getThreadIndex();
+	unsigned int pool = index < m_queues.size() ? index : static_cast<unsigned int>(m_queues.size());
+	// Los hilos ajenos comparten el ultimo pool
+	std::unique_lock<std::mutex> guard(m_injectLock, std::defer_lock);
+	if (pool == m_queues.size()) {
+		guard.lock();
+	}
+	Job* job = &m_jobPools[pool][m_jobPoolHeads[pool]++ & (JOB_POOL_SIZE - 1)];
+	// El slot reciclado todavia no termino: no se puede pisar
+	if (job->live.load(std::memory_order_acquire)) {
+		m_stats[pool].heapJobs++;
+		job = new Job();
+		job->heap = true;
+	}
+	job->live.store(1, std::memory_order_relaxed);
+	return job;
+}
+
+void
+JobSystem::submit(Job* job) {
+	unsigned int index = getThreadIndex();
+	if (index >= m_queues.size()) {
+		// Hilo ajeno: no puede tocar los deques, usa la cola compartida
+		std::lock_guard<std::mutex> guard(m_injectLock);
+		m_injected.push_back(job);
+		m_injectedCount.fetch_add(1, std::memory_order_relaxed);
+	}
+	else if (!m_queues[index]->push(job)) {
+		m_stats[index].inlined++;
+		execute(job);
+		return;
+	}
+	if (m_sleeping.load(std::memory_order_relaxed) > 0) {
+		m_wakeUp.notify_one();
+	}
+}
+
+bool
+JobSystem::executeOne() {
+	unsigned int index = getThreadIndex();
+	if (index >= m_queues.size()) {
+		return false;
+	}
+
+	Job* job = m_queues[index]->pop();
+	if (!job && m_injectedCount.load(std::memory_order_relaxed) > 0) {
+		std::lock_guard<std::mutex> guard(m_injectLock);
+		if (!m_injected.empty()) {
+			job = m_injected.back();
+			m_injected.pop_back();
+			m_injectedCount.fetch_sub(1, std::memory_order_relaxed);
+		}
+	}
+	if (!job) {
+		unsigned int count = static_cast<unsigned int>(m_queues.size());
+		for (unsigned int i = 1; i < count && !job; ++i) {
+			unsigned int victim = (index + i + t_stealCursor) % count;
+			if (victim == index) {
+				continue;
+			}
+			job = m_queues[victim]->steal();
+		}
+		t_stealCursor++;
+		if (!job) {
+			m_stats[index].failedSteals++;
+			return false;
+		}
+		m_stats[index].stolen++;
+	}
+
+	execute(job);
+	return true;
+}
+
+void
+JobSystem::execute(Job* job) {
+	job->function(*job);
+	unsigned int index = getThreadIndex();
+	m_stats[index < m_queues.size() ? index : m_queues.size()].executed++;
+	finish(job);
+	release(job);
+}
+
+void
+JobSystem::release(Job* job) {
+	if (job->heap) {
+		delete job;
+	}
+	else {
+		job->live.store(0, std::memory_order_release);
+	}
+}
+
+void
+JobSystem::finish(Job* job) {
+	JobCounter* counter = job->counter;
+	if (!counter) {
+		return;
+	}
+	int value = counter->value.load(std::memory_order_acquire);
+	while (value > 1) {
+		if (counter->value.compare_exchange_weak(value, value - 1, std::memory_order_acq_rel)) {
+			return;
+		}
+	}
+
+	// Posible ultimo job: el paso a cero se hace con el lock tomado para que
+	// wait() no destruya el contador mientras aun se usa
+	std::vector<Job*> ready;
+	{
+		std::lock_guard<std::mutex> guard(counter->lock);
+		if (counter->value.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			ready.swap(counter->continuations);
+		}
+	}
+	// Liberar los jobs que esperaban a este contador
+	for (size_t i = 0; i < ready.size(); ++i) {
+		submit(ready[i]);
+	}
+}
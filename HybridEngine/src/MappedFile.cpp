@@ -0,0 +1,56 @@
+#include "MappedFile.h"
+
+HRESULT
+MappedFile::open(const std::string& path) {
+	close();
+
+	m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+											 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (m_file == INVALID_HANDLE_VALUE) {
+		ERROR("MappedFile", "open", ("Failed to open " + path).c_str());
+		return HRESULT_FROM_WIN32(GetLastError());
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(m_file, &fileSize)) {
+		ERROR("MappedFile", "open", ("Failed to query size of " + path).c_str());
+		close();
+		return E_FAIL;
+	}
+	m_size = static_cast<size_t>(fileSize.QuadPart);
+	if (m_size == 0) {
+		// No se puede proyectar un archivo vacio; se deja abierto sin vista
+		return S_OK;
+	}
+
+	m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!m_mapping) {
+		ERROR("MappedFile", "open", ("Failed to create mapping for " + path).c_str());
+		close();
+		return E_FAIL;
+	}
+	m_view = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!m_view) {
+		ERROR("MappedFile", "open", ("Failed to map view of " + path).c_str());
+		close();
+		return E_FAIL;
+	}
+	return S_OK;
+}
+
+void
+MappedFile::close() {
+	if (m_view) {
+		UnmapViewOfFile(m_view);
+		m_view = nullptr;
+	}
+	if (m_mapping) {
+		CloseHandle(m_mapping);
+		m_mapping = nullptr;
+	}
+	if (m_file != INVALID_HANDLE_VALUE) {
+		CloseHandle(m_file);
+		m_file = INVALID_HANDLE_VALUE;
+	}
+	m_size = 0;
+}
@@ -0,0 +1,228 @@
+#include "MeshFile.h"
+#include "MeshComponent.h"
+#include "Buffer.h"
+#include "Device.h"
+#include <fstream>
+#include <cmath>
+
+namespace {
+	unsigned long long
+	alignUp(unsigned long long value, unsigned long long alignment) {
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	void
+	writePadding(std::ofstream& out, unsigned long long from, unsigned long long to) {
+		static const char zeros[MESH_FILE_ALIGNMENT] = {};
+		out.write(zeros, static_cast<std::streamsize>(to - from));
+	}
+
+	bool
+	sectionFits(unsigned long long offset, unsigned long long bytes, unsigned long long size) {
+		return offset % MESH_FILE_ALIGNMENT == 0 && offset <= size && bytes <= size - offset;
+	}
+
+	// Bounds de los vertices usados por un rango de indices
+	Bounds
+	computeSubmeshBounds(const MeshComponent& mesh, const MeshFileSubmesh& submesh) {
+		float minimum[3] = { 1e30f, 1e30f, 1e30f };
+		float maximum[3] = { -1e30f, -1e30f, -1e30f };
+		for (unsigned int i = 0; i < submesh.indexCount; ++i) {
+			const XMFLOAT3& p = mesh.m_vertex[submesh.baseVertex + mesh.m_index[submesh.indexStart + i]].Pos;
+			const float v[3] = { p.x, p.y, p.z };
+			for (int k = 0; k < 3; ++k) {
+				minimum[k] = v[k] < minimum[k] ? v[k] : minimum[k];
+				maximum[k] = v[k] > maximum[k] ? v[k] : maximum[k];
+			}
+		}
+		Bounds bounds;
+		bounds.center = Float3((minimum[0] + maximum[0]) * 0.5f,
+													 (minimum[1] + maximum[1]) * 0.5f,
+													 (minimum[2] + maximum[2]) * 0.5f);
+		bounds.extents = Float3((maximum[0] - minimum[0]) * 0.5f,
+														(maximum[1] - minimum[1]) * 0.5f,
+														(maximum[2] - minimum[2]) * 0.5f);
+		bounds.radius = sqrtf(bounds.extents.x * bounds.extents.x +
+													bounds.extents.y * bounds.extents.y +
+													bounds.extents.z * bounds.extents.z);
+		return bounds;
+	}
+}
+
+HRESULT
+MeshFile::write(const std::string& path,
+								const MeshComponent& mesh,
+								const MeshFileSubmesh* submeshes,
+								unsigned int submeshCount) {
+	if (mesh.m_vertex.empty() || mesh.m_index.empty()) {
+		ERROR("MeshFile", "write", "Mesh is empty");
+		return E_INVALIDARG;
+	}
+
+	std::vector<MeshFileSubmesh> sections;
+	if (submeshes && submeshCount > 0) {
+		sections.assign(submeshes, submeshes + submeshCount);
+	}
+	else {
+		MeshFileSubmesh whole = {};
+		whole.indexCount = static_cast<unsigned int>(mesh.m_index.size());
+		sections.push_back(whole);
+	}
+	for (size_t i = 0; i < sections.size(); ++i) {
+		MeshFileSubmesh& submesh = sections[i];
+		if (submesh.indexStart + submesh.indexCount > mesh.m_index.size()) {
+			ERROR("MeshFile", "write", "Submesh index range out of bounds");
+			return E_INVALIDARG;
+		}
+		for (unsigned int k = 0; k < submesh.indexCount; ++k) {
+			if (submesh.baseVertex + mesh.m_index[submesh.indexStart + k] >= mesh.m_vertex.size()) {
+				ERROR("MeshFile", "write", "Submesh vertex out of bounds");
+				return E_INVALIDARG;
+			}
+		}
+		submesh.bounds = computeSubmeshBounds(mesh, submesh);
+	}
+
+	MeshFileHeader header = {};
+	header.magic = MESH_FILE_MAGIC;
+	header.version = MESH_FILE_VERSION;
+	header.headerSize = sizeof(MeshFileHeader);
+	header.alignment = MESH_FILE_ALIGNMENT;
+	header.vertexCount = static_cast<unsigned int>(mesh.m_vertex.size());
+	header.vertexStride = sizeof(SimpleVertex);
+	header.indexCount = static_cast<unsigned int>(mesh.m_index.size());
+	unsigned int maxIndex = 0;
+	for (size_t i = 0; i < mesh.m_index.size(); ++i) {
+		maxIndex = mesh.m_index[i] > maxIndex ? mesh.m_index[i] : maxIndex;
+	}
+	header.indexStride = maxIndex <= 0xffff ? sizeof(unsigned short) : sizeof(unsigned int);
+	header.submeshCount = static_cast<unsigned int>(sections.size());
+	header.vertexOffset = alignUp(sizeof(MeshFileHeader), MESH_FILE_ALIGNMENT);
+	header.indexOffset = alignUp(header.vertexOffset + header.vertexCount * header.vertexStride, MESH_FILE_ALIGNMENT);
+	header.submeshOffset = alignUp(header.indexOffset + header.indexCount * header.indexStride, MESH_FILE_ALIGNMENT);
+	header.fileSize = header.submeshOffset + header.submeshCount * sizeof(MeshFileSubmesh);
+	header.bounds = ComputeMeshBounds(mesh);
+
+	std::ofstream out(path.c_str(), std::ios::binary | std::ios::trunc);
+	if (!out) {
+		ERROR("MeshFile", "write", ("Failed to create " + path).c_str());
+		return E_FAIL;
+	}
+	unsigned long long written = sizeof(MeshFileHeader);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(MeshFileHeader));
+	writePadding(out, written, header.vertexOffset);
+	out.write(reinterpret_cast<const char*>(mesh.m_vertex.data()), header.vertexCount * header.vertexStride);
+	written = header.vertexOffset + header.vertexCount * header.vertexStride;
+	writePadding(out, written, header.indexOffset);
+	if (header.indexStride == sizeof(unsigned short)) {
+		std::vector<unsigned short> compact(mesh.m_index.begin(), mesh.m_index.end());
+		out.write(reinterpret_cast<const char*>(compact.data()), header.indexCount * header.indexStride);
+	}
+	else {
+		out.write(reinterpret_cast<const char*>(mesh.m_index.data()), header.indexCount * header.indexStride);
+	}
+	written = header.indexOffset + header.indexCount * header.indexStride;
+	writePadding(out, written, header.submeshOffset);
+	out.write(reinterpret_cast<const char*>(sections.data()), sections.size() * sizeof(MeshFileSubmesh));
+	if (!out) {
+		ERROR("MeshFile", "write", ("Failed to write " + path).c_str());
+		return E_FAIL;
+	}
+	return S_OK;
+}
+
+bool
+MeshFile::validate(const void* data, size_t size) {
+	if (!data || size < sizeof(MeshFileHeader)) {
+		return false;
+	}
+	const MeshFileHeader& header = *static_cast<const MeshFileHeader*>(data);
+	return header.magic == MESH_FILE_MAGIC &&
+				 header.version == MESH_FILE_VERSION &&
+				 header.headerSize == sizeof(MeshFileHeader) &&
+				 header.vertexStride == sizeof(SimpleVertex) &&
+				 (header.indexStride == sizeof(unsigned short) || header.indexStride == sizeof(unsigned int)) &&
+				 header.fileSize <= size &&
+				 sectionFits(header.vertexOffset, static_cast<unsigned long long>(header.vertexCount) * header.vertexStride, size) &&
+				 sectionFits(header.indexOffset, static_cast<unsigned long long>(header.indexCount) * header.indexStride, size) &&
+				 sectionFits(header.submeshOffset, static_cast<unsigned long long>(header.submeshCount) * sizeof(MeshFileSubmesh), size);
+}
+
+HRESULT
+MeshFile::open(const std::string& path) {
+	close();
+	HRESULT hr = m_file.open(path);
+	if (FAILED(hr)) {
+		return hr;
+	}
+	if (!validate(m_file.data(), m_file.size())) {
+		ERROR("MeshFile", "open", ("Invalid or truncated mesh file " + path).c_str());
+		m_file.close();
+		return E_FAIL;
+	}
+	m_header = reinterpret_cast<const MeshFileHeader*>(m_file.data());
+	return S_OK;
+}
+
+void
+MeshFile::close() {
+	m_header = nullptr;
+	m_file.close();
+}
+
+const SimpleVertex*
+MeshFile::getVertices() const {
+	return reinterpret_cast<const SimpleVertex*>(m_file.data() + m_header->vertexOffset);
+}
+
+const void*
+MeshFile::getIndices() const {
+	return m_file.data() + m_header->indexOffset;
+}
+
+unsigned int
+MeshFile::getIndex(unsigned int i) const {
+	if (m_header->indexStride == sizeof(unsigned short)) {
+		return static_cast<const unsigned short*>(getIndices())[i];
+	}
+	return static_cast<const unsigned int*>(getIndices())[i];
+}
+
+const MeshFileSubmesh*
+MeshFile::getSubmeshes() const {
+	return reinterpret_cast<const MeshFileSubmesh*>(m_file.data() + m_header->submeshOffset);
+}
+
+HRESULT
+MeshFile::createBuffers(Device& device, Buffer& vertexBuffer, Buffer& indexBuffer) const {
+	if (!m_header) {
+		ERROR("MeshFile", "createBuffers", "Mesh file is not open");
+		return E_FAIL;
+	}
+	HRESULT hr = vertexBuffer.init(device, getVertices(), m_header->vertexCount,
+																 m_header->vertexStride, D3D11_BIND_VERTEX_BUFFER);
+	if (FAILED(hr)) {
+		return hr;
+	}
+	hr = indexBuffer.init(device, getIndices(), m_header->indexCount,
+												m_header->indexStride, D3D11_BIND_INDEX_BUFFER);
+	if (FAILED(hr)) {
+		vertexBuffer.destroy();
+	}
+	return hr;
+}
+
+void
+MeshFile::toMesh(MeshComponent& mesh) const {
+	if (!m_header) {
+		ERROR("MeshFile", "toMesh", "Mesh file is not open");
+		return;
+	}
+	mesh.m_vertex.assign(getVertices(), getVertices() + m_header->vertexCount);
+	mesh.m_index.resize(m_header->indexCount);
+	for (unsigned int i = 0; i < m_header->indexCount; ++i) {
+		mesh.m_index[i] = getIndex(i);
+	}
+	mesh.m_numVertex = static_cast<int>(m_header->vertexCount);
+	mesh.m_numIndex = static_cast<int>(m_header->indexCount);
+}
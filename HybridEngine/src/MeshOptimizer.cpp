@@ -0,0 +1,516 @@
+#include "MeshOptimizer.h"
+#include "MeshComponent.h"
+#include "MeshFile.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	// Parametros de Forsyth: cache LRU simulada y peso de la valencia
+	const unsigned int FORSYTH_CACHE_SIZE = 32;
+	const float CACHE_DECAY_POWER = 1.5f;
+	const float LAST_TRIANGLE_SCORE = 0.75f;
+	const float VALENCE_BOOST_SCALE = 2.0f;
+	const float VALENCE_BOOST_POWER = 0.5f;
+
+	const unsigned int INVALID_TRIANGLE = 0xffffffff;
+	const unsigned int OVERDRAW_RESOLUTION = 256;
+
+	float
+	vertexScore(int cachePosition, unsigned int remaining) {
+		if (remaining == 0) {
+			return -1.0f;
+		}
+		float score = 0.0f;
+		if (cachePosition >= 0) {
+			// Los 3 vertices del ultimo triangulo valen lo mismo para no favorecer tiras
+			if (cachePosition < 3) {
+				score = LAST_TRIANGLE_SCORE;
+			}
+			else {
+				float scale = 1.0f / (FORSYTH_CACHE_SIZE - 3);
+				score = powf(1.0f - (cachePosition - 3) * scale, CACHE_DECAY_POWER);
+			}
+		}
+		// Vertices con pocos triangulos pendientes se terminan primero
+		score += VALENCE_BOOST_SCALE * powf(static_cast<float>(remaining), -VALENCE_BOOST_POWER);
+		return score;
+	}
+
+	// Cache FIFO de vertices post-transform como la de la mayoria del hardware
+	class
+	FifoCache {
+	public:
+		FifoCache(size_t vertexCount, unsigned int size)
+			: m_stamps(vertexCount, 0), m_time(size + 1), m_size(size) {}
+
+		// true si v no estaba en la cache
+		bool
+		access(unsigned int v) {
+			if (m_time - m_stamps[v] > m_size) {
+				m_stamps[v] = m_time++;
+				return true;
+			}
+			return false;
+		}
+
+		void
+		reset() { m_time += m_size + 1; }
+
+	private:
+		std::vector<unsigned int> m_stamps;
+		unsigned int m_time;
+		unsigned int m_size;
+	};
+
+	unsigned int
+	triangleMisses(FifoCache& cache, const unsigned int* triangle) {
+		return (cache.access(triangle[0]) ? 1 : 0) +
+					 (cache.access(triangle[1]) ? 1 : 0) +
+					 (cache.access(triangle[2]) ? 1 : 0);
+	}
+
+	struct
+	Cluster {
+		unsigned int start;
+		unsigned int count;
+		float sortKey;
+	};
+}
+
+void
+OptimizeVertexCache(MeshComponent& mesh) {
+	const std::vector<unsigned int>& indices = mesh.m_index;
+	const unsigned int triangleCount = static_cast<unsigned int>(indices.size() / 3);
+	const unsigned int vertexCount = static_cast<unsigned int>(mesh.m_vertex.size());
+	if (triangleCount == 0) {
+		return;
+	}
+
+	// Triangulos por vertice; remaining[v] marca cuantos siguen vivos al
+	// inicio de su rango en adjacency
+	std::vector<unsigned int> remaining(vertexCount, 0);
+	for (size_t i = 0; i < indices.size(); ++i) {
+		remaining[indices[i]]++;
+	}
+	std::vector<unsigned int> offsets(vertexCount + 1, 0);
+	for (unsigned int v = 0; v < vertexCount; ++v) {
+		offsets[v + 1] = offsets[v] + remaining[v];
+	}
+	std::vector<unsigned int> adjacency(indices.size());
+	std::vector<unsigned int> cursor(offsets.begin(), offsets.end() - 1);
+	for (unsigned int t = 0; t < triangleCount; ++t) {
+		for (int k = 0; k < 3; ++k) {
+			adjacency[cursor[indices[t * 3 + k]]++] = t;
+		}
+	}
+
+	std::vector<int> cachePosition(vertexCount, -1);
+	std::vector<float> vertexScores(vertexCount);
+	for (unsigned int v = 0; v < vertexCount; ++v) {
+		vertexScores[v] = vertexScore(-1, remaining[v]);
+	}
+	std::vector<float> triangleScores(triangleCount);
+	std::vector<unsigned char> emitted(triangleCount, 0);
+	unsigned int best = 0;
+	for (unsigned int t = 0; t < triangleCount; ++t) {
+		triangleScores[t] = vertexScores[indices[t * 3]] +
+												vertexScores[indices[t * 3 + 1]] +
+												vertexScores[indices[t * 3 + 2]];
+		if (triangleScores[t] > triangleScores[best]) {
+			best = t;
+		}
+	}
+
+	std::vector<unsigned int> output;
+	output.reserve(indices.size());
+	unsigned int cache[FORSYTH_CACHE_SIZE + 3];
+	unsigned int cacheCount = 0;
+	unsigned int scan = 0;
+
+	for (unsigned int n = 0; n < triangleCount; ++n) {
+		if (best == INVALID_TRIANGLE) {
+			// Nada en la cache tiene triangulos pendientes: seguir con el siguiente
+			while (emitted[scan]) {
+				scan++;
+			}
+			best = scan;
+		}
+
+		const unsigned int* triangle = &indices[best * 3];
+		emitted[best] = 1;
+		output.insert(output.end(), triangle, triangle + 3);
+
+		// Sacar el triangulo de la lista viva de sus vertices
+		for (int k = 0; k < 3; ++k) {
+			unsigned int v = triangle[k];
+			unsigned int* list = &adjacency[offsets[v]];
+			for (unsigned int i = 0; i < remaining[v]; ++i) {
+				if (list[i] == best) {
+					list[i] = list[remaining[v] - 1];
+					remaining[v]--;
+					break;
+				}
+			}
+		}
+
+		// LRU: los vertices del triangulo al frente, el resto se corre
+		unsigned int next[FORSYTH_CACHE_SIZE + 3];
+		unsigned int nextCount = 0;
+		for (int k = 0; k < 3; ++k) {
+			if (std::find(next, next + nextCount, triangle[k]) == next + nextCount) {
+				next[nextCount++] = triangle[k];
+			}
+		}
+		for (unsigned int i = 0; i < cacheCount; ++i) {
+			if (std::find(next, next + nextCount, cache[i]) == next + nextCount) {
+				next[nextCount++] = cache[i];
+			}
+		}
+		for (unsigned int i = 0; i < nextCount; ++i) {
+			unsigned int v = next[i];
+			cachePosition[v] = i < FORSYTH_CACHE_SIZE ? static_cast<int>(i) : -1;
+			vertexScores[v] = vertexScore(cachePosition[v], remaining[v]);
+		}
+
+		// Solo cambian los triangulos que tocan la cache
+		best = INVALID_TRIANGLE;
+		float bestScore = -1.0f;
+		for (unsigned int i = 0; i < nextCount; ++i) {
+			unsigned int v = next[i];
+			const unsigned int* list = &adjacency[offsets[v]];
+			for (unsigned int j = 0; j < remaining[v]; ++j) {
+				unsigned int t = list[j];
+				triangleScores[t] = vertexScores[indices[t * 3]] +
+														vertexScores[indices[t * 3 + 1]] +
+														vertexScores[indices[t * 3 + 2]];
+				if (triangleScores[t] > bestScore) {
+					bestScore = triangleScores[t];
+					best = t;
+				}
+			}
+		}
+
+		cacheCount = nextCount < FORSYTH_CACHE_SIZE ? nextCount : FORSYTH_CACHE_SIZE;
+		std::copy(next, next + cacheCount, cache);
+	}
+
+	mesh.m_index.swap(output);
+}
+
+void
+OptimizeOverdraw(MeshComponent& mesh, float threshold) {
+	const std::vector<unsigned int>& indices = mesh.m_index;
+	const unsigned int triangleCount = static_cast<unsigned int>(indices.size() / 3);
+	if (triangleCount < 2) {
+		return;
+	}
+
+	// Limites duros: triangulos con 3 fallos, donde el orden de cache ya se corta
+	FifoCache cache(mesh.m_vertex.size(), MESH_CACHE_SIZE);
+	std::vector<unsigned int> hard;
+	for (unsigned int t = 0; t < triangleCount; ++t) {
+		if (triangleMisses(cache, &indices[t * 3]) == 3 || t == 0) {
+			hard.push_back(t);
+		}
+	}
+	hard.push_back(triangleCount);
+
+	// Limites blandos: dentro de cada cluster duro se corta en cuanto el ACMR
+	// acumulado (con cache fria) ya no empeora mas de threshold
+	std::vector<Cluster> clusters;
+	for (size_t h = 0; h + 1 < hard.size(); ++h) {
+		unsigned int begin = hard[h];
+		unsigned int end = hard[h + 1];
+
+		cache.reset();
+		unsigned int hardMisses = 0;
+		for (unsigned int t = begin; t < end; ++t) {
+			hardMisses += triangleMisses(cache, &indices[t * 3]);
+		}
+		float hardAcmr = static_cast<float>(hardMisses) / (end - begin);
+
+		cache.reset();
+		unsigned int start = begin;
+		unsigned int misses = 0;
+		for (unsigned int t = begin; t < end; ++t) {
+			misses += triangleMisses(cache, &indices[t * 3]);
+			float acmr = static_cast<float>(misses) / (t - start + 1);
+			if (t + 1 < end && acmr <= threshold * hardAcmr) {
+				Cluster cluster = { start, t + 1 - start, 0.0f };
+				clusters.push_back(cluster);
+				start = t + 1;
+				misses = 0;
+				cache.reset();
+			}
+		}
+		Cluster cluster = { start, end - start, 0.0f };
+		clusters.push_back(cluster);
+	}
+
+	// Centroide de la malla y de cada cluster, pesados por area
+	std::vector<XMFLOAT3> centroids(clusters.size());
+	std::vector<XMFLOAT3> normals(clusters.size());
+	float meshCentroid[3] = { 0.0f, 0.0f, 0.0f };
+	float meshArea = 0.0f;
+	for (size_t c = 0; c < clusters.size(); ++c) {
+		float centroid[3] = { 0.0f, 0.0f, 0.0f };
+		float normal[3] = { 0.0f, 0.0f, 0.0f };
+		float area = 0.0f;
+		for (unsigned int t = clusters[c].start; t < clusters[c].start + clusters[c].count; ++t) {
+			const XMFLOAT3& a = mesh.m_vertex[indices[t * 3]].Pos;
+			const XMFLOAT3& b = mesh.m_vertex[indices[t * 3 + 1]].Pos;
+			const XMFLOAT3& d = mesh.m_vertex[indices[t * 3 + 2]].Pos;
+			float e1[3] = { b.x - a.x, b.y - a.y, b.z - a.z };
+			float e2[3] = { d.x - a.x, d.y - a.y, d.z - a.z };
+			float n[3] = { e1[1] * e2[2] - e1[2] * e2[1],
+										 e1[2] * e2[0] - e1[0] * e2[2],
+										 e1[0] * e2[1] - e1[1] * e2[0] };
+			float triangleArea = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+			centroid[0] += (a.x + b.x + d.x) * triangleArea;
+			centroid[1] += (a.y + b.y + d.y) * triangleArea;
+			centroid[2] += (a.z + b.z + d.z) * triangleArea;
+			normal[0] += n[0];
+			normal[1] += n[1];
+			normal[2] += n[2];
+			area += triangleArea;
+		}
+		meshCentroid[0] += centroid[0];
+		meshCentroid[1] += centroid[1];
+		meshCentroid[2] += centroid[2];
+		meshArea += area;
+		float inv = area > 0.0f ? 1.0f / (3.0f * area) : 0.0f;
+		centroids[c] = XMFLOAT3(centroid[0] * inv, centroid[1] * inv, centroid[2] * inv);
+		float length = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+		float invLength = length > 0.0f ? 1.0f / length : 0.0f;
+		normals[c] = XMFLOAT3(normal[0] * invLength, normal[1] * invLength, normal[2] * invLength);
+	}
+	float invMeshArea = meshArea > 0.0f ? 1.0f / (3.0f * meshArea) : 0.0f;
+	meshCentroid[0] *= invMeshArea;
+	meshCentroid[1] *= invMeshArea;
+	meshCentroid[2] *= invMeshArea;
+
+	// Los clusters mas hacia afuera en la direccion de su normal tapan a los
+	// demas desde la mayoria de las vistas: van primero
+	for (size_t c = 0; c < clusters.size(); ++c) {
+		clusters[c].sortKey = (centroids[c].x - meshCentroid[0]) * normals[c].x +
+													(centroids[c].y - meshCentroid[1]) * normals[c].y +
+													(centroids[c].z - meshCentroid[2]) * normals[c].z;
+	}
+	std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& a, const Cluster& b) {
+		return a.sortKey > b.sortKey;
+	});
+
+	std::vector<unsigned int> output;
+	output.reserve(indices.size());
+	for (size_t c = 0; c < clusters.size(); ++c) {
+		const unsigned int* first = &indices[clusters[c].start * 3];
+		output.insert(output.end(), first, first + clusters[c].count * 3);
+	}
+	mesh.m_index.swap(output);
+}
+
+void
+OptimizeVertexFetch(MeshComponent& mesh) {
+	const unsigned int unused = 0xffffffff;
+	std::vector<unsigned int> remap(mesh.m_vertex.size(), unused);
+	std::vector<SimpleVertex> vertices;
+	vertices.reserve(mesh.m_vertex.size());
+	for (size_t i = 0; i < mesh.m_index.size(); ++i) {
+		unsigned int& slot = remap[mesh.m_index[i]];
+		if (slot == unused) {
+			slot = static_cast<unsigned int>(vertices.size());
+			vertices.push_back(mesh.m_vertex[mesh.m_index[i]]);
+		}
+		mesh.m_index[i] = slot;
+	}
+	mesh.m_vertex.swap(vertices);
+	mesh.m_numVertex = static_cast<int>(mesh.m_vertex.size());
+	mesh.m_numIndex = static_cast<int>(mesh.m_index.size());
+}
+
+void
+OptimizeMesh(MeshComponent& mesh, float overdrawThreshold) {
+	OptimizeVertexCache(mesh);
+	OptimizeOverdraw(mesh, overdrawThreshold);
+	OptimizeVertexFetch(mesh);
+}
+
+void
+SplitMeshFor16BitIndices(MeshComponent& mesh, std::vector<MeshFileSubmesh>& submeshes) {
+	const unsigned int limit = 0x10000;
+	const unsigned int unmapped = 0xffffffff;
+	submeshes.clear();
+
+	MeshFileSubmesh current = {};
+	if (mesh.m_vertex.size() <= limit) {
+		current.indexCount = static_cast<unsigned int>(mesh.m_index.size());
+		submeshes.push_back(current);
+		return;
+	}
+
+	// Se recorren los triangulos en orden (conserva el orden de cache) y se
+	// cierra el submesh cuando el siguiente triangulo ya no cabe
+	std::vector<unsigned int> local(mesh.m_vertex.size(), unmapped);
+	std::vector<unsigned int> touched;
+	touched.reserve(limit);
+	std::vector<SimpleVertex> vertices;
+	vertices.reserve(mesh.m_vertex.size());
+	std::vector<unsigned int> indices;
+	indices.reserve(mesh.m_index.size());
+
+	for (size_t t = 0; t + 2 < mesh.m_index.size(); t += 3) {
+		const unsigned int* triangle = &mesh.m_index[t];
+		unsigned int added = 0;
+		for (int k = 0; k < 3; ++k) {
+			bool repeated = (k > 0 && triangle[k] == triangle[0]) || (k > 1 && triangle[k] == triangle[1]);
+			if (local[triangle[k]] == unmapped && !repeated) {
+				added++;
+			}
+		}
+		if (touched.size() + added > limit) {
+			current.indexCount = static_cast<unsigned int>(indices.size()) - current.indexStart;
+			submeshes.push_back(current);
+			for (size_t i = 0; i < touched.size(); ++i) {
+				local[touched[i]] = unmapped;
+			}
+			touched.clear();
+			current.indexStart = static_cast<unsigned int>(indices.size());
+			current.baseVertex = static_cast<unsigned int>(vertices.size());
+		}
+		for (int k = 0; k < 3; ++k) {
+			unsigned int v = triangle[k];
+			if (local[v] == unmapped) {
+				local[v] = static_cast<unsigned int>(touched.size());
+				touched.push_back(v);
+				vertices.push_back(mesh.m_vertex[v]);
+			}
+			indices.push_back(local[v]);
+		}
+	}
+	current.indexCount = static_cast<unsigned int>(indices.size()) - current.indexStart;
+	submeshes.push_back(current);
+
+	mesh.m_vertex.swap(vertices);
+	mesh.m_index.swap(indices);
+	mesh.m_numVertex = static_cast<int>(mesh.m_vertex.size());
+	mesh.m_numIndex = static_cast<int>(mesh.m_index.size());
+}
+
+MeshOptimizationMetrics
+AnalyzeMesh(const MeshComponent& mesh) {
+	MeshOptimizationMetrics metrics;
+	const std::vector<unsigned int>& indices = mesh.m_index;
+	const unsigned int triangleCount = static_cast<unsigned int>(indices.size() / 3);
+	if (triangleCount == 0) {
+		return metrics;
+	}
+
+	// --- Cache post-transform ---
+	FifoCache cache(mesh.m_vertex.size(), MESH_CACHE_SIZE);
+	unsigned int misses = 0;
+	for (unsigned int t = 0; t < triangleCount; ++t) {
+		misses += triangleMisses(cache, &indices[t * 3]);
+	}
+	std::vector<unsigned char> used(mesh.m_vertex.size(), 0);
+	unsigned int usedCount = 0;
+	for (size_t i = 0; i < indices.size(); ++i) {
+		if (!used[indices[i]]) {
+			used[indices[i]] = 1;
+			usedCount++;
+		}
+	}
+	metrics.acmr = static_cast<float>(misses) / triangleCount;
+	metrics.atvr = static_cast<float>(misses) / usedCount;
+
+	// --- Overdraw: raster ortografico desde +-X, +-Y, +-Z con prueba LESS ---
+	float minimum[3] = { 1e30f, 1e30f, 1e30f };
+	float maximum[3] = { -1e30f, -1e30f, -1e30f };
+	for (size_t v = 0; v < mesh.m_vertex.size(); ++v) {
+		const float p[3] = { mesh.m_vertex[v].Pos.x, mesh.m_vertex[v].Pos.y, mesh.m_vertex[v].Pos.z };
+		for (int k = 0; k < 3; ++k) {
+			minimum[k] = p[k] < minimum[k] ? p[k] : minimum[k];
+			maximum[k] = p[k] > maximum[k] ? p[k] : maximum[k];
+		}
+	}
+	float extent = 0.0f;
+	for (int k = 0; k < 3; ++k) {
+		extent = maximum[k] - minimum[k] > extent ? maximum[k] - minimum[k] : extent;
+	}
+	float toPixels = extent > 0.0f ? (OVERDRAW_RESOLUTION - 1) / extent : 0.0f;
+
+	std::vector<float> depth(OVERDRAW_RESOLUTION * OVERDRAW_RESOLUTION);
+	unsigned long long covered = 0;
+	unsigned long long shaded = 0;
+	for (int view = 0; view < 6; ++view) {
+		const int axis = view >> 1;
+		const float sign = (view & 1) ? -1.0f : 1.0f;
+		const int uAxis = (axis + 1) % 3;
+		const int vAxis = (axis + 2) % 3;
+		std::fill(depth.begin(), depth.end(), 1e30f);
+
+		for (unsigned int t = 0; t < triangleCount; ++t) {
+			float x[3], y[3], z[3];
+			for (int k = 0; k < 3; ++k) {
+				const XMFLOAT3& pos = mesh.m_vertex[indices[t * 3 + k]].Pos;
+				const float p[3] = { pos.x, pos.y, pos.z };
+				x[k] = (p[uAxis] - minimum[uAxis]) * toPixels;
+				y[k] = (p[vAxis] - minimum[vAxis]) * toPixels;
+				z[k] = p[axis] * sign;
+			}
+			// Cara trasera (normal de mano izquierda alejandose de la vista): se descarta
+			// como lo haria el rasterizador con el culling por defecto
+			const XMFLOAT3& a = mesh.m_vertex[indices[t * 3]].Pos;
+			const XMFLOAT3& b = mesh.m_vertex[indices[t * 3 + 1]].Pos;
+			const XMFLOAT3& c = mesh.m_vertex[indices[t * 3 + 2]].Pos;
+			const float e1[3] = { b.x - a.x, b.y - a.y, b.z - a.z };
+			const float e2[3] = { c.x - a.x, c.y - a.y, c.z - a.z };
+			const float normal[3] = { e1[1] * e2[2] - e1[2] * e2[1],
+																e1[2] * e2[0] - e1[0] * e2[2],
+																e1[0] * e2[1] - e1[1] * e2[0] };
+			if (normal[axis] * sign >= 0.0f) {
+				continue;
+			}
+
+			float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+			if (fabsf(area) < 1e-12f) {
+				continue;
+			}
+			float invArea = 1.0f / area;
+
+			int x0 = static_cast<int>(floorf(std::min(x[0], std::min(x[1], x[2]))));
+			int x1 = static_cast<int>(ceilf(std::max(x[0], std::max(x[1], x[2]))));
+			int y0 = static_cast<int>(floorf(std::min(y[0], std::min(y[1], y[2]))));
+			int y1 = static_cast<int>(ceilf(std::max(y[0], std::max(y[1], y[2]))));
+			x0 = std::max(x0, 0);
+			y0 = std::max(y0, 0);
+			x1 = std::min(x1, static_cast<int>(OVERDRAW_RESOLUTION) - 1);
+			y1 = std::min(y1, static_cast<int>(OVERDRAW_RESOLUTION) - 1);
+
+			for (int py = y0; py <= y1; ++py) {
+				for (int px = x0; px <= x1; ++px) {
+					float cx = px + 0.5f;
+					float cy = py + 0.5f;
+					// Baricentricas normalizadas por el area con signo (la orientacion
+					// en pantalla depende del eje)
+					float w0 = ((x[2] - x[1]) * (cy - y[1]) - (y[2] - y[1]) * (cx - x[1])) * invArea;
+					float w1 = ((x[0] - x[2]) * (cy - y[2]) - (y[0] - y[2]) * (cx - x[2])) * invArea;
+					float w2 = 1.0f - w0 - w1;
+					if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) {
+						continue;
+					}
+					float d = w0 * z[0] + w1 * z[1] + w2 * z[2];
+					float& stored = depth[py * OVERDRAW_RESOLUTION + px];
+					if (d < stored) {
+						if (stored == 1e30f) {
+							covered++;
+						}
+						stored = d;
+						shaded++;
+					}
+				}
+			}
+		}
+	}
+	metrics.overdraw = covered > 0 ? static_cast<float>(shaded) / covered : 0.0f;
+	return metrics;
+}
@@ -0,0 +1,612 @@
+#include "MeshSimplifier.h"
+#include "MeshComponent.h"
+#include "Bounds.h"
+#include "MathConversions.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+	const unsigned int INVALID_VERTEX = 0xffffffff;
+	const unsigned int COMPLEX_EDGE = 0xfffffffe;   // Mas de una arista abierta
+	const unsigned int ATTRIBUTES = 5;               // x, y, z, u, v
+	const float BORDER_WEIGHT = 10.0f;
+
+	enum
+	VertexKind {
+		KIND_MANIFOLD = 0,   // Interior: puede ir a cualquier vecino
+		KIND_BORDER,         // Borde abierto: solo a lo largo del borde
+		KIND_SEAM,           // Costura de UV (2 wedges): solo a lo largo de la costura
+		KIND_LOCKED
+	};
+
+	// Cuadrica simetrica en 5D: e(p) = p^T A p + 2 b^T p + c, ponderada por area
+	struct
+	Quadric {
+		double a[15];   // Triangulo superior de A por filas
+		double b[ATTRIBUTES];
+		double c;
+		double weight;
+	};
+
+	inline unsigned int
+	upper(unsigned int i, unsigned int j) {
+		// Fila i del triangulo superior empieza en i * 5 - i * (i - 1) / 2
+		return i * ATTRIBUTES - i * (i - 1) / 2 + (j - i);
+	}
+
+	void
+	clear(Quadric& q) {
+		memset(&q, 0, sizeof(q));
+	}
+
+	void
+	accumulate(Quadric& q, const Quadric& other) {
+		for (unsigned int k = 0; k < 15; ++k) {
+			q.a[k] += other.a[k];
+		}
+		for (unsigned int k = 0; k < ATTRIBUTES; ++k) {
+			q.b[k] += other.b[k];
+		}
+		q.c += other.c;
+		q.weight += other.weight;
+	}
+
+	double
+	evaluate(const Quadric& q, const float* p) {
+		double result = q.c;
+		for (unsigned int i = 0; i < ATTRIBUTES; ++i) {
+			result += q.a[upper(i, i)] * p[i] * p[i] + 2.0 * q.b[i] * p[i];
+			for (unsigned int j = i + 1; j < ATTRIBUTES; ++j) {
+				result += 2.0 * q.a[upper(i, j)] * p[i] * p[j];
+			}
+		}
+		return result > 0.0 ? result : 0.0;
+	}
+
+	// Garland-Heckbert generalizado: distancia al cuadrado al plano del
+	// triangulo en el espacio posicion + atributos
+	void
+	triangleQuadric(Quadric& q, const float* p0, const float* p1, const float* p2, double area) {
+		clear(q);
+		double e1[ATTRIBUTES], e2[ATTRIBUTES];
+		double length1 = 0.0;
+		for (unsigned int k = 0; k < ATTRIBUTES; ++k) {
+			e1[k] = p1[k] - p0[k];
+			length1 += e1[k] * e1[k];
+		}
+		if (length1 <= 0.0 || area <= 0.0) {
+			return;
+		}
+		length1 = sqrt(length1);
+		double dot = 0.0;
+		for (unsigned int k = 0; k < ATTRIBUTES; ++k) {
+			e1[k] /= length1;
+			dot += e1[k] * (p2[k] - p0[k]);
+		}
+		double length2 = 0.0;
+		for (unsigned int k = 0; k < ATTRIBUTES; ++k) {
+			e2[k] = p2[k] - p0[k] - dot * e1[k];
+			length2 += e2[k] * e2[k];
+		}
+		if (length2 <= 0.0) {
+			return;
+		}
+		length2 = sqrt(length2);
+		double p0e1 = 0.0, p0e2 = 0.0, p0p0 = 0.0;
+		for (unsigned int k = 0; k < ATTRIBUTES; ++k) {
+			e2[k] /= length2;
+			p0e1 += p0[k] * e1[k];
+			p0e2 += p0[k] * e2[k];
+			p0p0 += static_cast<double>(p0[k]) * p0[k];
+		}
+		for (unsigned int i = 0; i < ATTRIBUTES; ++i) {
+			for (unsigned int j = i; j < ATTRIBUTES; ++j) {
+				q.a[upper(i, j)] = area * ((i == j ? 1.0 : 0.0) - e1[i] * e1[j] - e2[i] * e2[j]);
+			}
+			q.b[i] = area * (p0e1 * e1[i] + p0e2 * e2[i] - p0[i]);
+		}
+		q.c = area * (p0p0 - p0e1 * p0e1 - p0e2 * p0e2);
+		q.weight = area;
+	}
+
+	// Plano que contiene la arista a-b y es perpendicular al triangulo; evita
+	// que los bordes se encojan cuando no estan bloqueados
+	void
+	borderQuadric(Quadric& q, const float* a, const float* b, const float* normal, double weight) {
+		clear(q);
+		double edge[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+		double m[3] = { edge[1] * normal[2] - edge[2] * normal[1],
+										edge[2] * normal[0] - edge[0] * normal[2],
+										edge[0] * normal[1] - edge[1] * normal[0] };
+		double length = sqrt(m[0] * m[0] + m[1] * m[1] + m[2] * m[2]);
+		if (length <= 0.0) {
+			return;
+		}
+		for (unsigned int k = 0; k < 3; ++k) {
+			m[k] /= length;
+		}
+		double d = -(m[0] * a[0] + m[1] * a[1] + m[2] * a[2]);
+		for (unsigned int i = 0; i < 3; ++i) {
+			for (unsigned int j = i; j < 3; ++j) {
+				q.a[upper(i, j)] = weight * m[i] * m[j];
+			}
+			q.b[i] = weight * m[i] * d;
+		}
+		q.c = weight * d * d;
+		q.weight = weight;
+	}
+
+	void
+	cross(const float* a, const float* b, const float* c, float* n) {
+		float u[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+		float v[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+		n[0] = u[1] * v[2] - u[2] * v[1];
+		n[1] = u[2] * v[0] - u[0] * v[2];
+		n[2] = u[0] * v[1] - u[1] * v[0];
+	}
+
+	struct
+	Collapse {
+		unsigned int from;
+		unsigned int to;
+		unsigned int siblingFrom;   // INVALID_VERTEX si no es costura
+		unsigned int siblingTo;
+		float cost;
+	};
+
+	// Topologia de la lista de indices actual: triangulos por vertice y
+	// aristas abiertas (sin la arista opuesta a nivel de vertice)
+	class
+	Topology {
+	public:
+		void
+		build(const std::vector<unsigned int>& indices, unsigned int vertexCount) {
+			offsets.assign(vertexCount + 1, 0);
+			for (size_t i = 0; i < indices.size(); ++i) {
+				offsets[indices[i] + 1]++;
+			}
+			for (unsigned int v = 0; v < vertexCount; ++v) {
+				offsets[v + 1] += offsets[v];
+			}
+			triangles.resize(indices.size());
+			std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+			for (size_t i = 0; i < indices.size(); ++i) {
+				triangles[fill[indices[i]]++] = static_cast<unsigned int>(i / 3);
+			}
+
+			openOut.assign(vertexCount, INVALID_VERTEX);
+			openIn.assign(vertexCount, INVALID_VERTEX);
+			for (size_t t = 0; t < indices.size(); t += 3) {
+				for (unsigned int k = 0; k < 3; ++k) {
+					unsigned int a = indices[t + k];
+					unsigned int b = indices[t + (k + 1) % 3];
+					if (!hasEdge(indices, b, a)) {
+						openOut[a] = openOut[a] == INVALID_VERTEX || openOut[a] == b ? b : COMPLEX_EDGE;
+						openIn[b] = openIn[b] == INVALID_VERTEX || openIn[b] == a ? a : COMPLEX_EDGE;
+					}
+				}
+			}
+		}
+
+		// true si algun triangulo tiene la arista dirigida a -> b
+		bool
+		hasEdge(const std::vector<unsigned int>& indices, unsigned int a, unsigned int b) const {
+			for (unsigned int i = offsets[a]; i < offsets[a + 1]; ++i) {
+				unsigned int t = triangles[i] * 3;
+				for (unsigned int k = 0; k < 3; ++k) {
+					if (indices[t + k] == a && indices[t + (k + 1) % 3] == b) {
+						return true;
+					}
+				}
+			}
+			return false;
+		}
+
+		unsigned int
+		triangleCount(unsigned int v) const { return offsets[v + 1] - offsets[v]; }
+
+		std::vector<unsigned int> offsets;
+		std::vector<unsigned int> triangles;
+		std::vector<unsigned int> openOut;
+		std::vector<unsigned int> openIn;
+	};
+
+	// Otro wedge vivo de la misma posicion, o INVALID_VERTEX (o COMPLEX_EDGE si hay mas de dos)
+	unsigned int
+	liveSibling(unsigned int v, const std::vector<unsigned int>& wedge, const Topology& topology) {
+		unsigned int sibling = INVALID_VERTEX;
+		for (unsigned int w = wedge[v]; w != v; w = wedge[w]) {
+			if (topology.triangleCount(w) == 0) {
+				continue;
+			}
+			if (sibling != INVALID_VERTEX) {
+				return COMPLEX_EDGE;
+			}
+			sibling = w;
+		}
+		return sibling;
+	}
+
+	void
+	classify(const std::vector<unsigned int>& wedge,
+					 const std::vector<unsigned int>& positionId,
+					 const Topology& topology,
+					 bool lockBorders,
+					 std::vector<unsigned char>& kind,
+					 std::vector<unsigned int>& sibling) {
+		const unsigned int vertexCount = static_cast<unsigned int>(wedge.size());
+		for (unsigned int v = 0; v < vertexCount; ++v) {
+			sibling[v] = INVALID_VERTEX;
+			kind[v] = KIND_LOCKED;
+			if (topology.triangleCount(v) == 0) {
+				continue;
+			}
+			unsigned int in = topology.openIn[v];
+			unsigned int out = topology.openOut[v];
+			unsigned int other = liveSibling(v, wedge, topology);
+			if (other == INVALID_VERTEX) {
+				if (in == INVALID_VERTEX && out == INVALID_VERTEX) {
+					kind[v] = KIND_MANIFOLD;
+				}
+				else if (!lockBorders && in < COMPLEX_EDGE && out < COMPLEX_EDGE) {
+					kind[v] = KIND_BORDER;
+				}
+			}
+			else if (other != COMPLEX_EDGE) {
+				// Costura: cada wedge tiene un borde abierto y los dos lados
+				// recorren las mismas posiciones en sentido contrario
+				unsigned int otherIn = topology.openIn[other];
+				unsigned int otherOut = topology.openOut[other];
+				if (in < COMPLEX_EDGE && out < COMPLEX_EDGE && otherIn < COMPLEX_EDGE && otherOut < COMPLEX_EDGE &&
+						positionId[in] == positionId[otherOut] && positionId[out] == positionId[otherIn]) {
+					kind[v] = KIND_SEAM;
+					sibling[v] = other;
+				}
+			}
+		}
+	}
+
+	// Rechaza el colapso si algun triangulo de from (que no se degenera) gira demasiado
+	bool
+	flips(unsigned int from, unsigned int to,
+				const std::vector<unsigned int>& indices,
+				const Topology& topology,
+				const std::vector<float>& attributes) {
+		const float* target = &attributes[to * ATTRIBUTES];
+		for (unsigned int i = topology.offsets[from]; i < topology.offsets[from + 1]; ++i) {
+			unsigned int t = topology.triangles[i] * 3;
+			unsigned int a = indices[t], b = indices[t + 1], c = indices[t + 2];
+			if (a == to || b == to || c == to) {
+				continue;
+			}
+			const float* p[3] = { &attributes[a * ATTRIBUTES], &attributes[b * ATTRIBUTES], &attributes[c * ATTRIBUTES] };
+			float before[3], after[3];
+			cross(p[0], p[1], p[2], before);
+			p[a == from ? 0 : (b == from ? 1 : 2)] = target;
+			cross(p[0], p[1], p[2], after);
+			float dot = before[0] * after[0] + before[1] * after[1] + before[2] * after[2];
+			float lengths = sqrtf((before[0] * before[0] + before[1] * before[1] + before[2] * before[2]) *
+														(after[0] * after[0] + after[1] * after[1] + after[2] * after[2]));
+			if (dot <= 0.25f * lengths) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Triangulos que comparten from y to (los que desaparecen con el colapso)
+	unsigned int
+	sharedTriangles(unsigned int from, unsigned int to,
+									const std::vector<unsigned int>& indices,
+									const Topology& topology) {
+		unsigned int shared = 0;
+		for (unsigned int i = topology.offsets[from]; i < topology.offsets[from + 1]; ++i) {
+			unsigned int t = topology.triangles[i] * 3;
+			if (indices[t] == to || indices[t + 1] == to || indices[t + 2] == to) {
+				shared++;
+			}
+		}
+		return shared;
+	}
+
+	void
+	lockRing(unsigned int v,
+					 const std::vector<unsigned int>& indices,
+					 const Topology& topology,
+					 std::vector<unsigned char>& locked) {
+		locked[v] = 1;
+		for (unsigned int i = topology.offsets[v]; i < topology.offsets[v + 1]; ++i) {
+			unsigned int t = topology.triangles[i] * 3;
+			locked[indices[t]] = 1;
+			locked[indices[t + 1]] = 1;
+			locked[indices[t + 2]] = 1;
+		}
+	}
+}
+
+float
+SimplifyMesh(const MeshComponent& mesh,
+						 std::vector<unsigned int>& indices,
+						 unsigned int targetIndexCount,
+						 const MeshSimplifyOptions& options) {
+	const unsigned int vertexCount = static_cast<unsigned int>(mesh.m_vertex.size());
+	targetIndexCount -= targetIndexCount % 3;
+	if (indices.size() <= targetIndexCount || vertexCount == 0) {
+		return 0.0f;
+	}
+
+	// Posicion normalizada a la caja unitaria para que uvWeight sea independiente de la escala
+	Bounds bounds = ComputeMeshBounds(mesh);
+	float size = 2.0f * std::max(bounds.extents.x, std::max(bounds.extents.y, bounds.extents.z));
+	float scale = size > 0.0f ? 1.0f / size : 1.0f;
+	std::vector<float> attributes(vertexCount * ATTRIBUTES);
+	for (unsigned int v = 0; v < vertexCount; ++v) {
+		const SimpleVertex& vertex = mesh.m_vertex[v];
+		float* a = &attributes[v * ATTRIBUTES];
+		a[0] = (vertex.Pos.x - bounds.center.x) * scale;
+		a[1] = (vertex.Pos.y - bounds.center.y) * scale;
+		a[2] = (vertex.Pos.z - bounds.center.z) * scale;
+		a[3] = vertex.Tex.x * options.uvWeight;
+		a[4] = vertex.Tex.y * options.uvWeight;
+	}
+
+	// Vertices con la misma posicion (wedges) en una lista circular
+	std::vector<unsigned int> order(vertexCount);
+	for (unsigned int v = 0; v < vertexCount; ++v) {
+		order[v] = v;
+	}
+	std::sort(order.begin(), order.end(), [&mesh](unsigned int a, unsigned int b) {
+		const XMFLOAT3& pa = mesh.m_vertex[a].Pos;
+		const XMFLOAT3& pb = mesh.m_vertex[b].Pos;
+		if (pa.x != pb.x) return pa.x < pb.x;
+		if (pa.y != pb.y) return pa.y < pb.y;
+		if (pa.z != pb.z) return pa.z < pb.z;
+		return a < b;
+	});
+	std::vector<unsigned int> positionId(vertexCount);
+	std::vector<unsigned int> wedge(vertexCount);
+	for (unsigned int begin = 0; begin < vertexCount;) {
+		unsigned int end = begin + 1;
+		const XMFLOAT3& p = mesh.m_vertex[order[begin]].Pos;
+		while (end < vertexCount && mesh.m_vertex[order[end]].Pos.x == p.x &&
+					 mesh.m_vertex[order[end]].Pos.y == p.y && mesh.m_vertex[order[end]].Pos.z == p.z) {
+			end++;
+		}
+		for (unsigned int i = begin; i < end; ++i) {
+			positionId[order[i]] = order[begin];
+			wedge[order[i]] = order[i + 1 < end ? i + 1 : begin];
+		}
+		begin = end;
+	}
+
+	// Cuadricas iniciales por vertice
+	Topology topology;
+	topology.build(indices, vertexCount);
+	std::vector<Quadric> quadrics(vertexCount);
+	for (unsigned int v = 0; v < vertexCount; ++v) {
+		clear(quadrics[v]);
+	}
+	for (size_t t = 0; t < indices.size(); t += 3) {
+		const float* p[3] = { &attributes[indices[t] * ATTRIBUTES],
+													&attributes[indices[t + 1] * ATTRIBUTES],
+													&attributes[indices[t + 2] * ATTRIBUTES] };
+		float normal[3];
+		cross(p[0], p[1], p[2], normal);
+		float area = 0.5f * sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+		Quadric q;
+		triangleQuadric(q, p[0], p[1], p[2], area);
+		for (unsigned int k = 0; k < 3; ++k) {
+			accumulate(quadrics[indices[t + k]], q);
+		}
+		if (options.lockBorders) {
+			continue;
+		}
+		for (unsigned int k = 0; k < 3; ++k) {
+			unsigned int a = indices[t + k];
+			unsigned int b = indices[t + (k + 1) % 3];
+			if (topology.openOut[a] != INVALID_VERTEX && !topology.hasEdge(indices, b, a)) {
+				const float* pa = &attributes[a * ATTRIBUTES];
+				const float* pb = &attributes[b * ATTRIBUTES];
+				float edge[3] = { pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2] };
+				Quadric border;
+				borderQuadric(border, pa, pb, normal, BORDER_WEIGHT * (edge[0] * edge[0] + edge[1] * edge[1] + edge[2] * edge[2]));
+				accumulate(quadrics[a], border);
+				accumulate(quadrics[b], border);
+			}
+		}
+	}
+
+	const double maxCost = static_cast<double>(options.maxError) * scale * options.maxError * scale;
+	std::vector<unsigned char> kind(vertexCount);
+	std::vector<unsigned int> sibling(vertexCount);
+	std::vector<unsigned char> locked(vertexCount);
+	std::vector<unsigned int> collapseTo(vertexCount);
+	std::vector<Collapse> candidates;
+	double worstCost = 0.0;
+
+	while (indices.size() > targetIndexCount) {
+		classify(wedge, positionId, topology, options.lockBorders, kind, sibling);
+
+		// Una arista por triangulo y lado; se guarda la direccion mas barata
+		candidates.clear();
+		for (size_t t = 0; t < indices.size(); t += 3) {
+			for (unsigned int k = 0; k < 3; ++k) {
+				unsigned int a = indices[t + k];
+				unsigned int b = indices[t + (k + 1) % 3];
+				if (a > b && topology.hasEdge(indices, b, a)) {
+					continue;
+				}
+				Collapse best = { INVALID_VERTEX, INVALID_VERTEX, INVALID_VERTEX, INVALID_VERTEX, 0.0f };
+				for (unsigned int direction = 0; direction < 2; ++direction) {
+					unsigned int from = direction == 0 ? a : b;
+					unsigned int to = direction == 0 ? b : a;
+					unsigned int siblingFrom = INVALID_VERTEX;
+					unsigned int siblingTo = INVALID_VERTEX;
+					if (kind[from] == KIND_LOCKED) {
+						continue;
+					}
+					if (kind[from] != KIND_MANIFOLD && to != topology.openOut[from] && to != topology.openIn[from]) {
+						continue;
+					}
+					if (kind[from] == KIND_SEAM) {
+						siblingFrom = sibling[from];
+						siblingTo = to == topology.openOut[from] ? topology.openIn[siblingFrom] : topology.openOut[siblingFrom];
+						if (siblingTo >= COMPLEX_EDGE || positionId[siblingTo] != positionId[to]) {
+							continue;
+						}
+					}
+
+					const float* target = &attributes[to * ATTRIBUTES];
+					double cost = evaluate(quadrics[from], target) + evaluate(quadrics[to], target);
+					double weight = quadrics[from].weight + quadrics[to].weight;
+					if (siblingFrom != INVALID_VERTEX) {
+						const float* siblingTarget = &attributes[siblingTo * ATTRIBUTES];
+						cost += evaluate(quadrics[siblingFrom], siblingTarget);
+						weight += quadrics[siblingFrom].weight;
+						if (siblingTo != to) {
+							cost += evaluate(quadrics[siblingTo], siblingTarget);
+							weight += quadrics[siblingTo].weight;
+						}
+					}
+					float normalized = static_cast<float>(weight > 0.0 ? cost / weight : 0.0);
+					if (best.from == INVALID_VERTEX || normalized < best.cost) {
+						best.from = from;
+						best.to = to;
+						best.siblingFrom = siblingFrom;
+						best.siblingTo = siblingTo;
+						best.cost = normalized;
+					}
+				}
+				if (best.from != INVALID_VERTEX && best.cost <= maxCost) {
+					candidates.push_back(best);
+				}
+			}
+		}
+		if (candidates.empty()) {
+			break;
+		}
+		std::sort(candidates.begin(), candidates.end(), [](const Collapse& a, const Collapse& b) {
+			return a.cost < b.cost;
+		});
+
+		// Conjunto independiente: un colapso bloquea el anillo de sus vertices
+		// para que las pruebas de volteo sigan siendo validas en esta pasada
+		std::fill(locked.begin(), locked.end(), 0);
+		for (unsigned int v = 0; v < vertexCount; ++v) {
+			collapseTo[v] = v;
+		}
+		unsigned int removable = static_cast<unsigned int>(indices.size() - targetIndexCount) / 3;
+		unsigned int removed = 0;
+		unsigned int applied = 0;
+		for (size_t i = 0; i < candidates.size() && removed < removable; ++i) {
+			const Collapse& collapse = candidates[i];
+			if (locked[collapse.from] || locked[collapse.to] ||
+					(collapse.siblingFrom != INVALID_VERTEX && (locked[collapse.siblingFrom] || locked[collapse.siblingTo]))) {
+				continue;
+			}
+			if (flips(collapse.from, collapse.to, indices, topology, attributes) ||
+					(collapse.siblingFrom != INVALID_VERTEX &&
+					 flips(collapse.siblingFrom, collapse.siblingTo, indices, topology, attributes))) {
+				continue;
+			}
+
+			removed += sharedTriangles(collapse.from, collapse.to, indices, topology);
+			lockRing(collapse.from, indices, topology, locked);
+			lockRing(collapse.to, indices, topology, locked);
+			collapseTo[collapse.from] = collapse.to;
+			accumulate(quadrics[collapse.to], quadrics[collapse.from]);
+			if (collapse.siblingFrom != INVALID_VERTEX) {
+				removed += sharedTriangles(collapse.siblingFrom, collapse.siblingTo, indices, topology);
+				lockRing(collapse.siblingFrom, indices, topology, locked);
+				lockRing(collapse.siblingTo, indices, topology, locked);
+				collapseTo[collapse.siblingFrom] = collapse.siblingTo;
+				accumulate(quadrics[collapse.siblingTo], quadrics[collapse.siblingFrom]);
+			}
+			worstCost = std::max(worstCost, static_cast<double>(collapse.cost));
+			applied++;
+		}
+		if (applied == 0) {
+			break;
+		}
+
+		// Reescribir indices y quitar triangulos degenerados (dos esquinas en la misma posicion)
+		size_t write = 0;
+		for (size_t t = 0; t < indices.size(); t += 3) {
+			unsigned int a = collapseTo[indices[t]];
+			unsigned int b = collapseTo[indices[t + 1]];
+			unsigned int c = collapseTo[indices[t + 2]];
+			if (positionId[a] == positionId[b] || positionId[b] == positionId[c] || positionId[c] == positionId[a]) {
+				continue;
+			}
+			indices[write++] = a;
+			indices[write++] = b;
+			indices[write++] = c;
+		}
+		indices.resize(write);
+		topology.build(indices, vertexCount);
+	}
+	return static_cast<float>(sqrt(worstCost)) / scale;
+}
+
+void
+GenerateMeshLODs(MeshComponent& mesh,
+								 const float* ratios,
+								 unsigned int ratioCount,
+								 std::vector<MeshLOD>& lods,
+								 const MeshSimplifyOptions& options) {
+	lods.clear();
+	const unsigned int baseCount = static_cast<unsigned int>(mesh.m_index.size());
+	MeshLOD base = { 0, baseCount, 0.0f };
+	lods.push_back(base);
+
+	std::vector<unsigned int> level(mesh.m_index.begin(), mesh.m_index.end());
+	float error = 0.0f;
+	for (unsigned int i = 0; i < ratioCount; ++i) {
+		unsigned int target = static_cast<unsigned int>(baseCount / 3 * ratios[i]) * 3;
+		unsigned int previous = static_cast<unsigned int>(level.size());
+		// Las cuadricas parten del nivel anterior: el error respecto al nivel 0 se acumula
+		error += SimplifyMesh(mesh, level, target, options);
+		if (level.size() >= previous || error > options.maxError) {
+			break;
+		}
+		MeshLOD lod = { static_cast<unsigned int>(mesh.m_index.size()), static_cast<unsigned int>(level.size()), error };
+		mesh.m_index.insert(mesh.m_index.end(), level.begin(), level.end());
+		lods.push_back(lod);
+	}
+	mesh.m_numIndex = static_cast<int>(mesh.m_index.size());
+}
+
+float
+ProjectedScreenSize(const Bounds& worldBounds, const XMMATRIX& view, const XMMATRIX& projection) {
+	XMFLOAT3 center;
+	XMStoreFloat3(&center, XMVector3TransformCoord(LoadFloat3(worldBounds.center), view));
+	// Camara dentro de la esfera: cubre toda la pantalla
+	if (center.z <= worldBounds.radius) {
+		return 1e30f;
+	}
+	XMFLOAT4X4 p;
+	XMStoreFloat4x4(&p, projection);
+	// Radio proyectado en NDC (media altura = 1) == fraccion de la altura que cubre el diametro
+	return worldBounds.radius * p._22 / center.z;
+}
+
+unsigned int
+SelectMeshLOD(const std::vector<MeshLOD>& lods,
+							const Bounds& worldBounds,
+							const XMMATRIX& view,
+							const XMMATRIX& projection,
+							float viewportHeight,
+							float maxPixelError) {
+	if (lods.size() < 2 || worldBounds.radius <= 0.0f) {
+		return 0;
+	}
+	float screenSize = ProjectedScreenSize(worldBounds, view, projection);
+	// Pixeles por unidad de mundo a la distancia del objeto
+	float pixelsPerUnit = screenSize * viewportHeight / (2.0f * worldBounds.radius);
+	unsigned int level = 0;
+	while (level + 1 < lods.size() && lods[level + 1].error * pixelsPerUnit <= maxPixelError) {
+		level++;
+	}
+	return level;
+}
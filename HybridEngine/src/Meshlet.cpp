@@ -0,0 +1,252 @@
+#include "Meshlet.h"
+#include "MeshComponent.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	const unsigned int INVALID_TRIANGLE = 0xffffffff;
+	const unsigned char NO_LOCAL_INDEX = 0xff;
+
+	// Vertices distintos del triangulo que todavia no estan en el meshlet
+	unsigned int
+	countNewVertices(const unsigned int* triangle, const std::vector<unsigned char>& localIndex) {
+		unsigned int a = triangle[0], b = triangle[1], c = triangle[2];
+		unsigned int count = localIndex[a] == NO_LOCAL_INDEX ? 1 : 0;
+		if (b != a && localIndex[b] == NO_LOCAL_INDEX) {
+			count++;
+		}
+		if (c != a && c != b && localIndex[c] == NO_LOCAL_INDEX) {
+			count++;
+		}
+		return count;
+	}
+
+	// Esfera (centro de la caja + distancia maxima) y cono de normales del meshlet
+	void
+	computeBounds(const MeshComponent& mesh,
+								const std::vector<XMFLOAT3>& normals,
+								const std::vector<unsigned int>& meshletTriangles,
+								const Meshlet& meshlet,
+								MeshletData& out) {
+		const unsigned int* vertices = &out.vertices[meshlet.vertexOffset];
+		XMFLOAT3 minimum = mesh.m_vertex[vertices[0]].Pos;
+		XMFLOAT3 maximum = minimum;
+		for (unsigned int i = 1; i < meshlet.vertexCount; ++i) {
+			const XMFLOAT3& p = mesh.m_vertex[vertices[i]].Pos;
+			minimum.x = std::min(minimum.x, p.x);
+			minimum.y = std::min(minimum.y, p.y);
+			minimum.z = std::min(minimum.z, p.z);
+			maximum.x = std::max(maximum.x, p.x);
+			maximum.y = std::max(maximum.y, p.y);
+			maximum.z = std::max(maximum.z, p.z);
+		}
+		XMFLOAT3 center((minimum.x + maximum.x) * 0.5f, (minimum.y + maximum.y) * 0.5f, (minimum.z + maximum.z) * 0.5f);
+		float radiusSq = 0.0f;
+		for (unsigned int i = 0; i < meshlet.vertexCount; ++i) {
+			const XMFLOAT3& p = mesh.m_vertex[vertices[i]].Pos;
+			float dx = p.x - center.x, dy = p.y - center.y, dz = p.z - center.z;
+			radiusSq = std::max(radiusSq, dx * dx + dy * dy + dz * dz);
+		}
+
+		XMFLOAT3 axis(0.0f, 0.0f, 0.0f);
+		for (size_t t = 0; t < meshletTriangles.size(); ++t) {
+			const XMFLOAT3& n = normals[meshletTriangles[t]];
+			axis.x += n.x;
+			axis.y += n.y;
+			axis.z += n.z;
+		}
+		float length = sqrtf(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+		float cutoff = 1.0f;
+		if (length > 0.0f) {
+			axis.x /= length;
+			axis.y /= length;
+			axis.z /= length;
+			// Cono de normales con coseno minDot; el de descarte lo ensancha
+			// 90 grados: -cos(a + 90) = sin(a) = sqrt(1 - minDot^2)
+			float minDot = 1.0f;
+			for (size_t t = 0; t < meshletTriangles.size(); ++t) {
+				const XMFLOAT3& n = normals[meshletTriangles[t]];
+				minDot = std::min(minDot, n.x * axis.x + n.y * axis.y + n.z * axis.z);
+			}
+			cutoff = minDot <= 0.0f ? 1.0f : sqrtf(1.0f - minDot * minDot);
+		}
+
+		out.meshlets.push_back(meshlet);
+		out.centerX.push_back(center.x);
+		out.centerY.push_back(center.y);
+		out.centerZ.push_back(center.z);
+		out.radius.push_back(sqrtf(radiusSq));
+		out.axisX.push_back(axis.x);
+		out.axisY.push_back(axis.y);
+		out.axisZ.push_back(axis.z);
+		out.cutoff.push_back(cutoff);
+	}
+}
+
+void
+MeshletData::clear() {
+	meshlets.clear();
+	vertices.clear();
+	triangles.clear();
+	centerX.clear();
+	centerY.clear();
+	centerZ.clear();
+	radius.clear();
+	axisX.clear();
+	axisY.clear();
+	axisZ.clear();
+	cutoff.clear();
+}
+
+void
+BuildMeshlets(const MeshComponent& mesh,
+							unsigned int indexStart,
+							unsigned int indexCount,
+							MeshletData& out,
+							float coneWeight,
+							unsigned int maxVertices,
+							unsigned int maxTriangles) {
+	out.clear();
+	maxVertices = std::min(std::max(maxVertices, 3u), static_cast<unsigned int>(NO_LOCAL_INDEX));
+	maxTriangles = std::max(maxTriangles, 1u);
+	const unsigned int triangleCount = indexCount / 3;
+	const unsigned int vertexCount = static_cast<unsigned int>(mesh.m_vertex.size());
+	if (triangleCount == 0 || vertexCount == 0) {
+		return;
+	}
+	const unsigned int* indices = &mesh.m_index[indexStart];
+
+	// Normal unitaria por triangulo (horario = frente: cross(b - a, c - a) apunta al observador)
+	std::vector<XMFLOAT3> normals(triangleCount);
+	for (unsigned int t = 0; t < triangleCount; ++t) {
+		const XMFLOAT3& a = mesh.m_vertex[indices[t * 3]].Pos;
+		const XMFLOAT3& b = mesh.m_vertex[indices[t * 3 + 1]].Pos;
+		const XMFLOAT3& c = mesh.m_vertex[indices[t * 3 + 2]].Pos;
+		float ux = b.x - a.x, uy = b.y - a.y, uz = b.z - a.z;
+		float vx = c.x - a.x, vy = c.y - a.y, vz = c.z - a.z;
+		XMFLOAT3 n(uy * vz - uz * vy, uz * vx - ux * vz, ux * vy - uy * vx);
+		float length = sqrtf(n.x * n.x + n.y * n.y + n.z * n.z);
+		float inv = length > 0.0f ? 1.0f / length : 0.0f;
+		normals[t] = XMFLOAT3(n.x * inv, n.y * inv, n.z * inv);
+	}
+
+	// Triangulos por vertice
+	std::vector<unsigned int> offsets(vertexCount + 1, 0);
+	for (unsigned int i = 0; i < triangleCount * 3; ++i) {
+		offsets[indices[i] + 1]++;
+	}
+	for (unsigned int v = 0; v < vertexCount; ++v) {
+		offsets[v + 1] += offsets[v];
+	}
+	std::vector<unsigned int> adjacency(triangleCount * 3);
+	{
+		std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+		for (unsigned int i = 0; i < triangleCount * 3; ++i) {
+			adjacency[fill[indices[i]]++] = i / 3;
+		}
+	}
+
+	std::vector<unsigned char> used(triangleCount, 0);
+	std::vector<unsigned int> candidateOf(triangleCount, INVALID_TRIANGLE);   // Meshlet que ya lo tiene como candidato
+	std::vector<unsigned char> localIndex(vertexCount, NO_LOCAL_INDEX);
+	std::vector<unsigned int> candidates;
+	std::vector<unsigned int> meshletTriangles;
+	Meshlet current = { 0, 0, 0, 0 };
+	XMFLOAT3 normalSum(0.0f, 0.0f, 0.0f);
+	unsigned int nextSeed = 0;
+	unsigned int remaining = triangleCount;
+
+	auto flush = [&]() {
+		computeBounds(mesh, normals, meshletTriangles, current, out);
+		for (unsigned int i = 0; i < current.vertexCount; ++i) {
+			localIndex[out.vertices[current.vertexOffset + i]] = NO_LOCAL_INDEX;
+		}
+		current.vertexOffset = static_cast<unsigned int>(out.vertices.size());
+		current.triangleOffset = static_cast<unsigned int>(out.triangles.size());
+		current.vertexCount = 0;
+		current.triangleCount = 0;
+		normalSum = XMFLOAT3(0.0f, 0.0f, 0.0f);
+		candidates.clear();
+		meshletTriangles.clear();
+	};
+
+	while (remaining > 0) {
+		// Candidato adyacente que agrega menos vertices y sigue la normal del cluster
+		unsigned int best = INVALID_TRIANGLE;
+		float bestScore = 1e30f;
+		XMFLOAT3 axis = normalSum;
+		float axisLength = sqrtf(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+		if (axisLength > 0.0f) {
+			axis = XMFLOAT3(axis.x / axisLength, axis.y / axisLength, axis.z / axisLength);
+		}
+		size_t write = 0;
+		for (size_t i = 0; i < candidates.size(); ++i) {
+			unsigned int t = candidates[i];
+			if (used[t]) {
+				continue;
+			}
+			candidates[write++] = t;
+			unsigned int added = countNewVertices(&indices[t * 3], localIndex);
+			if (current.vertexCount + added > maxVertices) {
+				continue;
+			}
+			const XMFLOAT3& n = normals[t];
+			float score = added + coneWeight * (1.0f - (n.x * axis.x + n.y * axis.y + n.z * axis.z));
+			if (score < bestScore) {
+				bestScore = score;
+				best = t;
+			}
+		}
+		candidates.resize(write);
+
+		if (best == INVALID_TRIANGLE) {
+			// Sin vecinos que quepan: cerrar si el borde esta lleno, o seguir
+			// con el siguiente triangulo libre en el orden de la lista
+			if (!candidates.empty()) {
+				flush();
+				continue;
+			}
+			while (used[nextSeed]) {
+				nextSeed++;
+			}
+			best = nextSeed;
+			if (current.vertexCount + countNewVertices(&indices[best * 3], localIndex) > maxVertices) {
+				flush();
+			}
+		}
+
+		used[best] = 1;
+		remaining--;
+		for (unsigned int k = 0; k < 3; ++k) {
+			unsigned int v = indices[best * 3 + k];
+			if (localIndex[v] == NO_LOCAL_INDEX) {
+				localIndex[v] = static_cast<unsigned char>(current.vertexCount++);
+				out.vertices.push_back(v);
+			}
+			out.triangles.push_back(localIndex[v]);
+			for (unsigned int i = offsets[v]; i < offsets[v + 1]; ++i) {
+				unsigned int neighbor = adjacency[i];
+				if (!used[neighbor] && candidateOf[neighbor] != out.meshlets.size()) {
+					candidateOf[neighbor] = static_cast<unsigned int>(out.meshlets.size());
+					candidates.push_back(neighbor);
+				}
+			}
+		}
+		meshletTriangles.push_back(best);
+		normalSum.x += normals[best].x;
+		normalSum.y += normals[best].y;
+		normalSum.z += normals[best].z;
+		current.triangleCount++;
+		if (current.triangleCount == maxTriangles) {
+			flush();
+		}
+	}
+	if (current.triangleCount > 0) {
+		flush();
+	}
+}
+
+void
+BuildMeshlets(const MeshComponent& mesh, MeshletData& out, float coneWeight) {
+	BuildMeshlets(mesh, 0, static_cast<unsigned int>(mesh.m_index.size()), out, coneWeight);
+}
@@ -0,0 +1,161 @@
+#include "MeshletCuller.h"
+#include "Meshlet.h"
+#include <cmath>
+#include <xmmintrin.h>
+
+void
+MeshletCuller::setView(const XMMATRIX& world, const XMMATRIX& viewProjection, const XMFLOAT3& cameraPosition) {
+	XMFLOAT4X4 m;
+	XMStoreFloat4x4(&m, world * viewProjection);
+
+	// Mismos planos que FrustumCuller::setFrustum, pero de world * viewProjection
+	for (int i = 0; i < 4; ++i) {
+		const float* row = m.m[i];
+		(&m_planes[0].x)[i] = row[3] + row[0];   // Izquierdo
+		(&m_planes[1].x)[i] = row[3] - row[0];   // Derecho
+		(&m_planes[2].x)[i] = row[3] + row[1];   // Inferior
+		(&m_planes[3].x)[i] = row[3] - row[1];   // Superior
+		(&m_planes[4].x)[i] = row[2];            // Cercano
+		(&m_planes[5].x)[i] = row[3] - row[2];   // Lejano
+	}
+	for (int p = 0; p < 6; ++p) {
+		XMFLOAT4& plane = m_planes[p];
+		float length = sqrtf(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+		float inv = length > 0.0f ? 1.0f / length : 0.0f;
+		plane.x *= inv;
+		plane.y *= inv;
+		plane.z *= inv;
+		plane.w *= inv;
+	}
+
+	XMVECTOR determinant;
+	XMMATRIX inverse = XMMatrixInverse(&determinant, world);
+	XMStoreFloat3(&m_camera, XMVector3TransformCoord(XMLoadFloat3(&cameraPosition), inverse));
+}
+
+int
+MeshletCuller::testScalar(const MeshletData& data, unsigned int i) const {
+	for (int p = 0; p < 6; ++p) {
+		const XMFLOAT4& plane = m_planes[p];
+		float distance = data.centerX[i] * plane.x + data.centerY[i] * plane.y + data.centerZ[i] * plane.z + plane.w;
+		if (distance < -data.radius[i]) {
+			return 1;
+		}
+	}
+	float dx = data.centerX[i] - m_camera.x;
+	float dy = data.centerY[i] - m_camera.y;
+	float dz = data.centerZ[i] - m_camera.z;
+	float along = dx * data.axisX[i] + dy * data.axisY[i] + dz * data.axisZ[i];
+	float distance = sqrtf(dx * dx + dy * dy + dz * dz);
+	return along >= data.cutoff[i] * distance + data.radius[i] ? 2 : 0;
+}
+
+unsigned int
+MeshletCuller::cullMeshletsScalar(const MeshletData& data, std::vector<unsigned int>& visible) {
+	visible.clear();
+	m_stats = MeshletCullStats();
+	const unsigned int count = data.size();
+	for (unsigned int i = 0; i < count; ++i) {
+		int result = testScalar(data, i);
+		m_stats.frustumCulled += result == 1 ? 1 : 0;
+		m_stats.coneCulled += result == 2 ? 1 : 0;
+		if (result == 0) {
+			visible.push_back(i);
+		}
+	}
+	m_stats.tested = count;
+	m_stats.visible = static_cast<unsigned int>(visible.size());
+	return m_stats.visible;
+}
+
+unsigned int
+MeshletCuller::cullMeshlets(const MeshletData& data, std::vector<unsigned int>& visible) {
+	visible.clear();
+	m_stats = MeshletCullStats();
+	const unsigned int count = data.size();
+	visible.reserve(count);
+	unsigned int i = 0;
+
+	const __m128 cameraX = _mm_set1_ps(m_camera.x);
+	const __m128 cameraY = _mm_set1_ps(m_camera.y);
+	const __m128 cameraZ = _mm_set1_ps(m_camera.z);
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	for (; i + 4 <= count; i += 4) {
+		__m128 cx = _mm_loadu_ps(&data.centerX[i]);
+		__m128 cy = _mm_loadu_ps(&data.centerY[i]);
+		__m128 cz = _mm_loadu_ps(&data.centerZ[i]);
+		__m128 radius = _mm_loadu_ps(&data.radius[i]);
+		__m128 negativeRadius = _mm_xor_ps(radius, signMask);
+
+		__m128 outside = _mm_setzero_ps();
+		for (int p = 0; p < 6; ++p) {
+			const XMFLOAT4& plane = m_planes[p];
+			// Mismo orden de operaciones que testScalar
+			__m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(plane.x)),
+																											_mm_mul_ps(cy, _mm_set1_ps(plane.y))),
+																							 _mm_mul_ps(cz, _mm_set1_ps(plane.z))),
+																	 _mm_set1_ps(plane.w));
+			outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negativeRadius));
+		}
+
+		__m128 dx = _mm_sub_ps(cx, cameraX);
+		__m128 dy = _mm_sub_ps(cy, cameraY);
+		__m128 dz = _mm_sub_ps(cz, cameraZ);
+		__m128 along = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, _mm_loadu_ps(&data.axisX[i])),
+																				 _mm_mul_ps(dy, _mm_loadu_ps(&data.axisY[i]))),
+															_mm_mul_ps(dz, _mm_loadu_ps(&data.axisZ[i])));
+		__m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+		__m128 backfacing = _mm_cmpge_ps(along, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&data.cutoff[i]), distance), radius));
+
+		int outsideMask = _mm_movemask_ps(outside);
+		int backMask = _mm_movemask_ps(backfacing) & ~outsideMask;
+		int visibleMask = ~(outsideMask | backMask) & 0xf;
+		for (int k = 0; k < 4; ++k) {
+			m_stats.frustumCulled += (outsideMask >> k) & 1;
+			m_stats.coneCulled += (backMask >> k) & 1;
+			if (visibleMask & (1 << k)) {
+				visible.push_back(i + k);
+			}
+		}
+	}
+
+	// Resto que no llena un registro
+	for (; i < count; ++i) {
+		int result = testScalar(data, i);
+		m_stats.frustumCulled += result == 1 ? 1 : 0;
+		m_stats.coneCulled += result == 2 ? 1 : 0;
+		if (result == 0) {
+			visible.push_back(i);
+		}
+	}
+
+	m_stats.tested = count;
+	m_stats.visible = static_cast<unsigned int>(visible.size());
+	return m_stats.visible;
+}
+
+void
+MeshletCuller::writeIndices(const MeshletData& data,
+														const std::vector<unsigned int>& visible,
+														std::vector<unsigned int>& indices) {
+	for (size_t v = 0; v < visible.size(); ++v) {
+		const Meshlet& meshlet = data.meshlets[visible[v]];
+		const unsigned int* vertices = &data.vertices[meshlet.vertexOffset];
+		const unsigned char* triangles = &data.triangles[meshlet.triangleOffset];
+		size_t base = indices.size();
+		indices.resize(base + meshlet.triangleCount * 3);
+		unsigned int* out = &indices[base];
+		for (unsigned int t = 0; t < meshlet.triangleCount * 3; ++t) {
+			out[t] = vertices[triangles[t]];
+		}
+	}
+}
+
+unsigned int
+MeshletCuller::cull(const MeshletData& data, std::vector<unsigned int>& indices) {
+	indices.clear();
+	cullMeshlets(data, m_visible);
+	writeIndices(data, m_visible, indices);
+	m_stats.triangles = static_cast<unsigned int>(indices.size() / 3);
+	return m_stats.triangles;
+}
@@ -0,0 +1,516 @@
+#include "NullBackend.h"
+
+namespace {
+	// Objeto COM minimo. Solo implementa IUnknown; el motor nunca llama otros
+	// metodos sobre los recursos porque todo pasa por el RenderBackend.
+	class
+	NullObject : public IUnknown {
+	public:
+		explicit NullObject(unsigned int byteWidth) : m_data(byteWidth) {}
+		virtual ~NullObject() = default;
+
+		HRESULT STDMETHODCALLTYPE
+		QueryInterface(REFIID riid, void** ppvObject) override {
+			if (ppvObject) {
+				*ppvObject = nullptr;
+			}
+			return E_NOINTERFACE;
+		}
+
+		ULONG STDMETHODCALLTYPE
+		AddRef() override {
+			return ++m_refCount;
+		}
+
+		ULONG STDMETHODCALLTYPE
+		Release() override {
+			ULONG count = --m_refCount;
+			if (count == 0) {
+				delete this;
+			}
+			return count;
+		}
+
+	public:
+		std::vector<unsigned char> m_data;
+	private:
+		ULONG m_refCount = 1;
+	};
+
+	long long
+	elapsedNs(std::chrono::steady_clock::time_point from,
+						std::chrono::steady_clock::time_point to) {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count();
+	}
+}
+
+void
+NullBackend::init(bool recordCommands) {
+	m_recordCommands = recordCommands;
+	reset();
+	MESSAGE("NullBackend", "init", "OK");
+}
+
+void
+NullBackend::destroy() {
+	reset();
+	m_commands.shrink_to_fit();
+	m_frameStats.shrink_to_fit();
+}
+
+void
+NullBackend::reset() {
+	m_commands.clear();
+	m_frameStats.clear();
+	for (unsigned int i = 0; i < OP_COUNT; ++i) {
+		m_opStats[i] = RenderOpStats();
+	}
+	m_currentFrame = NullFrameStats();
+	m_lastTick = Clock::now();
+	m_frameStart = m_lastTick;
+}
+
+void
+NullBackend::record(RenderOp op, const void* handle, unsigned int slot, unsigned int count) {
+	Clock::time_point now = Clock::now();
+	long long cpuNs = elapsedNs(m_lastTick, now);
+	m_lastTick = now;
+
+	m_opStats[op].calls++;
+	m_opStats[op].cpuNs += cpuNs;
+	m_currentFrame.commands++;
+
+	if (m_recordCommands) {
+		RenderCommand cmd;
+		cmd.op = static_cast<unsigned short>(op);
+		cmd.slot = static_cast<unsigned short>(slot);
+		cmd.count = count;
+		cmd.handle = handle;
+		cmd.cpuNs = cpuNs;
+		m_commands.push_back(cmd);
+	}
+}
+
+template<typename T> HRESULT
+NullBackend::createObject(RenderOp op,
+													unsigned int byteWidth,
+													const void* initialData,
+													T** ppObject) {
+	if (!ppObject) {
+		ERROR("NullBackend", getOpName(op), "ppObject is nullptr");
+		return E_POINTER;
+	}
+	NullObject* object = new NullObject(byteWidth);
+	if (initialData && byteWidth > 0) {
+		memcpy(object->m_data.data(), initialData, byteWidth);
+	}
+	// Los interfaces D3D11 derivan de IUnknown sin herencia multiple, por lo
+	// que la vtable de IUnknown queda en el offset 0.
+	*ppObject = reinterpret_cast<T*>(static_cast<IUnknown*>(object));
+	record(op, *ppObject, 0, byteWidth);
+	return S_OK;
+}
+
+unsigned char*
+NullBackend::getBufferData(ID3D11Resource* pResource, unsigned int* pByteWidth) {
+	if (!pResource) {
+		return nullptr;
+	}
+	NullObject* object = static_cast<NullObject*>(reinterpret_cast<IUnknown*>(pResource));
+	if (pByteWidth) {
+		*pByteWidth = static_cast<unsigned int>(object->m_data.size());
+	}
+	return object->m_data.empty() ? nullptr : object->m_data.data();
+}
+
+HRESULT
+NullBackend::CreateBuffer(const D3D11_BUFFER_DESC* pDesc,
+													const D3D11_SUBRESOURCE_DATA* pInitialData,
+													ID3D11Buffer** ppBuffer) {
+	return createObject(OP_CREATE_BUFFER,
+											pDesc->ByteWidth,
+											pInitialData ? pInitialData->pSysMem : nullptr,
+											ppBuffer);
+}
+
+HRESULT
+NullBackend::CreateTexture2D(const D3D11_TEXTURE2D_DESC* pDesc,
+														 const D3D11_SUBRESOURCE_DATA* pInitialData,
+														 ID3D11Texture2D** ppTexture2D) {
+	// Las texturas no necesitan almacenamiento en CPU
+	return createObject(OP_CREATE_TEXTURE2D, 0, nullptr, ppTexture2D);
+}
+
+HRESULT
+NullBackend::CreateShaderResourceView(ID3D11Resource* pResource,
+																			const D3D11_SHADER_RESOURCE_VIEW_DESC* pDesc,
+																			ID3D11ShaderResourceView** ppSRView) {
+	return createObject(OP_CREATE_SHADER_RESOURCE_VIEW, 0, nullptr, ppSRView);
+}
+
+HRESULT
+NullBackend::CreateShaderResourceViewFromFile(const std::string& fileName,
+																							ID3D11ShaderResourceView** ppSRView) {
+	return createObject(OP_CREATE_SHADER_RESOURCE_VIEW, 0, nullptr, ppSRView);
+}
+
+HRESULT
+NullBackend::CreateRenderTargetView(ID3D11Resource* pResource,
+																		const D3D11_RENDER_TARGET_VIEW_DESC* pDesc,
+																		ID3D11RenderTargetView** ppRTView) {
+	return createObject(OP_CREATE_RENDER_TARGET_VIEW, 0, nullptr, ppRTView);
+}
+
+HRESULT
+NullBackend::CreateDepthStencilView(ID3D11Resource* pResource,
+																		const D3D11_DEPTH_STENCIL_VIEW_DESC* pDesc,
+																		ID3D11DepthStencilView** ppDepthStencilView) {
+	return createObject(OP_CREATE_DEPTH_STENCIL_VIEW, 0, nullptr, ppDepthStencilView);
+}
+
+HRESULT
+NullBackend::CreateVertexShader(const void* pShaderBytecode,
+																unsigned int BytecodeLength,
+																ID3D11ClassLinkage* pClassLinkage,
+																ID3D11VertexShader** ppVertexShader) {
+	return createObject(OP_CREATE_VERTEX_SHADER, 0, nullptr, ppVertexShader);
+}
+
+HRESULT
+NullBackend::CreatePixelShader(const void* pShaderBytecode,
+															 unsigned int BytecodeLength,
+															 ID3D11ClassLinkage* pClassLinkage,
+															 ID3D11PixelShader** ppPixelShader) {
+	return createObject(OP_CREATE_PIXEL_SHADER, 0, nullptr, ppPixelShader);
+}
+
+HRESULT
+NullBackend::CreateInputLayout(const D3D11_INPUT_ELEMENT_DESC* pInputElementDescs,
+															 unsigned int NumElements,
+															 const void* pShaderBytecodeWithInputSignature,
+															 unsigned int BytecodeLength,
+															 ID3D11InputLayout** ppInputLayout) {
+	return createObject(OP_CREATE_INPUT_LAYOUT, 0, nullptr, ppInputLayout);
+}
+
+HRESULT
+NullBackend::CreateSamplerState(const D3D11_SAMPLER_DESC* pSamplerDesc,
+																ID3D11SamplerState** ppSamplerState) {
+	return createObject(OP_CREATE_SAMPLER_STATE, 0, nullptr, ppSamplerState);
+}
+
+HRESULT
+NullBackend::CreateBlendState(const D3D11_BLEND_DESC* pBlendStateDesc,
+															ID3D11BlendState** ppBlendState) {
+	return createObject(OP_CREATE_BLEND_STATE, 0, nullptr, ppBlendState);
+}
+
+HRESULT
+NullBackend::CreateDepthStencilState(const D3D11_DEPTH_STENCIL_DESC* pDepthStencilDesc,
+																		 ID3D11DepthStencilState** ppDepthStencilState) {
+	return createObject(OP_CREATE_DEPTH_STENCIL_STATE, 0, nullptr, ppDepthStencilState);
+}
+
+HRESULT
+NullBackend::CreateRasterizerState(const D3D11_RASTERIZER_DESC* pRasterizerDesc,
+																	 ID3D11RasterizerState** ppRasterizerState) {
+	return createObject(OP_CREATE_RASTERIZER_STATE, 0, nullptr, ppRasterizerState);
+}
+
+void
+NullBackend::IASetInputLayout(ID3D11InputLayout* pInputLayout) {
+	record(OP_IA_SET_INPUT_LAYOUT, pInputLayout);
+}
+
+void
+NullBackend::IASetVertexBuffers(unsigned int StartSlot,
+																unsigned int NumBuffers,
+																ID3D11Buffer* const* ppVertexBuffers,
+																const unsigned int* pStrides,
+																const unsigned int* pOffsets) {
+	record(OP_IA_SET_VERTEX_BUFFERS,
+				 ppVertexBuffers ? ppVertexBuffers[0] : nullptr,
+				 StartSlot,
+				 NumBuffers);
+}
+
+void
+NullBackend::IASetIndexBuffer(ID3D11Buffer* pIndexBuffer,
+															DXGI_FORMAT Format,
+															unsigned int Offset) {
+	record(OP_IA_SET_INDEX_BUFFER, pIndexBuffer, 0, static_cast<unsigned int>(Format));
+}
+
+void
+NullBackend::IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology) {
+	record(OP_IA_SET_PRIMITIVE_TOPOLOGY, nullptr, 0, static_cast<unsigned int>(Topology));
+}
+
+void
+NullBackend::VSSetShader(ID3D11VertexShader* pVertexShader,
+												 ID3D11ClassInstance* const* ppClassInstances,
+												 unsigned int NumClassInstances) {
+	record(OP_VS_SET_SHADER, pVertexShader);
+}
+
+void
+NullBackend::PSSetShader(ID3D11PixelShader* pPixelShader,
+												 ID3D11ClassInstance* const* ppClassInstances,
+												 unsigned int NumClassInstances) {
+	record(OP_PS_SET_SHADER, pPixelShader);
+}
+
+void
+NullBackend::VSSetConstantBuffers(unsigned int StartSlot,
+																	unsigned int NumBuffers,
+																	ID3D11Buffer* const* ppConstantBuffers) {
+	record(OP_VS_SET_CONSTANT_BUFFERS,
+				 ppConstantBuffers ? ppConstantBuffers[0] : nullptr,
+				 StartSlot,
+				 NumBuffers);
+}
+
+void
+NullBackend::PSSetConstantBuffers(unsigned int StartSlot,
+																	unsigned int NumBuffers,
+																	ID3D11Buffer* const* ppConstantBuffers) {
+	record(OP_PS_SET_CONSTANT_BUFFERS,
+				 ppConstantBuffers ? ppConstantBuffers[0] : nullptr,
+				 StartSlot,
+				 NumBuffers);
+}
+
+void
+NullBackend::PSSetShaderResources(unsigned int StartSlot,
+																	unsigned int NumViews,
+																	ID3D11ShaderResourceView* const* ppShaderResourceViews) {
+	record(OP_PS_SET_SHADER_RESOURCES,
+				 ppShaderResourceViews ? ppShaderResourceViews[0] : nullptr,
+				 StartSlot,
+				 NumViews);
+}
+
+void
+NullBackend::PSSetSamplers(unsigned int StartSlot,
+													 unsigned int NumSamplers,
+													 ID3D11SamplerState* const* ppSamplers) {
+	record(OP_PS_SET_SAMPLERS, ppSamplers ? ppSamplers[0] : nullptr, StartSlot, NumSamplers);
+}
+
+void
+NullBackend::OMSetRenderTargets(unsigned int NumViews,
+																ID3D11RenderTargetView* const* ppRenderTargetViews,
+																ID3D11DepthStencilView* pDepthStencilView) {
+	record(OP_OM_SET_RENDER_TARGETS,
+				 ppRenderTargetViews ? ppRenderTargetViews[0] : nullptr,
+				 0,
+				 NumViews);
+}
+
+void
+NullBackend::OMSetBlendState(ID3D11BlendState* pBlendState,
+														 const float BlendFactor[4],
+														 unsigned int SampleMask) {
+	record(OP_OM_SET_BLEND_STATE, pBlendState, 0, SampleMask);
+}
+
+void
+NullBackend::OMSetDepthStencilState(ID3D11DepthStencilState* pDepthStencilState,
+																		unsigned int StencilRef) {
+	record(OP_OM_SET_DEPTH_STENCIL_STATE, pDepthStencilState, 0, StencilRef);
+}
+
+void
+NullBackend::RSSetViewports(unsigned int NumViewports, const D3D11_VIEWPORT* pViewports) {
+	record(OP_RS_SET_VIEWPORTS, pViewports, 0, NumViewports);
+}
+
+void
+NullBackend::RSSetState(ID3D11RasterizerState* pRasterizerState) {
+	record(OP_RS_SET_STATE, pRasterizerState);
+}
+
+void
+NullBackend::ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView,
+																	 const float ColorRGBA[4]) {
+	record(OP_CLEAR_RENDER_TARGET_VIEW, pRenderTargetView);
+}
+
+void
+NullBackend::ClearDepthStencilView(ID3D11DepthStencilView* pDepthStencilView,
+																	 unsigned int ClearFlags,
+																	 float Depth,
+																	 UINT8 Stencil) {
+	record(OP_CLEAR_DEPTH_STENCIL_VIEW, pDepthStencilView, 0, ClearFlags);
+}
+
+void
+NullBackend::UpdateSubresource(ID3D11Resource* pDstResource,
+															 unsigned int DstSubresource,
+															 const D3D11_BOX* pDstBox,
+															 const void* pSrcData,
+															 unsigned int SrcRowPitch,
+															 unsigned int SrcDepthPitch) {
+	unsigned int byteWidth = 0;
+	unsigned char* data = getBufferData(pDstResource, &byteWidth);
+	if (data && pSrcData) {
+		unsigned int begin = pDstBox ? pDstBox->left : 0;
+		unsigned int end = pDstBox ? pDstBox->right : byteWidth;
+		if (end > byteWidth) {
+			end = byteWidth;
+		}
+		if (begin < end) {
+			memcpy(data + begin, pSrcData, end - begin);
+		}
+	}
+	record(OP_UPDATE_SUBRESOURCE, pDstResource, DstSubresource, byteWidth);
+}
+
+HRESULT
+NullBackend::Map(ID3D11Resource* pResource,
+								 unsigned int Subresource,
+								 D3D11_MAP MapType,
+								 unsigned int MapFlags,
+								 D3D11_MAPPED_SUBRESOURCE* pMappedResource) {
+	if (!pMappedResource) {
+		return E_INVALIDARG;
+	}
+	unsigned int byteWidth = 0;
+	unsigned char* data = getBufferData(pResource, &byteWidth);
+	if (!data) {
+		return E_INVALIDARG;
+	}
+	// El mapeo apunta directo a la copia en CPU del buffer
+	pMappedResource->pData = data;
+	pMappedResource->RowPitch = byteWidth;
+	pMappedResource->DepthPitch = byteWidth;
+	record(OP_MAP, pResource, static_cast<unsigned int>(MapType), byteWidth);
+	return S_OK;
+}
+
+void
+NullBackend::Unmap(ID3D11Resource* pResource, unsigned int Subresource) {
+	record(OP_UNMAP, pResource, Subresource);
+}
+
+void
+NullBackend::DrawIndexed(unsigned int IndexCount,
+												 unsigned int StartIndexLocation,
+												 int BaseVertexLocation) {
+	record(OP_DRAW_INDEXED, nullptr, 0, IndexCount);
+	m_currentFrame.draws++;
+	m_currentFrame.indices += IndexCount;
+}
+
+void
+NullBackend::DrawIndexedInstanced(unsigned int IndexCountPerInstance,
+																	unsigned int InstanceCount,
+																	unsigned int StartIndexLocation,
+																	int BaseVertexLocation,
+																	unsigned int StartInstanceLocation) {
+	record(OP_DRAW_INDEXED_INSTANCED, nullptr, InstanceCount, IndexCountPerInstance);
+	m_currentFrame.draws++;
+	m_currentFrame.instances += InstanceCount;
+	m_currentFrame.indices += static_cast<unsigned long long>(IndexCountPerInstance) * InstanceCount;
+}
+
+void
+NullBackend::ClearState() {
+	record(OP_CLEAR_STATE, nullptr);
+}
+
+HRESULT
+NullBackend::Present(IDXGISwapChain* pSwapChain, unsigned int SyncInterval, unsigned int Flags) {
+	record(OP_PRESENT, pSwapChain, 0, SyncInterval);
+
+	// Cerrar el frame actual
+	Clock::time_point now = Clock::now();
+	m_currentFrame.cpuNs = elapsedNs(m_frameStart, now);
+	m_frameStats.push_back(m_currentFrame);
+
+	unsigned int nextFrame = m_currentFrame.frame + 1;
+	m_currentFrame = NullFrameStats();
+	m_currentFrame.frame = nextFrame;
+	m_frameStart = now;
+	return S_OK;
+}
+
+std::string
+NullBackend::summary() const {
+	std::ostringstream os;
+	os << "NullBackend: " << m_frameStats.size() << " frames, "
+		 << m_commands.size() << " commands recorded\n";
+
+	for (unsigned int i = 0; i < OP_COUNT; ++i) {
+		const RenderOpStats& stats = m_opStats[i];
+		if (stats.calls == 0) {
+			continue;
+		}
+		os << "  " << getOpName(static_cast<RenderOp>(i))
+			 << " calls=" << stats.calls
+			 << " cpu=" << stats.cpuNs / 1000 << "us"
+			 << " avg=" << stats.cpuNs / static_cast<long long>(stats.calls) << "ns\n";
+	}
+
+	if (!m_frameStats.empty()) {
+		long long totalNs = 0;
+		unsigned long long totalDraws = 0;
+		unsigned long long totalInstances = 0;
+		for (const NullFrameStats& frame : m_frameStats) {
+			totalNs += frame.cpuNs;
+			totalDraws += frame.draws;
+			totalInstances += frame.instances;
+		}
+		long long frames = static_cast<long long>(m_frameStats.size());
+		os << "  avg frame cpu=" << totalNs / frames << "ns"
+			 << " avg draws=" << totalDraws / frames
+			 << " avg instances=" << totalInstances / frames << "\n";
+	}
+	return os.str();
+}
+
+const char*
+NullBackend::getOpName(RenderOp op) {
+	static const char* names[OP_COUNT] = {
+		"CreateBuffer",
+		"CreateTexture2D",
+		"CreateShaderResourceView",
+		"CreateRenderTargetView",
+		"CreateDepthStencilView",
+		"CreateVertexShader",
+		"CreatePixelShader",
+		"CreateInputLayout",
+		"CreateSamplerState",
+		"CreateBlendState",
+		"CreateDepthStencilState",
+		"CreateRasterizerState",
+		"IASetInputLayout",
+		"IASetVertexBuffers",
+		"IASetIndexBuffer",
+		"IASetPrimitiveTopology",
+		"VSSetShader",
+		"PSSetShader",
+		"VSSetConstantBuffers",
+		"PSSetConstantBuffers",
+		"PSSetShaderResources",
+		"PSSetSamplers",
+		"OMSetRenderTargets",
+		"OMSetBlendState",
+		"OMSetDepthStencilState",
+		"RSSetViewports",
+		"RSSetState",
+		"ClearRenderTargetView",
+		"ClearDepthStencilView",
+		"UpdateSubresource",
+		"Map",
+		"Unmap",
+		"DrawIndexed",
+		"DrawIndexedInstanced",
+		"ClearState",
+		"Present",
+	};
+	if (op < 0 || op >= OP_COUNT) {
+		return "Unknown";
+	}
+	return names[op];
+}
@@ -0,0 +1,439 @@
+#include "ObjLoader.h"
+#include "MeshComponent.h"
+#include "MappedFile.h"
+#include "JobSystem.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace {
+	typedef std::chrono::steady_clock Clock;
+
+	double
+	elapsedMs(Clock::time_point start) {
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	const unsigned char RELATIVE_V = 1;
+	const unsigned char RELATIVE_VT = 2;
+	const unsigned char RELATIVE_VN = 4;
+
+	inline bool
+	isBlank(char c) {
+		return c == ' ' || c == '\t' || c == '\r';
+	}
+
+	inline void
+	skipBlanks(const char*& p, const char* end) {
+		while (p < end && isBlank(*p)) {
+			++p;
+		}
+	}
+
+	inline const char*
+	nextLine(const char* p, const char* end) {
+		const char* newline = static_cast<const char*>(memchr(p, '\n', end - p));
+		return newline ? newline + 1 : end;
+	}
+
+	// Entero con signo; devuelve false si no hay digitos
+	inline bool
+	parseInt(const char*& p, const char* end, int& value) {
+		bool negative = false;
+		if (p < end && (*p == '-' || *p == '+')) {
+			negative = *p == '-';
+			++p;
+		}
+		if (p >= end || *p < '0' || *p > '9') {
+			return false;
+		}
+		int result = 0;
+		while (p < end && *p >= '0' && *p <= '9') {
+			result = result * 10 + (*p - '0');
+			++p;
+		}
+		value = negative ? -result : result;
+		return true;
+	}
+
+	// Flotante decimal con exponente opcional. Acumula hasta 19 digitos en un
+	// entero y escala una vez con una tabla de potencias de 10.
+	inline bool
+	parseFloat(const char*& p, const char* end, float& value) {
+		static const double powers[] = {
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+
+		bool negative = false;
+		if (p < end && (*p == '-' || *p == '+')) {
+			negative = *p == '-';
+			++p;
+		}
+
+		unsigned long long mantissa = 0;
+		int digits = 0;
+		int exponent = 0;
+		bool any = false;
+		while (p < end && *p >= '0' && *p <= '9') {
+			if (digits < 19) {
+				mantissa = mantissa * 10 + (*p - '0');
+				if (mantissa) {
+					digits++;
+				}
+			}
+			else {
+				exponent++;
+			}
+			any = true;
+			++p;
+		}
+		if (p < end && *p == '.') {
+			++p;
+			while (p < end && *p >= '0' && *p <= '9') {
+				if (digits < 19) {
+					mantissa = mantissa * 10 + (*p - '0');
+					if (mantissa) {
+						digits++;
+					}
+					exponent--;
+				}
+				any = true;
+				++p;
+			}
+		}
+		if (!any) {
+			return false;
+		}
+		if (p < end && (*p == 'e' || *p == 'E')) {
+			++p;
+			int e = 0;
+			if (!parseInt(p, end, e)) {
+				return false;
+			}
+			exponent += e;
+		}
+
+		double result = static_cast<double>(mantissa);
+		if (exponent < 0) {
+			result = exponent >= -22 ? result / powers[-exponent] : result * pow(10.0, exponent);
+		}
+		else if (exponent > 0) {
+			result = exponent <= 22 ? result * powers[exponent] : result * pow(10.0, exponent);
+		}
+		value = static_cast<float>(negative ? -result : result);
+		return true;
+	}
+
+	// Indice OBJ (base 1 o negativo relativo) -> base 0; los negativos quedan
+	// relativos al inicio del chunk y se marcan para resolverlos al unir
+	inline int
+	resolveIndex(int raw, unsigned int localCount, unsigned char bit, unsigned char& relative) {
+		if (raw > 0) {
+			return raw - 1;
+		}
+		relative |= bit;
+		return static_cast<int>(localCount) + raw;
+	}
+}
+
+HRESULT
+ObjLoader::load(const std::string& path, MeshComponent& mesh, JobSystem* jobs) {
+	Clock::time_point start = Clock::now();
+	MappedFile file;
+	HRESULT hr = file.open(path);
+	if (FAILED(hr)) {
+		return hr;
+	}
+	double mapMs = elapsedMs(start);
+
+	hr = parse(file.data(), file.size(), mesh, jobs);
+	m_stats.mapMs = mapMs;
+	if (SUCCEEDED(hr)) {
+		mesh.m_name = path;
+	}
+	return hr;
+}
+
+HRESULT
+ObjLoader::parse(const char* data, size_t size, MeshComponent& mesh, JobSystem* jobs) {
+	m_stats = ObjLoadStats();
+	m_stats.bytes = size;
+	if (!data || size == 0) {
+		ERROR("ObjLoader", "parse", "Empty OBJ data");
+		return E_INVALIDARG;
+	}
+
+	// Cortar en chunks que terminan en fin de linea
+	m_chunks.clear();
+	const char* end = data + size;
+	for (const char* begin = data; begin < end;) {
+		const char* split = begin + CHUNK_SIZE < end ? nextLine(begin + CHUNK_SIZE, end) : end;
+		Chunk chunk;
+		chunk.begin = begin;
+		chunk.end = split;
+		chunk.normals = 0;
+		chunk.failed = false;
+		m_chunks.push_back(chunk);
+		begin = split;
+	}
+	m_stats.chunks = static_cast<unsigned int>(m_chunks.size());
+
+	Clock::time_point start = Clock::now();
+	if (jobs) {
+		jobs->parallelFor(static_cast<unsigned int>(m_chunks.size()), 1, [this](unsigned int begin, unsigned int end) {
+			for (unsigned int i = begin; i < end; ++i) {
+				parseChunk(m_chunks[i]);
+			}
+		});
+	}
+	else {
+		for (size_t i = 0; i < m_chunks.size(); ++i) {
+			parseChunk(m_chunks[i]);
+		}
+	}
+	m_stats.parseMs = elapsedMs(start);
+
+	for (size_t i = 0; i < m_chunks.size(); ++i) {
+		if (m_chunks[i].failed) {
+			ERROR("ObjLoader", "parse", "Malformed OBJ line");
+			m_chunks.clear();
+			return E_FAIL;
+		}
+	}
+
+	start = Clock::now();
+	HRESULT hr = merge(mesh, jobs);
+	m_stats.mergeMs = elapsedMs(start);
+	m_chunks.clear();
+	return hr;
+}
+
+void
+ObjLoader::parseChunk(Chunk& chunk) {
+	// Estimacion gruesa para evitar realocaciones: ~30 bytes por linea
+	size_t estimate = (chunk.end - chunk.begin) / 30;
+	chunk.positions.reserve(estimate / 2);
+	chunk.texcoords.reserve(estimate / 2);
+	chunk.corners.reserve(estimate * 3 / 2);
+	chunk.relative.reserve(estimate * 3 / 2);
+
+	Corner polygon[64];
+	unsigned char polygonRelative[64];
+
+	const char* p = chunk.begin;
+	const char* end = chunk.end;
+	while (p < end) {
+		skipBlanks(p, end);
+		if (p >= end) {
+			break;
+		}
+		const char* lineEnd = static_cast<const char*>(memchr(p, '\n', end - p));
+		if (!lineEnd) {
+			lineEnd = end;
+		}
+
+		if (p[0] == 'v' && p + 1 < lineEnd && isBlank(p[1])) {
+			XMFLOAT3 position;
+			p += 2;
+			skipBlanks(p, lineEnd);
+			bool ok = parseFloat(p, lineEnd, position.x);
+			skipBlanks(p, lineEnd);
+			ok = ok && parseFloat(p, lineEnd, position.y);
+			skipBlanks(p, lineEnd);
+			ok = ok && parseFloat(p, lineEnd, position.z);
+			if (!ok) {
+				chunk.failed = true;
+				return;
+			}
+			position.z = -position.z;
+			chunk.positions.push_back(position);
+		}
+		else if (p[0] == 'v' && p + 2 < lineEnd && p[1] == 't' && isBlank(p[2])) {
+			XMFLOAT2 texcoord;
+			p += 3;
+			skipBlanks(p, lineEnd);
+			bool ok = parseFloat(p, lineEnd, texcoord.x);
+			skipBlanks(p, lineEnd);
+			// v es opcional en la especificacion
+			if (!parseFloat(p, lineEnd, texcoord.y)) {
+				texcoord.y = 0.0f;
+			}
+			if (!ok) {
+				chunk.failed = true;
+				return;
+			}
+			texcoord.y = 1.0f - texcoord.y;
+			chunk.texcoords.push_back(texcoord);
+		}
+		else if (p[0] == 'v' && p + 2 < lineEnd && p[1] == 'n' && isBlank(p[2])) {
+			chunk.normals++;
+		}
+		else if (p[0] == 'f' && p + 1 < lineEnd && isBlank(p[1])) {
+			p += 2;
+			unsigned int count = 0;
+			for (;;) {
+				skipBlanks(p, lineEnd);
+				int raw;
+				if (p >= lineEnd || !parseInt(p, lineEnd, raw)) {
+					break;
+				}
+				if (count == 64) {
+					chunk.failed = true;
+					return;
+				}
+				Corner& corner = polygon[count];
+				unsigned char& relative = polygonRelative[count];
+				relative = 0;
+				corner.v = resolveIndex(raw, static_cast<unsigned int>(chunk.positions.size()), RELATIVE_V, relative);
+				corner.vt = -1;
+				corner.vn = -1;
+				if (p < lineEnd && *p == '/') {
+					++p;
+					if (parseInt(p, lineEnd, raw)) {
+						corner.vt = resolveIndex(raw, static_cast<unsigned int>(chunk.texcoords.size()), RELATIVE_VT, relative);
+					}
+					if (p < lineEnd && *p == '/') {
+						++p;
+						if (parseInt(p, lineEnd, raw)) {
+							corner.vn = resolveIndex(raw, chunk.normals, RELATIVE_VN, relative);
+						}
+					}
+				}
+				count++;
+			}
+			if (count < 3) {
+				chunk.failed = true;
+				return;
+			}
+			// Abanico con el orden invertido por el cambio de mano
+			for (unsigned int i = 1; i + 1 < count; ++i) {
+				chunk.corners.push_back(polygon[0]);
+				chunk.corners.push_back(polygon[i + 1]);
+				chunk.corners.push_back(polygon[i]);
+				chunk.relative.push_back(polygonRelative[0]);
+				chunk.relative.push_back(polygonRelative[i + 1]);
+				chunk.relative.push_back(polygonRelative[i]);
+			}
+		}
+		// Comentarios, grupos, materiales, etc. se ignoran
+
+		p = lineEnd < end ? lineEnd + 1 : end;
+	}
+}
+
+HRESULT
+ObjLoader::merge(MeshComponent& mesh, JobSystem* jobs) {
+	const unsigned int chunkCount = static_cast<unsigned int>(m_chunks.size());
+
+	// Base de cada chunk dentro de los arreglos globales
+	std::vector<unsigned int> positionBase(chunkCount + 1, 0);
+	std::vector<unsigned int> texcoordBase(chunkCount + 1, 0);
+	std::vector<unsigned int> normalBase(chunkCount + 1, 0);
+	std::vector<unsigned int> cornerBase(chunkCount + 1, 0);
+	for (unsigned int i = 0; i < chunkCount; ++i) {
+		positionBase[i + 1] = positionBase[i] + static_cast<unsigned int>(m_chunks[i].positions.size());
+		texcoordBase[i + 1] = texcoordBase[i] + static_cast<unsigned int>(m_chunks[i].texcoords.size());
+		normalBase[i + 1] = normalBase[i] + m_chunks[i].normals;
+		cornerBase[i + 1] = cornerBase[i] + static_cast<unsigned int>(m_chunks[i].corners.size());
+	}
+	const unsigned int positionCount = positionBase[chunkCount];
+	const unsigned int texcoordCount = texcoordBase[chunkCount];
+	const unsigned int normalCount = normalBase[chunkCount];
+	const unsigned int cornerCount = cornerBase[chunkCount];
+	m_stats.positions = positionCount;
+	m_stats.texcoords = texcoordCount;
+	m_stats.normals = normalCount;
+	m_stats.triangles = cornerCount / 3;
+	if (cornerCount == 0) {
+		ERROR("ObjLoader", "merge", "OBJ has no faces");
+		return E_FAIL;
+	}
+
+	std::vector<XMFLOAT3> positions(positionCount);
+	std::vector<XMFLOAT2> texcoords(texcoordCount);
+	std::vector<Corner> corners(cornerCount);
+	std::vector<unsigned char> invalid(chunkCount, 0);
+
+	// Copiar cada chunk a su lugar y resolver indices relativos
+	auto gather = [&](unsigned int begin, unsigned int end) {
+		for (unsigned int c = begin; c < end; ++c) {
+			const Chunk& chunk = m_chunks[c];
+			if (!chunk.positions.empty()) {
+				memcpy(&positions[positionBase[c]], &chunk.positions[0], chunk.positions.size() * sizeof(XMFLOAT3));
+			}
+			if (!chunk.texcoords.empty()) {
+				memcpy(&texcoords[texcoordBase[c]], &chunk.texcoords[0], chunk.texcoords.size() * sizeof(XMFLOAT2));
+			}
+			for (size_t i = 0; i < chunk.corners.size(); ++i) {
+				Corner corner = chunk.corners[i];
+				unsigned char relative = chunk.relative[i];
+				if (relative & RELATIVE_V) {
+					corner.v += positionBase[c];
+				}
+				if ((relative & RELATIVE_VT) && corner.vt != -1) {
+					corner.vt += texcoordBase[c];
+				}
+				if ((relative & RELATIVE_VN) && corner.vn != -1) {
+					corner.vn += normalBase[c];
+				}
+				if (corner.v < 0 || corner.v >= static_cast<int>(positionCount) ||
+						corner.vt < -1 || corner.vt >= static_cast<int>(texcoordCount) ||
+						corner.vn < -1 || corner.vn >= static_cast<int>(normalCount)) {
+					invalid[c] = 1;
+				}
+				corners[cornerBase[c] + i] = corner;
+			}
+		}
+	};
+	if (jobs) {
+		jobs->parallelFor(chunkCount, 1, gather);
+	}
+	else {
+		gather(0, chunkCount);
+	}
+	for (unsigned int c = 0; c < chunkCount; ++c) {
+		if (invalid[c]) {
+			ERROR("ObjLoader", "merge", "Face index out of range");
+			return E_FAIL;
+		}
+	}
+
+	// Deduplicar (v, vt) con direccionamiento abierto; el orden de los
+	// vertices es el de primera aparicion, igual en serie y en paralelo
+	unsigned int tableSize = 1;
+	while (tableSize < cornerCount * 2) {
+		tableSize <<= 1;
+	}
+	const unsigned long long EMPTY = ~0ull;
+	std::vector<unsigned long long> keys(tableSize, EMPTY);
+	std::vector<unsigned int> slots(tableSize);
+	const unsigned int mask = tableSize - 1;
+
+	mesh.m_vertex.clear();
+	mesh.m_vertex.reserve(positionCount > texcoordCount ? positionCount : texcoordCount);
+	mesh.m_index.resize(cornerCount);
+	for (unsigned int i = 0; i < cornerCount; ++i) {
+		const Corner& corner = corners[i];
+		unsigned long long key = (static_cast<unsigned long long>(corner.v) << 32) |
+														 static_cast<unsigned int>(corner.vt + 1);
+		unsigned int slot = static_cast<unsigned int>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+		while (keys[slot] != EMPTY && keys[slot] != key) {
+			slot = (slot + 1) & mask;
+		}
+		if (keys[slot] == EMPTY) {
+			keys[slot] = key;
+			slots[slot] = static_cast<unsigned int>(mesh.m_vertex.size());
+			SimpleVertex vertex;
+			vertex.Pos = positions[corner.v];
+			vertex.Tex = corner.vt >= 0 ? texcoords[corner.vt] : XMFLOAT2(0.0f, 0.0f);
+			mesh.m_vertex.push_back(vertex);
+		}
+		mesh.m_index[i] = slots[slot];
+	}
+
+	mesh.m_numVertex = static_cast<int>(mesh.m_vertex.size());
+	mesh.m_numIndex = static_cast<int>(mesh.m_index.size());
+	m_stats.vertices = mesh.m_numVertex;
+	return S_OK;
+}
@@ -0,0 +1,329 @@
+#include "OcclusionCuller.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <xmmintrin.h>
+
+namespace {
+	typedef std::chrono::steady_clock Clock;
+
+	double
+	elapsedMs(Clock::time_point start) {
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	// (x, y, z, 1) * m
+	inline Float4
+	transformPoint(const float* p, const Float4x4& m) {
+		return Float4(p[0] * m.m[0][0] + p[1] * m.m[1][0] + p[2] * m.m[2][0] + m.m[3][0],
+									p[0] * m.m[0][1] + p[1] * m.m[1][1] + p[2] * m.m[2][1] + m.m[3][1],
+									p[0] * m.m[0][2] + p[1] * m.m[1][2] + p[2] * m.m[2][2] + m.m[3][2],
+									p[0] * m.m[0][3] + p[1] * m.m[1][3] + p[2] * m.m[2][3] + m.m[3][3]);
+	}
+
+	inline Float4
+	lerp(const Float4& a, const Float4& b, float t) {
+		return Float4(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t,
+									a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t);
+	}
+
+	inline void
+	multiply(const Float4x4& a, const Float4x4& b, Float4x4& out) {
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				out.m[i][j] = a.m[i][0] * b.m[0][j] + a.m[i][1] * b.m[1][j] +
+											a.m[i][2] * b.m[2][j] + a.m[i][3] * b.m[3][j];
+			}
+		}
+	}
+}
+
+void
+OcclusionCuller::init(unsigned int width, unsigned int height) {
+	m_tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+	m_tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+	m_width = m_tilesX * TILE_SIZE;
+	m_height = m_tilesY * TILE_SIZE;
+	m_depth.assign(m_width * m_height, 1.0f);
+	m_tileMax.assign(m_tilesX * m_tilesY, 1.0f);
+}
+
+void
+OcclusionCuller::beginFrame(const Float4x4& viewProjection) {
+	m_viewProjection = viewProjection;
+	std::fill(m_depth.begin(), m_depth.end(), 1.0f);
+	m_stats = OcclusionStats();
+}
+
+void
+OcclusionCuller::addOccluder(const float* positions, unsigned int vertexCount, unsigned int stride,
+														 const unsigned int* indices, unsigned int indexCount, const Float4x4& world) {
+	Clock::time_point start = Clock::now();
+
+	Float4x4 worldViewProjection;
+	multiply(world, m_viewProjection, worldViewProjection);
+
+	const unsigned char* vertex = reinterpret_cast<const unsigned char*>(positions);
+	m_clip.resize(vertexCount);
+	for (unsigned int i = 0; i < vertexCount; ++i) {
+		m_clip[i] = transformPoint(reinterpret_cast<const float*>(vertex + i * stride), worldViewProjection);
+	}
+	for (unsigned int i = 0; i + 2 < indexCount; i += 3) {
+		clipAndRasterize(m_clip[indices[i]], m_clip[indices[i + 1]], m_clip[indices[i + 2]]);
+	}
+
+	m_stats.occluders++;
+	m_stats.rasterMs += elapsedMs(start);
+}
+
+void
+OcclusionCuller::addOccluderTriangles(const Float3* positions, unsigned int triangleCount, const Float4x4& world) {
+	Clock::time_point start = Clock::now();
+
+	Float4x4 worldViewProjection;
+	multiply(world, m_viewProjection, worldViewProjection);
+
+	for (unsigned int t = 0; t < triangleCount; ++t) {
+		clipAndRasterize(transformPoint(&positions[t * 3 + 0].x, worldViewProjection),
+										 transformPoint(&positions[t * 3 + 1].x, worldViewProjection),
+										 transformPoint(&positions[t * 3 + 2].x, worldViewProjection));
+	}
+
+	m_stats.occluders++;
+	m_stats.rasterMs += elapsedMs(start);
+}
+
+void
+OcclusionCuller::clipAndRasterize(const Float4& a, const Float4& b, const Float4& c) {
+	// Sutherland-Hodgman contra z >= 0 (plano cercano de D3D): 3 o 4 vertices
+	const Float4* in[3] = { &a, &b, &c };
+	Float4 out[4];
+	unsigned int count = 0;
+	for (int i = 0; i < 3; ++i) {
+		const Float4& current = *in[i];
+		const Float4& next = *in[(i + 1) % 3];
+		if (current.z >= 0.0f) {
+			out[count++] = current;
+		}
+		if ((current.z >= 0.0f) != (next.z >= 0.0f)) {
+			out[count++] = lerp(current, next, current.z / (current.z - next.z));
+		}
+	}
+	if (count < 3) {
+		return;
+	}
+
+	Float3 screen[4];
+	for (unsigned int i = 0; i < count; ++i) {
+		// Con z >= 0 y una proyeccion en perspectiva w > 0; se descarta lo degenerado
+		if (out[i].w <= 1e-6f) {
+			return;
+		}
+		screen[i] = toScreen(out[i]);
+	}
+	rasterizeTriangle(screen[0], screen[1], screen[2]);
+	if (count == 4) {
+		rasterizeTriangle(screen[0], screen[2], screen[3]);
+	}
+}
+
+Float3
+OcclusionCuller::toScreen(const Float4& clip) const {
+	float invW = 1.0f / clip.w;
+	return Float3((clip.x * invW * 0.5f + 0.5f) * m_width,
+								(0.5f - clip.y * invW * 0.5f) * m_height,
+								clip.z * invW);
+}
+
+void
+OcclusionCuller::rasterizeTriangle(const Float3& v0, const Float3& in1, const Float3& in2) {
+	// Orientar el triangulo para que el area sea positiva (sin backface culling)
+	float area = (in1.x - v0.x) * (in2.y - v0.y) - (in1.y - v0.y) * (in2.x - v0.x);
+	if (area == 0.0f) {
+		return;
+	}
+	const Float3& v1 = area > 0.0f ? in1 : in2;
+	const Float3& v2 = area > 0.0f ? in2 : in1;
+	area = fabsf(area);
+
+	float minXf = fminf(v0.x, fminf(v1.x, v2.x));
+	float maxXf = fmaxf(v0.x, fmaxf(v1.x, v2.x));
+	float minYf = fminf(v0.y, fminf(v1.y, v2.y));
+	float maxYf = fmaxf(v0.y, fmaxf(v1.y, v2.y));
+	if (maxXf < 0.0f || maxYf < 0.0f || minXf >= m_width || minYf >= m_height) {
+		return;
+	}
+	int minX = static_cast<int>(fmaxf(minXf, 0.0f)) & ~3;
+	int maxX = static_cast<int>(fminf(maxXf, static_cast<float>(m_width - 1)));
+	int minY = static_cast<int>(fmaxf(minYf, 0.0f));
+	int maxY = static_cast<int>(fminf(maxYf, static_cast<float>(m_height - 1)));
+
+	// Funciones de arista e(p) = A * x + B * y + C, positivas dentro
+	const Float3* edgeFrom[3] = { &v1, &v2, &v0 };
+	const Float3* edgeTo[3] = { &v2, &v0, &v1 };
+	float edgeA[3], edgeB[3], edgeC[3];
+	for (int e = 0; e < 3; ++e) {
+		edgeA[e] = edgeFrom[e]->y - edgeTo[e]->y;
+		edgeB[e] = edgeTo[e]->x - edgeFrom[e]->x;
+		edgeC[e] = -edgeA[e] * edgeFrom[e]->x - edgeB[e] * edgeFrom[e]->y;
+	}
+
+	// z interpolado linealmente en pantalla: z = zA * x + zB * y + zC
+	float invArea = 1.0f / area;
+	float zA = (edgeA[1] * (v1.z - v0.z) + edgeA[2] * (v2.z - v0.z)) * invArea;
+	float zB = (edgeB[1] * (v1.z - v0.z) + edgeB[2] * (v2.z - v0.z)) * invArea;
+	float zC = v0.z + (edgeC[1] * (v1.z - v0.z) + edgeC[2] * (v2.z - v0.z)) * invArea;
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 pixelOffset = _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f);
+	const __m128 a0 = _mm_set1_ps(edgeA[0]), a1 = _mm_set1_ps(edgeA[1]), a2 = _mm_set1_ps(edgeA[2]);
+	const __m128 za = _mm_set1_ps(zA);
+	const __m128 step4 = _mm_set1_ps(4.0f);
+
+	for (int y = minY; y <= maxY; ++y) {
+		float py = y + 0.5f;
+		__m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(minX)), pixelOffset);
+		__m128 rowE0 = _mm_set1_ps(edgeB[0] * py + edgeC[0]);
+		__m128 rowE1 = _mm_set1_ps(edgeB[1] * py + edgeC[1]);
+		__m128 rowE2 = _mm_set1_ps(edgeB[2] * py + edgeC[2]);
+		__m128 rowZ = _mm_set1_ps(zB * py + zC);
+		float* row = &m_depth[y * m_width];
+
+		for (int x = minX; x <= maxX; x += 4) {
+			__m128 e0 = _mm_add_ps(_mm_mul_ps(a0, px), rowE0);
+			__m128 e1 = _mm_add_ps(_mm_mul_ps(a1, px), rowE1);
+			__m128 e2 = _mm_add_ps(_mm_mul_ps(a2, px), rowE2);
+			__m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)),
+																 _mm_cmpge_ps(e2, zero));
+			if (_mm_movemask_ps(inside)) {
+				__m128 z = _mm_add_ps(_mm_mul_ps(za, px), rowZ);
+				__m128 depth = _mm_loadu_ps(row + x);
+				__m128 closer = _mm_min_ps(depth, z);
+				_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, closer), _mm_andnot_ps(inside, depth)));
+			}
+			px = _mm_add_ps(px, step4);
+		}
+	}
+	m_stats.triangles++;
+}
+
+void
+OcclusionCuller::finalize() {
+	Clock::time_point start = Clock::now();
+
+	// Profundidad mas lejana de cada tile de 8x8
+	for (unsigned int ty = 0; ty < m_tilesY; ++ty) {
+		for (unsigned int tx = 0; tx < m_tilesX; ++tx) {
+			const float* tile = &m_depth[ty * TILE_SIZE * m_width + tx * TILE_SIZE];
+			__m128 farthest = _mm_loadu_ps(tile);
+			for (unsigned int y = 0; y < TILE_SIZE; ++y) {
+				farthest = _mm_max_ps(farthest, _mm_loadu_ps(tile + y * m_width));
+				farthest = _mm_max_ps(farthest, _mm_loadu_ps(tile + y * m_width + 4));
+			}
+			farthest = _mm_max_ps(farthest, _mm_shuffle_ps(farthest, farthest, _MM_SHUFFLE(1, 0, 3, 2)));
+			farthest = _mm_max_ps(farthest, _mm_shuffle_ps(farthest, farthest, _MM_SHUFFLE(2, 3, 0, 1)));
+			_mm_store_ss(&m_tileMax[ty * m_tilesX + tx], farthest);
+		}
+	}
+
+	m_stats.rasterMs += elapsedMs(start);
+}
+
+bool
+OcclusionCuller::isVisible(const Bounds& worldBounds) {
+	Clock::time_point start = Clock::now();
+	m_stats.tested++;
+
+	// Proyectar las 8 esquinas de la caja: 4 por registro
+	const Float3& c = worldBounds.center;
+	const Float3& e = worldBounds.extents;
+	const __m128 signX = _mm_set_ps(1.0f, -1.0f, 1.0f, -1.0f);
+	const __m128 signY = _mm_set_ps(1.0f, 1.0f, -1.0f, -1.0f);
+	const Float4x4& m = m_viewProjection;
+
+	__m128 minX = _mm_set1_ps(1e30f), minY = _mm_set1_ps(1e30f), minZ = _mm_set1_ps(1e30f);
+	__m128 maxX = _mm_set1_ps(-1e30f), maxY = _mm_set1_ps(-1e30f);
+	__m128 minW = _mm_set1_ps(1e30f);
+	for (int half = 0; half < 2; ++half) {
+		__m128 px = _mm_add_ps(_mm_set1_ps(c.x), _mm_mul_ps(signX, _mm_set1_ps(e.x)));
+		__m128 py = _mm_add_ps(_mm_set1_ps(c.y), _mm_mul_ps(signY, _mm_set1_ps(e.y)));
+		__m128 pz = _mm_set1_ps(half == 0 ? c.z - e.z : c.z + e.z);
+
+		__m128 cx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(m.m[0][0])), _mm_mul_ps(py, _mm_set1_ps(m.m[1][0]))),
+													 _mm_add_ps(_mm_mul_ps(pz, _mm_set1_ps(m.m[2][0])), _mm_set1_ps(m.m[3][0])));
+		__m128 cy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(m.m[0][1])), _mm_mul_ps(py, _mm_set1_ps(m.m[1][1]))),
+													 _mm_add_ps(_mm_mul_ps(pz, _mm_set1_ps(m.m[2][1])), _mm_set1_ps(m.m[3][1])));
+		__m128 cz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(m.m[0][2])), _mm_mul_ps(py, _mm_set1_ps(m.m[1][2]))),
+													 _mm_add_ps(_mm_mul_ps(pz, _mm_set1_ps(m.m[2][2])), _mm_set1_ps(m.m[3][2])));
+		__m128 cw = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, _mm_set1_ps(m.m[0][3])), _mm_mul_ps(py, _mm_set1_ps(m.m[1][3]))),
+													 _mm_add_ps(_mm_mul_ps(pz, _mm_set1_ps(m.m[2][3])), _mm_set1_ps(m.m[3][3])));
+		minW = _mm_min_ps(minW, cw);
+
+		__m128 invW = _mm_div_ps(_mm_set1_ps(1.0f), cw);
+		__m128 sx = _mm_mul_ps(cx, invW);
+		__m128 sy = _mm_mul_ps(cy, invW);
+		__m128 sz = _mm_mul_ps(cz, invW);
+		minX = _mm_min_ps(minX, sx);
+		maxX = _mm_max_ps(maxX, sx);
+		minY = _mm_min_ps(minY, sy);
+		maxY = _mm_max_ps(maxY, sy);
+		minZ = _mm_min_ps(minZ, sz);
+	}
+
+	float lanes[4];
+	_mm_storeu_ps(lanes, minW);
+	float nearestW = fminf(fminf(lanes[0], lanes[1]), fminf(lanes[2], lanes[3]));
+	// La caja cruza el plano de la camara: se considera visible
+	if (nearestW <= 1e-6f) {
+		m_stats.testMs += elapsedMs(start);
+		return true;
+	}
+
+	float rect[5];
+	_mm_storeu_ps(lanes, minX);
+	rect[0] = fminf(fminf(lanes[0], lanes[1]), fminf(lanes[2], lanes[3]));
+	_mm_storeu_ps(lanes, maxX);
+	rect[1] = fmaxf(fmaxf(lanes[0], lanes[1]), fmaxf(lanes[2], lanes[3]));
+	_mm_storeu_ps(lanes, minY);
+	rect[2] = fminf(fminf(lanes[0], lanes[1]), fminf(lanes[2], lanes[3]));
+	_mm_storeu_ps(lanes, maxY);
+	rect[3] = fmaxf(fmaxf(lanes[0], lanes[1]), fmaxf(lanes[2], lanes[3]));
+	_mm_storeu_ps(lanes, minZ);
+	rect[4] = fminf(fminf(lanes[0], lanes[1]), fminf(lanes[2], lanes[3]));
+
+	// NDC a tiles (y hacia abajo en pantalla)
+	int tileX0 = static_cast<int>(floorf((rect[0] * 0.5f + 0.5f) * m_width / TILE_SIZE));
+	int tileX1 = static_cast<int>(floorf((rect[1] * 0.5f + 0.5f) * m_width / TILE_SIZE));
+	int tileY0 = static_cast<int>(floorf((0.5f - rect[3] * 0.5f) * m_height / TILE_SIZE));
+	int tileY1 = static_cast<int>(floorf((0.5f - rect[2] * 0.5f) * m_height / TILE_SIZE));
+	tileX0 = tileX0 < 0 ? 0 : tileX0;
+	tileY0 = tileY0 < 0 ? 0 : tileY0;
+	tileX1 = tileX1 >= static_cast<int>(m_tilesX) ? m_tilesX - 1 : tileX1;
+	tileY1 = tileY1 >= static_cast<int>(m_tilesY) ? m_tilesY - 1 : tileY1;
+
+	// Fuera de pantalla lo resuelve el frustum culling
+	bool visible = tileX0 > tileX1 || tileY0 > tileY1;
+	for (int ty = tileY0; ty <= tileY1 && !visible; ++ty) {
+		for (int tx = tileX0; tx <= tileX1; ++tx) {
+			if (rect[4] <= m_tileMax[ty * m_tilesX + tx]) {
+				visible = true;
+				break;
+			}
+		}
+	}
+
+	if (!visible) {
+		m_stats.culled++;
+	}
+	m_stats.testMs += elapsedMs(start);
+	return visible;
+}
+
+void
+OcclusionCuller::destroy() {
+	m_depth.clear();
+	m_tileMax.clear();
+	m_clip.clear();
+	m_width = m_height = 0;
+	m_tilesX = m_tilesY = 0;
+}
@@ -0,0 +1,93 @@
+#include "ParameterBlock.h"
+#include "Device.h"
+#include "DeviceContext.h"
+#include <algorithm>
+#include <cstring>
+
+HRESULT
+ParameterBlock::init(Device& device, const ConstantBufferLayout& layout) {
+	if (layout.size == 0 || (layout.size & 15) != 0) {
+		ERROR("ParameterBlock", "init",
+			("Invalid constant buffer size for " + layout.name + ": " + std::to_string(layout.size)).c_str());
+		return E_INVALIDARG;
+	}
+	destroy();
+	HRESULT hr = m_buffer.init(device, layout.size);
+	if (FAILED(hr)) {
+		ERROR("ParameterBlock", "init",
+			("Failed to create constant buffer " + layout.name + ". HRESULT: " + std::to_string(hr)).c_str());
+		return hr;
+	}
+	m_layout = layout;
+	m_data.assign(layout.size, 0);
+	// El contenido inicial del buffer no esta definido: la primera vez se sube
+	invalidate();
+	return S_OK;
+}
+
+void
+ParameterBlock::destroy() {
+	m_buffer.destroy();
+	m_data.clear();
+	m_dirtyBegin = 0;
+	m_dirtyEnd = 0;
+	m_stats = ParameterBlockStats();
+}
+
+bool
+ParameterBlock::set(unsigned int parameter, const void* data, unsigned int size) {
+	if (parameter >= m_layout.parameters.size()) {
+		ERROR("ParameterBlock", "set", ("Invalid parameter for " + m_layout.name).c_str());
+		return false;
+	}
+	const ShaderParameter& entry = m_layout.parameters[parameter];
+	return setRaw(entry.offset, data, std::min(size, entry.size));
+}
+
+bool
+ParameterBlock::setRaw(unsigned int offset, const void* data, unsigned int size) {
+	if (!data || offset > m_data.size() || size > m_data.size() - offset) {
+		ERROR("ParameterBlock", "setRaw", ("Write out of range in " + m_layout.name).c_str());
+		return false;
+	}
+	unsigned char* destination = &m_data[offset];
+	if (memcmp(destination, data, size) == 0) {
+		return false;
+	}
+	memcpy(destination, data, size);
+	if (isDirty()) {
+		m_dirtyBegin = std::min(m_dirtyBegin, offset);
+		m_dirtyEnd = std::max(m_dirtyEnd, offset + size);
+	}
+	else {
+		m_dirtyBegin = offset;
+		m_dirtyEnd = offset + size;
+	}
+	return true;
+}
+
+void
+ParameterBlock::invalidate() {
+	m_dirtyBegin = 0;
+	m_dirtyEnd = static_cast<unsigned int>(m_data.size());
+}
+
+bool
+ParameterBlock::update(DeviceContext& deviceContext) {
+	if (!isDirty()) {
+		m_stats.skipped++;
+		return false;
+	}
+	m_buffer.update(deviceContext, nullptr, 0, nullptr, m_data.data(), 0, 0);
+	m_stats.uploads++;
+	m_stats.bytes += m_data.size();
+	m_stats.dirtyBytes += m_dirtyEnd - m_dirtyBegin;
+	m_dirtyBegin = 0;
+	m_dirtyEnd = 0;
+	return true;
+}
+
+void
+ParameterBlock::render(DeviceContext& deviceContext, bool setPixelShader) {
+	m_buffer.render(deviceContext, m_layout.slot, 1, setPixelShader);
+}
@@ -0,0 +1,145 @@
+#include "PlanarShadows.h"
+#include <cmath>
+#include <xmmintrin.h>
+
+unsigned int
+PlanarShadows::addLight(const XMFLOAT4& light) {
+	m_lights.push_back(light);
+	return static_cast<unsigned int>(m_lights.size() - 1);
+}
+
+void
+PlanarShadows::setLight(unsigned int index, const XMFLOAT4& light) {
+	m_lights[index] = light;
+}
+
+unsigned int
+PlanarShadows::addReceiver(const XMFLOAT4& plane) {
+	float length = sqrtf(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+	if (length <= 0.0f) {
+		ERROR("PlanarShadows", "addReceiver", "Plane normal is zero");
+		return 0xffffffff;
+	}
+	float inv = 1.0f / length;
+	m_receivers.push_back(XMFLOAT4(plane.x * inv, plane.y * inv, plane.z * inv, plane.w * inv));
+	return static_cast<unsigned int>(m_receivers.size() - 1);
+}
+
+XMFLOAT4X4
+PlanarShadows::shadowMatrix(const XMFLOAT4& light, const XMFLOAT4& plane) {
+	// v' = dot(P, L) * v - dot(v, P) * L  ->  M[i][j] = d * (i == j) - P[i] * L[j]
+	const float p[4] = { plane.x, plane.y, plane.z, plane.w };
+	const float l[4] = { light.x, light.y, light.z, light.w };
+	float d = p[0] * l[0] + p[1] * l[1] + p[2] * l[2] + p[3] * l[3];
+
+	XMFLOAT4X4 m;
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			m.m[i][j] = (i == j ? d : 0.0f) - p[i] * l[j];
+		}
+	}
+	return m;
+}
+
+XMFLOAT4
+PlanarShadows::biasedPlane(unsigned int receiver) const {
+	// Subir el plano bias unidades en la direccion de su normal
+	XMFLOAT4 plane = m_receivers[receiver];
+	plane.w -= m_bias;
+	return plane;
+}
+
+unsigned int
+PlanarShadows::build(const XMFLOAT4X4* casterWorlds,
+										 const XMFLOAT4* colors,
+										 unsigned int casterCount,
+										 std::vector<CBChangesEveryFrame>& out) {
+	const unsigned int pairCount = static_cast<unsigned int>(m_lights.size() * m_receivers.size());
+	m_matrices.resize(pairCount);
+	for (unsigned int l = 0; l < m_lights.size(); ++l) {
+		for (unsigned int r = 0; r < m_receivers.size(); ++r) {
+			m_matrices[l * m_receivers.size() + r] = shadowMatrix(m_lights[l], biasedPlane(r));
+		}
+	}
+
+	out.resize(pairCount * casterCount);
+	for (unsigned int pair = 0; pair < pairCount; ++pair) {
+		const XMFLOAT4X4& s = m_matrices[pair];
+		const __m128 s0 = _mm_loadu_ps(s.m[0]);
+		const __m128 s1 = _mm_loadu_ps(s.m[1]);
+		const __m128 s2 = _mm_loadu_ps(s.m[2]);
+		const __m128 s3 = _mm_loadu_ps(s.m[3]);
+
+		CBChangesEveryFrame* dst = &out[pair * casterCount];
+		for (unsigned int c = 0; c < casterCount; ++c) {
+			// Fila i de W * S = sum_k W[i][k] * S[k]
+			const XMFLOAT4X4& w = casterWorlds[c];
+			__m128 rows[4];
+			for (int i = 0; i < 4; ++i) {
+				rows[i] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(w.m[i][0]), s0),
+																				_mm_mul_ps(_mm_set1_ps(w.m[i][1]), s1)),
+														 _mm_add_ps(_mm_mul_ps(_mm_set1_ps(w.m[i][2]), s2),
+																				_mm_mul_ps(_mm_set1_ps(w.m[i][3]), s3)));
+			}
+			// El shader espera la matriz transpuesta, igual que mWorld
+			_MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+			float* world = reinterpret_cast<float*>(&dst[c].mWorld);
+			_mm_storeu_ps(world + 0, rows[0]);
+			_mm_storeu_ps(world + 4, rows[1]);
+			_mm_storeu_ps(world + 8, rows[2]);
+			_mm_storeu_ps(world + 12, rows[3]);
+			dst[c].vMeshColor = colors[c];
+		}
+	}
+	return static_cast<unsigned int>(out.size());
+}
+
+bool
+PlanarShadows::projectBounds(const Bounds& casterBounds,
+														 unsigned int light,
+														 unsigned int receiver,
+														 Bounds& shadowBounds) const {
+	XMFLOAT4X4 s = shadowMatrix(m_lights[light], biasedPlane(receiver));
+	const Float3& c = casterBounds.center;
+	const Float3& e = casterBounds.extents;
+
+	float minimum[3] = { 1e30f, 1e30f, 1e30f };
+	float maximum[3] = { -1e30f, -1e30f, -1e30f };
+	for (int corner = 0; corner < 8; ++corner) {
+		float p[4] = { c.x + ((corner & 1) ? e.x : -e.x),
+									 c.y + ((corner & 2) ? e.y : -e.y),
+									 c.z + ((corner & 4) ? e.z : -e.z),
+									 1.0f };
+		float q[4];
+		for (int j = 0; j < 4; ++j) {
+			q[j] = p[0] * s.m[0][j] + p[1] * s.m[1][j] + p[2] * s.m[2][j] + p[3] * s.m[3][j];
+		}
+		// w <= 0: la esquina no queda entre la luz y el plano
+		if (q[3] <= 1e-6f) {
+			return false;
+		}
+		for (int j = 0; j < 3; ++j) {
+			float v = q[j] / q[3];
+			minimum[j] = v < minimum[j] ? v : minimum[j];
+			maximum[j] = v > maximum[j] ? v : maximum[j];
+		}
+	}
+
+	shadowBounds.center = Float3((minimum[0] + maximum[0]) * 0.5f,
+															 (minimum[1] + maximum[1]) * 0.5f,
+															 (minimum[2] + maximum[2]) * 0.5f);
+	shadowBounds.extents = Float3((maximum[0] - minimum[0]) * 0.5f,
+																(maximum[1] - minimum[1]) * 0.5f,
+																(maximum[2] - minimum[2]) * 0.5f);
+	shadowBounds.radius = sqrtf(shadowBounds.extents.x * shadowBounds.extents.x +
+															shadowBounds.extents.y * shadowBounds.extents.y +
+															shadowBounds.extents.z * shadowBounds.extents.z);
+	return true;
+}
+
+void
+PlanarShadows::clear() {
+	m_lights.clear();
+	m_receivers.clear();
+	m_matrices.clear();
+}
@@ -0,0 +1,437 @@
+#include "RenderQueue.h"
+#include "DeviceContext.h"
+#include "Buffer.h"
+#include "ShaderProgram.h"
+#include "BlendState.h"
+#include "DepthStencilState.h"
+#include "ConstantBufferRing.h"
+
+void
+RenderQueue::init(unsigned int expectedPackets) {
+	m_packets.reserve(expectedPackets);
+	m_sorted.reserve(expectedPackets);
+	m_scratch.reserve(expectedPackets);
+	m_constantData.reserve(expectedPackets * sizeof(CBChangesEveryFrame));
+	clear();
+}
+
+HRESULT
+RenderQueue::initInstancing(Device& device, unsigned int maxInstances) {
+	HRESULT hr = m_instanceBuffer.initDynamic(device,
+																						maxInstances * sizeof(CBChangesEveryFrame),
+																						sizeof(CBChangesEveryFrame),
+																						D3D11_BIND_VERTEX_BUFFER);
+	if (FAILED(hr)) {
+		ERROR("RenderQueue", "initInstancing",
+			("Failed to create instance buffer. HRESULT: " + std::to_string(hr)).c_str());
+		return hr;
+	}
+	m_instanceCapacity = maxInstances;
+	return S_OK;
+}
+
+unsigned long long
+RenderQueue::makeSortKey(RenderPass pass,
+												 unsigned int shaderId,
+												 unsigned int materialId,
+												 float depth01) {
+	if (depth01 < 0.0f) {
+		depth01 = 0.0f;
+	}
+	if (depth01 > 1.0f) {
+		depth01 = 1.0f;
+	}
+	unsigned long long depth = static_cast<unsigned long long>(depth01 * 16777215.0f);
+	// Transparentes: de atras hacia adelante
+	if (pass != RENDER_PASS_OPAQUE) {
+		depth = 0xffffffull - depth;
+	}
+
+	return (static_cast<unsigned long long>(pass & 0xf) << 60) |
+				 (static_cast<unsigned long long>(shaderId & 0xfff) << 48) |
+				 (static_cast<unsigned long long>(materialId & 0xffffff) << 24) |
+				 depth;
+}
+
+void
+RenderQueue::submit(const DrawPacket& packet,
+										const void* constantData,
+										unsigned int constantSize) {
+	if (!packet.vertexBuffer || !packet.indexBuffer || (!packet.shaderProgram && !packet.instancedProgram)) {
+		ERROR("RenderQueue", "submit", "Packet without geometry or shader program");
+		return;
+	}
+
+	DrawPacket stored = packet;
+	stored.constantDataSize = constantData ? constantSize : 0;
+	if (!stored.shaderProgram && !canInstance(stored)) {
+		ERROR("RenderQueue", "submit", "Instanced-only packet that cannot be instanced");
+		return;
+	}
+	if (stored.constantDataSize > 0) {
+		// Mantener alineacion de 16 bytes para las matrices
+		size_t offset = (m_constantData.size() + 15) & ~static_cast<size_t>(15);
+		m_constantData.resize(offset + constantSize);
+		memcpy(m_constantData.data() + offset, constantData, constantSize);
+		stored.constantDataOffset = static_cast<unsigned int>(offset);
+	}
+
+	SortEntry entry;
+	entry.key = stored.sortKey;
+	entry.index = static_cast<unsigned int>(m_packets.size());
+	m_packets.push_back(stored);
+	m_sorted.push_back(entry);
+	m_isSorted = false;
+}
+
+void
+RenderQueue::sort() {
+	const size_t count = m_sorted.size();
+	if (count < 2) {
+		m_isSorted = true;
+		return;
+	}
+
+	// Histograma de los 8 digitos en una sola pasada
+	unsigned int histogram[8][256];
+	memset(histogram, 0, sizeof(histogram));
+	for (size_t i = 0; i < count; ++i) {
+		unsigned long long key = m_sorted[i].key;
+		for (unsigned int digit = 0; digit < 8; ++digit) {
+			histogram[digit][(key >> (digit * 8)) & 0xff]++;
+		}
+	}
+
+	m_scratch.resize(count);
+	SortEntry* src = m_sorted.data();
+	SortEntry* dst = m_scratch.data();
+
+	for (unsigned int digit = 0; digit < 8; ++digit) {
+		unsigned int* counts = histogram[digit];
+		unsigned int shift = digit * 8;
+
+		// Si todas las keys comparten el digito la pasada no cambia nada
+		if (counts[(src[0].key >> shift) & 0xff] == count) {
+			continue;
+		}
+
+		unsigned int offsets[256];
+		unsigned int sum = 0;
+		for (unsigned int b = 0; b < 256; ++b) {
+			offsets[b] = sum;
+			sum += counts[b];
+		}
+		for (size_t i = 0; i < count; ++i) {
+			dst[offsets[(src[i].key >> shift) & 0xff]++] = src[i];
+		}
+		SortEntry* tmp = src;
+		src = dst;
+		dst = tmp;
+	}
+
+	if (src != m_sorted.data()) {
+		memcpy(m_sorted.data(), src, count * sizeof(SortEntry));
+	}
+	m_isSorted = true;
+}
+
+void
+RenderQueue::execute(DeviceContext& deviceContext) {
+	if (!deviceContext.m_backend) {
+		ERROR("RenderQueue", "execute", "DeviceContext is nullptr.");
+		return;
+	}
+	if (!m_isSorted) {
+		sort();
+	}
+
+	m_stats = RenderQueueStats();
+	m_stats.packets = size();
+
+	buildBatches();
+	m_instanceCursor = m_instanceCapacity;   // El primer map del frame descarta
+
+	BoundState bound;
+	for (size_t b = 0; b < m_batches.size(); ++b) {
+		const Batch& batch = m_batches[b];
+		if (batch.count >= MIN_INSTANCES || !m_packets[batch.first].shaderProgram) {
+			drawInstanced(deviceContext, batch, bound);
+			continue;
+		}
+		for (unsigned int p = batch.first; p != INVALID_INDEX; p = m_nextInBatch[p]) {
+			drawSingle(deviceContext, m_packets[p], bound);
+		}
+	}
+
+	// Dejar el estado por defecto para quien dibuje despues
+	if (bound.blendState) {
+		bound.blendState->render(deviceContext, nullptr, 0xffffffff, true);
+	}
+	if (bound.depthStencilState) {
+		bound.depthStencilState->render(deviceContext, 0, true);
+	}
+}
+
+bool
+RenderQueue::canInstance(const DrawPacket& packet) const {
+	return packet.instancedProgram &&
+				 m_instanceCapacity > 0 &&
+				 !packet.constantBuffer &&
+				 packet.constantDataSize == sizeof(CBChangesEveryFrame);
+}
+
+bool
+RenderQueue::sameBatch(const DrawPacket& a, const DrawPacket& b) {
+	return a.vertexBuffer == b.vertexBuffer &&
+				 a.indexBuffer == b.indexBuffer &&
+				 a.indexCount == b.indexCount &&
+				 a.startIndex == b.startIndex &&
+				 a.baseVertex == b.baseVertex &&
+				 a.shaderProgram == b.shaderProgram &&
+				 a.pixelShaderOverride == b.pixelShaderOverride &&
+				 a.instancedProgram == b.instancedProgram &&
+				 a.texture == b.texture &&
+				 a.sampler == b.sampler &&
+				 a.blendState == b.blendState &&
+				 a.depthStencilState == b.depthStencilState &&
+				 (a.sortKey >> 60) == (b.sortKey >> 60);
+}
+
+size_t
+RenderQueue::batchHash(const DrawPacket& packet) {
+	std::hash<const void*> hashPointer;
+	size_t hash = hashPointer(packet.vertexBuffer);
+	hash = hash * 31 + hashPointer(packet.indexBuffer);
+	hash = hash * 31 + hashPointer(packet.instancedProgram);
+	hash = hash * 31 + hashPointer(packet.texture);
+	hash = hash * 31 + packet.indexCount;
+	return hash;
+}
+
+void
+RenderQueue::buildBatches() {
+	m_batches.clear();
+	m_openBatches.clear();
+	m_nextInBatch.assign(m_packets.size(), INVALID_INDEX);
+
+	unsigned long long currentPass = ~0ull;
+	for (size_t i = 0; i < m_sorted.size(); ++i) {
+		unsigned int index = m_sorted[i].index;
+		const DrawPacket& packet = m_packets[index];
+		unsigned long long pass = packet.sortKey >> 60;
+		if (pass != currentPass) {
+			m_openBatches.clear();
+			currentPass = pass;
+		}
+
+		int target = -1;
+		if (canInstance(packet)) {
+			if (pass == RENDER_PASS_OPAQUE) {
+				// Opacos: el orden entre paquetes no importa, se agrupa con cualquiera
+				size_t hash = batchHash(packet);
+				auto range = m_openBatches.equal_range(hash);
+				for (auto it = range.first; it != range.second; ++it) {
+					if (sameBatch(m_packets[m_batches[it->second].first], packet)) {
+						target = static_cast<int>(it->second);
+						break;
+					}
+				}
+				if (target < 0) {
+					m_openBatches.insert(std::make_pair(hash, static_cast<unsigned int>(m_batches.size())));
+				}
+			}
+			else if (!m_batches.empty()) {
+				// Transparentes: solo con el lote anterior para respetar el orden
+				const Batch& last = m_batches.back();
+				const DrawPacket& lastPacket = m_packets[last.first];
+				if (canInstance(lastPacket) && sameBatch(lastPacket, packet)) {
+					target = static_cast<int>(m_batches.size() - 1);
+				}
+			}
+		}
+
+		if (target < 0) {
+			Batch batch = { index, index, 1 };
+			m_batches.push_back(batch);
+		}
+		else {
+			Batch& batch = m_batches[target];
+			m_nextInBatch[batch.last] = index;
+			batch.last = index;
+			batch.count++;
+		}
+	}
+}
+
+void
+RenderQueue::bindState(DeviceContext& deviceContext,
+											 const DrawPacket& packet,
+											 const ShaderProgram* program,
+											 const ShaderProgram* pixelShader,
+											 BoundState& bound) {
+	// Shaders
+	if (bound.first || bound.program != program) {
+		const_cast<ShaderProgram*>(program)->render(deviceContext);
+		bound.program = program;
+		bound.pixelShader = program;
+		m_stats.shaderChanges++;
+	}
+	if (pixelShader != bound.pixelShader) {
+		const_cast<ShaderProgram*>(pixelShader)->render(deviceContext, PIXEL_SHADER);
+		bound.pixelShader = pixelShader;
+		m_stats.shaderChanges++;
+	}
+
+	// Geometria
+	if (bound.first || bound.vertexBuffer != packet.vertexBuffer) {
+		packet.vertexBuffer->render(deviceContext, 0, 1);
+		bound.vertexBuffer = packet.vertexBuffer;
+		m_stats.geometryChanges++;
+	}
+	if (bound.first || bound.indexBuffer != packet.indexBuffer) {
+		packet.indexBuffer->render(deviceContext, 0, 1);
+		bound.indexBuffer = packet.indexBuffer;
+		m_stats.geometryChanges++;
+	}
+
+	// Material
+	if (bound.first || bound.texture != packet.texture || bound.sampler != packet.sampler) {
+		if (packet.texture) {
+			deviceContext.PSSetShaderResources(0, 1, &packet.texture);
+		}
+		if (packet.sampler) {
+			deviceContext.PSSetSamplers(0, 1, &packet.sampler);
+		}
+		bound.texture = packet.texture;
+		bound.sampler = packet.sampler;
+		m_stats.materialChanges++;
+	}
+
+	// Estados de blending y depth stencil
+	if (packet.blendState != bound.blendState) {
+		if (packet.blendState) {
+			packet.blendState->render(deviceContext);
+		}
+		else {
+			bound.blendState->render(deviceContext, nullptr, 0xffffffff, true);
+		}
+		bound.blendState = packet.blendState;
+		m_stats.stateChanges++;
+	}
+	if (packet.depthStencilState != bound.depthStencilState) {
+		if (packet.depthStencilState) {
+			packet.depthStencilState->render(deviceContext);
+		}
+		else {
+			bound.depthStencilState->render(deviceContext, 0, true);
+		}
+		bound.depthStencilState = packet.depthStencilState;
+		m_stats.stateChanges++;
+	}
+	bound.first = false;
+}
+
+void
+RenderQueue::drawSingle(DeviceContext& deviceContext, const DrawPacket& packet, BoundState& bound) {
+	const ShaderProgram* pixelShader = packet.pixelShaderOverride
+																	 ? packet.pixelShaderOverride
+																	 : packet.shaderProgram;
+	bindState(deviceContext, packet, packet.shaderProgram, pixelShader, bound);
+
+	// Constantes por objeto
+	if (packet.constantBuffer) {
+		if (packet.constantDataSize > 0) {
+			packet.constantBuffer->update(deviceContext,
+																		nullptr,
+																		0,
+																		nullptr,
+																		m_constantData.data() + packet.constantDataOffset,
+																		0,
+																		0);
+		}
+		if (bound.constantBuffer != packet.constantBuffer || bound.constantSlot != packet.constantSlot) {
+			packet.constantBuffer->render(deviceContext, packet.constantSlot, 1, true);
+			bound.constantBuffer = packet.constantBuffer;
+			bound.constantSlot = packet.constantSlot;
+		}
+	}
+	else if (packet.constantDataSize > 0 && m_constantRing) {
+		ID3D11Buffer* slice = m_constantRing->upload(deviceContext,
+																								 m_constantData.data() + packet.constantDataOffset,
+																								 packet.constantDataSize);
+		if (slice) {
+			deviceContext.VSSetConstantBuffers(packet.constantSlot, 1, &slice);
+			deviceContext.PSSetConstantBuffers(packet.constantSlot, 1, &slice);
+			bound.constantBuffer = nullptr;
+		}
+	}
+
+	deviceContext.DrawIndexed(packet.indexCount, packet.startIndex, packet.baseVertex);
+	m_stats.drawCalls++;
+}
+
+void
+RenderQueue::drawInstanced(DeviceContext& deviceContext, const Batch& batch, BoundState& bound) {
+	const DrawPacket& packet = m_packets[batch.first];
+	// El override es parte de la key del lote, asi que vale para todo el lote
+	const ShaderProgram* pixelShader = packet.pixelShaderOverride
+																	 ? packet.pixelShaderOverride
+																	 : packet.instancedProgram;
+	bindState(deviceContext, packet, packet.instancedProgram, pixelShader, bound);
+	m_instanceBuffer.render(deviceContext, 1, 1);
+
+	const unsigned int stride = sizeof(CBChangesEveryFrame);
+	unsigned int next = batch.first;
+	unsigned int remaining = batch.count;
+	while (remaining > 0) {
+		// Lotes mas grandes que el stream se parten en varios draws
+		unsigned int count = remaining < m_instanceCapacity ? remaining : m_instanceCapacity;
+		D3D11_MAP mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+		if (m_instanceCursor + count > m_instanceCapacity) {
+			mapType = D3D11_MAP_WRITE_DISCARD;
+			m_instanceCursor = 0;
+		}
+		unsigned char* mapped = static_cast<unsigned char*>(m_instanceBuffer.map(deviceContext, mapType));
+		if (!mapped) {
+			return;
+		}
+		unsigned char* dst = mapped + m_instanceCursor * stride;
+		for (unsigned int i = 0; i < count; ++i) {
+			memcpy(dst + i * stride, m_constantData.data() + m_packets[next].constantDataOffset, stride);
+			next = m_nextInBatch[next];
+		}
+		m_instanceBuffer.unmap(deviceContext);
+
+		deviceContext.DrawIndexedInstanced(packet.indexCount,
+																			 count,
+																			 packet.startIndex,
+																			 packet.baseVertex,
+																			 m_instanceCursor);
+		m_instanceCursor += count;
+		remaining -= count;
+		m_stats.drawCalls++;
+		m_stats.instancedDraws++;
+		m_stats.instances += count;
+	}
+}
+
+void
+RenderQueue::clear() {
+	m_packets.clear();
+	m_sorted.clear();
+	m_constantData.clear();
+	m_isSorted = true;
+}
+
+void
+RenderQueue::destroy() {
+	clear();
+	m_instanceBuffer.destroy();
+	m_instanceCapacity = 0;
+	m_batches.shrink_to_fit();
+	m_nextInBatch.shrink_to_fit();
+	m_packets.shrink_to_fit();
+	m_sorted.shrink_to_fit();
+	m_scratch.shrink_to_fit();
+	m_constantData.shrink_to_fit();
+}
@@ -6,7 +6,7 @@
 
 HRESULT 
 RenderTargetView::init(Device& device, Texture& backBuffer, DXGI_FORMAT Format) {
-	if (!device.m_device) {
+	if (!device.m_backend) {
 		ERROR("RenderTargetView", "init",	"Device is nullptr.");
 		return E_POINTER;
 	}
@@ -26,9 +26,9 @@ RenderTargetView::init(Device& device, Texture& backBuffer, DXGI_FORMAT Format)
 	desc.ViewDimension = D3D11_RTV_DIMENSION_TEXTURE2DMS;
 
 	// Create the render target view
-	HRESULT hr = device.m_device->CreateRenderTargetView(backBuffer.m_texture, 
-																											 &desc, 
-																											 &m_renderTargetView);
+	HRESULT hr = device.CreateRenderTargetView(backBuffer.m_texture, 
+                                             &desc,
+                                             &m_renderTargetView);
 	if (FAILED(hr)) {
 		ERROR("RenderTargetView", "init", 
 			("Failed to create render target view. HRESULT: " + std::to_string(hr)).c_str());
@@ -43,7 +43,7 @@ RenderTargetView::init(Device& device,
 											 Texture& inTex, 
 											 D3D11_RTV_DIMENSION ViewDimension, 
 											 DXGI_FORMAT Format) {
-	if (!device.m_device) {
+	if (!device.m_backend) {
 		ERROR("RenderTargetView", "init", "Device is nullptr.");
 		return E_POINTER;
 	}
@@ -63,9 +63,9 @@ RenderTargetView::init(Device& device,
 	desc.ViewDimension = ViewDimension;
 
 	// Create the render target view
-	HRESULT hr = device.m_device->CreateRenderTargetView(inTex.m_texture, 
-																											 &desc, 
-																											 &m_renderTargetView);
+	HRESULT hr = device.CreateRenderTargetView(inTex.m_texture, 
+                                             &desc,
+                                             &m_renderTargetView);
 
 	if (FAILED(hr)) {
 		ERROR("RenderTargetView", "init", 
@@ -81,7 +81,7 @@ RenderTargetView::render(DeviceContext& deviceContext,
 												 DepthStencilView& depthStencilView, 
 												 unsigned int numViews, 
 												 const float ClearColor[4]) {
-	if (!deviceContext.m_deviceContext) {
+	if (!deviceContext.m_backend) {
 		ERROR("RenderTargetView", "render", "DeviceContext is nullptr.");
 		return;
 	}
@@ -91,17 +91,17 @@ RenderTargetView::render(DeviceContext& deviceContext,
 	}
 
 	// Clear the render target view
-	deviceContext.m_deviceContext->ClearRenderTargetView(m_renderTargetView, ClearColor);
+	deviceContext.ClearRenderTargetView(m_renderTargetView, ClearColor);
 
 	// Config render target view and depth stencil view
-	deviceContext.m_deviceContext->OMSetRenderTargets(numViews, 
-																										&m_renderTargetView, 
-																										depthStencilView.m_depthStencilView);
+	deviceContext.OMSetRenderTargets(numViews, 
+                                   &m_renderTargetView,
+                                   depthStencilView.m_depthStencilView);
 }
 
 void 
 RenderTargetView::render(DeviceContext& deviceContext, unsigned int numViews) {
-	if (!deviceContext.m_deviceContext) {
+	if (!deviceContext.m_backend) {
 		ERROR("RenderTargetView", "render", "DeviceContext is nullptr.");
 		return;
 	}
@@ -110,9 +110,9 @@ RenderTargetView::render(DeviceContext& deviceContext, unsigned int numViews) {
 		return;
 	}
 	// Config render target view
-	deviceContext.m_deviceContext->OMSetRenderTargets(numViews, 
-																										&m_renderTargetView, 
-																										nullptr);
+	deviceContext.OMSetRenderTargets(numViews, 
+                                   &m_renderTargetView,
+                                   nullptr);
 }
 
 void RenderTargetView::destroy() {
@@ -0,0 +1,304 @@
+#include "SceneGraph.h"
+
+void
+SceneGraph::init(unsigned int expectedNodes) {
+	destroy();
+	m_parent.reserve(expectedNodes);
+	m_depth.reserve(expectedNodes);
+	m_local.init(expectedNodes);
+	m_localTransposed.reserve(expectedNodes);
+	m_world.reserve(expectedNodes);
+	m_localDirty.reserve(expectedNodes);
+	m_worldChanged.reserve(expectedNodes);
+	m_alive.reserve(expectedNodes);
+	m_indexToId.reserve(expectedNodes);
+	m_idToIndex.reserve(expectedNodes);
+}
+
+SceneNodeId
+SceneGraph::createNode(SceneNodeId parent,
+											 const XMFLOAT3& position,
+											 const XMFLOAT4& rotation,
+											 const XMFLOAT3& scale) {
+	int parentIndex = -1;
+	unsigned int depth = 0;
+	if (parent != INVALID_SCENE_NODE) {
+		if (!isValid(parent)) {
+			ERROR("SceneGraph", "createNode", "Invalid parent node");
+			return INVALID_SCENE_NODE;
+		}
+		parentIndex = static_cast<int>(m_idToIndex[parent]);
+		depth = m_depth[parentIndex] + 1;
+	}
+
+	SceneNodeId id;
+	if (!m_freeIds.empty()) {
+		id = m_freeIds.back();
+		m_freeIds.pop_back();
+	}
+	else {
+		id = static_cast<SceneNodeId>(m_idToIndex.size());
+		m_idToIndex.push_back(0);
+	}
+
+	unsigned int index = static_cast<unsigned int>(m_parent.size());
+	// Agregar al final mantiene padre antes que hijo; solo se reordena si
+	// el nodo rompe el orden por profundidad
+	if (!m_depth.empty() && depth < m_depth.back()) {
+		m_needsResort = true;
+	}
+
+	XMFLOAT4X4 identity;
+	XMStoreFloat4x4(&identity, XMMatrixIdentity());
+
+	m_parent.push_back(parentIndex);
+	m_depth.push_back(depth);
+	m_local.create(position, rotation, scale);
+	m_localTransposed.push_back(identity);
+	m_world.push_back(identity);
+	m_localDirty.push_back(1);
+	m_worldChanged.push_back(0);
+	m_alive.push_back(1);
+	m_indexToId.push_back(id);
+	m_idToIndex[id] = index;
+	m_stats.nodes++;
+	return id;
+}
+
+void
+SceneGraph::destroyNode(SceneNodeId id) {
+	if (!isValid(id)) {
+		return;
+	}
+	if (m_needsResort) {
+		resort();
+	}
+
+	// Con el padre siempre antes que el hijo basta una pasada hacia adelante
+	unsigned int root = m_idToIndex[id];
+	m_alive[root] = 0;
+	for (unsigned int i = root + 1; i < m_parent.size(); ++i) {
+		if (m_alive[i] && m_parent[i] >= 0 && !m_alive[m_parent[i]]) {
+			m_alive[i] = 0;
+		}
+	}
+	for (unsigned int i = root; i < m_parent.size(); ++i) {
+		if (!m_alive[i] && m_indexToId[i] != INVALID_SCENE_NODE) {
+			m_freeIds.push_back(m_indexToId[i]);
+			m_indexToId[i] = INVALID_SCENE_NODE;
+			m_stats.nodes--;
+		}
+	}
+	m_needsResort = true;
+}
+
+void
+SceneGraph::setParent(SceneNodeId id, SceneNodeId parent) {
+	if (!isValid(id)) {
+		return;
+	}
+	unsigned int index = m_idToIndex[id];
+	int parentIndex = -1;
+	if (parent != INVALID_SCENE_NODE) {
+		if (!isValid(parent)) {
+			ERROR("SceneGraph", "setParent", "Invalid parent node");
+			return;
+		}
+		parentIndex = static_cast<int>(m_idToIndex[parent]);
+		// Evitar ciclos: el nuevo padre no puede ser descendiente del nodo
+		for (int p = parentIndex; p >= 0; p = m_parent[p]) {
+			if (p == static_cast<int>(index)) {
+				ERROR("SceneGraph", "setParent", "Parent is a descendant of the node");
+				return;
+			}
+		}
+	}
+	m_parent[index] = parentIndex;
+	m_localDirty[index] = 1;
+	m_needsResort = true;
+}
+
+void
+SceneGraph::setLocalPosition(SceneNodeId id, const XMFLOAT3& position) {
+	unsigned int index = m_idToIndex[id];
+	m_local.setPosition(index, position);
+	m_localDirty[index] = 1;
+}
+
+void
+SceneGraph::setLocalRotation(SceneNodeId id, const XMFLOAT4& rotation) {
+	unsigned int index = m_idToIndex[id];
+	m_local.setRotation(index, rotation);
+	m_localDirty[index] = 1;
+}
+
+void
+SceneGraph::setLocalRotationRollPitchYaw(SceneNodeId id, float pitch, float yaw, float roll) {
+	XMFLOAT4 rotation;
+	XMStoreFloat4(&rotation, XMQuaternionRotationRollPitchYaw(pitch, yaw, roll));
+	setLocalRotation(id, rotation);
+}
+
+void
+SceneGraph::setLocalScale(SceneNodeId id, const XMFLOAT3& scale) {
+	unsigned int index = m_idToIndex[id];
+	m_local.setScale(index, scale);
+	m_localDirty[index] = 1;
+}
+
+void
+SceneGraph::update() {
+	if (m_needsResort) {
+		resort();
+	}
+
+	const unsigned int count = static_cast<unsigned int>(m_parent.size());
+
+	// Locales de los nodos sucios: cada tramo contiguo pasa por el compose
+	// SIMD (4 u 8 nodos por iteracion, escalar en la cola)
+	for (unsigned int i = 0; i < count;) {
+		if (!m_localDirty[i]) {
+			++i;
+			continue;
+		}
+		unsigned int end = i + 1;
+		while (end < count && m_localDirty[end]) {
+			++end;
+		}
+		m_local.composeWorldTransposed(i, end, m_localTransposed.data(), sizeof(XMFLOAT4X4));
+		i = end;
+	}
+
+	unsigned int updated = 0;
+	for (unsigned int i = 0; i < count; ++i) {
+		int parent = m_parent[i];
+		bool changed = m_localDirty[i] || (parent >= 0 && m_worldChanged[parent]);
+		m_worldChanged[i] = changed ? 1 : 0;
+		if (!changed) {
+			continue;
+		}
+
+		XMMATRIX world = XMMatrixTranspose(XMLoadFloat4x4(&m_localTransposed[i]));
+		if (parent >= 0) {
+			world = world * XMLoadFloat4x4(&m_world[parent]);
+		}
+		XMStoreFloat4x4(&m_world[i], world);
+		m_localDirty[i] = 0;
+		updated++;
+	}
+	m_stats.updated = updated;
+}
+
+XMMATRIX
+SceneGraph::getWorldMatrix(SceneNodeId id) const {
+	return XMLoadFloat4x4(&m_world[m_idToIndex[id]]);
+}
+
+void
+SceneGraph::getWorldTransposed(SceneNodeId id, XMMATRIX* dst) const {
+	*dst = XMMatrixTranspose(XMLoadFloat4x4(&m_world[m_idToIndex[id]]));
+}
+
+bool
+SceneGraph::isValid(SceneNodeId id) const {
+	if (id >= m_idToIndex.size()) {
+		return false;
+	}
+	unsigned int index = m_idToIndex[id];
+	return index < m_indexToId.size() && m_indexToId[index] == id && m_alive[index];
+}
+
+void
+SceneGraph::destroy() {
+	m_parent.clear();
+	m_depth.clear();
+	m_local.clear();
+	m_localTransposed.clear();
+	m_world.clear();
+	m_localDirty.clear();
+	m_worldChanged.clear();
+	m_alive.clear();
+	m_indexToId.clear();
+	m_idToIndex.clear();
+	m_freeIds.clear();
+	m_needsResort = false;
+	m_stats = SceneGraphStats();
+}
+
+unsigned int
+SceneGraph::computeDepth(unsigned int index) const {
+	unsigned int depth = 0;
+	for (int p = m_parent[index]; p >= 0; p = m_parent[p]) {
+		depth++;
+	}
+	return depth;
+}
+
+void
+SceneGraph::resort() {
+	const unsigned int count = static_cast<unsigned int>(m_parent.size());
+
+	// Counting sort estable por profundidad, descartando nodos eliminados
+	unsigned int maxDepth = 0;
+	for (unsigned int i = 0; i < count; ++i) {
+		if (m_alive[i]) {
+			m_depth[i] = computeDepth(i);
+			if (m_depth[i] > maxDepth) {
+				maxDepth = m_depth[i];
+			}
+		}
+	}
+	std::vector<unsigned int> offsets(maxDepth + 2, 0);
+	for (unsigned int i = 0; i < count; ++i) {
+		if (m_alive[i]) {
+			offsets[m_depth[i] + 1]++;
+		}
+	}
+	for (unsigned int d = 1; d < offsets.size(); ++d) {
+		offsets[d] += offsets[d - 1];
+	}
+	unsigned int alive = offsets.back();
+	std::vector<unsigned int> order(alive);
+	std::vector<int> oldToNew(count, -1);
+	for (unsigned int i = 0; i < count; ++i) {
+		if (m_alive[i]) {
+			unsigned int slot = offsets[m_depth[i]]++;
+			order[slot] = i;
+			oldToNew[i] = static_cast<int>(slot);
+		}
+	}
+
+	std::vector<int> parent(alive);
+	std::vector<unsigned int> depth(alive);
+	TransformSystem local;
+	local.init(alive);
+	std::vector<XMFLOAT4X4> localTransposed(alive);
+	std::vector<XMFLOAT4X4> world(alive);
+	std::vector<unsigned char> localDirty(alive);
+	std::vector<unsigned char> worldChanged(alive);
+	std::vector<SceneNodeId> indexToId(alive);
+	for (unsigned int n = 0; n < alive; ++n) {
+		unsigned int o = order[n];
+		parent[n] = m_parent[o] >= 0 ? oldToNew[m_parent[o]] : -1;
+		depth[n] = m_depth[o];
+		local.create(m_local.getPosition(o), m_local.getRotation(o), m_local.getScale(o));
+		localTransposed[n] = m_localTransposed[o];
+		world[n] = m_world[o];
+		localDirty[n] = m_localDirty[o];
+		worldChanged[n] = m_worldChanged[o];
+		indexToId[n] = m_indexToId[o];
+		m_idToIndex[indexToId[n]] = n;
+	}
+
+	m_parent.swap(parent);
+	m_depth.swap(depth);
+	m_local = std::move(local);
+	m_localTransposed.swap(localTransposed);
+	m_world.swap(world);
+	m_localDirty.swap(localDirty);
+	m_worldChanged.swap(worldChanged);
+	m_indexToId.swap(indexToId);
+	m_alive.assign(alive, 1);
+	m_needsResort = false;
+	m_stats.resorts++;
+}
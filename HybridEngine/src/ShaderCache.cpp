@@ -0,0 +1,337 @@
+#include "ShaderCache.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <set>
+
+namespace {
+	bool
+	readFile(const std::string& path, std::string& text) {
+		std::ifstream in(path.c_str(), std::ios::binary);
+		if (!in) {
+			return false;
+		}
+		in.seekg(0, std::ios::end);
+		text.resize(static_cast<size_t>(in.tellg()));
+		in.seekg(0, std::ios::beg);
+		return text.empty() || in.read(&text[0], static_cast<std::streamsize>(text.size()));
+	}
+
+	std::string
+	directoryOf(const std::string& path) {
+		size_t slash = path.find_last_of("/\\");
+		return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+	}
+
+	// Agrega a sourceHash el archivo y, en orden de aparicion, sus #include.
+	// Cada archivo entra una sola vez (cubre includes repetidos y ciclos).
+	bool
+	hashFileRecursive(const std::string& path,
+										std::set<std::string>& visited,
+										unsigned long long& sourceHash) {
+		if (!visited.insert(path).second) {
+			return true;
+		}
+		sourceHash = ShaderCache::hash(path.data(), path.size(), sourceHash);
+		std::string text;
+		if (!readFile(path, text)) {
+			return false;
+		}
+		sourceHash = ShaderCache::hash(text.data(), text.size(), sourceHash);
+
+		bool ok = true;
+		size_t position = 0;
+		while ((position = text.find("#include", position)) != std::string::npos) {
+			position += 8;
+			size_t open = text.find_first_of("\"<\n", position);
+			if (open == std::string::npos || text[open] == '\n') {
+				continue;
+			}
+			size_t close = text.find_first_of(text[open] == '"' ? "\"\n" : ">\n", open + 1);
+			if (close == std::string::npos || text[close] == '\n') {
+				continue;
+			}
+			// Relativo al archivo que lo incluye, como el include por defecto de D3DX
+			std::string name = text.substr(open + 1, close - open - 1);
+			ok = hashFileRecursive(directoryOf(path) + name, visited, sourceHash) && ok;
+			position = close;
+		}
+		return ok;
+	}
+
+	bool
+	entryLess(const ShaderCacheEntry& entry, unsigned long long key) {
+		return entry.key < key;
+	}
+}
+
+unsigned long long
+ShaderCache::hash(const void* data, size_t size, unsigned long long seed) {
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	unsigned long long value = seed;
+	for (size_t i = 0; i < size; ++i) {
+		value ^= bytes[i];
+		value *= 1099511628211ull;
+	}
+	return value;
+}
+
+bool
+ShaderCache::hashSource(const std::string& fileName, unsigned long long& sourceHash) {
+	std::set<std::string> visited;
+	sourceHash = hash(nullptr, 0);
+	return hashFileRecursive(fileName, visited, sourceHash);
+}
+
+unsigned long long
+ShaderCache::makeKey(unsigned long long sourceHash,
+										 LPCSTR entryPoint,
+										 LPCSTR shaderModel,
+										 unsigned int flags,
+										 const D3D_SHADER_MACRO* defines) {
+	// El separador evita que "VS"+"vs_4_0" choque con "VSv"+"s_4_0"
+	const unsigned int version = SHADER_CACHE_VERSION;
+	unsigned long long key = hash(&version, sizeof(version), sourceHash);
+	key = hash(entryPoint, strlen(entryPoint) + 1, key);
+	key = hash(shaderModel, strlen(shaderModel) + 1, key);
+	for (const D3D_SHADER_MACRO* define = defines; define && define->Name; ++define) {
+		const char* definition = define->Definition ? define->Definition : "";
+		key = hash(define->Name, strlen(define->Name) + 1, key);
+		key = hash(definition, strlen(definition) + 1, key);
+	}
+	return hash(&flags, sizeof(flags), key);
+}
+
+bool
+ShaderCache::validate(const void* data, size_t size) {
+	if (!data || size < sizeof(ShaderCacheHeader)) {
+		return false;
+	}
+	const ShaderCacheHeader& header = *static_cast<const ShaderCacheHeader*>(data);
+	if (header.magic != SHADER_CACHE_MAGIC ||
+			header.version != SHADER_CACHE_VERSION ||
+			header.headerSize != sizeof(ShaderCacheHeader) ||
+			header.fileSize != size ||
+			header.indexOffset > size ||
+			static_cast<unsigned long long>(header.entryCount) * sizeof(ShaderCacheEntry) > size - header.indexOffset ||
+			header.dataOffset > size) {
+		return false;
+	}
+	const char* bytes = static_cast<const char*>(data);
+	const ShaderCacheEntry* entries = reinterpret_cast<const ShaderCacheEntry*>(bytes + header.indexOffset);
+	const unsigned long long dataSize = size - header.dataOffset;
+	for (unsigned int i = 0; i < header.entryCount; ++i) {
+		const ShaderCacheEntry& entry = entries[i];
+		if ((i > 0 && entries[i - 1].key >= entry.key) ||
+				entry.offset > dataSize || entry.size > dataSize - entry.offset ||
+				static_cast<unsigned int>(hash(bytes + header.dataOffset + entry.offset, entry.size)) != entry.checksum) {
+			return false;
+		}
+	}
+	return true;
+}
+
+HRESULT
+ShaderCache::load(const std::string& path) {
+	clear();
+	m_path = path;
+
+	std::string file;
+	if (!readFile(path, file)) {
+		return S_FALSE;
+	}
+	if (!validate(file.data(), file.size())) {
+		ERROR("ShaderCache", "load", ("Invalid or stale shader cache " + path + ", rebuilding").c_str());
+		m_dirty = true;
+		return S_FALSE;
+	}
+	const ShaderCacheHeader& header = *reinterpret_cast<const ShaderCacheHeader*>(file.data());
+	const ShaderCacheEntry* entries = reinterpret_cast<const ShaderCacheEntry*>(file.data() + header.indexOffset);
+	m_entries.assign(entries, entries + header.entryCount);
+	m_used.assign(header.entryCount, 0);
+	m_data.assign(file.begin() + static_cast<size_t>(header.dataOffset), file.end());
+	return S_OK;
+}
+
+HRESULT
+ShaderCache::save() {
+	if (!m_dirty && std::find(m_used.begin(), m_used.end(), 0) == m_used.end()) {
+		return S_OK;
+	}
+	if (m_path.empty()) {
+		ERROR("ShaderCache", "save", "No path; call load() or save(path) first");
+		return E_FAIL;
+	}
+	return save(m_path);
+}
+
+HRESULT
+ShaderCache::save(const std::string& path) {
+	// Compacta: los datos reemplazados por insert() y las entradas que nadie
+	// uso en esta sesion no se escriben. Si no se uso ninguna (p. ej. el
+	// arranque fallo antes de compilar) se conservan todas
+	const bool anyUsed = std::find(m_used.begin(), m_used.end(), 1) != m_used.end();
+	std::vector<ShaderCacheEntry> entries;
+	std::vector<size_t> sources;
+	unsigned long long dataSize = 0;
+	for (size_t i = 0; i < m_entries.size(); ++i) {
+		if (anyUsed && !m_used[i]) {
+			continue;
+		}
+		entries.push_back(m_entries[i]);
+		entries.back().offset = dataSize;
+		sources.push_back(i);
+		dataSize += m_entries[i].size;
+	}
+
+	ShaderCacheHeader header = {};
+	header.magic = SHADER_CACHE_MAGIC;
+	header.version = SHADER_CACHE_VERSION;
+	header.headerSize = sizeof(ShaderCacheHeader);
+	header.entryCount = static_cast<unsigned int>(entries.size());
+	header.indexOffset = sizeof(ShaderCacheHeader);
+	header.dataOffset = header.indexOffset + entries.size() * sizeof(ShaderCacheEntry);
+	header.fileSize = header.dataOffset + dataSize;
+
+	// Temporal + rename: un proceso que muera a mitad no deja un cache truncado
+	std::string temporary = path + ".tmp";
+	{
+		std::ofstream out(temporary.c_str(), std::ios::binary | std::ios::trunc);
+		if (!out) {
+			ERROR("ShaderCache", "save", ("Failed to create " + temporary).c_str());
+			return E_FAIL;
+		}
+		out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		if (!entries.empty()) {
+			out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(ShaderCacheEntry));
+		}
+		for (size_t i = 0; i < sources.size(); ++i) {
+			const ShaderCacheEntry& entry = m_entries[sources[i]];
+			out.write(&m_data[static_cast<size_t>(entry.offset)], entry.size);
+		}
+		if (!out) {
+			ERROR("ShaderCache", "save", ("Failed to write " + temporary).c_str());
+			return E_FAIL;
+		}
+	}
+	remove(path.c_str());
+	if (rename(temporary.c_str(), path.c_str()) != 0) {
+		ERROR("ShaderCache", "save", ("Failed to replace " + path).c_str());
+		return E_FAIL;
+	}
+	m_path = path;
+	m_dirty = false;
+	return S_OK;
+}
+
+void
+ShaderCache::clear() {
+	m_entries.clear();
+	m_used.clear();
+	m_data.clear();
+	m_dirty = false;
+	m_stats = ShaderCacheStats();
+}
+
+bool
+ShaderCache::find(unsigned long long key, const void** data, size_t* size) const {
+	std::vector<ShaderCacheEntry>::const_iterator it =
+		std::lower_bound(m_entries.begin(), m_entries.end(), key, entryLess);
+	if (it == m_entries.end() || it->key != key) {
+		return false;
+	}
+	*data = m_data.data() + it->offset;
+	*size = it->size;
+	m_used[it - m_entries.begin()] = 1;
+	return true;
+}
+
+void
+ShaderCache::insert(unsigned long long key, const void* data, size_t size) {
+	ShaderCacheEntry entry;
+	entry.key = key;
+	entry.size = static_cast<unsigned int>(size);
+	entry.checksum = static_cast<unsigned int>(hash(data, size));
+	const char* bytes = static_cast<const char*>(data);
+	std::lock_guard<std::mutex> lock(m_lock);
+	entry.offset = m_data.size();
+	m_data.insert(m_data.end(), bytes, bytes + size);
+
+	std::vector<ShaderCacheEntry>::iterator it =
+		std::lower_bound(m_entries.begin(), m_entries.end(), key, entryLess);
+	size_t index = it - m_entries.begin();
+	if (it != m_entries.end() && it->key == key) {
+		*it = entry;
+		m_used[index] = 1;
+	}
+	else {
+		m_entries.insert(it, entry);
+		m_used.insert(m_used.begin() + index, 1);
+	}
+	m_dirty = true;
+}
+
+HRESULT
+ShaderCache::compileFromFile(const std::string& fileName,
+														 LPCSTR entryPoint,
+														 LPCSTR shaderModel,
+														 unsigned int flags,
+														 ID3DBlob** blobOut,
+														 const D3D_SHADER_MACRO* defines) {
+	// Si el fuente no se puede leer se compila igual para que D3DX reporte el error
+	unsigned long long sourceHash = 0;
+	bool hashed = hashSource(fileName, sourceHash);
+	unsigned long long key = makeKey(sourceHash, entryPoint, shaderModel, flags, defines);
+
+	if (hashed) {
+		// La copia se hace con el lock: otro hilo puede estar insertando
+		std::lock_guard<std::mutex> lock(m_lock);
+		const void* cached = nullptr;
+		size_t cachedSize = 0;
+		if (find(key, &cached, &cachedSize) && SUCCEEDED(D3DCreateBlob(cachedSize, blobOut))) {
+			memcpy((*blobOut)->GetBufferPointer(), cached, cachedSize);
+			m_stats.hits++;
+			return S_OK;
+		}
+	}
+
+	// El compilador corre sin el lock para que varios hilos compilen a la vez
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	ID3DBlob* errorBlob = nullptr;
+	HRESULT hr = D3DX11CompileFromFile(fileName.c_str(),
+																		 defines,
+																		 nullptr,
+																		 entryPoint,
+																		 shaderModel,
+																		 flags,
+																		 0,
+																		 nullptr,
+																		 blobOut,
+																		 &errorBlob,
+																		 nullptr);
+	double compileMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_stats.misses++;
+		m_stats.compileMs += compileMs;
+	}
+	if (FAILED(hr)) {
+		if (errorBlob) {
+			ERROR("ShaderCache", "compileFromFile",
+				("Failed to compile " + fileName + ": " + static_cast<const char*>(errorBlob->GetBufferPointer())).c_str());
+		}
+		else {
+			ERROR("ShaderCache", "compileFromFile", ("Failed to compile " + fileName).c_str());
+		}
+		SAFE_RELEASE(errorBlob);
+		return hr;
+	}
+	SAFE_RELEASE(errorBlob);
+
+	if (hashed) {
+		insert(key, (*blobOut)->GetBufferPointer(), (*blobOut)->GetBufferSize());
+	}
+	return S_OK;
+}
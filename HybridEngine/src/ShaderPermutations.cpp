@@ -0,0 +1,224 @@
+#include "ShaderPermutations.h"
+#include "ShaderProgram.h"
+#include "JobSystem.h"
+#include "Device.h"
+#include <chrono>
+
+namespace {
+	// Valores de las macros; los D3D_SHADER_MACRO apuntan a estos strings
+	const char* const KEYWORD_VALUES[SHADER_KEYWORD_MAX_VALUES] = {
+		"0", "1", "2", "3", "4", "5", "6", "7",
+		"8", "9", "10", "11", "12", "13", "14", "15"
+	};
+}
+
+unsigned int
+ShaderPermutations::addKeyword(const std::string& name, unsigned int valueCount) {
+	if (m_device) {
+		ERROR("ShaderPermutations", "addKeyword", "Keywords must be added before init()");
+		return INVALID_SHADER_KEYWORD;
+	}
+	if (name.empty() || valueCount < 2 || valueCount > SHADER_KEYWORD_MAX_VALUES) {
+		ERROR("ShaderPermutations", "addKeyword", ("Invalid keyword " + name).c_str());
+		return INVALID_SHADER_KEYWORD;
+	}
+	unsigned int bits = 1;
+	while ((1u << bits) < valueCount) {
+		bits++;
+	}
+	if (m_bits + bits > SHADER_PERMUTATION_MAX_BITS) {
+		ERROR("ShaderPermutations", "addKeyword", ("Too many variant bits for keyword " + name).c_str());
+		return INVALID_SHADER_KEYWORD;
+	}
+	ShaderKeyword keyword;
+	keyword.name = name;
+	keyword.valueCount = valueCount;
+	keyword.shift = m_bits;
+	keyword.bits = bits;
+	m_keywords.push_back(keyword);
+	m_bits += bits;
+	return static_cast<unsigned int>(m_keywords.size() - 1);
+}
+
+HRESULT
+ShaderPermutations::init(Device& device,
+												 const std::string& fileName,
+												 const std::vector<D3D11_INPUT_ELEMENT_DESC>& layout,
+												 ShaderCache* cache) {
+	if (!device.m_backend) {
+		ERROR("ShaderPermutations", "init", "Device is null.");
+		return E_POINTER;
+	}
+	if (fileName.empty() || layout.empty()) {
+		ERROR("ShaderPermutations", "init", "File name or input layout is empty.");
+		return E_INVALIDARG;
+	}
+	destroy();
+	m_device = &device;
+	m_fileName = fileName;
+	m_layout = layout;
+	m_cache = cache ? cache : &m_localCache;
+	m_variants.assign(getKeyCount(), nullptr);
+	m_failed.assign(getKeyCount(), 0);
+	return S_OK;
+}
+
+void
+ShaderPermutations::destroy() {
+	for (size_t i = 0; i < m_variants.size(); ++i) {
+		if (m_variants[i]) {
+			m_variants[i]->destroy();
+			delete m_variants[i];
+		}
+	}
+	m_variants.clear();
+	m_failed.clear();
+	m_localCache.clear();
+	m_stats = ShaderPermutationStats();
+	m_device = nullptr;
+}
+
+ShaderVariantKey
+ShaderPermutations::setKeyword(ShaderVariantKey key, unsigned int keyword, unsigned int value) const {
+	const ShaderKeyword& entry = m_keywords[keyword];
+	const unsigned int mask = ((1u << entry.bits) - 1) << entry.shift;
+	return (key & ~mask) | ((value << entry.shift) & mask);
+}
+
+unsigned int
+ShaderPermutations::getKeyword(ShaderVariantKey key, unsigned int keyword) const {
+	const ShaderKeyword& entry = m_keywords[keyword];
+	return (key >> entry.shift) & ((1u << entry.bits) - 1);
+}
+
+bool
+ShaderPermutations::isValid(ShaderVariantKey key) const {
+	if (key >= getKeyCount()) {
+		return false;
+	}
+	for (unsigned int k = 0; k < m_keywords.size(); ++k) {
+		if (getKeyword(key, k) >= m_keywords[k].valueCount) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void
+ShaderPermutations::buildDefines(ShaderVariantKey key, std::vector<D3D_SHADER_MACRO>& defines) const {
+	defines.clear();
+	for (unsigned int k = 0; k < m_keywords.size(); ++k) {
+		D3D_SHADER_MACRO define = { m_keywords[k].name.c_str(), KEYWORD_VALUES[getKeyword(key, k)] };
+		defines.push_back(define);
+	}
+	D3D_SHADER_MACRO terminator = { nullptr, nullptr };
+	defines.push_back(terminator);
+}
+
+ShaderProgram*
+ShaderPermutations::findVariant(ShaderVariantKey key) const {
+	return key < m_variants.size() ? m_variants[key] : nullptr;
+}
+
+ShaderProgram*
+ShaderPermutations::getVariant(ShaderVariantKey key) {
+	if (key < m_variants.size() && m_variants[key]) {
+		return m_variants[key];
+	}
+	if (!m_device || !isValid(key) || m_failed[key]) {
+		return nullptr;
+	}
+	m_stats.lazyBuilds++;
+	return createVariant(key);
+}
+
+HRESULT
+ShaderPermutations::compile(ShaderVariantKey key) {
+	if (!m_device || !isValid(key)) {
+		return E_INVALIDARG;
+	}
+	std::vector<D3D_SHADER_MACRO> defines;
+	buildDefines(key, defines);
+	ShaderProgram compiler;
+	compiler.setCache(m_cache);
+	compiler.setDefines(defines.data());
+	for (int type = VERTEX_SHADER; type <= PIXEL_SHADER; ++type) {
+		ID3DBlob* blob = nullptr;
+		HRESULT hr = compiler.CompileShader(m_fileName, static_cast<ShaderType>(type), &blob);
+		SAFE_RELEASE(blob);
+		if (FAILED(hr)) {
+			return hr;
+		}
+	}
+	return S_OK;
+}
+
+ShaderProgram*
+ShaderPermutations::createVariant(ShaderVariantKey key) {
+	if (!m_device || !isValid(key) || m_failed[key]) {
+		return nullptr;
+	}
+	if (m_variants[key]) {
+		return m_variants[key];
+	}
+	std::vector<D3D_SHADER_MACRO> defines;
+	buildDefines(key, defines);
+
+	ShaderProgram* program = new ShaderProgram();
+	program->setCache(m_cache);
+	program->setDefines(defines.data());
+	HRESULT hr = program->init(*m_device, m_fileName, m_layout);
+	if (FAILED(hr)) {
+		ERROR("ShaderPermutations", "createVariant",
+			("Failed to create variant " + std::to_string(key) + " of " + m_fileName).c_str());
+		program->destroy();
+		delete program;
+		m_failed[key] = 1;
+		m_stats.failed++;
+		return nullptr;
+	}
+	m_variants[key] = program;
+	m_stats.built++;
+	return program;
+}
+
+HRESULT
+ShaderPermutations::prebuild(JobSystem& jobs, const std::vector<ShaderVariantKey>& keys) {
+	if (!m_device) {
+		ERROR("ShaderPermutations", "prebuild", "Not initialized.");
+		return E_FAIL;
+	}
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	std::vector<ShaderVariantKey> pending;
+	const unsigned int requested = keys.empty() ? getKeyCount() : static_cast<unsigned int>(keys.size());
+	for (unsigned int i = 0; i < requested; ++i) {
+		ShaderVariantKey key = keys.empty() ? i : keys[i];
+		if (isValid(key) && !m_variants[key] && !m_failed[key]) {
+			pending.push_back(key);
+		}
+	}
+
+	// Fase 1: bytecode en paralelo; solo llena el cache
+	std::vector<unsigned char> compiled(pending.size(), 0);
+	jobs.parallelFor(static_cast<unsigned int>(pending.size()), 1, [&](unsigned int begin, unsigned int end) {
+		for (unsigned int i = begin; i < end; ++i) {
+			compiled[i] = SUCCEEDED(compile(pending[i])) ? 1 : 0;
+		}
+	});
+
+	// Fase 2: objetos de GPU en este hilo; cada compilacion es un acierto del cache
+	HRESULT hr = S_OK;
+	for (size_t i = 0; i < pending.size(); ++i) {
+		if (!compiled[i]) {
+			m_failed[pending[i]] = 1;
+			m_stats.failed++;
+			hr = E_FAIL;
+		}
+		else if (!createVariant(pending[i])) {
+			hr = E_FAIL;
+		}
+	}
+	m_stats.prebuildMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return hr;
+}
@@ -1,12 +1,13 @@
 #include "ShaderProgram.h"
 #include "Device.h"
 #include "DeviceContext.h"
+#include "ShaderCache.h"
 
 HRESULT
 ShaderProgram::init(Device& device,
 	const std::string& fileName,
 	std::vector<D3D11_INPUT_ELEMENT_DESC> Layout) {
-	if (!device.m_device) {
+	if (!device.m_backend) {
 		ERROR("ShaderProgram", "init", "Device is null.");
 		return E_POINTER;
 	}
@@ -19,6 +20,8 @@ ShaderProgram::init(Device& device,
 		return E_INVALIDARG;
 	}
 	m_shaderFileName = fileName;
+	m_reflection.clear();
+	m_layout = Layout;
 
 	// Create the Vertex Shader
 	HRESULT hr = CreateShader(device, ShaderType::VERTEX_SHADER);
@@ -51,7 +54,7 @@ ShaderProgram::CreateInputLayout(Device& device,
 		ERROR("ShaderProgram", "CreateInputLayout", "Vertex shader data is null.");
 		return E_POINTER;
 	}
-	if (!device.m_device) {
+	if (!device.m_backend) {
 		ERROR("ShaderProgram", "CreateInputLayout", "Device is null.");
 		return E_POINTER;
 	}
@@ -74,7 +77,7 @@ ShaderProgram::CreateInputLayout(Device& device,
 
 HRESULT
 ShaderProgram::CreateShader(Device& device, ShaderType type) {
-	if (!device.m_device) {
+	if (!device.m_backend) {
 		ERROR("ShaderProgram", "CreateShader", "Device is null.");
 		return E_POINTER;
 	}
@@ -86,14 +89,8 @@ ShaderProgram::CreateShader(Device& device, ShaderType type) {
 	HRESULT hr = S_OK;
 	ID3DBlob* shaderData = nullptr;
 
-	const char* shaderEntryPoint = (type == ShaderType::PIXEL_SHADER) ? "PS" : "VS";
-	const char* shaderModel = (type == ShaderType::PIXEL_SHADER) ? "ps_4_0" : "vs_4_0";
-
 	// Compile the shader from file
-	hr = CompileShaderFromFile(m_shaderFileName.data(),
-		shaderEntryPoint,
-		shaderModel,
-		&shaderData);
+	hr = CompileShader(m_shaderFileName, type, &shaderData);
 
 	if (FAILED(hr)) {
 		ERROR("ShaderProgram", "CreateShader",
@@ -122,6 +119,9 @@ ShaderProgram::CreateShader(Device& device, ShaderType type) {
 		return hr;
 	}
 
+	// Layout de los cbuffers; sin el, el shader sigue siendo usable
+	m_reflection.reflect(shaderData->GetBufferPointer(), shaderData->GetBufferSize());
+
 	// Store the compiled shader data
 	if (type == PIXEL_SHADER) {
 		SAFE_RELEASE(m_pixelShaderData);
@@ -137,7 +137,7 @@ ShaderProgram::CreateShader(Device& device, ShaderType type) {
 
 HRESULT
 ShaderProgram::CreateShader(Device& device, ShaderType type, const std::string& fileName) {
-	if (!device.m_device) {
+	if (!device.m_backend) {
 		ERROR("ShaderProgram", "init", "Device is null.");
 		return E_POINTER;
 	}
@@ -153,7 +153,14 @@ ShaderProgram::CreateShader(Device& device, ShaderType type, const std::string&
 }
 
 HRESULT
-ShaderProgram::CompileShaderFromFile(char* szFileName,
+ShaderProgram::CompileShader(const std::string& fileName, ShaderType type, ID3DBlob** ppBlobOut) {
+	const char* shaderEntryPoint = (type == ShaderType::PIXEL_SHADER) ? "PS" : "VS";
+	const char* shaderModel = (type == ShaderType::PIXEL_SHADER) ? "ps_4_0" : "vs_4_0";
+	return CompileShaderFromFile(fileName.c_str(), shaderEntryPoint, shaderModel, ppBlobOut);
+}
+
+HRESULT
+ShaderProgram::CompileShaderFromFile(const char* szFileName,
 	LPCSTR szEntryPoint,
 	LPCSTR szShaderModel,
 	ID3DBlob** ppBlobOut) {
@@ -167,9 +174,14 @@ ShaderProgram::CompileShaderFromFile(char* szFileName,
 	// the release configuration of this program.
 	dwShaderFlags |= D3DCOMPILE_DEBUG;
 #endif
+	const D3D_SHADER_MACRO* defines = m_defines.empty() ? nullptr : m_defines.data();
+	if (m_cache) {
+		return m_cache->compileFromFile(szFileName, szEntryPoint, szShaderModel, dwShaderFlags, ppBlobOut, defines);
+	}
+
 	ID3DBlob* pErrorBlob;
 	hr = D3DX11CompileFromFile(szFileName,
-		nullptr,
+		defines,
 		nullptr,
 		szEntryPoint,
 		szShaderModel,
@@ -201,6 +213,18 @@ ShaderProgram::CompileShaderFromFile(char* szFileName,
 		return S_OK;
 }
 
+void
+ShaderProgram::setDefines(const D3D_SHADER_MACRO* defines) {
+	m_defines.clear();
+	for (const D3D_SHADER_MACRO* define = defines; define && define->Name; ++define) {
+		m_defines.push_back(*define);
+	}
+	if (!m_defines.empty()) {
+		D3D_SHADER_MACRO terminator = { nullptr, nullptr };
+		m_defines.push_back(terminator);
+	}
+}
+
 void
 ShaderProgram::update() {
 }
@@ -213,28 +237,74 @@ ShaderProgram::render(DeviceContext& deviceContext) {
 	}
 
 	m_inputLayout.render(deviceContext);
-	deviceContext.m_deviceContext->VSSetShader(m_VertexShader, nullptr, 0);
-	deviceContext.m_deviceContext->PSSetShader(m_PixelShader, nullptr, 0);
+	deviceContext.VSSetShader(m_VertexShader, nullptr, 0);
+	deviceContext.PSSetShader(m_PixelShader, nullptr, 0);
 }
 
 void
 ShaderProgram::render(DeviceContext& deviceContext, ShaderType type) {
-	if (!deviceContext.m_deviceContext) {
+	if (!deviceContext.m_backend) {
 		ERROR("RenderTargetView", "render", "DeviceContext is nullptr.");
 		return;
 	}
 	switch (type)	{
 	case VERTEX_SHADER:
-		deviceContext.m_deviceContext->VSSetShader(m_VertexShader, nullptr, 0);
+		deviceContext.VSSetShader(m_VertexShader, nullptr, 0);
 		break;
 	case PIXEL_SHADER:
-		deviceContext.m_deviceContext->PSSetShader(m_PixelShader, nullptr, 0);
+		deviceContext.PSSetShader(m_PixelShader, nullptr, 0);
 		break;
 	default:
 		break;
 	}
 }
 
+HRESULT
+ShaderProgram::reload(Device& device) {
+	if (m_shaderFileName.empty() || (!m_VertexShader && !m_PixelShader)) {
+		ERROR("ShaderProgram", "reload", "Nothing to reload.");
+		return E_FAIL;
+	}
+	ShaderProgram staged;
+	staged.m_shaderFileName = m_shaderFileName;
+	staged.m_cache = m_cache;
+	staged.m_defines = m_defines;
+	staged.m_layout = m_layout;
+
+	// Solo las etapas que ya existian (el shader de sombra es solo PS)
+	HRESULT hr = S_OK;
+	if (m_VertexShader) {
+		hr = staged.CreateShader(device, VERTEX_SHADER);
+		if (SUCCEEDED(hr) && !m_layout.empty()) {
+			hr = staged.CreateInputLayout(device, m_layout);
+		}
+	}
+	if (SUCCEEDED(hr) && m_PixelShader) {
+		hr = staged.CreateShader(device, PIXEL_SHADER);
+	}
+	if (SUCCEEDED(hr) && !staged.m_reflection.isCompatible(m_reflection)) {
+		ERROR("ShaderProgram", "reload",
+			("Constant buffer layout changed in " + m_shaderFileName + "; restart to apply it").c_str());
+		hr = E_FAIL;
+	}
+	if (FAILED(hr)) {
+		staged.destroy();
+		return hr;
+	}
+
+	// Intercambio: lo viejo queda en staged y se libera con el
+	std::swap(m_VertexShader, staged.m_VertexShader);
+	std::swap(m_PixelShader, staged.m_PixelShader);
+	if (!m_layout.empty()) {
+		std::swap(m_inputLayout.m_inputLayout, staged.m_inputLayout.m_inputLayout);
+	}
+	std::swap(m_vertexShaderData, staged.m_vertexShaderData);
+	std::swap(m_pixelShaderData, staged.m_pixelShaderData);
+	std::swap(m_reflection, staged.m_reflection);
+	staged.destroy();
+	return S_OK;
+}
+
 void
 ShaderProgram::destroy() {
 	SAFE_RELEASE(m_VertexShader);
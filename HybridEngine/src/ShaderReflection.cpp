@@ -0,0 +1,230 @@
+#include "ShaderReflection.h"
+#include <algorithm>
+
+namespace {
+	bool
+	parameterLess(const ShaderParameter& a, const ShaderParameter& b) {
+		return a.offset < b.offset;
+	}
+
+	// Tipo de C++ para un parametro; vacio si no hay uno directo
+	std::string
+	cppTypeName(const ShaderParameter& parameter) {
+		if (parameter.type == D3D_SVT_FLOAT) {
+			if (parameter.variableClass == D3D_SVC_MATRIX_ROWS || parameter.variableClass == D3D_SVC_MATRIX_COLUMNS) {
+				return parameter.rows == 4 && parameter.columns == 4 ? "XMMATRIX" : "";
+			}
+			switch (parameter.columns) {
+			case 1: return "float";
+			case 2: return "XMFLOAT2";
+			case 3: return "XMFLOAT3";
+			case 4: return "XMFLOAT4";
+			}
+			return "";
+		}
+		if (parameter.columns != 1 || parameter.variableClass != D3D_SVC_SCALAR) {
+			return "";
+		}
+		switch (parameter.type) {
+		case D3D_SVT_INT:  return "int";
+		case D3D_SVT_UINT: return "unsigned int";
+		case D3D_SVT_BOOL: return "BOOL";   // bool de HLSL ocupa 4 bytes
+		default:           return "";
+		}
+	}
+}
+
+bool
+ShaderReflection::sameLayout(const ConstantBufferLayout& a, const ConstantBufferLayout& b) {
+	if (a.slot != b.slot || a.size != b.size || a.parameters.size() != b.parameters.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < a.parameters.size(); ++i) {
+		if (a.parameters[i].name != b.parameters[i].name ||
+				a.parameters[i].offset != b.parameters[i].offset ||
+				a.parameters[i].size != b.parameters[i].size) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool
+ShaderReflection::isCompatible(const ShaderReflection& previous) const {
+	for (size_t i = 0; i < previous.m_layouts.size(); ++i) {
+		const ConstantBufferLayout* current = find(previous.m_layouts[i].name);
+		if (current && !sameLayout(*current, previous.m_layouts[i])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+unsigned int
+ConstantBufferLayout::findParameter(const std::string& parameterName) const {
+	for (size_t i = 0; i < parameters.size(); ++i) {
+		if (parameters[i].name == parameterName) {
+			return static_cast<unsigned int>(i);
+		}
+	}
+	return INVALID_SHADER_PARAMETER;
+}
+
+HRESULT
+ShaderReflection::reflect(const void* bytecode, size_t size) {
+	if (!bytecode || size == 0) {
+		ERROR("ShaderReflection", "reflect", "Bytecode is empty.");
+		return E_INVALIDARG;
+	}
+	ID3D11ShaderReflection* reflection = nullptr;
+	HRESULT hr = D3DReflect(bytecode, size, IID_ID3D11ShaderReflection, reinterpret_cast<void**>(&reflection));
+	if (FAILED(hr)) {
+		ERROR("ShaderReflection", "reflect", ("D3DReflect failed. HRESULT: " + std::to_string(hr)).c_str());
+		return hr;
+	}
+
+	D3D11_SHADER_DESC shaderDesc;
+	hr = reflection->GetDesc(&shaderDesc);
+	for (unsigned int b = 0; SUCCEEDED(hr) && b < shaderDesc.ConstantBuffers; ++b) {
+		ID3D11ShaderReflectionConstantBuffer* buffer = reflection->GetConstantBufferByIndex(b);
+		D3D11_SHADER_BUFFER_DESC bufferDesc;
+		hr = buffer->GetDesc(&bufferDesc);
+		if (FAILED(hr) || bufferDesc.Type != D3D_CT_CBUFFER) {
+			// tbuffers y datos de UAV no son constant buffers
+			continue;
+		}
+		ConstantBufferLayout layout;
+		layout.name = bufferDesc.Name;
+		layout.size = bufferDesc.Size;
+		D3D11_SHADER_INPUT_BIND_DESC bindDesc;
+		layout.slot = SUCCEEDED(reflection->GetResourceBindingDescByName(bufferDesc.Name, &bindDesc)) ? bindDesc.BindPoint : 0;
+
+		for (unsigned int v = 0; SUCCEEDED(hr) && v < bufferDesc.Variables; ++v) {
+			ID3D11ShaderReflectionVariable* variable = buffer->GetVariableByIndex(v);
+			D3D11_SHADER_VARIABLE_DESC variableDesc;
+			D3D11_SHADER_TYPE_DESC typeDesc;
+			hr = variable->GetDesc(&variableDesc);
+			if (SUCCEEDED(hr)) {
+				hr = variable->GetType()->GetDesc(&typeDesc);
+			}
+			if (SUCCEEDED(hr)) {
+				ShaderParameter parameter;
+				parameter.name = variableDesc.Name;
+				parameter.offset = variableDesc.StartOffset;
+				parameter.size = variableDesc.Size;
+				parameter.variableClass = typeDesc.Class;
+				parameter.type = typeDesc.Type;
+				parameter.rows = typeDesc.Rows;
+				parameter.columns = typeDesc.Columns;
+				parameter.elements = typeDesc.Elements;
+				layout.parameters.push_back(parameter);
+			}
+		}
+		if (SUCCEEDED(hr)) {
+			std::sort(layout.parameters.begin(), layout.parameters.end(), parameterLess);
+			hr = addLayout(layout);
+		}
+	}
+	reflection->Release();
+	if (FAILED(hr)) {
+		ERROR("ShaderReflection", "reflect", ("Failed to read constant buffers. HRESULT: " + std::to_string(hr)).c_str());
+	}
+	return hr;
+}
+
+HRESULT
+ShaderReflection::addLayout(const ConstantBufferLayout& layout) {
+	const ConstantBufferLayout* existing = find(layout.name);
+	if (existing) {
+		if (!sameLayout(*existing, layout)) {
+			ERROR("ShaderReflection", "addLayout",
+				("Constant buffer " + layout.name + " has different layouts in the same program").c_str());
+			return E_FAIL;
+		}
+		return S_OK;
+	}
+	m_layouts.push_back(layout);
+	return S_OK;
+}
+
+const ConstantBufferLayout*
+ShaderReflection::find(const std::string& name) const {
+	for (size_t i = 0; i < m_layouts.size(); ++i) {
+		if (m_layouts[i].name == name) {
+			return &m_layouts[i];
+		}
+	}
+	return nullptr;
+}
+
+bool
+ShaderReflection::validate(const ConstantBufferLayout& layout,
+													 const ConstantBufferMember* members,
+													 unsigned int memberCount,
+													 unsigned int cppSize) {
+	const unsigned int paddedSize = (cppSize + 15) & ~15u;
+	if (paddedSize != layout.size) {
+		ERROR("ShaderReflection", "validate",
+			(layout.name + ": C++ size " + std::to_string(cppSize) + " does not match " + std::to_string(layout.size)).c_str());
+		return false;
+	}
+	for (unsigned int m = 0; m < memberCount; ++m) {
+		unsigned int index = layout.findParameter(members[m].name);
+		if (index == INVALID_SHADER_PARAMETER) {
+			ERROR("ShaderReflection", "validate",
+				(layout.name + ": " + members[m].name + " is not in the shader").c_str());
+			return false;
+		}
+		const ShaderParameter& parameter = layout.parameters[index];
+		if (parameter.offset != members[m].offset || parameter.size != members[m].size) {
+			ERROR("ShaderReflection", "validate",
+				(layout.name + "." + parameter.name + ": shader offset " + std::to_string(parameter.offset) +
+				 " size " + std::to_string(parameter.size) + ", C++ offset " + std::to_string(members[m].offset) +
+				 " size " + std::to_string(members[m].size)).c_str());
+			return false;
+		}
+	}
+	// Un parametro sin miembro quedaria con basura en la GPU
+	for (size_t p = 0; p < layout.parameters.size(); ++p) {
+		bool found = false;
+		for (unsigned int m = 0; m < memberCount && !found; ++m) {
+			found = layout.parameters[p].name == members[m].name;
+		}
+		if (!found) {
+			ERROR("ShaderReflection", "validate",
+				(layout.name + "." + layout.parameters[p].name + " has no C++ member").c_str());
+			return false;
+		}
+	}
+	return true;
+}
+
+std::string
+ShaderReflection::generateStruct(const ConstantBufferLayout& layout, const std::string& typeName) {
+	std::ostringstream os;
+	os << "// " << layout.name << " : register( b" << layout.slot << " ), " << layout.size << " bytes\n"
+		 << "struct\n  " << typeName << " {\n";
+	unsigned int offset = 0;
+	unsigned int padding = 0;
+	for (size_t i = 0; i < layout.parameters.size(); ++i) {
+		const ShaderParameter& parameter = layout.parameters[i];
+		if (parameter.offset > offset) {
+			os << "  unsigned char pad" << padding++ << "[" << (parameter.offset - offset) << "];\n";
+		}
+		std::string type = cppTypeName(parameter);
+		if (type.empty() || parameter.elements > 0) {
+			// Arreglos y tipos sin equivalente: bytes crudos (los arreglos de
+			// HLSL alinean cada elemento a 16)
+			os << "  unsigned char " << parameter.name << "[" << parameter.size << "];\n";
+		}
+		else {
+			os << "  " << type << " " << parameter.name << ";\n";
+		}
+		offset = parameter.offset + parameter.size;
+	}
+	if (layout.size > offset) {
+		os << "  unsigned char pad" << padding << "[" << (layout.size - offset) << "];\n";
+	}
+	os << "};\n";
+	return os.str();
+}
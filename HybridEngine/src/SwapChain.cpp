@@ -64,6 +64,12 @@ SwapChain::init(Device& device,
     return hr;
   }
 
+  // Enlazar device y context con el backend D3D11
+  m_d3d11Backend.init(device.m_device, deviceContext.m_deviceContext);
+  m_backend = &m_d3d11Backend;
+  device.init(m_backend);
+  deviceContext.init(m_backend);
+
 	// Config the MSAA settings
   m_sampleCount = 4;
   hr = device.m_device->CheckMultisampleQualityLevels(DXGI_FORMAT_R8G8B8A8_UNORM, 
@@ -135,6 +141,48 @@ SwapChain::init(Device& device,
 	return S_OK;
 }
 
+HRESULT
+SwapChain::init(Device& device,
+                DeviceContext& deviceContext,
+                Texture& backBuffer,
+                RenderBackend& backend,
+                unsigned int width,
+                unsigned int height) {
+  if (width == 0 || height == 0) {
+    ERROR("SwapChain", "init", "Width and height must be greater than 0");
+    return E_INVALIDARG;
+  }
+
+  m_driverType = D3D_DRIVER_TYPE_NULL;
+  m_sampleCount = 4;
+  m_qualityLevels = 1;
+  m_backend = &backend;
+  device.init(m_backend);
+  deviceContext.init(m_backend);
+
+  // El back buffer es una textura mas del backend
+  D3D11_TEXTURE2D_DESC desc;
+  memset(&desc, 0, sizeof(desc));
+  desc.Width = width;
+  desc.Height = height;
+  desc.MipLevels = 1;
+  desc.ArraySize = 1;
+  desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+  desc.SampleDesc.Count = m_sampleCount;
+  desc.SampleDesc.Quality = m_qualityLevels - 1;
+  desc.Usage = D3D11_USAGE_DEFAULT;
+  desc.BindFlags = D3D11_BIND_RENDER_TARGET;
+
+  HRESULT hr = device.CreateTexture2D(&desc, nullptr, &backBuffer.m_texture);
+  if (FAILED(hr)) {
+    ERROR("SwapChain", "init",
+      ("Failed to create headless back buffer. HRESULT: " + std::to_string(hr)).c_str());
+    return hr;
+  }
+
+  MESSAGE("SwapChain", "init", backend.getName());
+  return S_OK;
+}
 
 void 
 SwapChain::destroy() {
@@ -150,12 +198,14 @@ SwapChain::destroy() {
   if (m_dxgiFactory) {
     SAFE_RELEASE(m_dxgiFactory);
   }
+  m_d3d11Backend.destroy();
+  m_backend = nullptr;
 }
 
 void 
 SwapChain::present() {
-  if (m_swapChain) {
-    HRESULT hr = m_swapChain->Present(0, 0);
+  if (m_backend) {
+    HRESULT hr = m_backend->Present(m_swapChain, 0, 0);
     if (FAILED(hr)) {
       ERROR("SwapChain", "present", 
         ("Failed to present swap chain. HRESULT: " + std::to_string(hr)).c_str());
@@ -17,7 +17,7 @@ Texture::init(Device device,
 							unsigned int BindFlags, 
 							unsigned int sampleCount, 
 							unsigned int qualityLevels ) {
-	if (!device.m_device) {
+	if (!device.m_backend) {
 		ERROR("DepthStencilView", "init", "Device is null.");
 		return E_POINTER;
 	}
@@ -54,7 +54,7 @@ Texture::init(Device device,
 
 HRESULT
 Texture::init(Device& device, Texture& textureRef, DXGI_FORMAT format) {
-	if (!device.m_device) {
+	if (!device.m_backend) {
 		ERROR("Texture", "init", "Device is null.");
 		return E_POINTER;
 	}
@@ -70,9 +70,9 @@ Texture::init(Device& device, Texture& textureRef, DXGI_FORMAT format) {
 	srvDesc.Texture2D.MipLevels = 1;
 	srvDesc.Texture2D.MostDetailedMip = 0;
 
-	HRESULT hr = device.m_device->CreateShaderResourceView(textureRef.m_texture, 
-																												 &srvDesc, 
-																												 &m_textureFromImg);
+	HRESULT hr = device.CreateShaderResourceView(textureRef.m_texture, 
+                                               &srvDesc,
+                                               &m_textureFromImg);
 
 	if (FAILED(hr)) {
 		ERROR("Texture", "init",
@@ -91,15 +91,13 @@ void
 Texture::render(DeviceContext& deviceContext, 
 								unsigned int StartSlot, 
 								unsigned int NumViews) {
-	if (!deviceContext.m_deviceContext) {
+	if (!deviceContext.m_backend) {
 		ERROR("DepthStencilView", "render", "Device context is null.");
 		return;
 	}
 
 	if (m_textureFromImg) {
-		ID3D11ShaderResourceView* nullSRV[] = { nullptr };
-		deviceContext.m_deviceContext->PSSetShaderResources(StartSlot, NumViews, nullSRV);
-		deviceContext.m_deviceContext->PSSetShaderResources(StartSlot, NumViews, &m_textureFromImg);
+		deviceContext.PSSetShaderResources(StartSlot, NumViews, &m_textureFromImg);
 	}
 }
 
@@ -0,0 +1,284 @@
+#include "TransformSystem.h"
+#include <xmmintrin.h>
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace {
+	// Escribe las filas 0..2 transpuestas de 4 objetos; la fila 3 es (0, 0, 0, 1)
+	inline void
+	storeTransposed4(__m128 w00, __m128 w01, __m128 w02,
+									 __m128 w10, __m128 w11, __m128 w12,
+									 __m128 w20, __m128 w21, __m128 w22,
+									 __m128 tx, __m128 ty, __m128 tz,
+									 unsigned char* dst,
+									 unsigned int stride) {
+		const __m128 lastRow = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+
+		_MM_TRANSPOSE4_PS(w00, w10, w20, tx);
+		_MM_TRANSPOSE4_PS(w01, w11, w21, ty);
+		_MM_TRANSPOSE4_PS(w02, w12, w22, tz);
+
+		float* out = reinterpret_cast<float*>(dst);
+		_mm_storeu_ps(out + 0, w00);
+		_mm_storeu_ps(out + 4, w01);
+		_mm_storeu_ps(out + 8, w02);
+		_mm_storeu_ps(out + 12, lastRow);
+		out = reinterpret_cast<float*>(dst + stride);
+		_mm_storeu_ps(out + 0, w10);
+		_mm_storeu_ps(out + 4, w11);
+		_mm_storeu_ps(out + 8, w12);
+		_mm_storeu_ps(out + 12, lastRow);
+		out = reinterpret_cast<float*>(dst + stride * 2);
+		_mm_storeu_ps(out + 0, w20);
+		_mm_storeu_ps(out + 4, w21);
+		_mm_storeu_ps(out + 8, w22);
+		_mm_storeu_ps(out + 12, lastRow);
+		out = reinterpret_cast<float*>(dst + stride * 3);
+		_mm_storeu_ps(out + 0, tx);
+		_mm_storeu_ps(out + 4, ty);
+		_mm_storeu_ps(out + 8, tz);
+		_mm_storeu_ps(out + 12, lastRow);
+	}
+}
+
+void
+TransformSystem::init(unsigned int expectedCount) {
+	clear();
+	reserve(expectedCount);
+}
+
+unsigned int
+TransformSystem::create(const XMFLOAT3& position,
+												const XMFLOAT4& rotation,
+												const XMFLOAT3& scale) {
+	m_posX.push_back(position.x);
+	m_posY.push_back(position.y);
+	m_posZ.push_back(position.z);
+	m_rotX.push_back(rotation.x);
+	m_rotY.push_back(rotation.y);
+	m_rotZ.push_back(rotation.z);
+	m_rotW.push_back(rotation.w);
+	m_scaleX.push_back(scale.x);
+	m_scaleY.push_back(scale.y);
+	m_scaleZ.push_back(scale.z);
+	return m_count++;
+}
+
+void
+TransformSystem::setPosition(unsigned int index, const XMFLOAT3& position) {
+	m_posX[index] = position.x;
+	m_posY[index] = position.y;
+	m_posZ[index] = position.z;
+}
+
+void
+TransformSystem::setRotation(unsigned int index, const XMFLOAT4& rotation) {
+	m_rotX[index] = rotation.x;
+	m_rotY[index] = rotation.y;
+	m_rotZ[index] = rotation.z;
+	m_rotW[index] = rotation.w;
+}
+
+void
+TransformSystem::setRotationRollPitchYaw(unsigned int index, float pitch, float yaw, float roll) {
+	XMFLOAT4 rotation;
+	XMStoreFloat4(&rotation, XMQuaternionRotationRollPitchYaw(pitch, yaw, roll));
+	setRotation(index, rotation);
+}
+
+void
+TransformSystem::setScale(unsigned int index, const XMFLOAT3& scale) {
+	m_scaleX[index] = scale.x;
+	m_scaleY[index] = scale.y;
+	m_scaleZ[index] = scale.z;
+}
+
+void
+TransformSystem::composeWorldTransposed(unsigned int begin,
+																				unsigned int end,
+																				void* dst,
+																				unsigned int stride) const {
+	if (end > m_count) {
+		end = m_count;
+	}
+	unsigned char* base = static_cast<unsigned char*>(dst);
+	unsigned int i = begin;
+
+#if defined(__AVX__)
+	// 8 objetos por iteracion; la transposicion se hace por mitades de 128 bits
+	const __m256 one8 = _mm256_set1_ps(1.0f);
+	for (; i + 8 <= end; i += 8) {
+		__m256 x = _mm256_loadu_ps(&m_rotX[i]);
+		__m256 y = _mm256_loadu_ps(&m_rotY[i]);
+		__m256 z = _mm256_loadu_ps(&m_rotZ[i]);
+		__m256 w = _mm256_loadu_ps(&m_rotW[i]);
+		__m256 sx = _mm256_loadu_ps(&m_scaleX[i]);
+		__m256 sy = _mm256_loadu_ps(&m_scaleY[i]);
+		__m256 sz = _mm256_loadu_ps(&m_scaleZ[i]);
+
+		__m256 x2 = _mm256_add_ps(x, x);
+		__m256 y2 = _mm256_add_ps(y, y);
+		__m256 z2 = _mm256_add_ps(z, z);
+		__m256 xx = _mm256_mul_ps(x, x2);
+		__m256 yy = _mm256_mul_ps(y, y2);
+		__m256 zz = _mm256_mul_ps(z, z2);
+		__m256 xy = _mm256_mul_ps(x, y2);
+		__m256 xz = _mm256_mul_ps(x, z2);
+		__m256 yz = _mm256_mul_ps(y, z2);
+		__m256 wx = _mm256_mul_ps(w, x2);
+		__m256 wy = _mm256_mul_ps(w, y2);
+		__m256 wz = _mm256_mul_ps(w, z2);
+
+		__m256 w00 = _mm256_mul_ps(sx, _mm256_sub_ps(one8, _mm256_add_ps(yy, zz)));
+		__m256 w01 = _mm256_mul_ps(sx, _mm256_add_ps(xy, wz));
+		__m256 w02 = _mm256_mul_ps(sx, _mm256_sub_ps(xz, wy));
+		__m256 w10 = _mm256_mul_ps(sy, _mm256_sub_ps(xy, wz));
+		__m256 w11 = _mm256_mul_ps(sy, _mm256_sub_ps(one8, _mm256_add_ps(xx, zz)));
+		__m256 w12 = _mm256_mul_ps(sy, _mm256_add_ps(yz, wx));
+		__m256 w20 = _mm256_mul_ps(sz, _mm256_add_ps(xz, wy));
+		__m256 w21 = _mm256_mul_ps(sz, _mm256_sub_ps(yz, wx));
+		__m256 w22 = _mm256_mul_ps(sz, _mm256_sub_ps(one8, _mm256_add_ps(xx, yy)));
+		__m256 tx = _mm256_loadu_ps(&m_posX[i]);
+		__m256 ty = _mm256_loadu_ps(&m_posY[i]);
+		__m256 tz = _mm256_loadu_ps(&m_posZ[i]);
+
+		storeTransposed4(_mm256_castps256_ps128(w00), _mm256_castps256_ps128(w01), _mm256_castps256_ps128(w02),
+										 _mm256_castps256_ps128(w10), _mm256_castps256_ps128(w11), _mm256_castps256_ps128(w12),
+										 _mm256_castps256_ps128(w20), _mm256_castps256_ps128(w21), _mm256_castps256_ps128(w22),
+										 _mm256_castps256_ps128(tx), _mm256_castps256_ps128(ty), _mm256_castps256_ps128(tz),
+										 base + i * stride, stride);
+		storeTransposed4(_mm256_extractf128_ps(w00, 1), _mm256_extractf128_ps(w01, 1), _mm256_extractf128_ps(w02, 1),
+										 _mm256_extractf128_ps(w10, 1), _mm256_extractf128_ps(w11, 1), _mm256_extractf128_ps(w12, 1),
+										 _mm256_extractf128_ps(w20, 1), _mm256_extractf128_ps(w21, 1), _mm256_extractf128_ps(w22, 1),
+										 _mm256_extractf128_ps(tx, 1), _mm256_extractf128_ps(ty, 1), _mm256_extractf128_ps(tz, 1),
+										 base + (i + 4) * stride, stride);
+	}
+#endif
+
+	// 4 objetos por iteracion con SSE
+	const __m128 one = _mm_set1_ps(1.0f);
+	for (; i + 4 <= end; i += 4) {
+		__m128 x = _mm_loadu_ps(&m_rotX[i]);
+		__m128 y = _mm_loadu_ps(&m_rotY[i]);
+		__m128 z = _mm_loadu_ps(&m_rotZ[i]);
+		__m128 w = _mm_loadu_ps(&m_rotW[i]);
+		__m128 sx = _mm_loadu_ps(&m_scaleX[i]);
+		__m128 sy = _mm_loadu_ps(&m_scaleY[i]);
+		__m128 sz = _mm_loadu_ps(&m_scaleZ[i]);
+
+		__m128 x2 = _mm_add_ps(x, x);
+		__m128 y2 = _mm_add_ps(y, y);
+		__m128 z2 = _mm_add_ps(z, z);
+		__m128 xx = _mm_mul_ps(x, x2);
+		__m128 yy = _mm_mul_ps(y, y2);
+		__m128 zz = _mm_mul_ps(z, z2);
+		__m128 xy = _mm_mul_ps(x, y2);
+		__m128 xz = _mm_mul_ps(x, z2);
+		__m128 yz = _mm_mul_ps(y, z2);
+		__m128 wx = _mm_mul_ps(w, x2);
+		__m128 wy = _mm_mul_ps(w, y2);
+		__m128 wz = _mm_mul_ps(w, z2);
+
+		storeTransposed4(_mm_mul_ps(sx, _mm_sub_ps(one, _mm_add_ps(yy, zz))),
+										 _mm_mul_ps(sx, _mm_add_ps(xy, wz)),
+										 _mm_mul_ps(sx, _mm_sub_ps(xz, wy)),
+										 _mm_mul_ps(sy, _mm_sub_ps(xy, wz)),
+										 _mm_mul_ps(sy, _mm_sub_ps(one, _mm_add_ps(xx, zz))),
+										 _mm_mul_ps(sy, _mm_add_ps(yz, wx)),
+										 _mm_mul_ps(sz, _mm_add_ps(xz, wy)),
+										 _mm_mul_ps(sz, _mm_sub_ps(yz, wx)),
+										 _mm_mul_ps(sz, _mm_sub_ps(one, _mm_add_ps(xx, yy))),
+										 _mm_loadu_ps(&m_posX[i]),
+										 _mm_loadu_ps(&m_posY[i]),
+										 _mm_loadu_ps(&m_posZ[i]),
+										 base + i * stride, stride);
+	}
+
+	// Cola que no llena un grupo de 4
+	for (; i < end; ++i) {
+		composeScalar(i, reinterpret_cast<float*>(base + i * stride));
+	}
+}
+
+XMMATRIX
+TransformSystem::getWorldMatrix(unsigned int index) const {
+	float t[16];
+	composeScalar(index, t);
+	return XMMATRIX(t[0], t[4], t[8],  t[12],
+									t[1], t[5], t[9],  t[13],
+									t[2], t[6], t[10], t[14],
+									t[3], t[7], t[11], t[15]);
+}
+
+void
+TransformSystem::composeScalar(unsigned int i, float* out) const {
+	float x = m_rotX[i], y = m_rotY[i], z = m_rotZ[i], w = m_rotW[i];
+	float x2 = x + x, y2 = y + y, z2 = z + z;
+	float xx = x * x2, yy = y * y2, zz = z * z2;
+	float xy = x * y2, xz = x * z2, yz = y * z2;
+	float wx = w * x2, wy = w * y2, wz = w * z2;
+	float sx = m_scaleX[i], sy = m_scaleY[i], sz = m_scaleZ[i];
+
+	// Columnas del mundo = filas de la transpuesta
+	out[0]  = sx * (1.0f - (yy + zz));
+	out[1]  = sy * (xy - wz);
+	out[2]  = sz * (xz + wy);
+	out[3]  = m_posX[i];
+	out[4]  = sx * (xy + wz);
+	out[5]  = sy * (1.0f - (xx + zz));
+	out[6]  = sz * (yz - wx);
+	out[7]  = m_posY[i];
+	out[8]  = sx * (xz - wy);
+	out[9]  = sy * (yz + wx);
+	out[10] = sz * (1.0f - (xx + yy));
+	out[11] = m_posZ[i];
+	out[12] = 0.0f;
+	out[13] = 0.0f;
+	out[14] = 0.0f;
+	out[15] = 1.0f;
+}
+
+void
+TransformSystem::reserve(unsigned int capacity) {
+	m_posX.reserve(capacity);
+	m_posY.reserve(capacity);
+	m_posZ.reserve(capacity);
+	m_rotX.reserve(capacity);
+	m_rotY.reserve(capacity);
+	m_rotZ.reserve(capacity);
+	m_rotW.reserve(capacity);
+	m_scaleX.reserve(capacity);
+	m_scaleY.reserve(capacity);
+	m_scaleZ.reserve(capacity);
+}
+
+void
+TransformSystem::clear() {
+	m_count = 0;
+	m_posX.clear();
+	m_posY.clear();
+	m_posZ.clear();
+	m_rotX.clear();
+	m_rotY.clear();
+	m_rotZ.clear();
+	m_rotW.clear();
+	m_scaleX.clear();
+	m_scaleY.clear();
+	m_scaleZ.clear();
+}
+
+void
+TransformSystem::destroy() {
+	clear();
+	m_posX.shrink_to_fit();
+	m_posY.shrink_to_fit();
+	m_posZ.shrink_to_fit();
+	m_rotX.shrink_to_fit();
+	m_rotY.shrink_to_fit();
+	m_rotZ.shrink_to_fit();
+	m_rotW.shrink_to_fit();
+	m_scaleX.shrink_to_fit();
+	m_scaleY.shrink_to_fit();
+	m_scaleZ.shrink_to_fit();
+}
@@ -0,0 +1,91 @@
+#include "UploadRing.h"
+
+bool
+UploadRing::init(unsigned int capacity, unsigned int alignment, unsigned int framesInFlight) {
+	if (capacity == 0 || alignment == 0 || (alignment & (alignment - 1)) != 0) {
+		return false;
+	}
+	m_capacity = capacity;
+	m_alignment = alignment;
+	m_maxFramesInFlight = framesInFlight;
+	m_head = 0;
+	m_used = 0;
+	m_inFlight.clear();
+	m_inFlight.reserve(framesInFlight + 1);
+	m_current = UploadRingStats();
+	m_lastFrame = UploadRingStats();
+	return true;
+}
+
+void
+UploadRing::beginFrame() {
+	// La cola avanza implicitamente: tail = head - used
+	while (m_inFlight.size() > m_maxFramesInFlight) {
+		m_used -= m_inFlight.front();
+		m_inFlight.erase(m_inFlight.begin());
+	}
+}
+
+unsigned int
+UploadRing::allocate(unsigned int size) {
+	unsigned int aligned = (size + m_alignment - 1) & ~(m_alignment - 1);
+	if (aligned == 0 || aligned > m_capacity || m_used == m_capacity) {
+		m_current.failedAllocations++;
+		return INVALID_OFFSET;
+	}
+
+	if (m_used == 0) {
+		m_head = 0;
+	}
+	unsigned int tail = (m_head + m_capacity - m_used) % m_capacity;
+	unsigned int offset = INVALID_OFFSET;
+	unsigned int consumed = 0;
+
+	if (m_head >= tail) {
+		// Libre: [head, capacity) y [0, tail)
+		if (m_head + aligned <= m_capacity) {
+			offset = m_head;
+			consumed = aligned;
+		}
+		else if (aligned <= tail) {
+			// Se descarta el hueco del final y se da la vuelta
+			offset = 0;
+			consumed = (m_capacity - m_head) + aligned;
+			m_current.wraps++;
+		}
+	}
+	else if (m_head + aligned <= tail) {
+		offset = m_head;
+		consumed = aligned;
+	}
+
+	if (offset == INVALID_OFFSET) {
+		m_current.failedAllocations++;
+		return INVALID_OFFSET;
+	}
+
+	m_head = (offset + aligned) % m_capacity;
+	m_used += consumed;
+	m_current.allocations++;
+	m_current.bytesRequested += size;
+	m_current.bytesConsumed += consumed;
+	return offset;
+}
+
+void
+UploadRing::endFrame() {
+	m_inFlight.push_back(static_cast<unsigned int>(m_current.bytesConsumed));
+	m_lastFrame = m_current;
+	unsigned int frame = m_current.frame;
+	m_current = UploadRingStats();
+	m_current.frame = frame + 1;
+}
+
+void
+UploadRing::destroy() {
+	m_inFlight.clear();
+	m_inFlight.shrink_to_fit();
+	m_capacity = 0;
+	m_head = 0;
+	m_used = 0;
+}
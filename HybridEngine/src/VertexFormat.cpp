@@ -0,0 +1,461 @@
+#include "VertexFormat.h"
+#include "MeshComponent.h"
+#include "Bounds.h"
+#include <cstring>
+#include <emmintrin.h>
+
+namespace {
+	inline const char*
+	at(const void* base, unsigned int index, unsigned int stride) {
+		return static_cast<const char*>(base) + static_cast<size_t>(index) * stride;
+	}
+
+	inline char*
+	at(void* base, unsigned int index, unsigned int stride) {
+		return static_cast<char*>(base) + static_cast<size_t>(index) * stride;
+	}
+
+	inline __m128
+	select(__m128 mask, __m128 a, __m128 b) {
+		return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+	}
+
+	inline __m128i
+	select(__m128i mask, __m128i a, __m128i b) {
+		return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+	}
+
+	// 4 floats -> 4 halfs en los 16 bits bajos de cada entero. Redondeo al par
+	// mas cercano, subnormales, inf y nan; version SSE2 del metodo de F. Giesen
+	inline __m128i
+	floatToHalf(__m128 f) {
+		const __m128i signMask = _mm_set1_epi32(0x80000000);
+		const __m128i f16Max = _mm_set1_epi32((127 + 16) << 23);
+		const __m128i nanBit = _mm_set1_epi32(0x200);
+		const __m128i infinity = _mm_set1_epi32(0x7c00);
+		const __m128i minNormal = _mm_set1_epi32((127 - 14) << 23);
+		const __m128i subnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+		const __m128i normalBias = _mm_set1_epi32(0xfff - ((127 - 15) << 23));
+
+		__m128 sign = _mm_and_ps(f, _mm_castsi128_ps(signMask));
+		__m128 absolute = _mm_xor_ps(f, sign);
+		__m128i absoluteInt = _mm_castps_si128(absolute);
+
+		__m128i isNan = _mm_castps_si128(_mm_cmpunord_ps(absolute, absolute));
+		__m128i isRegular = _mm_cmpgt_epi32(f16Max, absoluteInt);
+		__m128i isSubnormal = _mm_cmpgt_epi32(minNormal, absoluteInt);
+		__m128i infOrNan = _mm_or_si128(_mm_and_si128(isNan, nanBit), infinity);
+
+		// Subnormal: la suma con el numero magico alinea la mantisa
+		__m128 subnormal = _mm_add_ps(absolute, _mm_castsi128_ps(subnormalMagic));
+		__m128i subnormalInt = _mm_sub_epi32(_mm_castps_si128(subnormal), subnormalMagic);
+
+		// Normal: rebias del exponente y redondeo al par
+		__m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absoluteInt, 31 - 13), 31);
+		__m128i rounded = _mm_sub_epi32(_mm_add_epi32(absoluteInt, normalBias), mantissaOdd);
+		__m128i normal = _mm_srli_epi32(rounded, 13);
+
+		__m128i finite = select(isSubnormal, subnormalInt, normal);
+		__m128i joined = select(isRegular, finite, infOrNan);
+		return _mm_or_si128(joined, _mm_srli_epi32(_mm_castps_si128(sign), 16));
+	}
+
+	// 4 halfs (16 bits bajos de cada entero) -> 4 floats
+	inline __m128
+	halfToFloat(__m128i h) {
+		const __m128i noSign = _mm_set1_epi32(0x7fff);
+		const __m128 magic = _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23));
+		const __m128i wasInfNan = _mm_set1_epi32(0x7bff);
+		const __m128i infNanExponent = _mm_set1_epi32(255 << 23);
+
+		__m128i exponentMantissa = _mm_and_si128(noSign, h);
+		__m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(exponentMantissa, 13)), magic);
+		__m128i isInfNan = _mm_cmpgt_epi32(exponentMantissa, wasInfNan);
+		__m128i sign = _mm_slli_epi32(_mm_xor_si128(h, exponentMantissa), 16);
+		__m128i signInfNan = _mm_or_si128(sign, _mm_and_si128(isInfNan, infNanExponent));
+		return _mm_or_ps(scaled, _mm_castsi128_ps(signInfNan));
+	}
+
+	// Empaqueta los 16 bits bajos de 8 enteros sin saturar
+	inline __m128i
+	packLow16(__m128i a, __m128i b) {
+		a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+		b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+		return _mm_packs_epi32(a, b);
+	}
+
+	inline void
+	store32(void* dst, __m128i value) {
+		int word = _mm_cvtsi128_si32(value);
+		memcpy(dst, &word, sizeof(word));
+	}
+
+	inline int
+	load32(const void* src) {
+		int word;
+		memcpy(&word, src, sizeof(word));
+		return word;
+	}
+
+	const short SNORM16_ONE = 32767;
+}
+
+void
+EncodePositionsUnorm16(const void* src, unsigned int srcStride, unsigned int count,
+											 const XMFLOAT3& minimum, const XMFLOAT3& extent,
+											 void* dst, unsigned int dstStride) {
+	const __m128 offset = _mm_set_ps(0.0f, minimum.z, minimum.y, minimum.x);
+	const __m128 scale = _mm_set_ps(65535.0f,
+																	extent.z > 0.0f ? 65535.0f / extent.z : 0.0f,
+																	extent.y > 0.0f ? 65535.0f / extent.y : 0.0f,
+																	extent.x > 0.0f ? 65535.0f / extent.x : 0.0f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 maximum = _mm_set1_ps(65535.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128i bias = _mm_set1_epi32(32768);
+	const __m128i flip = _mm_set1_epi16(static_cast<short>(0x8000));
+
+	// Dos vertices por registro de 8 x uint16
+	for (unsigned int i = 0; i < count; i += 2) {
+		const XMFLOAT3& a = *reinterpret_cast<const XMFLOAT3*>(at(src, i, srcStride));
+		const XMFLOAT3& b = i + 1 < count ? *reinterpret_cast<const XMFLOAT3*>(at(src, i + 1, srcStride)) : a;
+		__m128 qa = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(_mm_set_ps(1.0f, a.z, a.y, a.x), offset), scale), half);
+		__m128 qb = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(_mm_set_ps(1.0f, b.z, b.y, b.x), offset), scale), half);
+		qa = _mm_min_ps(_mm_max_ps(qa, zero), maximum);
+		qb = _mm_min_ps(_mm_max_ps(qb, zero), maximum);
+		// SSE2 solo empaqueta con signo: correr a [-32768, 32767] y volver
+		__m128i ia = _mm_sub_epi32(_mm_cvttps_epi32(qa), bias);
+		__m128i ib = _mm_sub_epi32(_mm_cvttps_epi32(qb), bias);
+		__m128i packed = _mm_xor_si128(_mm_packs_epi32(ia, ib), flip);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(at(dst, i, dstStride)), packed);
+		if (i + 1 < count) {
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(at(dst, i + 1, dstStride)), _mm_srli_si128(packed, 8));
+		}
+	}
+}
+
+void
+DecodePositionsUnorm16(const void* src, unsigned int srcStride, unsigned int count,
+											 const XMFLOAT3& minimum, const XMFLOAT3& extent,
+											 void* dst, unsigned int dstStride) {
+	const __m128 offset = _mm_set_ps(0.0f, minimum.z, minimum.y, minimum.x);
+	const __m128 scale = _mm_set_ps(0.0f, extent.z / 65535.0f, extent.y / 65535.0f, extent.x / 65535.0f);
+	const __m128i zero = _mm_setzero_si128();
+	for (unsigned int i = 0; i < count; ++i) {
+		__m128i raw = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(at(src, i, srcStride)));
+		__m128 p = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(raw, zero)), scale), offset);
+		float out[4];
+		_mm_storeu_ps(out, p);
+		memcpy(at(dst, i, dstStride), out, sizeof(XMFLOAT3));
+	}
+}
+
+void
+EncodeHalf2(const void* src, unsigned int srcStride, unsigned int count,
+						void* dst, unsigned int dstStride) {
+	for (unsigned int i = 0; i < count; i += 4) {
+		// Bloque de 4: los que faltan al final repiten el ultimo
+		const XMFLOAT2* v[4];
+		for (unsigned int k = 0; k < 4; ++k) {
+			unsigned int index = i + k < count ? i + k : count - 1;
+			v[k] = reinterpret_cast<const XMFLOAT2*>(at(src, index, srcStride));
+		}
+		__m128i h01 = floatToHalf(_mm_set_ps(v[1]->y, v[1]->x, v[0]->y, v[0]->x));
+		__m128i h23 = floatToHalf(_mm_set_ps(v[3]->y, v[3]->x, v[2]->y, v[2]->x));
+		__m128i packed = packLow16(h01, h23);
+		for (unsigned int k = 0; k < 4 && i + k < count; ++k) {
+			store32(at(dst, i + k, dstStride), packed);
+			packed = _mm_srli_si128(packed, 4);
+		}
+	}
+}
+
+void
+DecodeHalf2(const void* src, unsigned int srcStride, unsigned int count,
+						void* dst, unsigned int dstStride) {
+	const __m128i zero = _mm_setzero_si128();
+	for (unsigned int i = 0; i < count; i += 4) {
+		int words[4] = { 0, 0, 0, 0 };
+		for (unsigned int k = 0; k < 4 && i + k < count; ++k) {
+			words[k] = load32(at(src, i + k, srcStride));
+		}
+		__m128i raw = _mm_set_epi32(words[3], words[2], words[1], words[0]);
+		float out[8];
+		_mm_storeu_ps(out, halfToFloat(_mm_unpacklo_epi16(raw, zero)));
+		_mm_storeu_ps(out + 4, halfToFloat(_mm_unpackhi_epi16(raw, zero)));
+		for (unsigned int k = 0; k < 4 && i + k < count; ++k) {
+			memcpy(at(dst, i + k, dstStride), out + k * 2, sizeof(XMFLOAT2));
+		}
+	}
+}
+
+void
+EncodeOctahedral16(const void* src, unsigned int srcStride, unsigned int count,
+									 void* dst, unsigned int dstStride) {
+	const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 tiny = _mm_set1_ps(1e-20f);
+	const __m128 snorm = _mm_set1_ps(static_cast<float>(SNORM16_ONE));
+
+	for (unsigned int i = 0; i < count; i += 4) {
+		const XMFLOAT3* n[4];
+		for (unsigned int k = 0; k < 4; ++k) {
+			unsigned int index = i + k < count ? i + k : count - 1;
+			n[k] = reinterpret_cast<const XMFLOAT3*>(at(src, index, srcStride));
+		}
+		__m128 x = _mm_set_ps(n[3]->x, n[2]->x, n[1]->x, n[0]->x);
+		__m128 y = _mm_set_ps(n[3]->y, n[2]->y, n[1]->y, n[0]->y);
+		__m128 z = _mm_set_ps(n[3]->z, n[2]->z, n[1]->z, n[0]->z);
+
+		// Proyectar sobre el octaedro |x| + |y| + |z| = 1
+		__m128 sum = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(signMask, x), _mm_andnot_ps(signMask, y)),
+														_mm_andnot_ps(signMask, z));
+		__m128 inv = _mm_div_ps(one, _mm_max_ps(sum, tiny));
+		__m128 ox = _mm_mul_ps(x, inv);
+		__m128 oy = _mm_mul_ps(y, inv);
+
+		// Hemisferio inferior: doblar las esquinas hacia afuera
+		__m128 lower = _mm_cmplt_ps(z, _mm_setzero_ps());
+		__m128 foldX = _mm_or_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, oy)), _mm_and_ps(ox, signMask));
+		__m128 foldY = _mm_or_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, ox)), _mm_and_ps(oy, signMask));
+		ox = select(lower, foldX, ox);
+		oy = select(lower, foldY, oy);
+
+		__m128i ix = _mm_cvtps_epi32(_mm_mul_ps(ox, snorm));
+		__m128i iy = _mm_cvtps_epi32(_mm_mul_ps(oy, snorm));
+		__m128i packed = _mm_packs_epi32(_mm_unpacklo_epi32(ix, iy), _mm_unpackhi_epi32(ix, iy));
+		for (unsigned int k = 0; k < 4 && i + k < count; ++k) {
+			store32(at(dst, i + k, dstStride), packed);
+			packed = _mm_srli_si128(packed, 4);
+		}
+	}
+}
+
+void
+DecodeOctahedral16(const void* src, unsigned int srcStride, unsigned int count,
+									 void* dst, unsigned int dstStride) {
+	const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 minusOne = _mm_set1_ps(-1.0f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 inverseSnorm = _mm_set1_ps(1.0f / SNORM16_ONE);
+
+	for (unsigned int i = 0; i < count; i += 4) {
+		int words[4] = { 0, 0, 0, 0 };
+		for (unsigned int k = 0; k < 4 && i + k < count; ++k) {
+			words[k] = load32(at(src, i + k, srcStride));
+		}
+		__m128i raw = _mm_set_epi32(words[3], words[2], words[1], words[0]);
+		__m128 x = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_slli_epi32(raw, 16), 16)), inverseSnorm), minusOne);
+		__m128 y = _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(raw, 16)), inverseSnorm), minusOne);
+
+		__m128 z = _mm_sub_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, x)), _mm_andnot_ps(signMask, y));
+		__m128 t = _mm_max_ps(_mm_sub_ps(zero, z), zero);
+		x = _mm_sub_ps(x, _mm_or_ps(t, _mm_and_ps(x, signMask)));
+		y = _mm_sub_ps(y, _mm_or_ps(t, _mm_and_ps(y, signMask)));
+
+		__m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+		__m128 inv = _mm_div_ps(one, length);
+		float xs[4], ys[4], zs[4];
+		_mm_storeu_ps(xs, _mm_mul_ps(x, inv));
+		_mm_storeu_ps(ys, _mm_mul_ps(y, inv));
+		_mm_storeu_ps(zs, _mm_mul_ps(z, inv));
+		for (unsigned int k = 0; k < 4 && i + k < count; ++k) {
+			XMFLOAT3 n(xs[k], ys[k], zs[k]);
+			memcpy(at(dst, i + k, dstStride), &n, sizeof(XMFLOAT3));
+		}
+	}
+}
+
+void
+VertexFormat::init(const VertexFormatDesc& desc) {
+	static const unsigned int positionSizes[] = { 12, 8 };
+	static const unsigned int texcoordSizes[] = { 8, 4 };
+	static const unsigned int normalSizes[] = { 0, 12, 4 };
+	static const unsigned int tangentSizes[] = { 0, 16, 8 };
+
+	m_desc = desc;
+	m_positionOffset = 0;
+	m_texcoordOffset = m_positionOffset + positionSizes[desc.position];
+	m_normalOffset = m_texcoordOffset + texcoordSizes[desc.texcoord];
+	m_tangentOffset = m_normalOffset + normalSizes[desc.normal];
+	m_stride = m_tangentOffset + tangentSizes[desc.tangent];
+	m_quantizeMin = XMFLOAT3(0.0f, 0.0f, 0.0f);
+	m_quantizeExtent = XMFLOAT3(1.0f, 1.0f, 1.0f);
+}
+
+void
+VertexFormat::buildLayout(std::vector<D3D11_INPUT_ELEMENT_DESC>& Layout, unsigned int inputSlot) const {
+	D3D11_INPUT_ELEMENT_DESC element;
+	memset(&element, 0, sizeof(element));
+	element.InputSlot = inputSlot;
+	element.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+
+	element.SemanticName = "POSITION";
+	element.Format = m_desc.position == VERTEX_POSITION_UNORM16 ? DXGI_FORMAT_R16G16B16A16_UNORM
+																															 : DXGI_FORMAT_R32G32B32_FLOAT;
+	element.AlignedByteOffset = m_positionOffset;
+	Layout.push_back(element);
+
+	element.SemanticName = "TEXCOORD";
+	element.Format = m_desc.texcoord == VERTEX_TEXCOORD_HALF2 ? DXGI_FORMAT_R16G16_FLOAT
+																														 : DXGI_FORMAT_R32G32_FLOAT;
+	element.AlignedByteOffset = m_texcoordOffset;
+	Layout.push_back(element);
+
+	if (m_desc.normal != VERTEX_NORMAL_NONE) {
+		// Con OCT16 el shader recibe (x, y) del octaedro y debe expandirlo
+		element.SemanticName = "NORMAL";
+		element.Format = m_desc.normal == VERTEX_NORMAL_OCT16 ? DXGI_FORMAT_R16G16_SNORM
+																													 : DXGI_FORMAT_R32G32B32_FLOAT;
+		element.AlignedByteOffset = m_normalOffset;
+		Layout.push_back(element);
+	}
+	if (m_desc.tangent != VERTEX_TANGENT_NONE) {
+		element.SemanticName = "TANGENT";
+		element.Format = m_desc.tangent == VERTEX_TANGENT_OCT16 ? DXGI_FORMAT_R16G16B16A16_SNORM
+																														 : DXGI_FORMAT_R32G32B32A32_FLOAT;
+		element.AlignedByteOffset = m_tangentOffset;
+		Layout.push_back(element);
+	}
+}
+
+HRESULT
+VertexFormat::encode(const MeshComponent& mesh,
+										 const XMFLOAT3* normals,
+										 const XMFLOAT4* tangents,
+										 std::vector<unsigned char>& out) {
+	if (m_stride == 0) {
+		ERROR("VertexFormat", "encode", "Format is not initialized");
+		return E_FAIL;
+	}
+	if ((m_desc.normal != VERTEX_NORMAL_NONE && !normals) ||
+			(m_desc.tangent != VERTEX_TANGENT_NONE && !tangents)) {
+		ERROR("VertexFormat", "encode", "Format requires normals or tangents that were not provided");
+		return E_INVALIDARG;
+	}
+
+	const unsigned int count = static_cast<unsigned int>(mesh.m_vertex.size());
+	out.assign(static_cast<size_t>(count) * m_stride, 0);
+	if (count == 0) {
+		return S_OK;
+	}
+	unsigned char* base = out.data();
+	const SimpleVertex* vertices = mesh.m_vertex.data();
+	const unsigned int vertexStride = sizeof(SimpleVertex);
+
+	if (m_desc.position == VERTEX_POSITION_UNORM16) {
+		Bounds bounds = ComputeMeshBounds(mesh);
+		m_quantizeMin = XMFLOAT3(bounds.center.x - bounds.extents.x,
+														 bounds.center.y - bounds.extents.y,
+														 bounds.center.z - bounds.extents.z);
+		m_quantizeExtent = XMFLOAT3(bounds.extents.x * 2.0f, bounds.extents.y * 2.0f, bounds.extents.z * 2.0f);
+		EncodePositionsUnorm16(&vertices[0].Pos, vertexStride, count, m_quantizeMin, m_quantizeExtent,
+													 base + m_positionOffset, m_stride);
+	}
+	else {
+		for (unsigned int i = 0; i < count; ++i) {
+			memcpy(base + i * m_stride + m_positionOffset, &vertices[i].Pos, sizeof(XMFLOAT3));
+		}
+	}
+
+	if (m_desc.texcoord == VERTEX_TEXCOORD_HALF2) {
+		EncodeHalf2(&vertices[0].Tex, vertexStride, count, base + m_texcoordOffset, m_stride);
+	}
+	else {
+		for (unsigned int i = 0; i < count; ++i) {
+			memcpy(base + i * m_stride + m_texcoordOffset, &vertices[i].Tex, sizeof(XMFLOAT2));
+		}
+	}
+
+	if (m_desc.normal == VERTEX_NORMAL_OCT16) {
+		EncodeOctahedral16(normals, sizeof(XMFLOAT3), count, base + m_normalOffset, m_stride);
+	}
+	else if (m_desc.normal == VERTEX_NORMAL_FLOAT3) {
+		for (unsigned int i = 0; i < count; ++i) {
+			memcpy(base + i * m_stride + m_normalOffset, &normals[i], sizeof(XMFLOAT3));
+		}
+	}
+
+	if (m_desc.tangent == VERTEX_TANGENT_OCT16) {
+		// xyz en el octaedro; z del elemento guarda el signo de la bitangente
+		EncodeOctahedral16(tangents, sizeof(XMFLOAT4), count, base + m_tangentOffset, m_stride);
+		for (unsigned int i = 0; i < count; ++i) {
+			short handedness[2] = { static_cast<short>(tangents[i].w < 0.0f ? -SNORM16_ONE : SNORM16_ONE), 0 };
+			memcpy(base + i * m_stride + m_tangentOffset + 4, handedness, sizeof(handedness));
+		}
+	}
+	else if (m_desc.tangent == VERTEX_TANGENT_FLOAT4) {
+		for (unsigned int i = 0; i < count; ++i) {
+			memcpy(base + i * m_stride + m_tangentOffset, &tangents[i], sizeof(XMFLOAT4));
+		}
+	}
+	return S_OK;
+}
+
+void
+VertexFormat::decode(const void* data,
+										 unsigned int count,
+										 MeshComponent& mesh,
+										 XMFLOAT3* normals,
+										 XMFLOAT4* tangents) const {
+	mesh.m_vertex.resize(count);
+	mesh.m_numVertex = static_cast<int>(count);
+	if (count == 0) {
+		return;
+	}
+	const unsigned char* base = static_cast<const unsigned char*>(data);
+	SimpleVertex* vertices = mesh.m_vertex.data();
+	const unsigned int vertexStride = sizeof(SimpleVertex);
+
+	if (m_desc.position == VERTEX_POSITION_UNORM16) {
+		DecodePositionsUnorm16(base + m_positionOffset, m_stride, count, m_quantizeMin, m_quantizeExtent,
+													 &vertices[0].Pos, vertexStride);
+	}
+	else {
+		for (unsigned int i = 0; i < count; ++i) {
+			memcpy(&vertices[i].Pos, base + i * m_stride + m_positionOffset, sizeof(XMFLOAT3));
+		}
+	}
+
+	if (m_desc.texcoord == VERTEX_TEXCOORD_HALF2) {
+		DecodeHalf2(base + m_texcoordOffset, m_stride, count, &vertices[0].Tex, vertexStride);
+	}
+	else {
+		for (unsigned int i = 0; i < count; ++i) {
+			memcpy(&vertices[i].Tex, base + i * m_stride + m_texcoordOffset, sizeof(XMFLOAT2));
+		}
+	}
+
+	if (normals && m_desc.normal == VERTEX_NORMAL_OCT16) {
+		DecodeOctahedral16(base + m_normalOffset, m_stride, count, normals, sizeof(XMFLOAT3));
+	}
+	else if (normals && m_desc.normal == VERTEX_NORMAL_FLOAT3) {
+		for (unsigned int i = 0; i < count; ++i) {
+			memcpy(&normals[i], base + i * m_stride + m_normalOffset, sizeof(XMFLOAT3));
+		}
+	}
+
+	if (tangents && m_desc.tangent == VERTEX_TANGENT_OCT16) {
+		DecodeOctahedral16(base + m_tangentOffset, m_stride, count, tangents, sizeof(XMFLOAT4));
+		for (unsigned int i = 0; i < count; ++i) {
+			short handedness;
+			memcpy(&handedness, base + i * m_stride + m_tangentOffset + 4, sizeof(handedness));
+			tangents[i].w = handedness < 0 ? -1.0f : 1.0f;
+		}
+	}
+	else if (tangents && m_desc.tangent == VERTEX_TANGENT_FLOAT4) {
+		for (unsigned int i = 0; i < count; ++i) {
+			memcpy(&tangents[i], base + i * m_stride + m_tangentOffset, sizeof(XMFLOAT4));
+		}
+	}
+}
+
+XMMATRIX
+VertexFormat::getDequantizeMatrix() const {
+	if (m_desc.position != VERTEX_POSITION_UNORM16) {
+		return XMMatrixIdentity();
+	}
+	return XMMatrixScaling(m_quantizeExtent.x, m_quantizeExtent.y, m_quantizeExtent.z) *
+				 XMMatrixTranslation(m_quantizeMin.x, m_quantizeMin.y, m_quantizeMin.z);
+}